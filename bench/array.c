@@ -0,0 +1,137 @@
+/* wav_array.h kernels compared with plain loops.
+ *
+ *   wav      the wav_*_array_* function
+ *   naive    a scalar loop with vectorization and interleaving
+ *            disabled
+ *   autovec  the same loop left to clang's vectorizer (on wasm that
+ *            means SIMD128; natively, whatever the flags allow)
+ *
+ * Lengths are in elements; 1000 isn't a multiple of any vector size,
+ * so the partial head and tail vectors are included.  The wav results
+ * are checked against the naive ones before timing. */
+
+#include "bench.h"
+#include "wav_array.h"
+
+typedef struct {
+  void * dest;
+  const void * a;
+  const void * b;
+  size_t len;
+} array_input;
+
+#define DEFINE_IMPL_(name, Element, ...) \
+  static void \
+  name(void * ctx, size_t iterations) { \
+    const array_input * in = (const array_input *) ctx; \
+    for (size_t it = 0 ; it < iterations ; it++) { \
+      Element * dest = (Element *) in->dest; \
+      const Element * a = (const Element *) in->a; \
+      const Element * b = (const Element *) in->b; \
+      const size_t len = in->len; \
+      WAV_BENCH_KEEP_SCALAR(dest); \
+      __VA_ARGS__ \
+      WAV_BENCH_CLOBBER(dest); \
+      (void) a; (void) b; (void) len; \
+    } \
+  }
+
+/* DEFINE_UNARY/DEFINE_BINARY(Type, Element, op, expr): expr is the
+ * scalar version, in terms of a[i] (and b[i]). */
+#define DEFINE_UNARY(Type, Element, op, expr) \
+  DEFINE_IMPL_(array_wav_##Type##_##op, Element, \
+    wav_##Type##_array_##op(dest, a, len);) \
+  DEFINE_IMPL_(array_naive_##Type##_##op, Element, \
+    _Pragma("clang loop vectorize(disable) interleave(disable)") \
+    for (size_t i = 0 ; i < len ; i++) dest[i] = (expr);) \
+  DEFINE_IMPL_(array_autovec_##Type##_##op, Element, \
+    _Pragma("clang loop vectorize(enable)") \
+    for (size_t i = 0 ; i < len ; i++) dest[i] = (expr);)
+
+#define DEFINE_BINARY(Type, Element, op, expr) \
+  DEFINE_IMPL_(array_wav_##Type##_##op, Element, \
+    wav_##Type##_array_##op(dest, a, b, len);) \
+  DEFINE_IMPL_(array_naive_##Type##_##op, Element, \
+    _Pragma("clang loop vectorize(disable) interleave(disable)") \
+    for (size_t i = 0 ; i < len ; i++) dest[i] = (expr);) \
+  DEFINE_IMPL_(array_autovec_##Type##_##op, Element, \
+    _Pragma("clang loop vectorize(enable)") \
+    for (size_t i = 0 ; i < len ; i++) dest[i] = (expr);)
+
+DEFINE_BINARY(f32x4,    float, add, a[i] + b[i])
+DEFINE_BINARY(f64x2,   double, mul, a[i] * b[i])
+DEFINE_BINARY(i16x8,  int16_t, mul, (int16_t) (a[i] * b[i]))
+DEFINE_BINARY(i32x4,  int32_t, min, (a[i] < b[i]) ? a[i] : b[i])
+DEFINE_BINARY(u8x16,  uint8_t, add_sat, (uint8_t) (((a[i] + b[i]) > UINT8_MAX) ? UINT8_MAX : (a[i] + b[i])))
+DEFINE_UNARY (i32x4,  int32_t, abs, (int32_t) ((a[i] < 0) ? (0u - (uint32_t) a[i]) : (uint32_t) a[i]))
+DEFINE_UNARY (i8x16,   int8_t, popcnt, (int8_t) __builtin_popcount((uint8_t) a[i]))
+
+/* Run the naive and wav versions once and compare their output. */
+#define CHECK(Type, Element, op, in, expected) \
+  do { \
+    array_naive_##Type##_##op((in), 1); \
+    memcpy((expected), (in)->dest, (in)->len * sizeof(Element)); \
+    array_wav_##Type##_##op((in), 1); \
+    if (memcmp((in)->dest, (expected), (in)->len * sizeof(Element)) != 0) { \
+      fprintf(stderr, "%s_array_%s: wrong result for %zu elements\n", #Type, #op, (in)->len); \
+      return EXIT_FAILURE; \
+    } \
+  } while (0)
+
+#define RUN(Type, Element, op, size, in, expected) \
+  do { \
+    const char * name = #Type "_array_" #op; \
+    CHECK(Type, Element, op, in, expected); \
+    wav_bench_run(name, "wav", "throughput", (size), (double) (size), array_wav_##Type##_##op, (in)); \
+    wav_bench_run(name, "naive", "throughput", (size), (double) (size), array_naive_##Type##_##op, (in)); \
+    wav_bench_run(name, "autovec", "throughput", (size), (double) (size), array_autovec_##Type##_##op, (in)); \
+  } while (0)
+
+int
+main(int argc, char ** argv) {
+  static const size_t sizes[] = { 1000, 16384, 1 << 20 };
+
+  wav_bench_init("array", argc, argv);
+
+  for (size_t s = 0 ; s < sizeof(sizes) / sizeof(sizes[0]) ; s++) {
+    const size_t len = sizes[s];
+    if (!wav_bench_size_enabled(len))
+      continue;
+
+    /* Room for len doubles, the largest element type. */
+    const size_t bytes = len * sizeof(double);
+    array_input in = { wav_bench_alloc(bytes), wav_bench_alloc(bytes), wav_bench_alloc(bytes), len };
+    void * expected = wav_bench_alloc(bytes);
+    wav_bench_fill_random((void *) in.a, bytes, 1);
+    wav_bench_fill_random((void *) in.b, bytes, 2);
+
+    /* Random bytes can make NaNs and subnormals, which would make the
+     * float benchmarks measure something else. */
+    for (size_t i = 0 ; i < len ; i++) {
+      ((float *) in.a)[i] = (float) (i % 1000) * 0.5f;
+      ((float *) in.b)[i] = 1.25f;
+    }
+    RUN(f32x4, float, add, len, &in, expected);
+
+    for (size_t i = 0 ; i < len ; i++) {
+      ((double *) in.a)[i] = (double) (i % 1000) * 0.5;
+      ((double *) in.b)[i] = 1.25;
+    }
+    RUN(f64x2, double, mul, len, &in, expected);
+
+    wav_bench_fill_random((void *) in.a, bytes, 3);
+    wav_bench_fill_random((void *) in.b, bytes, 4);
+    RUN(i16x8, int16_t, mul, len, &in, expected);
+    RUN(i32x4, int32_t, min, len, &in, expected);
+    RUN(u8x16, uint8_t, add_sat, len, &in, expected);
+    RUN(i32x4, int32_t, abs, len, &in, expected);
+    RUN(i8x16, int8_t, popcnt, len, &in, expected);
+
+    free(expected);
+    free(in.dest);
+    free((void *) in.a);
+    free((void *) in.b);
+  }
+
+  return 0;
+}
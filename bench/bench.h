@@ -0,0 +1,319 @@
+/* WAV benchmark harness
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* Shared code for the programs in bench/.
+ *
+ * Each program is one suite.  It calls wav_bench_init() with argc and
+ * argv, then wav_bench_run() once per benchmark, and every result is
+ * printed as a single line of JSON:
+ *
+ *   {"suite":"ops","name":"f32x4_add","impl":"wav","mode":"latency",
+ *    "size":1,"backend":"sse4.1","runtime":"native","ns":0.912}
+ *
+ * "ns" is nanoseconds per item; what an item is depends on the
+ * benchmark (one operation for the ops suite, one element for the
+ * array kernels).  "backend" is the WAV implementation compiled in
+ * (wasm-simd128, sse4.1, ssse3, sse2 or portable) and "runtime" is
+ * whatever was passed with --runtime (the CMake targets pass native,
+ * wasmtime or node), so output from several builds can be
+ * concatenated and compared.
+ *
+ * Options:
+ *
+ *   --runtime=NAME  value for the "runtime" field (default "native")
+ *   --filter=TEXT   only run benchmarks whose name contains TEXT
+ *   --quick         run each benchmark once on small inputs; used by
+ *                   the tests to make sure everything still runs
+ *
+ * Timing uses clock_gettime(CLOCK_MONOTONIC), which is also available
+ * in WASI.  The iteration count is doubled until a run takes at least
+ * WAV_BENCH_MIN_NS, and the fastest of WAV_BENCH_REPEAT runs at that
+ * count is reported. */
+
+#if !defined(WAV_BENCH_H)
+#define WAV_BENCH_H
+
+#if !defined(WAV_EMULATION) && !defined(__wasm_simd128__)
+  #define WAV_EMULATION 1
+#endif
+
+#include "wav.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if !defined(WAV_BENCH_MIN_NS)
+  #define WAV_BENCH_MIN_NS 20000000
+#endif
+
+#if !defined(WAV_BENCH_REPEAT)
+  #define WAV_BENCH_REPEAT 5
+#endif
+
+/* Number of independent chains in the throughput loops.  Eight is
+ * enough to cover the latency of everything in WASM SIMD128 on current
+ * hardware without running out of registers on x86-64 or in V8. */
+#if !defined(WAV_BENCH_CHAINS)
+  #define WAV_BENCH_CHAINS 8
+#endif
+
+/* Largest input the --quick runs use. */
+#define WAV_BENCH_QUICK_SIZE 4096
+
+#if defined(__wasm_simd128__)
+  #if defined(__wasm_relaxed_simd__)
+    #define WAV_BENCH_BACKEND "wasm-relaxed-simd"
+  #else
+    #define WAV_BENCH_BACKEND "wasm-simd128"
+  #endif
+#elif WAV_X86_SSE4_1
+  #define WAV_BENCH_BACKEND "sse4.1"
+#elif WAV_X86_SSSE3
+  #define WAV_BENCH_BACKEND "ssse3"
+#elif WAV_X86_SSE2
+  #define WAV_BENCH_BACKEND "sse2"
+#else
+  #define WAV_BENCH_BACKEND "portable"
+#endif
+
+/* Force a value into a register without telling the compiler anything
+ * about it, so loops can't be folded, hoisted or vectorized across
+ * iterations.  WAV_BENCH_KEEP is for WAV vectors, WAV_BENCH_KEEP_SCALAR
+ * for integers and pointers. */
+#if defined(__wasm__)
+  #define WAV_BENCH_KEEP(v) __asm__ __volatile__("" : "+r" ((v).values))
+#elif (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+  #define WAV_BENCH_KEEP(v) __asm__ __volatile__("" : "+x" ((v).values))
+#elif defined(__aarch64__) || (defined(__arm__) && defined(__ARM_NEON))
+  #define WAV_BENCH_KEEP(v) __asm__ __volatile__("" : "+w" ((v).values))
+#else
+  #define WAV_BENCH_KEEP(v) __asm__ __volatile__("" : "+m" ((v).values))
+#endif
+#define WAV_BENCH_KEEP_SCALAR(x) __asm__ __volatile__("" : "+r" (x))
+
+/* Make the compiler believe the memory at ptr is read. */
+#define WAV_BENCH_CLOBBER(ptr) __asm__ __volatile__("" : : "r" (ptr) : "memory")
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef void (*wav_bench_fn)(void * ctx, size_t iterations);
+
+static struct {
+  const char * suite;
+  const char * runtime;
+  const char * filter;
+  int quick;
+} wav_bench_config_ = { "", "native", NULL, 0 };
+
+static inline void
+wav_bench_init(const char * suite, int argc, char ** argv) {
+  int i;
+
+  wav_bench_config_.suite = suite;
+
+  for (i = 1 ; i < argc ; i++) {
+    if (strncmp(argv[i], "--runtime=", 10) == 0) {
+      wav_bench_config_.runtime = argv[i] + 10;
+    } else if (strncmp(argv[i], "--filter=", 9) == 0) {
+      wav_bench_config_.filter = argv[i] + 9;
+    } else if (strcmp(argv[i], "--quick") == 0) {
+      wav_bench_config_.quick = 1;
+    } else {
+      fprintf(stderr, "Usage: %s [--runtime=NAME] [--filter=TEXT] [--quick]\n", argv[0]);
+      exit(EXIT_FAILURE);
+    }
+  }
+}
+
+/* Whether a benchmark on size elements should run; suites which sweep
+ * over input sizes use this to skip the large ones in --quick mode. */
+static inline int
+wav_bench_size_enabled(size_t size) {
+  return !wav_bench_config_.quick || size <= WAV_BENCH_QUICK_SIZE;
+}
+
+static inline uint64_t
+wav_bench_now_ns_(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t) ts.tv_sec) * UINT64_C(1000000000) + ((uint64_t) ts.tv_nsec);
+}
+
+static inline uint64_t
+wav_bench_time_(wav_bench_fn fn, void * ctx, size_t iterations) {
+  uint64_t start = wav_bench_now_ns_();
+  fn(ctx, iterations);
+  return wav_bench_now_ns_() - start;
+}
+
+/* Time fn and print the result.  fn(ctx, iterations) must process
+ * items_per_iteration items on each of its iterations; size is just
+ * reported (use 1 for benchmarks which don't have one). */
+static inline void
+wav_bench_run(
+    const char * name, const char * impl, const char * mode, size_t size,
+    double items_per_iteration, wav_bench_fn fn, void * ctx) {
+  size_t iterations = 1;
+  uint64_t best;
+  int repeat;
+
+  if (wav_bench_config_.filter != NULL && strstr(name, wav_bench_config_.filter) == NULL)
+    return;
+
+  if (wav_bench_config_.quick) {
+    best = wav_bench_time_(fn, ctx, iterations);
+  } else {
+    /* Warm up and calibrate. */
+    while (wav_bench_time_(fn, ctx, iterations) < WAV_BENCH_MIN_NS && iterations < (SIZE_MAX / 2))
+      iterations *= 2;
+
+    best = UINT64_MAX;
+    for (repeat = 0 ; repeat < WAV_BENCH_REPEAT ; repeat++) {
+      uint64_t elapsed = wav_bench_time_(fn, ctx, iterations);
+      if (elapsed < best)
+        best = elapsed;
+    }
+  }
+
+  printf(
+    "{\"suite\":\"%s\",\"name\":\"%s\",\"impl\":\"%s\",\"mode\":\"%s\","
+    "\"size\":%zu,\"backend\":\"%s\",\"runtime\":\"%s\",\"ns\":%.4f}\n",
+    wav_bench_config_.suite, name, impl, mode, size,
+    WAV_BENCH_BACKEND, wav_bench_config_.runtime,
+    ((double) best) / (((double) iterations) * items_per_iteration));
+  fflush(stdout);
+}
+
+/* Deterministic pseudo-random numbers for filling inputs (xorshift64*,
+ * so every backend and runtime benchmarks the same data). */
+static inline uint64_t
+wav_bench_random(uint64_t * state) {
+  uint64_t x = *state;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  *state = x;
+  return x * UINT64_C(2685821657736338717);
+}
+
+static inline void
+wav_bench_fill_random(void * dest, size_t size, uint64_t seed) {
+  uint8_t * d = (uint8_t *) dest;
+  uint64_t state = seed | 1;
+  size_t i;
+
+  for (i = 0 ; i < size ; i++)
+    d[i] = (uint8_t) (wav_bench_random(&state) >> 56);
+}
+
+static inline void *
+wav_bench_alloc(size_t size) {
+  void * ptr = malloc(size == 0 ? 1 : size);
+  if (ptr == NULL) {
+    fprintf(stderr, "Unable to allocate %zu bytes\n", size);
+    exit(EXIT_FAILURE);
+  }
+  return ptr;
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+/* Latency and throughput benchmarks for a single operation.
+ *
+ * WAV_BENCH_DEFINE_OP(Type, name, expr) defines
+ * wav_bench_op_<name>_latency_ and wav_bench_op_<name>_throughput_.
+ * expr computes the next value of a wav_<Type>_t from the previous
+ * one, x, and a second operand, k; both start out as 16 bytes taken
+ * from the buffer passed as ctx (x from the start, k from offset 16).
+ * The buffer itself is available to expr as in, for loads.
+ *
+ * The latency loop feeds each result back into the next operation, so
+ * it measures the length of the dependency chain through expr.  The
+ * throughput loop runs WAV_BENCH_CHAINS independent chains, so it
+ * measures how many can be issued per unit of time. */
+#define WAV_BENCH_DEFINE_OP(Type, name, expr) \
+  static void \
+  wav_bench_op_##name##_latency_(void * ctx, size_t iterations) { \
+    const uint8_t * in = (const uint8_t *) ctx; \
+    WAV_BENCH_KEEP_SCALAR(in); \
+    wav_##Type##_t k = wav_##Type##_loadu(in + 16); \
+    wav_##Type##_t acc = wav_##Type##_loadu(in); \
+    size_t i; \
+    for (i = 0 ; i < iterations ; i++) { \
+      const wav_##Type##_t x = acc; \
+      acc = (expr); \
+      WAV_BENCH_KEEP(acc); \
+    } \
+    WAV_BENCH_KEEP(acc); \
+    (void) k; \
+  } \
+  \
+  static void \
+  wav_bench_op_##name##_throughput_(void * ctx, size_t iterations) { \
+    const uint8_t * in = (const uint8_t *) ctx; \
+    WAV_BENCH_KEEP_SCALAR(in); \
+    wav_##Type##_t k = wav_##Type##_loadu(in + 16); \
+    wav_##Type##_t acc[WAV_BENCH_CHAINS]; \
+    size_t i, j; \
+    _Pragma("clang loop unroll(full)") \
+    for (j = 0 ; j < WAV_BENCH_CHAINS ; j++) \
+      acc[j] = wav_##Type##_loadu(in); \
+    for (i = 0 ; i < iterations ; i++) { \
+      _Pragma("clang loop unroll(full)") \
+      for (j = 0 ; j < WAV_BENCH_CHAINS ; j++) { \
+        const wav_##Type##_t x = acc[j]; \
+        acc[j] = (expr); \
+        WAV_BENCH_KEEP(acc[j]); \
+      } \
+    } \
+    (void) k; \
+  }
+
+/* Run both benchmarks defined by WAV_BENCH_DEFINE_OP(Type, name, ...)
+ * on the input buffer ctx (at least 32 bytes). */
+#define WAV_BENCH_RUN_OP(name, ctx) \
+  WAV_BENCH_RUN_OP_AS(name, #name, "wav", ctx)
+
+/* Like WAV_BENCH_RUN_OP, but report the benchmarks defined for op
+ * under a different name and implementation; used to compare WAV
+ * functions with alternative implementations of the same thing. */
+#define WAV_BENCH_RUN_OP_AS(op, name, impl, ctx) \
+  do { \
+    wav_bench_run((name), (impl), "latency", 1, 1.0, wav_bench_op_##op##_latency_, (ctx)); \
+    wav_bench_run((name), (impl), "throughput", 1, (double) WAV_BENCH_CHAINS, wav_bench_op_##op##_throughput_, (ctx)); \
+  } while (0)
+
+#endif /* !defined(WAV_BENCH_H) */
@@ -0,0 +1,165 @@
+/* wav_*_bitmask compared with the per-lane loops WAV used to have
+ * for them ("loop").  The multiply-gather versions which replaced the
+ * loops are what the portable backend uses; with SSE2 WAV uses MOVMSKB
+ * and friends, and WebAssembly has bitmask instructions.
+ *
+ * The single-operation benchmarks work like the ones in ops.c: the
+ * mask is splatted and xored back into the vector so the latency loop
+ * has a dependency chain.  "find_byte" is closer to real use: compare
+ * each 16 bytes of a buffer with a byte, and count the matches using
+ * the bitmask.  Before timing, both implementations are checked
+ * against each other for every possible mask, and the find_byte
+ * counts against a scalar loop. */
+
+#include "bench.h"
+
+#define FIND_BYTE_SIZE 16384
+
+static unsigned int
+loop_i8x16_bitmask(wav_i8x16_t a) {
+  unsigned int r = 0;
+
+  for (int i = 0 ; i < 16 ; i++) {
+    r |= ((unsigned int) (a.values[i] < 0)) << i;
+  }
+
+  return r;
+}
+
+static unsigned int
+loop_i16x8_bitmask(wav_i16x8_t a) {
+  unsigned int r = 0;
+
+  for (int i = 0 ; i < 8 ; i++) {
+    r |= ((unsigned int) (a.values[i] < 0)) << i;
+  }
+
+  return r;
+}
+
+static unsigned int
+loop_i32x4_bitmask(wav_i32x4_t a) {
+  unsigned int r = 0;
+
+  for (int i = 0 ; i < 4 ; i++) {
+    r |= ((unsigned int) (a.values[i] < 0)) << i;
+  }
+
+  return r;
+}
+
+static unsigned int
+loop_i64x2_bitmask(wav_i64x2_t a) {
+  unsigned int r = 0;
+
+  for (int i = 0 ; i < 2 ; i++) {
+    r |= ((unsigned int) (a.values[i] < 0)) << i;
+  }
+
+  return r;
+}
+
+/* Every mask, with random values (of the right sign) in the lanes. */
+#define DEFINE_CHECK(Type, Element, Unsigned) \
+  static int \
+  check_##Type##_bitmask(void) { \
+    const unsigned int lanes = 16 / sizeof(Element); \
+    const Unsigned sign = (Unsigned) (((Unsigned) 1) << (8 * sizeof(Element) - 1)); \
+    uint64_t state = 1; \
+    for (unsigned int mask = 0 ; mask < (1U << lanes) ; mask++) { \
+      wav_##Type##_t v; \
+      for (unsigned int i = 0 ; i < lanes ; i++) { \
+        const Unsigned bits = (Unsigned) wav_bench_random(&state); \
+        v.values[i] = (Element) (((mask >> i) & 1) ? (bits | sign) : (bits & (Unsigned) ~sign)); \
+      } \
+      if (wav_##Type##_bitmask(v) != mask || loop_##Type##_bitmask(v) != mask) { \
+        fprintf(stderr, "%s_bitmask: wrong result for mask 0x%x\n", #Type, mask); \
+        return 0; \
+      } \
+    } \
+    return 1; \
+  }
+
+DEFINE_CHECK(i8x16, int8_t, uint8_t)
+DEFINE_CHECK(i16x8, int16_t, uint16_t)
+DEFINE_CHECK(i32x4, int32_t, uint32_t)
+DEFINE_CHECK(i64x2, int64_t, uint64_t)
+
+static uint8_t op_input[32];
+
+WAV_BENCH_DEFINE_OP(i8x16, i8x16_wav, wav_i8x16_xor(x, wav_i8x16_splat((int8_t) wav_i8x16_bitmask(x))))
+WAV_BENCH_DEFINE_OP(i8x16, i8x16_loop, wav_i8x16_xor(x, wav_i8x16_splat((int8_t) loop_i8x16_bitmask(x))))
+WAV_BENCH_DEFINE_OP(i16x8, i16x8_wav, wav_i16x8_xor(x, wav_i16x8_splat((int16_t) wav_i16x8_bitmask(x))))
+WAV_BENCH_DEFINE_OP(i16x8, i16x8_loop, wav_i16x8_xor(x, wav_i16x8_splat((int16_t) loop_i16x8_bitmask(x))))
+WAV_BENCH_DEFINE_OP(i32x4, i32x4_wav, wav_i32x4_xor(x, wav_i32x4_splat((int32_t) wav_i32x4_bitmask(x))))
+WAV_BENCH_DEFINE_OP(i32x4, i32x4_loop, wav_i32x4_xor(x, wav_i32x4_splat((int32_t) loop_i32x4_bitmask(x))))
+WAV_BENCH_DEFINE_OP(i64x2, i64x2_wav, wav_i64x2_xor(x, wav_i64x2_splat((int64_t) wav_i64x2_bitmask(x))))
+WAV_BENCH_DEFINE_OP(i64x2, i64x2_loop, wav_i64x2_xor(x, wav_i64x2_splat((int64_t) loop_i64x2_bitmask(x))))
+
+static uint8_t find_byte_input[FIND_BYTE_SIZE];
+
+#define DEFINE_FIND_BYTE(impl, bitmask) \
+  static size_t \
+  count_byte_##impl(const uint8_t * buf) { \
+    const wav_i8x16_t needle = wav_i8x16_splat(42); \
+    size_t matches = 0; \
+    for (size_t j = 0 ; j < FIND_BYTE_SIZE ; j += 16) { \
+      unsigned int m = bitmask(wav_as_i8x16(wav_i8x16_eq(wav_i8x16_loadu(&buf[j]), needle))); \
+      matches += (size_t) __builtin_popcount(m); \
+    } \
+    return matches; \
+  } \
+  \
+  static void \
+  find_byte_##impl(void * ctx, size_t iterations) { \
+    const uint8_t * buf = (const uint8_t *) ctx; \
+    size_t matches = 0; \
+    for (size_t i = 0 ; i < iterations ; i++) { \
+      WAV_BENCH_KEEP_SCALAR(buf); \
+      matches += count_byte_##impl(buf); \
+    } \
+    WAV_BENCH_KEEP_SCALAR(matches); \
+  }
+
+DEFINE_FIND_BYTE(wav, wav_i8x16_bitmask)
+DEFINE_FIND_BYTE(loop, loop_i8x16_bitmask)
+
+int
+main(int argc, char ** argv) {
+  wav_bench_init("bitmask", argc, argv);
+
+  if (!check_i8x16_bitmask() || !check_i16x8_bitmask() || !check_i32x4_bitmask() || !check_i64x2_bitmask())
+    return EXIT_FAILURE;
+
+  /* Mixed signs, so the masks aren't all zeros or all ones. */
+  wav_bench_fill_random(op_input, sizeof(op_input), 1);
+
+  WAV_BENCH_RUN_OP_AS(i8x16_wav, "i8x16_bitmask", "wav", op_input);
+  WAV_BENCH_RUN_OP_AS(i8x16_loop, "i8x16_bitmask", "loop", op_input);
+  WAV_BENCH_RUN_OP_AS(i16x8_wav, "i16x8_bitmask", "wav", op_input);
+  WAV_BENCH_RUN_OP_AS(i16x8_loop, "i16x8_bitmask", "loop", op_input);
+  WAV_BENCH_RUN_OP_AS(i32x4_wav, "i32x4_bitmask", "wav", op_input);
+  WAV_BENCH_RUN_OP_AS(i32x4_loop, "i32x4_bitmask", "loop", op_input);
+  WAV_BENCH_RUN_OP_AS(i64x2_wav, "i64x2_bitmask", "wav", op_input);
+  WAV_BENCH_RUN_OP_AS(i64x2_loop, "i64x2_bitmask", "loop", op_input);
+
+  /* About one byte in 64 matches. */
+  wav_bench_fill_random(find_byte_input, sizeof(find_byte_input), 2);
+  for (size_t i = 0 ; i < FIND_BYTE_SIZE ; i++) {
+    if (find_byte_input[i] < 4)
+      find_byte_input[i] = 42;
+  }
+
+  size_t expected_matches = 0;
+  for (size_t i = 0 ; i < FIND_BYTE_SIZE ; i++)
+    expected_matches += (find_byte_input[i] == 42);
+  if (count_byte_wav(find_byte_input) != expected_matches || count_byte_loop(find_byte_input) != expected_matches) {
+    fprintf(stderr, "find_byte: wrong count\n");
+    return EXIT_FAILURE;
+  }
+
+  wav_bench_run("find_byte", "wav", "throughput", FIND_BYTE_SIZE, FIND_BYTE_SIZE, find_byte_wav, find_byte_input);
+  wav_bench_run("find_byte", "loop", "throughput", FIND_BYTE_SIZE, FIND_BYTE_SIZE, find_byte_loop, find_byte_input);
+
+  return 0;
+}
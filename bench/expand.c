@@ -0,0 +1,119 @@
+/* wav_*_expand compared with a scalar loop, decoding a null-padded
+ * column: dense holds only the values which are present, valid has a
+ * nonzero element for each of them, and the output gets the values in
+ * place with zeros for the nulls.
+ *
+ *   wav     wav_*_expand with the mask from comparing valid to zero,
+ *           advancing through dense by the popcount of its bitmask
+ *   scalar  out[i] = valid[i] ? dense[k++] : 0
+ *
+ * The number at the end of each name is the percentage of elements
+ * present; at 50% the scalar loop's branch is unpredictable (unless
+ * the compiler turns it into a select).  The output of the wav version
+ * is checked against the scalar one before timing. */
+
+#include "bench.h"
+#include "wav_compress.h"
+
+typedef struct {
+  void * out;
+  const void * dense;
+  const void * valid;
+  size_t len;
+} expand_input;
+
+#define DEFINE_BENCH(impl, Type, Element) \
+  static void \
+  bench_##impl##_##Type(void * ctx, size_t iterations) { \
+    const expand_input * in = (const expand_input *) ctx; \
+    for (size_t it = 0 ; it < iterations ; it++) { \
+      Element * out = (Element *) in->out; \
+      WAV_BENCH_KEEP_SCALAR(out); \
+      expand_##impl##_##Type(out, (const Element *) in->dense, (const Element *) in->valid, in->len); \
+      WAV_BENCH_CLOBBER(out); \
+    } \
+  }
+
+/* dense is read a whole vector at a time, so it needs a vector of
+ * padding past the last present value. */
+#define DEFINE_EXPAND(Type, Element, Bool) \
+  static void \
+  expand_wav_##Type(Element * out, const Element * dense, const Element * valid, size_t len) { \
+    const size_t lanes = sizeof(wav_##Type##_t) / sizeof(Element); \
+    const wav_##Type##_t zero = wav_##Type##_splat(0); \
+    size_t k = 0; \
+    for (size_t i = 0 ; i < len ; i += lanes) { \
+      const wav_##Bool##_t mask = wav_##Type##_ne(wav_##Type##_loadu(&valid[i]), zero); \
+      wav_##Type##_storeu(&out[i], wav_##Type##_expand(wav_##Type##_loadu(&dense[k]), mask)); \
+      k += (size_t) __builtin_popcount(wav_##Bool##_bitmask(mask)); \
+    } \
+  } \
+  \
+  static void \
+  expand_scalar_##Type(Element * out, const Element * dense, const Element * valid, size_t len) { \
+    size_t k = 0; \
+    for (size_t i = 0 ; i < len ; i++) \
+      out[i] = (valid[i] != 0) ? dense[k++] : 0; \
+  } \
+  \
+  static void \
+  fill_valid_##Type(Element * valid, size_t len, unsigned int percent, uint64_t seed) { \
+    uint64_t state = seed | 1; \
+    for (size_t i = 0 ; i < len ; i++) \
+      valid[i] = (Element) ((wav_bench_random(&state) % 100) < percent); \
+  } \
+  \
+  DEFINE_BENCH(wav, Type, Element) \
+  DEFINE_BENCH(scalar, Type, Element)
+
+DEFINE_EXPAND(u8x16,  uint8_t,  b8x16)
+DEFINE_EXPAND(u16x8, uint16_t,  b16x8)
+DEFINE_EXPAND(u32x4, uint32_t,  b32x4)
+
+#define RUN(Type, Element, percent, in, expected) \
+  do { \
+    char name[32]; \
+    snprintf(name, sizeof(name), #Type "_expand_%u", (percent)); \
+    fill_valid_##Type((Element *) (in)->valid, (in)->len, (percent), (in)->len + (percent)); \
+    expand_scalar_##Type((Element *) (expected), (const Element *) (in)->dense, (const Element *) (in)->valid, (in)->len); \
+    expand_wav_##Type((Element *) (in)->out, (const Element *) (in)->dense, (const Element *) (in)->valid, (in)->len); \
+    if (memcmp((in)->out, (expected), (in)->len * sizeof(Element)) != 0) { \
+      fprintf(stderr, "%s: wrong result for %zu elements\n", name, (in)->len); \
+      return EXIT_FAILURE; \
+    } \
+    wav_bench_run(name, "wav", "throughput", (in)->len, (double) (in)->len, bench_wav_##Type, (in)); \
+    wav_bench_run(name, "scalar", "throughput", (in)->len, (double) (in)->len, bench_scalar_##Type, (in)); \
+  } while (0)
+
+int
+main(int argc, char ** argv) {
+  static const size_t sizes[] = { 4096, 1 << 20 };
+  static const unsigned int percents[] = { 50, 90 };
+
+  wav_bench_init("expand", argc, argv);
+
+  for (size_t s = 0 ; s < sizeof(sizes) / sizeof(sizes[0]) ; s++) {
+    const size_t len = sizes[s];
+    if (!wav_bench_size_enabled(len))
+      continue;
+
+    /* Room for len uint32_t, the largest element type, plus padding. */
+    const size_t bytes = (len + 4) * sizeof(uint32_t);
+    void * expected = wav_bench_alloc(bytes);
+    expand_input in = { wav_bench_alloc(bytes), wav_bench_alloc(bytes), wav_bench_alloc(bytes), len };
+    wav_bench_fill_random((void *) in.dense, bytes, 1);
+
+    for (size_t p = 0 ; p < sizeof(percents) / sizeof(percents[0]) ; p++) {
+      RUN(u8x16,  uint8_t, percents[p], &in, expected);
+      RUN(u16x8, uint16_t, percents[p], &in, expected);
+      RUN(u32x4, uint32_t, percents[p], &in, expected);
+    }
+
+    free(expected);
+    free(in.out);
+    free((void *) in.dense);
+    free((void *) in.valid);
+  }
+
+  return 0;
+}
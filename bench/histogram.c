@@ -0,0 +1,164 @@
+/* wav_histogram.h compared with the obvious scalar loop.
+ *
+ *   wav     wav_histogram_u8, or wav_histogram_u16 with the given
+ *           number of bins
+ *   scalar  hist[src[i]]++ (skipping values >= bins for u16)
+ *
+ * Each benchmark runs on uniform data, where consecutive elements
+ * rarely land in the same bin, and on skewed data, where 7 out of 8
+ * elements have the same value; that's where the scalar loop stalls
+ * on the dependency between one increment and the next.  The u16 bin
+ * counts cover each of wav_histogram_u16's strategies (compare and
+ * count, four sub-histograms, two sub-histograms, direct).  Results
+ * are checked against the scalar loop before timing. */
+
+#include "bench.h"
+#include "wav_histogram.h"
+
+typedef struct {
+  uint32_t * hist;
+  const void * src;
+  size_t len;
+  size_t bins;
+} histogram_input;
+
+static size_t
+histogram_u8_scalar(uint32_t * hist, const uint8_t * src, size_t len) {
+  memset(hist, 0, 256 * sizeof(uint32_t));
+  for (size_t i = 0 ; i < len ; i++)
+    hist[src[i]]++;
+  return 0;
+}
+
+static size_t
+histogram_u16_scalar(uint32_t * hist, size_t bins, const uint16_t * src, size_t len) {
+  size_t skipped = 0;
+
+  memset(hist, 0, bins * sizeof(uint32_t));
+  for (size_t i = 0 ; i < len ; i++) {
+    if (src[i] < bins)
+      hist[src[i]]++;
+    else
+      skipped++;
+  }
+
+  return skipped;
+}
+
+static size_t
+histogram_u8_wav(uint32_t * hist, const uint8_t * src, size_t len) {
+  wav_histogram_u8(hist, src, len);
+  return 0;
+}
+
+static size_t
+histogram_u16_wav(uint32_t * hist, size_t bins, const uint16_t * src, size_t len) {
+  return wav_histogram_u16(hist, bins, src, len);
+}
+
+#define DEFINE_BENCH(impl) \
+  static void \
+  bench_u8_##impl(void * ctx, size_t iterations) { \
+    const histogram_input * in = (const histogram_input *) ctx; \
+    for (size_t it = 0 ; it < iterations ; it++) { \
+      uint32_t * hist = in->hist; \
+      WAV_BENCH_KEEP_SCALAR(hist); \
+      histogram_u8_##impl(hist, (const uint8_t *) in->src, in->len); \
+      WAV_BENCH_CLOBBER(hist); \
+    } \
+  } \
+  \
+  static void \
+  bench_u16_##impl(void * ctx, size_t iterations) { \
+    const histogram_input * in = (const histogram_input *) ctx; \
+    for (size_t it = 0 ; it < iterations ; it++) { \
+      uint32_t * hist = in->hist; \
+      WAV_BENCH_KEEP_SCALAR(hist); \
+      size_t skipped = histogram_u16_##impl(hist, in->bins, (const uint16_t *) in->src, in->len); \
+      WAV_BENCH_KEEP_SCALAR(skipped); \
+      WAV_BENCH_CLOBBER(hist); \
+    } \
+  }
+
+DEFINE_BENCH(wav)
+DEFINE_BENCH(scalar)
+
+/* Skewed data has the value in the middle of the range in 7 out of 8
+ * elements.  All the u16 values are below bins. */
+static void
+fill_u8(uint8_t * dest, size_t len, int skewed, uint64_t seed) {
+  uint64_t state = seed | 1;
+  for (size_t i = 0 ; i < len ; i++) {
+    const uint64_t r = wav_bench_random(&state);
+    dest[i] = (skewed && (r & 7) != 0) ? 128 : (uint8_t) (r >> 56);
+  }
+}
+
+static void
+fill_u16(uint16_t * dest, size_t len, size_t bins, int skewed, uint64_t seed) {
+  uint64_t state = seed | 1;
+  for (size_t i = 0 ; i < len ; i++) {
+    const uint64_t r = wav_bench_random(&state);
+    dest[i] = (uint16_t) ((skewed && (r & 7) != 0) ? (bins / 2) : ((r >> 32) % bins));
+  }
+}
+
+int
+main(int argc, char ** argv) {
+  static const size_t sizes[] = { 4096, 1 << 20 };
+  static const size_t u16_bins[] = { 16, 256, 1024, 65536 };
+  static const char * const distributions[] = { "uniform", "skewed" };
+  char name[64];
+
+  wav_bench_init("histogram", argc, argv);
+
+  uint32_t * hist = (uint32_t *) wav_bench_alloc(65536 * sizeof(uint32_t));
+  uint32_t * expected = (uint32_t *) wav_bench_alloc(65536 * sizeof(uint32_t));
+
+  for (size_t s = 0 ; s < sizeof(sizes) / sizeof(sizes[0]) ; s++) {
+    const size_t len = sizes[s];
+    if (!wav_bench_size_enabled(len))
+      continue;
+
+    void * src = wav_bench_alloc(len * sizeof(uint16_t));
+
+    for (int skewed = 0 ; skewed < 2 ; skewed++) {
+      histogram_input in = { hist, src, len, 256 };
+
+      fill_u8((uint8_t *) src, len, skewed, len);
+      histogram_u8_scalar(expected, (const uint8_t *) src, len);
+      histogram_u8_wav(hist, (const uint8_t *) src, len);
+      if (memcmp(hist, expected, 256 * sizeof(uint32_t)) != 0) {
+        fprintf(stderr, "histogram_u8: wrong result for %zu elements\n", len);
+        return EXIT_FAILURE;
+      }
+
+      snprintf(name, sizeof(name), "histogram_u8_%s", distributions[skewed]);
+      wav_bench_run(name, "wav", "throughput", len, (double) len, bench_u8_wav, &in);
+      wav_bench_run(name, "scalar", "throughput", len, (double) len, bench_u8_scalar, &in);
+
+      for (size_t b = 0 ; b < sizeof(u16_bins) / sizeof(u16_bins[0]) ; b++) {
+        in.bins = u16_bins[b];
+
+        fill_u16((uint16_t *) src, len, in.bins, skewed, len + in.bins);
+        histogram_u16_scalar(expected, in.bins, (const uint16_t *) src, len);
+        if (histogram_u16_wav(hist, in.bins, (const uint16_t *) src, len) != 0 ||
+            memcmp(hist, expected, in.bins * sizeof(uint32_t)) != 0) {
+          fprintf(stderr, "histogram_u16: wrong result for %zu bins, %zu elements\n", in.bins, len);
+          return EXIT_FAILURE;
+        }
+
+        snprintf(name, sizeof(name), "histogram_u16_%zu_%s", in.bins, distributions[skewed]);
+        wav_bench_run(name, "wav", "throughput", len, (double) len, bench_u16_wav, &in);
+        wav_bench_run(name, "scalar", "throughput", len, (double) len, bench_u16_scalar, &in);
+      }
+    }
+
+    free(src);
+  }
+
+  free(hist);
+  free(expected);
+
+  return 0;
+}
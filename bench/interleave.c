@@ -0,0 +1,145 @@
+/* wav_interleave.h compared with plain loops, converting whole frames
+ * between interleaved and planar layouts.
+ *
+ *   wav      wav_*_load2/3/4 to split interleaved data into planes
+ *            ("load" benchmarks), wav_*_store2/3/4 to join them
+ *            ("store" benchmarks)
+ *   scalar   a loop over pixels and channels, with vectorization and
+ *            interleaving disabled
+ *   autovec  the same loop left to clang's vectorizer, which knows how
+ *            to handle interleaved accesses on some targets
+ *
+ * The frames are 64x64 (the only size the --quick runs use) and 4K UHD
+ * (3840x2160), and "ns" is per pixel.  The cases are 8-bit RGB and
+ * RGBA, 16-bit stereo samples, and 32-bit xyz points, so each channel
+ * count and lane width is covered.  The wav loads and stores are
+ * checked against the scalar loop before timing. */
+
+#include "bench.h"
+#include "wav_interleave.h"
+
+typedef struct {
+  void * interleaved;
+  void * planar;
+  size_t pixels;
+} interleave_input;
+
+#define DEFINE_IMPL_(name, Element, ...) \
+  static void \
+  name(void * ctx, size_t iterations) { \
+    const interleave_input * in = (const interleave_input *) ctx; \
+    for (size_t it = 0 ; it < iterations ; it++) { \
+      Element * interleaved = (Element *) in->interleaved; \
+      Element * planar = (Element *) in->planar; \
+      const size_t pixels = in->pixels; \
+      WAV_BENCH_KEEP_SCALAR(interleaved); \
+      WAV_BENCH_KEEP_SCALAR(planar); \
+      __VA_ARGS__ \
+      WAV_BENCH_CLOBBER(interleaved); \
+      WAV_BENCH_CLOBBER(planar); \
+    } \
+  }
+
+/* Plane c of planar starts at c * pixels. */
+#define DEFINE_INTERLEAVE(Type, Element, Channels) \
+  DEFINE_IMPL_(load_wav_##Type##_##Channels, Element, \
+    for (size_t i = 0 ; i < pixels ; i += sizeof(wav_##Type##_t) / sizeof(Element)) { \
+      const wav_##Type##x##Channels##_t v = wav_##Type##_load##Channels(&(interleaved[i * (Channels)])); \
+      for (size_t c = 0 ; c < (Channels) ; c++) \
+        wav_##Type##_storeu(&(planar[(c * pixels) + i]), v.values[c]); \
+    }) \
+  DEFINE_IMPL_(load_scalar_##Type##_##Channels, Element, \
+    _Pragma("clang loop vectorize(disable) interleave(disable)") \
+    for (size_t i = 0 ; i < pixels ; i++) { \
+      for (size_t c = 0 ; c < (Channels) ; c++) \
+        planar[(c * pixels) + i] = interleaved[(i * (Channels)) + c]; \
+    }) \
+  DEFINE_IMPL_(load_autovec_##Type##_##Channels, Element, \
+    _Pragma("clang loop vectorize(enable)") \
+    for (size_t i = 0 ; i < pixels ; i++) { \
+      for (size_t c = 0 ; c < (Channels) ; c++) \
+        planar[(c * pixels) + i] = interleaved[(i * (Channels)) + c]; \
+    }) \
+  DEFINE_IMPL_(store_wav_##Type##_##Channels, Element, \
+    for (size_t i = 0 ; i < pixels ; i += sizeof(wav_##Type##_t) / sizeof(Element)) { \
+      wav_##Type##x##Channels##_t v; \
+      for (size_t c = 0 ; c < (Channels) ; c++) \
+        v.values[c] = wav_##Type##_loadu(&(planar[(c * pixels) + i])); \
+      wav_##Type##_store##Channels(&(interleaved[i * (Channels)]), v); \
+    }) \
+  DEFINE_IMPL_(store_scalar_##Type##_##Channels, Element, \
+    _Pragma("clang loop vectorize(disable) interleave(disable)") \
+    for (size_t i = 0 ; i < pixels ; i++) { \
+      for (size_t c = 0 ; c < (Channels) ; c++) \
+        interleaved[(i * (Channels)) + c] = planar[(c * pixels) + i]; \
+    }) \
+  DEFINE_IMPL_(store_autovec_##Type##_##Channels, Element, \
+    _Pragma("clang loop vectorize(enable)") \
+    for (size_t i = 0 ; i < pixels ; i++) { \
+      for (size_t c = 0 ; c < (Channels) ; c++) \
+        interleaved[(i * (Channels)) + c] = planar[(c * pixels) + i]; \
+    })
+
+DEFINE_INTERLEAVE(u8x16,  uint8_t, 3)
+DEFINE_INTERLEAVE(u8x16,  uint8_t, 4)
+DEFINE_INTERLEAVE(i16x8,  int16_t, 2)
+DEFINE_INTERLEAVE(f32x4,    float, 3)
+
+/* Check the wav load and store against the scalar loops, then time
+ * all of them.  expected needs room for the planar data. */
+#define RUN(Type, Element, Channels, in, expected) \
+  do { \
+    const size_t bytes_ = (in)->pixels * (Channels) * sizeof(Element); \
+    wav_bench_fill_random((in)->interleaved, bytes_, (in)->pixels + (Channels)); \
+    load_scalar_##Type##_##Channels((in), 1); \
+    memcpy((expected), (in)->planar, bytes_); \
+    memset((in)->planar, 0, bytes_); \
+    load_wav_##Type##_##Channels((in), 1); \
+    if (memcmp((expected), (in)->planar, bytes_) != 0) { \
+      fprintf(stderr, #Type "_load" #Channels ": wrong result for %zu pixels\n", (in)->pixels); \
+      return EXIT_FAILURE; \
+    } \
+    memset((in)->interleaved, 0, bytes_); \
+    store_wav_##Type##_##Channels((in), 1); \
+    memset((in)->planar, 0, bytes_); \
+    load_scalar_##Type##_##Channels((in), 1); \
+    if (memcmp((expected), (in)->planar, bytes_) != 0) { \
+      fprintf(stderr, #Type "_store" #Channels ": wrong result for %zu pixels\n", (in)->pixels); \
+      return EXIT_FAILURE; \
+    } \
+    wav_bench_run(#Type "_load" #Channels, "wav", "throughput", (in)->pixels, (double) (in)->pixels, load_wav_##Type##_##Channels, (in)); \
+    wav_bench_run(#Type "_load" #Channels, "scalar", "throughput", (in)->pixels, (double) (in)->pixels, load_scalar_##Type##_##Channels, (in)); \
+    wav_bench_run(#Type "_load" #Channels, "autovec", "throughput", (in)->pixels, (double) (in)->pixels, load_autovec_##Type##_##Channels, (in)); \
+    wav_bench_run(#Type "_store" #Channels, "wav", "throughput", (in)->pixels, (double) (in)->pixels, store_wav_##Type##_##Channels, (in)); \
+    wav_bench_run(#Type "_store" #Channels, "scalar", "throughput", (in)->pixels, (double) (in)->pixels, store_scalar_##Type##_##Channels, (in)); \
+    wav_bench_run(#Type "_store" #Channels, "autovec", "throughput", (in)->pixels, (double) (in)->pixels, store_autovec_##Type##_##Channels, (in)); \
+  } while (0)
+
+int
+main(int argc, char ** argv) {
+  static const size_t frames[] = { 64 * 64, 3840 * 2160 };
+
+  wav_bench_init("interleave", argc, argv);
+
+  for (size_t f = 0 ; f < sizeof(frames) / sizeof(frames[0]) ; f++) {
+    const size_t pixels = frames[f];
+    if (!wav_bench_size_enabled(pixels))
+      continue;
+
+    /* Room for the largest case, three floats per pixel. */
+    const size_t bytes = pixels * 3 * sizeof(float);
+    void * expected = wav_bench_alloc(bytes);
+    interleave_input in = { wav_bench_alloc(bytes), wav_bench_alloc(bytes), pixels };
+
+    RUN(u8x16,  uint8_t, 3, &in, expected);
+    RUN(u8x16,  uint8_t, 4, &in, expected);
+    RUN(i16x8,  int16_t, 2, &in, expected);
+    RUN(f32x4,    float, 3, &in, expected);
+
+    free(expected);
+    free(in.interleaved);
+    free(in.planar);
+  }
+
+  return 0;
+}
@@ -0,0 +1,219 @@
+/* Latency and throughput of individual WAV operations.
+ *
+ * There is at least one benchmark for each family of operations:
+ * loads and stores, splat/extract/replace, shuffle, swizzle,
+ * arithmetic, comparisons, conversions, narrowing and extending,
+ * bitmask, and any_true/all_true.  Operations which don't return a
+ * vector of the type they take are measured together with whatever
+ * it takes to get back (a reinterpretation, which is free, a
+ * conversion in the opposite direction, or a splat of the scalar
+ * result), and are named accordingly. */
+
+#include "bench.h"
+
+/* 16 bytes of x (0, 1, ... 15, so the first lane of every integer type
+ * is zero) followed by 16 bytes of k (a permutation of 0 ... 15, so
+ * swizzling with it stays in range). */
+static uint8_t int_input[32];
+
+/* Float inputs are chosen so the chains never produce subnormals or
+ * NaNs, which would slow some backends down for the wrong reason. */
+static float f32_input[8] = { 1.0f, 1.25f, 1.5f, 1.75f, 1.0f, 1.0f, 1.0f, 1.0f };
+static double f64_input[4] = { 1.0, 1.5, 1.0, 1.0 };
+
+static uint8_t store_scratch[WAV_BENCH_CHAINS * 16];
+
+/* Loads.  The address of each load depends on the result of the
+ * previous one (it is always the start of the buffer, but the compiler
+ * can't know that), so latency is load-to-use latency. */
+WAV_BENCH_DEFINE_OP(u8x16, u8x16_loadu, wav_u8x16_loadu(in + (wav_u8x16_extract_lane(x, 0) & 15)))
+WAV_BENCH_DEFINE_OP(u32x4, u32x4_load_splat, wav_u32x4_load_splat((const uint32_t *) (in + (wav_u32x4_extract_lane(x, 0) & 12))))
+WAV_BENCH_DEFINE_OP(u32x4, u32x4_load_zero, wav_u32x4_load_zero((const uint32_t *) (in + (wav_u32x4_extract_lane(x, 0) & 12))))
+WAV_BENCH_DEFINE_OP(u32x4, u32x4_load_lane, wav_u32x4_load_lane(x, 1, (const uint32_t *) (in + (wav_u32x4_extract_lane(x, 0) & 12))))
+
+/* Stores.  Latency is a store followed by a load from the same
+ * address, i.e., store-to-load forwarding. */
+static void
+bench_u8x16_storeu_latency_(void * ctx, size_t iterations) {
+  uint8_t * scratch = store_scratch;
+  wav_u8x16_t v = wav_u8x16_loadu(ctx);
+  size_t i;
+
+  for (i = 0 ; i < iterations ; i++) {
+    wav_u8x16_storeu(scratch, v);
+    WAV_BENCH_CLOBBER(scratch);
+    v = wav_u8x16_loadu(scratch);
+    WAV_BENCH_KEEP(v);
+  }
+}
+
+static void
+bench_u8x16_storeu_throughput_(void * ctx, size_t iterations) {
+  uint8_t * scratch = store_scratch;
+  wav_u8x16_t v = wav_u8x16_loadu(ctx);
+  size_t i, j;
+
+  for (i = 0 ; i < iterations ; i++) {
+    WAV_BENCH_KEEP(v);
+    _Pragma("clang loop unroll(full)")
+    for (j = 0 ; j < WAV_BENCH_CHAINS ; j++)
+      wav_u8x16_storeu(scratch + (j * 16), v);
+    WAV_BENCH_CLOBBER(scratch);
+  }
+}
+
+/* Splat, extract and replace */
+WAV_BENCH_DEFINE_OP(u8x16, u8x16_splat_extract_lane, wav_u8x16_splat(wav_u8x16_extract_lane(x, 0)))
+WAV_BENCH_DEFINE_OP(f32x4, f32x4_splat_extract_lane, wav_f32x4_splat(wav_f32x4_extract_lane(x, 1)))
+WAV_BENCH_DEFINE_OP(i64x2, i64x2_splat_extract_lane, wav_i64x2_splat(wav_i64x2_extract_lane(x, 1)))
+WAV_BENCH_DEFINE_OP(f32x4, f32x4_replace_lane, wav_f32x4_replace_lane(x, 1, wav_f32x4_extract_lane(k, 0)))
+WAV_BENCH_DEFINE_OP(u16x8, u16x8_replace_lane, wav_u16x8_replace_lane(x, 3, wav_u16x8_extract_lane(k, 0)))
+
+/* Shuffle */
+WAV_BENCH_DEFINE_OP(u8x16, u8x16_shuffle_interleave, wav_u8x16_shuffle(x, k, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23))
+WAV_BENCH_DEFINE_OP(u8x16, u8x16_shuffle_reverse, wav_u8x16_shuffle(x, x, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0))
+WAV_BENCH_DEFINE_OP(u8x16, u8x16_shuffle_irregular, wav_u8x16_shuffle(x, k, 3, 29, 7, 0, 18, 5, 31, 9, 12, 2, 27, 14, 1, 20, 8, 11))
+WAV_BENCH_DEFINE_OP(i32x4, i32x4_shuffle, wav_i32x4_shuffle(x, k, 1, 4, 3, 6))
+
+/* Swizzle (x is the indices, k the table) */
+WAV_BENCH_DEFINE_OP(u8x16, u8x16_swizzle, wav_u8x16_swizzle(k, x))
+
+/* Integer arithmetic */
+WAV_BENCH_DEFINE_OP(i8x16, i8x16_add, wav_i8x16_add(x, k))
+WAV_BENCH_DEFINE_OP(u8x16, u8x16_add_sat, wav_u8x16_add_sat(x, k))
+WAV_BENCH_DEFINE_OP(u8x16, u8x16_min, wav_u8x16_min(x, k))
+WAV_BENCH_DEFINE_OP(i8x16, i8x16_abs, wav_i8x16_abs(x))
+WAV_BENCH_DEFINE_OP(i8x16, i8x16_popcnt, wav_i8x16_popcnt(x))
+WAV_BENCH_DEFINE_OP(i16x8, i16x8_mul, wav_i16x8_mul(x, k))
+WAV_BENCH_DEFINE_OP(u16x8, u16x8_avgr, wav_u16x8_avgr(x, k))
+WAV_BENCH_DEFINE_OP(i16x8, i16x8_q15mulr_sat, wav_i16x8_q15mulr_sat(x, k))
+WAV_BENCH_DEFINE_OP(i16x8, i16x8_dot, wav_as_i16x8(wav_i16x8_dot(x, k)))
+WAV_BENCH_DEFINE_OP(i32x4, i32x4_mul, wav_i32x4_mul(x, k))
+WAV_BENCH_DEFINE_OP(i32x4, i32x4_shl, wav_i32x4_shl(x, 1))
+WAV_BENCH_DEFINE_OP(i64x2, i64x2_mul, wav_i64x2_mul(x, k))
+WAV_BENCH_DEFINE_OP(i8x16, i8x16_eq, wav_as_i8x16(wav_i8x16_eq(x, k)))
+WAV_BENCH_DEFINE_OP(i64x2, i64x2_gt, wav_as_i64x2(wav_i64x2_gt(x, k)))
+
+/* Floating-point arithmetic */
+WAV_BENCH_DEFINE_OP(f32x4, f32x4_add, wav_f32x4_add(x, k))
+WAV_BENCH_DEFINE_OP(f32x4, f32x4_mul, wav_f32x4_mul(x, k))
+WAV_BENCH_DEFINE_OP(f32x4, f32x4_div, wav_f32x4_div(x, k))
+WAV_BENCH_DEFINE_OP(f32x4, f32x4_sqrt, wav_f32x4_sqrt(x))
+WAV_BENCH_DEFINE_OP(f32x4, f32x4_min, wav_f32x4_min(x, k))
+WAV_BENCH_DEFINE_OP(f32x4, f32x4_pmin, wav_f32x4_pmin(x, k))
+WAV_BENCH_DEFINE_OP(f32x4, f32x4_ceil, wav_f32x4_ceil(x))
+WAV_BENCH_DEFINE_OP(f32x4, f32x4_nearest, wav_f32x4_nearest(x))
+WAV_BENCH_DEFINE_OP(f64x2, f64x2_add, wav_f64x2_add(x, k))
+WAV_BENCH_DEFINE_OP(f64x2, f64x2_mul, wav_f64x2_mul(x, k))
+
+/* Conversions (round trips) */
+WAV_BENCH_DEFINE_OP(f32x4, f32x4_trunc_sat_i32x4_convert, wav_i32x4_convert_f32x4(wav_f32x4_trunc_sat_i32x4(x)))
+WAV_BENCH_DEFINE_OP(f32x4, f32x4_trunc_sat_u32x4_convert, wav_u32x4_convert_f32x4(wav_f32x4_trunc_sat_u32x4(x)))
+WAV_BENCH_DEFINE_OP(f64x2, f64x2_trunc_sat_zero_i32x4_convert_low, wav_i32x4_convert_low_f64x2(wav_f64x2_trunc_sat_zero_i32x4(x)))
+WAV_BENCH_DEFINE_OP(f64x2, f64x2_demote_promote_low, wav_f32x4_promote_low(wav_f64x2_demote(x)))
+
+/* Narrowing and extending */
+WAV_BENCH_DEFINE_OP(i16x8, i16x8_narrow, wav_as_i16x8(wav_i16x8_narrow(x, k)))
+WAV_BENCH_DEFINE_OP(i16x8, i16x8_narrow_u, wav_as_i16x8(wav_i16x8_narrow_u(x, k)))
+WAV_BENCH_DEFINE_OP(i32x4, i32x4_narrow, wav_as_i32x4(wav_i32x4_narrow(x, k)))
+WAV_BENCH_DEFINE_OP(i32x4, i32x4_narrow_u, wav_as_i32x4(wav_i32x4_narrow_u(x, k)))
+WAV_BENCH_DEFINE_OP(i8x16, i8x16_extend_low, wav_as_i8x16(wav_i8x16_extend_low(x)))
+WAV_BENCH_DEFINE_OP(u8x16, u8x16_extend_low, wav_as_u8x16(wav_u8x16_extend_low(x)))
+WAV_BENCH_DEFINE_OP(i16x8, i16x8_extend_high, wav_as_i16x8(wav_i16x8_extend_high(x)))
+WAV_BENCH_DEFINE_OP(u32x4, u32x4_extend_low, wav_as_u32x4(wav_u32x4_extend_low(x)))
+
+/* Bitmask */
+WAV_BENCH_DEFINE_OP(i8x16, i8x16_bitmask, wav_i8x16_xor(x, wav_i8x16_splat((int8_t) wav_i8x16_bitmask(x))))
+WAV_BENCH_DEFINE_OP(i16x8, i16x8_bitmask, wav_i16x8_xor(x, wav_i16x8_splat((int16_t) wav_i16x8_bitmask(x))))
+WAV_BENCH_DEFINE_OP(i32x4, i32x4_bitmask, wav_i32x4_xor(x, wav_i32x4_splat((int32_t) wav_i32x4_bitmask(x))))
+WAV_BENCH_DEFINE_OP(i64x2, i64x2_bitmask, wav_i64x2_xor(x, wav_i64x2_splat((int64_t) wav_i64x2_bitmask(x))))
+
+/* any_true and all_true */
+WAV_BENCH_DEFINE_OP(u8x16, u8x16_any_true, wav_u8x16_add(x, wav_u8x16_splat((uint8_t) wav_u8x16_any_true(x))))
+WAV_BENCH_DEFINE_OP(u8x16, u8x16_all_true, wav_u8x16_add(x, wav_u8x16_splat((uint8_t) wav_u8x16_all_true(x))))
+WAV_BENCH_DEFINE_OP(u32x4, u32x4_all_true, wav_u32x4_add(x, wav_u32x4_splat((uint32_t) wav_u32x4_all_true(x))))
+WAV_BENCH_DEFINE_OP(i64x2, i64x2_all_true, wav_i64x2_add(x, wav_i64x2_splat((int64_t) wav_i64x2_all_true(x))))
+
+int
+main(int argc, char ** argv) {
+  size_t i;
+
+  wav_bench_init("ops", argc, argv);
+
+  for (i = 0 ; i < 16 ; i++) {
+    int_input[i] = (uint8_t) i;
+    int_input[16 + i] = (uint8_t) ((i * 7 + 3) & 15);
+  }
+
+  WAV_BENCH_RUN_OP(u8x16_loadu, int_input);
+  WAV_BENCH_RUN_OP(u32x4_load_splat, int_input);
+  WAV_BENCH_RUN_OP(u32x4_load_zero, int_input);
+  WAV_BENCH_RUN_OP(u32x4_load_lane, int_input);
+  wav_bench_run("u8x16_storeu", "wav", "latency", 1, 1.0, bench_u8x16_storeu_latency_, int_input);
+  wav_bench_run("u8x16_storeu", "wav", "throughput", 1, (double) WAV_BENCH_CHAINS, bench_u8x16_storeu_throughput_, int_input);
+
+  WAV_BENCH_RUN_OP(u8x16_splat_extract_lane, int_input);
+  WAV_BENCH_RUN_OP(f32x4_splat_extract_lane, f32_input);
+  WAV_BENCH_RUN_OP(i64x2_splat_extract_lane, int_input);
+  WAV_BENCH_RUN_OP(f32x4_replace_lane, f32_input);
+  WAV_BENCH_RUN_OP(u16x8_replace_lane, int_input);
+
+  WAV_BENCH_RUN_OP(u8x16_shuffle_interleave, int_input);
+  WAV_BENCH_RUN_OP(u8x16_shuffle_reverse, int_input);
+  WAV_BENCH_RUN_OP(u8x16_shuffle_irregular, int_input);
+  WAV_BENCH_RUN_OP(i32x4_shuffle, int_input);
+
+  WAV_BENCH_RUN_OP(u8x16_swizzle, int_input);
+
+  WAV_BENCH_RUN_OP(i8x16_add, int_input);
+  WAV_BENCH_RUN_OP(u8x16_add_sat, int_input);
+  WAV_BENCH_RUN_OP(u8x16_min, int_input);
+  WAV_BENCH_RUN_OP(i8x16_abs, int_input);
+  WAV_BENCH_RUN_OP(i8x16_popcnt, int_input);
+  WAV_BENCH_RUN_OP(i16x8_mul, int_input);
+  WAV_BENCH_RUN_OP(u16x8_avgr, int_input);
+  WAV_BENCH_RUN_OP(i16x8_q15mulr_sat, int_input);
+  WAV_BENCH_RUN_OP(i16x8_dot, int_input);
+  WAV_BENCH_RUN_OP(i32x4_mul, int_input);
+  WAV_BENCH_RUN_OP(i32x4_shl, int_input);
+  WAV_BENCH_RUN_OP(i64x2_mul, int_input);
+  WAV_BENCH_RUN_OP(i8x16_eq, int_input);
+  WAV_BENCH_RUN_OP(i64x2_gt, int_input);
+
+  WAV_BENCH_RUN_OP(f32x4_add, f32_input);
+  WAV_BENCH_RUN_OP(f32x4_mul, f32_input);
+  WAV_BENCH_RUN_OP(f32x4_div, f32_input);
+  WAV_BENCH_RUN_OP(f32x4_sqrt, f32_input);
+  WAV_BENCH_RUN_OP(f32x4_min, f32_input);
+  WAV_BENCH_RUN_OP(f32x4_pmin, f32_input);
+  WAV_BENCH_RUN_OP(f32x4_ceil, f32_input);
+  WAV_BENCH_RUN_OP(f32x4_nearest, f32_input);
+  WAV_BENCH_RUN_OP(f64x2_add, f64_input);
+  WAV_BENCH_RUN_OP(f64x2_mul, f64_input);
+
+  WAV_BENCH_RUN_OP(f32x4_trunc_sat_i32x4_convert, f32_input);
+  WAV_BENCH_RUN_OP(f32x4_trunc_sat_u32x4_convert, f32_input);
+  WAV_BENCH_RUN_OP(f64x2_trunc_sat_zero_i32x4_convert_low, f64_input);
+  WAV_BENCH_RUN_OP(f64x2_demote_promote_low, f64_input);
+
+  WAV_BENCH_RUN_OP(i16x8_narrow, int_input);
+  WAV_BENCH_RUN_OP(i16x8_narrow_u, int_input);
+  WAV_BENCH_RUN_OP(i32x4_narrow, int_input);
+  WAV_BENCH_RUN_OP(i32x4_narrow_u, int_input);
+  WAV_BENCH_RUN_OP(i8x16_extend_low, int_input);
+  WAV_BENCH_RUN_OP(u8x16_extend_low, int_input);
+  WAV_BENCH_RUN_OP(i16x8_extend_high, int_input);
+  WAV_BENCH_RUN_OP(u32x4_extend_low, int_input);
+
+  WAV_BENCH_RUN_OP(i8x16_bitmask, int_input);
+  WAV_BENCH_RUN_OP(i16x8_bitmask, int_input);
+  WAV_BENCH_RUN_OP(i32x4_bitmask, int_input);
+  WAV_BENCH_RUN_OP(i64x2_bitmask, int_input);
+
+  WAV_BENCH_RUN_OP(u8x16_any_true, int_input);
+  WAV_BENCH_RUN_OP(u8x16_all_true, int_input);
+  WAV_BENCH_RUN_OP(u32x4_all_true, int_input);
+  WAV_BENCH_RUN_OP(i64x2_all_true, int_input);
+
+  return 0;
+}
@@ -0,0 +1,137 @@
+/* Counting the bits set in a buffer with wav_u8x16_popcnt.
+ *
+ *   wav     wav_u8x16_popcnt (a nibble lookup with SSSE3, a parallel
+ *           bit count otherwise, the native instruction on wasm)
+ *   loop    the per-lane __builtin_popcount loop WAV used to emulate
+ *           it with, in the same surrounding code
+ *   scalar  __builtin_popcountll on 64-bit words, i.e., no SIMD
+ *
+ * The sizes go from a buffer which fits in L1 to several megabytes,
+ * where memory bandwidth starts to matter.  Before timing,
+ * wav_u8x16_popcnt is checked against the per-lane loop for every byte
+ * value and every vector of the buffer, and every implementation's
+ * count against the scalar one. */
+
+#include "bench.h"
+
+typedef struct {
+  const uint8_t * buf;
+  size_t len;
+} popcnt_input;
+
+static wav_u8x16_t
+loop_u8x16_popcnt(wav_u8x16_t a) {
+  wav_u8x16_t r;
+
+  for (int i = 0 ; i < 16 ; i++) {
+    r.values[i] = (uint8_t) __builtin_popcount(a.values[i]);
+  }
+
+  return r;
+}
+
+/* wav_u8x16_popcnt and loop_u8x16_popcnt must agree on each vector
+ * of buf; len must be a multiple of 16. */
+static int
+check_lanes(const uint8_t * buf, size_t len) {
+  for (size_t i = 0 ; i < len ; i += 16) {
+    const wav_u8x16_t v = wav_u8x16_loadu(&buf[i]);
+    if (!wav_b8x16_all_true(wav_u8x16_eq(wav_u8x16_popcnt(v), loop_u8x16_popcnt(v)))) {
+      fprintf(stderr, "u8x16_popcnt: wrong result at offset %zu\n", i);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/* Per-byte counts are accumulated in 8-bit lanes for up to 31 vectors
+ * (31 * 8 < 256) before being widened and added to the total.  len
+ * must be a multiple of 16. */
+#define DEFINE_COUNT(impl, popcnt) \
+  static size_t \
+  count_##impl(const uint8_t * buf, size_t len) { \
+    size_t total = 0; \
+    size_t i = 0; \
+    while (i < len) { \
+      const size_t end = (len - i > 31 * 16) ? (i + 31 * 16) : len; \
+      wav_u8x16_t acc = wav_u8x16_splat(0); \
+      for ( ; i < end ; i += 16) \
+        acc = wav_u8x16_add(acc, popcnt(wav_u8x16_loadu(&buf[i]))); \
+      const wav_u32x4_t sums = wav_u16x8_extadd_pairwise(wav_u8x16_extadd_pairwise(acc)); \
+      total += \
+        (size_t) wav_u32x4_extract_lane(sums, 0) + (size_t) wav_u32x4_extract_lane(sums, 1) + \
+        (size_t) wav_u32x4_extract_lane(sums, 2) + (size_t) wav_u32x4_extract_lane(sums, 3); \
+    } \
+    return total; \
+  }
+
+DEFINE_COUNT(wav, wav_u8x16_popcnt)
+DEFINE_COUNT(loop, loop_u8x16_popcnt)
+
+static size_t
+count_scalar(const uint8_t * buf, size_t len) {
+  size_t total = 0;
+
+  for (size_t i = 0 ; i < len ; i += sizeof(uint64_t)) {
+    uint64_t w;
+    memcpy(&w, &buf[i], sizeof(w));
+    total += (size_t) __builtin_popcountll(w);
+  }
+
+  return total;
+}
+
+#define DEFINE_BENCH(impl) \
+  static void \
+  bench_##impl(void * ctx, size_t iterations) { \
+    const popcnt_input * in = (const popcnt_input *) ctx; \
+    for (size_t i = 0 ; i < iterations ; i++) { \
+      const uint8_t * buf = in->buf; \
+      WAV_BENCH_KEEP_SCALAR(buf); \
+      size_t total = count_##impl(buf, in->len); \
+      WAV_BENCH_KEEP_SCALAR(total); \
+    } \
+  }
+
+DEFINE_BENCH(wav)
+DEFINE_BENCH(loop)
+DEFINE_BENCH(scalar)
+
+int
+main(int argc, char ** argv) {
+  static const size_t sizes[] = { 4096, 32768, 4 << 20, 64 << 20 };
+
+  wav_bench_init("popcnt", argc, argv);
+
+  uint8_t all_bytes[256];
+  for (size_t i = 0 ; i < sizeof(all_bytes) ; i++)
+    all_bytes[i] = (uint8_t) i;
+  if (!check_lanes(all_bytes, sizeof(all_bytes)))
+    return EXIT_FAILURE;
+
+  for (size_t s = 0 ; s < sizeof(sizes) / sizeof(sizes[0]) ; s++) {
+    const size_t len = sizes[s];
+    if (!wav_bench_size_enabled(len))
+      continue;
+
+    uint8_t * buf = (uint8_t *) wav_bench_alloc(len);
+    wav_bench_fill_random(buf, len, len);
+
+    const size_t expected = count_scalar(buf, len);
+    if (!check_lanes(buf, len))
+      return EXIT_FAILURE;
+    if (count_wav(buf, len) != expected || count_loop(buf, len) != expected) {
+      fprintf(stderr, "popcnt: wrong count for %zu bytes\n", len);
+      return EXIT_FAILURE;
+    }
+
+    popcnt_input in = { buf, len };
+    wav_bench_run("u8x16_popcnt", "wav", "throughput", len, (double) len, bench_wav, &in);
+    wav_bench_run("u8x16_popcnt", "loop", "throughput", len, (double) len, bench_loop, &in);
+    wav_bench_run("u8x16_popcnt", "scalar", "throughput", len, (double) len, bench_scalar, &in);
+
+    free(buf);
+  }
+
+  return 0;
+}
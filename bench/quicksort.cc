@@ -0,0 +1,136 @@
+/* wav_*_array_sort compared with std::sort on whole arrays.
+ *
+ *   wav  wav_*_array_sort
+ *   std  std::sort
+ *
+ * Both copy the (unsorted) input to the output first, and "ns" is per
+ * element.  The inputs are
+ *
+ *   random      uniformly distributed values
+ *   sorted      already in order, which is where a poor choice of
+ *               pivot goes quadratic
+ *   few_unique  16 distinct values, so most partitions are full of
+ *               elements equal to the pivot
+ *   equal       a single value, so every element equals the pivot
+ *
+ * The float inputs are integers smaller than 2^24 in magnitude, so
+ * there are no NaNs or negative zeros.  Every result is checked
+ * against std::sort first. */
+
+#include "bench.h"
+#include "wav_sort.h"
+
+#include <algorithm>
+
+struct quicksort_input {
+  void * dest;
+  const void * src;
+  size_t len;
+};
+
+enum quicksort_distribution {
+  QUICKSORT_RANDOM,
+  QUICKSORT_SORTED,
+  QUICKSORT_FEW_UNIQUE,
+  QUICKSORT_EQUAL
+};
+
+static const char * const quicksort_distribution_names[] = { "random", "sorted", "few_unique", "equal" };
+
+/* FromRandom turns a 64-bit random number, r, into an Element. */
+#define DEFINE_QUICKSORT(Type, Element, FromRandom) \
+  static void \
+  sort_wav_##Type(Element * dest, const Element * src, size_t len) { \
+    memcpy(dest, src, len * sizeof(Element)); \
+    wav_##Type##_array_sort(dest, len); \
+  } \
+  \
+  static void \
+  sort_std_##Type(Element * dest, const Element * src, size_t len) { \
+    memcpy(dest, src, len * sizeof(Element)); \
+    std::sort(dest, dest + len); \
+  } \
+  \
+  static void \
+  fill_##Type(Element * dest, size_t len, quicksort_distribution distribution, uint64_t seed) { \
+    uint64_t state = seed | 1; \
+    for (size_t i = 0 ; i < len ; i++) { \
+      uint64_t r = wav_bench_random(&state); \
+      if (distribution == QUICKSORT_FEW_UNIQUE) \
+        r = (r % 16) * UINT64_C(0x9e3779b97f4a7c15); \
+      else if (distribution == QUICKSORT_EQUAL) \
+        r = seed * UINT64_C(0x9e3779b97f4a7c15); \
+      dest[i] = (FromRandom); \
+    } \
+    if (distribution == QUICKSORT_SORTED) \
+      std::sort(dest, dest + len); \
+  } \
+  \
+  DEFINE_BENCH(Type, Element, wav) \
+  DEFINE_BENCH(Type, Element, std)
+
+#define DEFINE_BENCH(Type, Element, impl) \
+  static void \
+  bench_##impl##_##Type(void * ctx, size_t iterations) { \
+    const quicksort_input * in = static_cast<const quicksort_input *>(ctx); \
+    for (size_t it = 0 ; it < iterations ; it++) { \
+      Element * dest = static_cast<Element *>(in->dest); \
+      WAV_BENCH_KEEP_SCALAR(dest); \
+      sort_##impl##_##Type(dest, static_cast<const Element *>(in->src), in->len); \
+      WAV_BENCH_CLOBBER(dest); \
+    } \
+  }
+
+DEFINE_QUICKSORT(u32x4, uint32_t, static_cast<uint32_t>(r >> 32))
+DEFINE_QUICKSORT(i32x4,  int32_t, static_cast<int32_t>(r >> 32))
+DEFINE_QUICKSORT(f32x4,    float, static_cast<float>(static_cast<int32_t>(r >> 32) / 256))
+DEFINE_QUICKSORT(u64x2, uint64_t, r)
+DEFINE_QUICKSORT(i64x2,  int64_t, static_cast<int64_t>(r))
+
+#define RUN(Type, Element, in, expected, distribution) \
+  do { \
+    char name[64]; \
+    snprintf(name, sizeof(name), #Type "_array_sort_%s", quicksort_distribution_names[distribution]); \
+    fill_##Type(static_cast<Element *>(const_cast<void *>((in)->src)), (in)->len, (distribution), (in)->len); \
+    sort_wav_##Type(static_cast<Element *>((in)->dest), static_cast<const Element *>((in)->src), (in)->len); \
+    sort_std_##Type(static_cast<Element *>(expected), static_cast<const Element *>((in)->src), (in)->len); \
+    if (memcmp((in)->dest, (expected), (in)->len * sizeof(Element)) != 0) { \
+      fprintf(stderr, "%s: wrong result for %zu elements\n", name, (in)->len); \
+      return EXIT_FAILURE; \
+    } \
+    wav_bench_run(name, "wav", "throughput", (in)->len, static_cast<double>((in)->len), bench_wav_##Type, (in)); \
+    wav_bench_run(name, "std", "throughput", (in)->len, static_cast<double>((in)->len), bench_std_##Type, (in)); \
+  } while (0)
+
+int
+main(int argc, char ** argv) {
+  static const size_t sizes[] = { 4096, 65536, 1 << 20 };
+  static const quicksort_distribution distributions[] = { QUICKSORT_RANDOM, QUICKSORT_SORTED, QUICKSORT_FEW_UNIQUE, QUICKSORT_EQUAL };
+
+  wav_bench_init("quicksort", argc, argv);
+
+  for (size_t s = 0 ; s < sizeof(sizes) / sizeof(sizes[0]) ; s++) {
+    const size_t len = sizes[s];
+    if (!wav_bench_size_enabled(len))
+      continue;
+
+    /* Room for len uint64_t, the largest element type. */
+    const size_t bytes = len * sizeof(uint64_t);
+    void * expected = wav_bench_alloc(bytes);
+    quicksort_input in = { wav_bench_alloc(bytes), wav_bench_alloc(bytes), len };
+
+    for (size_t d = 0 ; d < sizeof(distributions) / sizeof(distributions[0]) ; d++) {
+      RUN(u32x4, uint32_t, &in, expected, distributions[d]);
+      RUN(i32x4,  int32_t, &in, expected, distributions[d]);
+      RUN(f32x4,    float, &in, expected, distributions[d]);
+      RUN(u64x2, uint64_t, &in, expected, distributions[d]);
+      RUN(i64x2,  int64_t, &in, expected, distributions[d]);
+    }
+
+    free(expected);
+    free(in.dest);
+    free(const_cast<void *>(in.src));
+  }
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+// Run a WASI benchmark under node:
+//
+//   node run-wasi.mjs bench-ops.wasm [arguments...]
+
+import { readFile } from 'node:fs/promises';
+import { argv, env, exit } from 'node:process';
+import { WASI } from 'node:wasi';
+
+const wasi = new WASI({
+  version: 'preview1',
+  args: argv.slice(2),
+  env,
+  returnOnExit: true,
+});
+
+const module = await WebAssembly.compile(await readFile(argv[2]));
+const instance = await WebAssembly.instantiate(module, {
+  wasi_snapshot_preview1: wasi.wasiImport,
+});
+
+exit(wasi.start(instance));
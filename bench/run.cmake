@@ -0,0 +1,27 @@
+# Run one benchmark program, print its output, and append it to
+# OUTPUT.
+#
+#   cmake -DOUTPUT=bench.jsonl -P run.cmake <program> [arguments...]
+
+# Everything after the script name is the command.
+set(command "")
+set(first -1)
+math(EXPR last "${CMAKE_ARGC} - 1")
+foreach(i RANGE 1 ${last})
+  if(first EQUAL -1 AND CMAKE_ARGV${i} STREQUAL "-P")
+    math(EXPR first "${i} + 2")
+  elseif(NOT first EQUAL -1 AND NOT i LESS first)
+    list(APPEND command "${CMAKE_ARGV${i}}")
+  endif()
+endforeach()
+
+execute_process(
+  COMMAND ${command}
+  RESULT_VARIABLE result
+  OUTPUT_VARIABLE output)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "${command} failed: ${result}")
+endif()
+
+message("${output}")
+file(APPEND "${OUTPUT}" "${output}")
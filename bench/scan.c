@@ -0,0 +1,124 @@
+/* wav_*_array_scan and wav_*_array_scan_exclusive compared with a
+ * scalar loop.
+ *
+ *   wav     the wav_*_array_scan* function
+ *   scalar  a running total, one element at a time
+ *
+ * Lengths go from 1000 elements, which fit in L1, to 100M, where both
+ * versions should be limited by memory bandwidth; 1000 isn't a
+ * multiple of any vector size, so the tail is included.  The results
+ * are checked against the scalar ones before timing.  The float scans
+ * add in a different order than the scalar loop, so their input is
+ * chosen so that nothing rounds. */
+
+#include "bench.h"
+#include "wav_scan.h"
+
+typedef struct {
+  void * dest;
+  const void * src;
+  size_t len;
+} scan_input;
+
+/* The scalar loops start from the same identity as wav_scan.h (-0.0
+ * for floats), so the exclusive scans agree on the first element. */
+#define DEFINE_SCAN(Type, Element, Identity) \
+  static Element \
+  scan_scalar_##Type(Element * dest, const Element * src, size_t len) { \
+    Element total = Identity; \
+    for (size_t i = 0 ; i < len ; i++) { \
+      total += src[i]; \
+      dest[i] = total; \
+    } \
+    return total; \
+  } \
+  \
+  static Element \
+  scan_exclusive_scalar_##Type(Element * dest, const Element * src, size_t len) { \
+    Element total = Identity; \
+    for (size_t i = 0 ; i < len ; i++) { \
+      dest[i] = total; \
+      total += src[i]; \
+    } \
+    return total; \
+  } \
+  \
+  DEFINE_BENCH(Type, Element, wav_##Type##_array_scan, wav_##Type##_scan) \
+  DEFINE_BENCH(Type, Element, wav_##Type##_array_scan_exclusive, wav_##Type##_scan_exclusive) \
+  DEFINE_BENCH(Type, Element, scan_scalar_##Type, scalar_##Type##_scan) \
+  DEFINE_BENCH(Type, Element, scan_exclusive_scalar_##Type, scalar_##Type##_scan_exclusive)
+
+#define DEFINE_BENCH(Type, Element, fn, name) \
+  static void \
+  bench_##name(void * ctx, size_t iterations) { \
+    const scan_input * in = (const scan_input *) ctx; \
+    for (size_t it = 0 ; it < iterations ; it++) { \
+      Element * dest = (Element *) in->dest; \
+      WAV_BENCH_KEEP_SCALAR(dest); \
+      Element total = fn(dest, (const Element *) in->src, in->len); \
+      WAV_BENCH_KEEP_SCALAR(total); \
+      WAV_BENCH_CLOBBER(dest); \
+    } \
+  }
+
+DEFINE_SCAN(u32x4, uint32_t, 0)
+DEFINE_SCAN(f32x4,    float, -0.0f)
+
+/* Run fn and scalar_fn on in->src and compare their output. */
+#define CHECK(Element, fn, scalar_fn, in, expected) \
+  do { \
+    const Element total = fn((Element *) (in)->dest, (const Element *) (in)->src, (in)->len); \
+    const Element expected_total = scalar_fn((Element *) (expected), (const Element *) (in)->src, (in)->len); \
+    if (total != expected_total || memcmp((in)->dest, (expected), (in)->len * sizeof(Element)) != 0) { \
+      fprintf(stderr, "%s: wrong result for %zu elements\n", #fn, (in)->len); \
+      return EXIT_FAILURE; \
+    } \
+  } while (0)
+
+#define RUN(Type, Element, in, expected) \
+  do { \
+    CHECK(Element, wav_##Type##_array_scan, scan_scalar_##Type, in, expected); \
+    CHECK(Element, wav_##Type##_array_scan_exclusive, scan_exclusive_scalar_##Type, in, expected); \
+    wav_bench_run(#Type "_array_scan", "wav", "throughput", (in)->len, (double) (in)->len, bench_wav_##Type##_scan, (in)); \
+    wav_bench_run(#Type "_array_scan", "scalar", "throughput", (in)->len, (double) (in)->len, bench_scalar_##Type##_scan, (in)); \
+    wav_bench_run(#Type "_array_scan_exclusive", "wav", "throughput", (in)->len, (double) (in)->len, bench_wav_##Type##_scan_exclusive, (in)); \
+    wav_bench_run(#Type "_array_scan_exclusive", "scalar", "throughput", (in)->len, (double) (in)->len, bench_scalar_##Type##_scan_exclusive, (in)); \
+  } while (0)
+
+int
+main(int argc, char ** argv) {
+  static const size_t sizes[] = { 1000, 100000, 10000000, 100000000 };
+
+  wav_bench_init("scan", argc, argv);
+
+  for (size_t s = 0 ; s < sizeof(sizes) / sizeof(sizes[0]) ; s++) {
+    const size_t len = sizes[s];
+    if (!wav_bench_size_enabled(len))
+      continue;
+
+    /* uint32_t and float are the same size. */
+    const size_t bytes = len * sizeof(uint32_t);
+    void * expected = wav_bench_alloc(bytes);
+    scan_input in = { wav_bench_alloc(bytes), wav_bench_alloc(bytes), len };
+
+    /* Small random deltas; the totals wrap, which is fine. */
+    uint32_t * u = (uint32_t *) in.src;
+    wav_bench_fill_random(u, bytes, len);
+    for (size_t i = 0 ; i < len ; i++)
+      u[i] &= 0xff;
+    RUN(u32x4, uint32_t, &in, expected);
+
+    /* A one every 64 elements, so the totals stay below 2^24 and every
+     * partial sum is exact no matter what order it's added in. */
+    float * f = (float *) in.src;
+    for (size_t i = 0 ; i < len ; i++)
+      f[i] = ((i % 64) == 0) ? 1.0f : 0.0f;
+    RUN(f32x4, float, &in, expected);
+
+    free(expected);
+    free(in.dest);
+    free((void *) in.src);
+  }
+
+  return 0;
+}
@@ -0,0 +1,186 @@
+/* wav_set.h compared with the standard library on posting lists.
+ *
+ *   wav  wav_u32x4_set_intersection, wav_u32x4_set_union,
+ *        wav_u32x4_set_difference, and wav_u32x4_array_merge
+ *   std  std::set_intersection, std::set_union, std::set_difference,
+ *        and std::merge
+ *
+ * The lists are sorted document IDs, each ID in the universe being
+ * picked independently with some probability, in a few shapes:
+ *
+ *   small    both lists about 1K IDs out of 4K (the only shape the
+ *            --quick runs use)
+ *   sparse   both about 128K out of 4M, so few IDs are in both
+ *   overlap  both about 128K out of 256K, so half of each list is in
+ *            the other
+ *   skewed   about 1K and 1M out of 16M, which takes the galloping
+ *            path
+ *
+ * "ns" is per input element (a_len + b_len).  Every result is checked
+ * against the standard library first, with the lists in both orders. */
+
+#include "bench.h"
+#include "wav_set.h"
+
+#include <algorithm>
+
+struct set_input {
+  uint32_t * dest;
+  const uint32_t * a;
+  size_t a_len;
+  const uint32_t * b;
+  size_t b_len;
+};
+
+struct set_shape {
+  const char * name;
+  uint32_t universe;
+  /* Probability of picking each ID, in 1/65536ths. */
+  uint32_t a_probability;
+  uint32_t b_probability;
+};
+
+static size_t
+set_intersection_std(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len) {
+  return static_cast<size_t>(std::set_intersection(a, a + a_len, b, b + b_len, dest) - dest);
+}
+
+static size_t
+set_union_std(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len) {
+  return static_cast<size_t>(std::set_union(a, a + a_len, b, b + b_len, dest) - dest);
+}
+
+static size_t
+set_difference_std(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len) {
+  return static_cast<size_t>(std::set_difference(a, a + a_len, b, b + b_len, dest) - dest);
+}
+
+static size_t
+merge_std(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len) {
+  std::merge(a, a + a_len, b, b + b_len, dest);
+  return a_len + b_len;
+}
+
+static size_t
+set_intersection_wav(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len) {
+  return wav_u32x4_set_intersection(dest, a, a_len, b, b_len);
+}
+
+static size_t
+set_union_wav(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len) {
+  return wav_u32x4_set_union(dest, a, a_len, b, b_len);
+}
+
+static size_t
+set_difference_wav(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len) {
+  return wav_u32x4_set_difference(dest, a, a_len, b, b_len);
+}
+
+static size_t
+merge_wav(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len) {
+  wav_u32x4_array_merge(dest, a, a_len, b, b_len);
+  return a_len + b_len;
+}
+
+#define DEFINE_BENCH(op, impl) \
+  static void \
+  bench_##op##_##impl(void * ctx, size_t iterations) { \
+    const set_input * in = static_cast<const set_input *>(ctx); \
+    for (size_t it = 0 ; it < iterations ; it++) { \
+      uint32_t * dest = in->dest; \
+      WAV_BENCH_KEEP_SCALAR(dest); \
+      size_t n = op##_##impl(dest, in->a, in->a_len, in->b, in->b_len); \
+      WAV_BENCH_KEEP_SCALAR(n); \
+      WAV_BENCH_CLOBBER(dest); \
+    } \
+  }
+
+DEFINE_BENCH(set_intersection, wav)
+DEFINE_BENCH(set_intersection, std)
+DEFINE_BENCH(set_union, wav)
+DEFINE_BENCH(set_union, std)
+DEFINE_BENCH(set_difference, wav)
+DEFINE_BENCH(set_difference, std)
+DEFINE_BENCH(merge, wav)
+DEFINE_BENCH(merge, std)
+
+/* Fill dest with the IDs below universe picked with the given
+ * probability, and return how many there are. */
+static size_t
+fill_posting_list(uint32_t * dest, uint32_t universe, uint32_t probability, uint64_t seed) {
+  uint64_t state = seed | 1;
+  size_t n = 0;
+
+  for (uint32_t id = 0 ; id < universe ; id++) {
+    if ((wav_bench_random(&state) >> 48) < probability)
+      dest[n++] = id;
+  }
+
+  return n;
+}
+
+/* Check <op>_wav against <op>_std with x and y as the inputs. */
+#define CHECK(op, name, dest, x, x_len, y, y_len, expected) \
+  do { \
+    const size_t n = op##_wav((dest), (x), (x_len), (y), (y_len)); \
+    const size_t expected_n = op##_std((expected), (x), (x_len), (y), (y_len)); \
+    if (n != expected_n || memcmp((dest), (expected), n * sizeof(uint32_t)) != 0) { \
+      fprintf(stderr, "%s: wrong result for %zu and %zu elements\n", (name), (x_len), (y_len)); \
+      return EXIT_FAILURE; \
+    } \
+  } while (0)
+
+/* Both orders are checked, since the galloping path depends on which
+ * list is longer. */
+#define RUN(op, shape, in, expected) \
+  do { \
+    char name[64]; \
+    const double items = static_cast<double>((in)->a_len + (in)->b_len); \
+    snprintf(name, sizeof(name), "u32x4_" #op "_%s", (shape)->name); \
+    CHECK(op, name, (in)->dest, (in)->a, (in)->a_len, (in)->b, (in)->b_len, expected); \
+    CHECK(op, name, (in)->dest, (in)->b, (in)->b_len, (in)->a, (in)->a_len, expected); \
+    wav_bench_run(name, "wav", "throughput", (in)->a_len + (in)->b_len, items, bench_##op##_wav, (in)); \
+    wav_bench_run(name, "std", "throughput", (in)->a_len + (in)->b_len, items, bench_##op##_std, (in)); \
+  } while (0)
+
+int
+main(int argc, char ** argv) {
+  static const set_shape shapes[] = {
+    { "small",       4096, 16384, 16384 },
+    { "sparse",   1 << 22,  2048,  2048 },
+    { "overlap",  1 << 18, 32768, 32768 },
+    { "skewed",   1 << 24,     4,  4096 }
+  };
+
+  wav_bench_init("set", argc, argv);
+
+  for (size_t s = 0 ; s < sizeof(shapes) / sizeof(shapes[0]) ; s++) {
+    const set_shape * shape = &(shapes[s]);
+    if (!wav_bench_size_enabled(shape->universe))
+      continue;
+
+    /* Neither list can be longer than the universe, and the outputs
+     * are at most as long as both together. */
+    const size_t bytes = static_cast<size_t>(shape->universe) * sizeof(uint32_t);
+    uint32_t * a = static_cast<uint32_t *>(wav_bench_alloc(bytes));
+    uint32_t * b = static_cast<uint32_t *>(wav_bench_alloc(bytes));
+    uint32_t * expected = static_cast<uint32_t *>(wav_bench_alloc(2 * bytes));
+    set_input in = {
+      static_cast<uint32_t *>(wav_bench_alloc(2 * bytes)),
+      a, fill_posting_list(a, shape->universe, shape->a_probability, 1),
+      b, fill_posting_list(b, shape->universe, shape->b_probability, 2)
+    };
+
+    RUN(set_intersection, shape, &in, expected);
+    RUN(set_union, shape, &in, expected);
+    RUN(set_difference, shape, &in, expected);
+    RUN(merge, shape, &in, expected);
+
+    free(in.dest);
+    free(expected);
+    free(a);
+    free(b);
+  }
+
+  return 0;
+}
@@ -0,0 +1,172 @@
+/* wav_sort.h's sorting networks compared with std::sort on the same
+ * small arrays.
+ *
+ *   wav  the register-level network (sort4/sort8/sort16 for 32-bit
+ *        lanes, sort8/sort16/sort32 for 16-bit lanes), loading each
+ *        array from the input and storing it to the output; 32 and 64
+ *        elements use wav_i32x4_array_sort, which finishes with the
+ *        networks
+ *   std  copy the input to the output, then std::sort each array
+ *
+ * Each iteration sorts SORT_BATCHES arrays of random data, and "ns" is
+ * per array.  Every result is checked against std::sort first. */
+
+#include "bench.h"
+#include "wav_sort.h"
+
+#include <algorithm>
+
+#define SORT_BATCHES 1024
+
+struct sort_input {
+  void * dest;
+  const void * src;
+};
+
+/* Load 1, 2, or 4 vectors from s, sort them with Sort, and store them
+ * to d. */
+#define SORT_REGISTERS_1_(Type, Sort, d, s) \
+  wav_##Type##_storeu(&((d)[0]), Sort(wav_##Type##_loadu(&((s)[0]))))
+
+#define SORT_REGISTERS_2_(Type, Sort, d, s) \
+  do { \
+    const size_t lanes_ = sizeof(wav_##Type##_t) / sizeof((s)[0]); \
+    wav_##Type##_t a_ = wav_##Type##_loadu(&((s)[0 * lanes_])); \
+    wav_##Type##_t b_ = wav_##Type##_loadu(&((s)[1 * lanes_])); \
+    Sort(&a_, &b_); \
+    wav_##Type##_storeu(&((d)[0 * lanes_]), a_); \
+    wav_##Type##_storeu(&((d)[1 * lanes_]), b_); \
+  } while (0)
+
+#define SORT_REGISTERS_4_(Type, Sort, d, s) \
+  do { \
+    const size_t lanes_ = sizeof(wav_##Type##_t) / sizeof((s)[0]); \
+    wav_##Type##_t a_ = wav_##Type##_loadu(&((s)[0 * lanes_])); \
+    wav_##Type##_t b_ = wav_##Type##_loadu(&((s)[1 * lanes_])); \
+    wav_##Type##_t c_ = wav_##Type##_loadu(&((s)[2 * lanes_])); \
+    wav_##Type##_t d_ = wav_##Type##_loadu(&((s)[3 * lanes_])); \
+    Sort(&a_, &b_, &c_, &d_); \
+    wav_##Type##_storeu(&((d)[0 * lanes_]), a_); \
+    wav_##Type##_storeu(&((d)[1 * lanes_]), b_); \
+    wav_##Type##_storeu(&((d)[2 * lanes_]), c_); \
+    wav_##Type##_storeu(&((d)[3 * lanes_]), d_); \
+  } while (0)
+
+#define DEFINE_BENCH(Element, name, impl) \
+  static void \
+  bench_##impl##_##name(void * ctx, size_t iterations) { \
+    const sort_input * in = static_cast<const sort_input *>(ctx); \
+    for (size_t it = 0 ; it < iterations ; it++) { \
+      Element * dest = static_cast<Element *>(in->dest); \
+      WAV_BENCH_KEEP_SCALAR(dest); \
+      sort_##impl##_##name(dest, static_cast<const Element *>(in->src)); \
+      WAV_BENCH_CLOBBER(dest); \
+    } \
+  }
+
+/* Each of these defines sort_<impl>_<name>(dest, src), which sorts all
+ * SORT_BATCHES arrays of n elements from src into dest, and its
+ * benchmark. */
+
+#define DEFINE_STD_SORT(Element, name, n) \
+  static void \
+  sort_std_##name(Element * dest, const Element * src) { \
+    memcpy(dest, src, SORT_BATCHES * (n) * sizeof(Element)); \
+    for (size_t b = 0 ; b < SORT_BATCHES ; b++) \
+      std::sort(&(dest[b * (n)]), &(dest[(b + 1) * (n)])); \
+  } \
+  DEFINE_BENCH(Element, name, std)
+
+#define DEFINE_NETWORK(Type, Element, Sort, n, Registers) \
+  static void \
+  sort_wav_##Type##_##Sort(Element * dest, const Element * src) { \
+    for (size_t b = 0 ; b < SORT_BATCHES ; b++) \
+      SORT_REGISTERS_##Registers##_(Type, wav_##Type##_##Sort, &(dest[b * (n)]), &(src[b * (n)])); \
+  } \
+  DEFINE_BENCH(Element, Type##_##Sort, wav) \
+  DEFINE_STD_SORT(Element, Type##_##Sort, n)
+
+#define DEFINE_ARRAY_SORT(Type, Element, n) \
+  static void \
+  sort_wav_##Type##_array_sort##n(Element * dest, const Element * src) { \
+    memcpy(dest, src, SORT_BATCHES * (n) * sizeof(Element)); \
+    for (size_t b = 0 ; b < SORT_BATCHES ; b++) \
+      wav_##Type##_array_sort(&(dest[b * (n)]), (n)); \
+  } \
+  DEFINE_BENCH(Element, Type##_array_sort##n, wav) \
+  DEFINE_STD_SORT(Element, Type##_array_sort##n, n)
+
+DEFINE_NETWORK(i32x4,  int32_t, sort4,   4, 1)
+DEFINE_NETWORK(i32x4,  int32_t, sort8,   8, 2)
+DEFINE_NETWORK(i32x4,  int32_t, sort16, 16, 4)
+DEFINE_NETWORK(u32x4, uint32_t, sort4,   4, 1)
+DEFINE_NETWORK(u32x4, uint32_t, sort8,   8, 2)
+DEFINE_NETWORK(u32x4, uint32_t, sort16, 16, 4)
+DEFINE_NETWORK(f32x4,    float, sort4,   4, 1)
+DEFINE_NETWORK(f32x4,    float, sort8,   8, 2)
+DEFINE_NETWORK(f32x4,    float, sort16, 16, 4)
+DEFINE_NETWORK(i16x8,  int16_t, sort8,   8, 1)
+DEFINE_NETWORK(i16x8,  int16_t, sort16, 16, 2)
+DEFINE_NETWORK(i16x8,  int16_t, sort32, 32, 4)
+DEFINE_NETWORK(u16x8, uint16_t, sort8,   8, 1)
+DEFINE_NETWORK(u16x8, uint16_t, sort16, 16, 2)
+DEFINE_NETWORK(u16x8, uint16_t, sort32, 32, 4)
+DEFINE_ARRAY_SORT(i32x4, int32_t, 32)
+DEFINE_ARRAY_SORT(i32x4, int32_t, 64)
+
+/* Check sort_wav_<fn> against sort_std_<fn>, then time both; name is
+ * what's reported. */
+#define RUN(Element, fn, name, n) \
+  do { \
+    sort_wav_##fn(static_cast<Element *>(in.dest), static_cast<const Element *>(in.src)); \
+    sort_std_##fn(static_cast<Element *>(expected), static_cast<const Element *>(in.src)); \
+    if (memcmp(in.dest, expected, SORT_BATCHES * (n) * sizeof(Element)) != 0) { \
+      fprintf(stderr, "%s: wrong result for %d elements\n", name, n); \
+      return EXIT_FAILURE; \
+    } \
+    wav_bench_run(name, "wav", "throughput", (n), SORT_BATCHES, bench_wav_##fn, &in); \
+    wav_bench_run(name, "std", "throughput", (n), SORT_BATCHES, bench_std_##fn, &in); \
+  } while (0)
+
+int
+main(int argc, char ** argv) {
+  /* Room for SORT_BATCHES arrays of 64 32-bit elements. */
+  const size_t bytes = SORT_BATCHES * 64 * sizeof(int32_t);
+
+  wav_bench_init("sort", argc, argv);
+
+  void * expected = wav_bench_alloc(bytes);
+  sort_input in = { wav_bench_alloc(bytes), wav_bench_alloc(bytes) };
+
+  wav_bench_fill_random(const_cast<void *>(in.src), bytes, 1);
+  RUN(int32_t, i32x4_sort4, "i32x4_sort4", 4);
+  RUN(int32_t, i32x4_sort8, "i32x4_sort8", 8);
+  RUN(int32_t, i32x4_sort16, "i32x4_sort16", 16);
+  RUN(uint32_t, u32x4_sort4, "u32x4_sort4", 4);
+  RUN(uint32_t, u32x4_sort8, "u32x4_sort8", 8);
+  RUN(uint32_t, u32x4_sort16, "u32x4_sort16", 16);
+  RUN(int32_t, i32x4_array_sort32, "i32x4_array_sort", 32);
+  RUN(int32_t, i32x4_array_sort64, "i32x4_array_sort", 64);
+  RUN(int16_t, i16x8_sort8, "i16x8_sort8", 8);
+  RUN(int16_t, i16x8_sort16, "i16x8_sort16", 16);
+  RUN(int16_t, i16x8_sort32, "i16x8_sort32", 32);
+  RUN(uint16_t, u16x8_sort8, "u16x8_sort8", 8);
+  RUN(uint16_t, u16x8_sort16, "u16x8_sort16", 16);
+  RUN(uint16_t, u16x8_sort32, "u16x8_sort32", 32);
+
+  /* Random bits would include NaNs, which the networks don't support. */
+  float * f = static_cast<float *>(const_cast<void *>(in.src));
+  const int32_t * i = static_cast<const int32_t *>(in.dest);
+  memcpy(in.dest, in.src, bytes);
+  for (size_t j = 0 ; j < bytes / sizeof(float) ; j++)
+    f[j] = static_cast<float>(i[j] / 256);
+  RUN(float, f32x4_sort4, "f32x4_sort4", 4);
+  RUN(float, f32x4_sort8, "f32x4_sort8", 8);
+  RUN(float, f32x4_sort16, "f32x4_sort16", 16);
+
+  free(expected);
+  free(in.dest);
+  free(const_cast<void *>(in.src));
+
+  return 0;
+}
@@ -0,0 +1,53 @@
+# Compile SOURCE for wasm32 with SIMD128, disassemble it, and compare
+# the SIMD instructions (one mnemonic per line, without operands) with
+# EXPECTED.  Scalar instructions (local.get, i32.and, end, ...) are
+# ignored since they depend on the calling convention more than on the
+# function being tested.  If UPDATE is true EXPECTED is overwritten
+# instead.
+#
+#   cmake -DCC=clang -DOBJDUMP=llvm-objdump -DINCLUDE=<dir with wav.h> \
+#     -DSOURCE=foo.c -DEXPECTED=foo.expected -DOBJECT=foo.o \
+#     [-DUPDATE=ON] -P codegen.cmake
+
+get_filename_component(object_dir "${OBJECT}" DIRECTORY)
+file(MAKE_DIRECTORY "${object_dir}")
+
+execute_process(
+  COMMAND "${CC}" --target=wasm32 -msimd128 -O2
+    -I "${INCLUDE}" -c "${SOURCE}" -o "${OBJECT}"
+  RESULT_VARIABLE result
+  ERROR_VARIABLE errors)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "Unable to compile ${SOURCE}:\n${errors}")
+endif()
+
+execute_process(
+  COMMAND "${OBJDUMP}" -d --no-show-raw-insn "${OBJECT}"
+  RESULT_VARIABLE result
+  OUTPUT_VARIABLE disassembly
+  ERROR_VARIABLE errors)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "Unable to disassemble ${OBJECT}:\n${errors}")
+endif()
+
+string(REPLACE ";" "," disassembly "${disassembly}")
+string(REPLACE "\n" ";" lines "${disassembly}")
+set(actual "")
+foreach(line ${lines})
+  if(line MATCHES "^ *[0-9a-f]+:.*[ \t]((v128|i8x16|i16x8|i32x4|i64x2|f32x4|f64x2)\\.[a-z0-9_]+)")
+    string(APPEND actual "${CMAKE_MATCH_1}\n")
+  endif()
+endforeach()
+
+if(UPDATE)
+  file(WRITE "${EXPECTED}" "${actual}")
+  return()
+endif()
+
+file(READ "${EXPECTED}" expected)
+if(NOT actual STREQUAL expected)
+  message(FATAL_ERROR
+    "Unexpected code generated for ${SOURCE}\n"
+    "Expected:\n${expected}"
+    "Actual:\n${actual}")
+endif()
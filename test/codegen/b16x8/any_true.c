@@ -0,0 +1,6 @@
+#include "wav.h"
+
+_Bool
+test(wav_b16x8_t value) {
+  return wav_b16x8_any_true(value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+unsigned int
+test(wav_b16x8_t a) {
+  return wav_b16x8_bitmask(a);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_b16x8_t
+test(wav_b16x8_t lhs, wav_b16x8_t rhs) {
+  return wav_b16x8_ne(lhs, rhs);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(wav_b16x8_t a, wav_u16x8_t b) {
+  return wav_b16x8_xor_u16x8(a, b);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+_Bool
+test(wav_b32x4_t value) {
+  return wav_b32x4_any_true(value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_b32x4_t
+test(wav_b32x4_t lhs, wav_b32x4_t rhs) {
+  return wav_b32x4_ne(lhs, rhs);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u32x4_t
+test(wav_b32x4_t a, wav_u32x4_t b) {
+  return wav_b32x4_xor_u32x4(a, b);
+}
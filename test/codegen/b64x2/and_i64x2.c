@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i64x2_t
+test(wav_b64x2_t a, wav_i64x2_t b) {
+  return wav_b64x2_and_i64x2(a, b);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+_Bool
+test(wav_b64x2_t value) {
+  return wav_b64x2_any_true(value);
+}
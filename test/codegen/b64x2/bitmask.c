@@ -0,0 +1,6 @@
+#include "wav.h"
+
+unsigned int
+test(wav_b64x2_t a) {
+  return wav_b64x2_bitmask(a);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_b64x2_t
+test(wav_b64x2_t lhs, wav_b64x2_t rhs) {
+  return wav_b64x2_ne(lhs, rhs);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_b64x2_t
+test(wav_b64x2_t v) {
+  return wav_b64x2_not(v);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+_Bool
+test(wav_b8x16_t value) {
+  return wav_b8x16_all_true(value);
+}
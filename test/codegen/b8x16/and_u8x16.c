@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u8x16_t
+test(wav_b8x16_t a, wav_u8x16_t b) {
+  return wav_b8x16_and_u8x16(a, b);
+}
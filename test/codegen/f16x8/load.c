@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f16x8_t
+test(const uint16_t src[8]) {
+  return wav_f16x8_load(src);
+}
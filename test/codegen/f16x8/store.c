@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(uint16_t dest[8], wav_f16x8_t src) {
+  wav_f16x8_store(dest, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f32x4_t
+test(wav_f32x4_t a) {
+  return wav_f32x4_abs(a);
+}
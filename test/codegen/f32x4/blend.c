@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f32x4_t
+test(wav_b32x4_t control, wav_f32x4_t when_set, wav_f32x4_t when_unset) {
+  return wav_f32x4_blend(control, when_set, when_unset);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+float
+test(wav_f32x4_t v) {
+  return wav_f32x4_extract_lane(v, 1);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_b32x4_t
+test(wav_f32x4_t lhs, wav_f32x4_t rhs) {
+  return wav_f32x4_le(lhs, rhs);
+}
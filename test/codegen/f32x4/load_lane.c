@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f32x4_t
+test(wav_f32x4_t v, const float * src) {
+  return wav_f32x4_load_lane(v, 1, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f32x4_t
+test(const float *a) {
+  return wav_f32x4_load_splat(a);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f32x4_t
+test(const float src[4]) {
+  return wav_f32x4_loada(src);
+}
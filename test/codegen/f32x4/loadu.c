@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f32x4_t
+test(const void *src) {
+  return wav_f32x4_loadu(src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f32x4_t
+test(float c0, float c1, float c2, float c3) {
+  return wav_f32x4_make(c0, c1, c2, c3);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f32x4_t
+test(wav_f32x4_t a, wav_f32x4_t b) {
+  return wav_f32x4_mul(a, b);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f64x2_t
+test(wav_f32x4_t vec) {
+  return wav_f32x4_promote_low(vec);
+}
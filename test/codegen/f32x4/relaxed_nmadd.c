@@ -0,0 +1,7 @@
+#include "wav.h"
+
+__attribute__((__target__("relaxed-simd")))
+wav_f32x4_t
+test(wav_f32x4_t a, wav_f32x4_t b, wav_f32x4_t c) {
+  return wav_f32x4_relaxed_nmadd(a, b, c);
+}
@@ -0,0 +1,7 @@
+#include "wav.h"
+
+__attribute__((__target__("relaxed-simd")))
+wav_i32x4_t
+test(wav_f32x4_t a) {
+  return wav_f32x4_relaxed_trunc_i32x4(a);
+}
@@ -0,0 +1,7 @@
+#include "wav.h"
+
+__attribute__((__target__("relaxed-simd")))
+wav_u32x4_t
+test(wav_f32x4_t a) {
+  return wav_f32x4_relaxed_trunc_u32x4(a);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f32x4_t
+test(wav_f32x4_t v, float value) {
+  return wav_f32x4_replace_lane(v, 1, value);
+}
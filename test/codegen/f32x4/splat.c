@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f32x4_t
+test(float value) {
+  return wav_f32x4_splat(value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(float dest[2], wav_f32x4_t src) {
+  wav_f32x4_store(dest, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(float * dest, wav_f32x4_t v) {
+  wav_f32x4_store_lane(dest, v, 1);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(void *dest, wav_f32x4_t src) {
+  wav_f32x4_storeu(dest, src);
+}
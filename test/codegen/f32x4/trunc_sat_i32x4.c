@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i32x4_t
+test(wav_f32x4_t a) {
+  return wav_f32x4_trunc_sat_i32x4(a);
+}
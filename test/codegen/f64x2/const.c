@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f64x2_t
+test(void) {
+  return wav_f64x2_const(1, 2);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f32x4_t
+test(wav_f64x2_t a) {
+  return wav_f64x2_demote(a);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f64x2_t
+test(wav_f64x2_t lhs, wav_f64x2_t rhs) {
+  return wav_f64x2_div(lhs, rhs);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+double
+test(wav_f64x2_t v) {
+  return wav_f64x2_extract_lane(v, 1);
+}
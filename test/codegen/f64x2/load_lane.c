@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f64x2_t
+test(wav_f64x2_t v, const double * src) {
+  return wav_f64x2_load_lane(v, 1, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f64x2_t
+test(const double *a) {
+  return wav_f64x2_load_zero(a);
+}
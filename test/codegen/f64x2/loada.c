@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f64x2_t
+test(const double src[2]) {
+  return wav_f64x2_loada(src);
+}
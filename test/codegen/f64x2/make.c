@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f64x2_t
+test(double c0, double c1) {
+  return wav_f64x2_make(c0, c1);
+}
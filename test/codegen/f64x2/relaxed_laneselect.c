@@ -0,0 +1,7 @@
+#include "wav.h"
+
+__attribute__((__target__("relaxed-simd")))
+wav_f64x2_t
+test(wav_b64x2_t control, wav_f64x2_t when_set, wav_f64x2_t when_unset) {
+  return wav_f64x2_relaxed_laneselect(control, when_set, when_unset);
+}
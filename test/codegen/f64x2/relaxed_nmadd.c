@@ -0,0 +1,7 @@
+#include "wav.h"
+
+__attribute__((__target__("relaxed-simd")))
+wav_f64x2_t
+test(wav_f64x2_t a, wav_f64x2_t b, wav_f64x2_t c) {
+  return wav_f64x2_relaxed_nmadd(a, b, c);
+}
@@ -0,0 +1,7 @@
+#include "wav.h"
+
+__attribute__((__target__("relaxed-simd")))
+wav_u32x4_t
+test(wav_f64x2_t a) {
+  return wav_f64x2_relaxed_trunc_zero_u32x4(a);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f64x2_t
+test(wav_f64x2_t v, double value) {
+  return wav_f64x2_replace_lane(v, 1, value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f64x2_t
+test(double value) {
+  return wav_f64x2_splat(value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f64x2_t
+test(wav_f64x2_t vec) {
+  return wav_f64x2_sqrt(vec);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(double dest[16], wav_f64x2_t src) {
+  wav_f64x2_store(dest, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(double * dest, wav_f64x2_t v) {
+  wav_f64x2_store_lane(dest, v, 1);
+}
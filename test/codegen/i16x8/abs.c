@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i16x8_t
+test(wav_i16x8_t a) {
+  return wav_i16x8_abs(a);
+}
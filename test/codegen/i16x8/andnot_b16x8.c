@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i16x8_t
+test(wav_i16x8_t a, wav_b16x8_t b) {
+  return wav_i16x8_andnot_b16x8(a, b);
+}
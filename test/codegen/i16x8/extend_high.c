@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i32x4_t
+test(wav_i16x8_t vec) {
+  return wav_i16x8_extend_high(vec);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+int16_t
+test(wav_i16x8_t v) {
+  return wav_i16x8_extract_lane(v, 1);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_b16x8_t
+test(wav_i16x8_t lhs, wav_i16x8_t rhs) {
+  return wav_i16x8_le(lhs, rhs);
+}
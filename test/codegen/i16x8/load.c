@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i16x8_t
+test(const int16_t src[8]) {
+  return wav_i16x8_load(src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i16x8_t
+test(int8_t values[8]) {
+  return wav_i16x8_load_extend(values);
+}
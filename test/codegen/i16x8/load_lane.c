@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i16x8_t
+test(wav_i16x8_t v, const int16_t * src) {
+  return wav_i16x8_load_lane(v, 1, src);
+}
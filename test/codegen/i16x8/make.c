@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i16x8_t
+test(int16_t c0, int16_t c1, int16_t c2, int16_t c3, int16_t c4, int16_t c5, int16_t c6, int16_t c7) {
+  return wav_i16x8_make(c0, c1, c2, c3, c4, c5, c6, c7);
+}
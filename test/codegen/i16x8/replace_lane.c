@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i16x8_t
+test(wav_i16x8_t v, int16_t value) {
+  return wav_i16x8_replace_lane(v, 1, value);
+}
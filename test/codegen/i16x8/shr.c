@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i16x8_t
+test(wav_i16x8_t a, int count) {
+  return wav_i16x8_shr(a, count);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i16x8_t
+test(int16_t value) {
+  return wav_i16x8_splat(value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(int16_t * dest, wav_i16x8_t v) {
+  wav_i16x8_store_lane(dest, v, 1);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(int16_t dest[8], wav_i16x8_t src) {
+  wav_i16x8_storea(dest, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(void *dest, wav_i16x8_t src) {
+  wav_i16x8_storeu(dest, src);
+}
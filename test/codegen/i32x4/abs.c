@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i32x4_t
+test(wav_i32x4_t a) {
+  return wav_i32x4_abs(a);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+_Bool
+test(wav_i32x4_t value) {
+  return wav_i32x4_all_true(value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i32x4_t
+test(wav_b32x4_t control, wav_i32x4_t when_set, wav_i32x4_t when_unset) {
+  return wav_i32x4_bitselect(control, when_set, when_unset);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_f64x2_t
+test(wav_i32x4_t a) {
+  return wav_i32x4_convert_low_f64x2(a);
+}
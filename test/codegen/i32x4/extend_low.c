@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i64x2_t
+test(wav_i32x4_t vec) {
+  return wav_i32x4_extend_low(vec);
+}
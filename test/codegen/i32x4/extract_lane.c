@@ -0,0 +1,6 @@
+#include "wav.h"
+
+int32_t
+test(wav_i32x4_t v) {
+  return wav_i32x4_extract_lane(v, 1);
+}
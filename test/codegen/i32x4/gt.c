@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_b32x4_t
+test(wav_i32x4_t lhs, wav_i32x4_t rhs) {
+  return wav_i32x4_gt(lhs, rhs);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i32x4_t
+test(int16_t values[4]) {
+  return wav_i32x4_load_extend(values);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i32x4_t
+test(wav_i32x4_t v, const int32_t * src) {
+  return wav_i32x4_load_lane(v, 1, src);
+}
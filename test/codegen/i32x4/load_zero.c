@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i32x4_t
+test(const int32_t *a) {
+  return wav_i32x4_load_zero(a);
+}
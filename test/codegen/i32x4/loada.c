@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i32x4_t
+test(const int32_t src[4]) {
+  return wav_i32x4_loada(src);
+}
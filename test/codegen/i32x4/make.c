@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i32x4_t
+test(int32_t c0, int32_t c1, int32_t c2, int32_t c3) {
+  return wav_i32x4_make(c0, c1, c2, c3);
+}
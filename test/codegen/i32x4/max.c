@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i32x4_t
+test(wav_i32x4_t a, wav_i32x4_t b) {
+  return wav_i32x4_max(a, b);
+}
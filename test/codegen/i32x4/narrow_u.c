@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(wav_i32x4_t a, wav_i32x4_t b) {
+  return wav_i32x4_narrow_u(a, b);
+}
@@ -0,0 +1,7 @@
+#include "wav.h"
+
+__attribute__((__target__("relaxed-simd")))
+wav_i32x4_t
+test(wav_b32x4_t control, wav_i32x4_t when_set, wav_i32x4_t when_unset) {
+  return wav_i32x4_relaxed_laneselect(control, when_set, when_unset);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i32x4_t
+test(wav_i32x4_t v, int32_t value) {
+  return wav_i32x4_replace_lane(v, 1, value);
+}
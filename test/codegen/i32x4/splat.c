@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i32x4_t
+test(int32_t value) {
+  return wav_i32x4_splat(value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(int32_t * dest, wav_i32x4_t v) {
+  wav_i32x4_store_lane(dest, v, 1);
+}
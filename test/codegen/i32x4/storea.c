@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(int32_t dest[4], wav_i32x4_t src) {
+  wav_i32x4_storea(dest, src);
+}
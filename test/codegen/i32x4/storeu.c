@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(void *dest, wav_i32x4_t src) {
+  wav_i32x4_storeu(dest, src);
+}
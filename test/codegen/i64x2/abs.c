@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i64x2_t
+test(wav_i64x2_t a) {
+  return wav_i64x2_abs(a);
+}
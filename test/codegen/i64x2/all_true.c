@@ -0,0 +1,6 @@
+#include "wav.h"
+
+_Bool
+test(wav_i64x2_t value) {
+  return wav_i64x2_all_true(value);
+}
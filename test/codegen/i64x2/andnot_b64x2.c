@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i64x2_t
+test(wav_i64x2_t a, wav_b64x2_t b) {
+  return wav_i64x2_andnot_b64x2(a, b);
+}
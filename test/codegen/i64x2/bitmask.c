@@ -0,0 +1,6 @@
+#include "wav.h"
+
+unsigned int
+test(wav_i64x2_t a) {
+  return wav_i64x2_bitmask(a);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i64x2_t
+test(void) {
+  return wav_i64x2_const(1, 2);
+}
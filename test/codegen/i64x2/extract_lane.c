@@ -0,0 +1,6 @@
+#include "wav.h"
+
+int64_t
+test(wav_i64x2_t v) {
+  return wav_i64x2_extract_lane(v, 1);
+}
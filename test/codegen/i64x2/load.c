@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i64x2_t
+test(const int64_t src[2]) {
+  return wav_i64x2_load(src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i64x2_t
+test(int32_t values[2]) {
+  return wav_i64x2_load_extend(values);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i64x2_t
+test(wav_i64x2_t v, const int64_t * src) {
+  return wav_i64x2_load_lane(v, 1, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i64x2_t
+test(const void *src) {
+  return wav_i64x2_loadu(src);
+}
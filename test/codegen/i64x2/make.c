@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i64x2_t
+test(int64_t c0, int64_t c1) {
+  return wav_i64x2_make(c0, c1);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i64x2_t
+test(wav_i64x2_t v, int64_t value) {
+  return wav_i64x2_replace_lane(v, 1, value);
+}
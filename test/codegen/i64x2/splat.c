@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i64x2_t
+test(int64_t value) {
+  return wav_i64x2_splat(value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(int64_t dest[2], wav_i64x2_t src) {
+  wav_i64x2_store(dest, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(int64_t * dest, wav_i64x2_t v) {
+  wav_i64x2_store_lane(dest, v, 1);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+_Bool
+test(wav_i8x16_t value) {
+  return wav_i8x16_any_true(value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+unsigned int
+test(wav_i8x16_t a) {
+  return wav_i8x16_bitmask(a);
+}
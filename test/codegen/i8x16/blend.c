@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i8x16_t
+test(wav_b8x16_t control, wav_i8x16_t when_set, wav_i8x16_t when_unset) {
+  return wav_i8x16_blend(control, when_set, when_unset);
+}
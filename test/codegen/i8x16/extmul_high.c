@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i16x8_t
+test(wav_i8x16_t a, wav_i8x16_t b) {
+  return wav_i8x16_extmul_high(a, b);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+int8_t
+test(wav_i8x16_t v) {
+  return wav_i8x16_extract_lane(v, 1);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i8x16_t
+test(wav_i8x16_t v, const int8_t * src) {
+  return wav_i8x16_load_lane(v, 1, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i8x16_t
+test(const int8_t *a) {
+  return wav_i8x16_load_splat(a);
+}
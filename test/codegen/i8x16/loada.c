@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i8x16_t
+test(const int8_t src[16]) {
+  return wav_i8x16_loada(src);
+}
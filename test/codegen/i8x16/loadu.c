@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i8x16_t
+test(const void *src) {
+  return wav_i8x16_loadu(src);
+}
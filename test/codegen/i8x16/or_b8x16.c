@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i8x16_t
+test(wav_i8x16_t a, wav_b8x16_t b) {
+  return wav_i8x16_or_b8x16(a, b);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i8x16_t
+test(wav_i8x16_t a) {
+  return wav_i8x16_popcnt(a);
+}
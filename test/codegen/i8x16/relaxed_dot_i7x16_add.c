@@ -0,0 +1,7 @@
+#include "wav.h"
+
+__attribute__((__target__("relaxed-simd")))
+wav_i32x4_t
+test(wav_i8x16_t a, wav_i8x16_t b, wav_i32x4_t c) {
+  return wav_i8x16_relaxed_dot_i7x16_add(a, b, c);
+}
@@ -0,0 +1,7 @@
+#include "wav.h"
+
+__attribute__((__target__("relaxed-simd")))
+wav_i8x16_t
+test(wav_i8x16_t data, wav_i8x16_t idx) {
+  return wav_i8x16_relaxed_swizzle(data, idx);
+}
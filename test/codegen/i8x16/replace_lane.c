@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i8x16_t
+test(wav_i8x16_t v, int8_t value) {
+  return wav_i8x16_replace_lane(v, 1, value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i8x16_t
+test(int8_t value) {
+  return wav_i8x16_splat(value);
+}
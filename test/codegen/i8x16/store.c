@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(int8_t dest[16], wav_i8x16_t src) {
+  wav_i8x16_store(dest, src);
+}
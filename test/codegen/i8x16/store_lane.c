@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(int8_t * dest, wav_i8x16_t v) {
+  wav_i8x16_store_lane(dest, v, 1);
+}
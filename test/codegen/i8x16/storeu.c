@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(void *dest, wav_i8x16_t src) {
+  wav_i8x16_storeu(dest, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_i8x16_t
+test(wav_i8x16_t data, wav_i8x16_t idx) {
+  return wav_i8x16_swizzle(data, idx);
+}
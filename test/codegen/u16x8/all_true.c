@@ -0,0 +1,6 @@
+#include "wav.h"
+
+_Bool
+test(wav_u16x8_t value) {
+  return wav_u16x8_all_true(value);
+}
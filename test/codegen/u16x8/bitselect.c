@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(wav_b16x8_t control, wav_u16x8_t when_set, wav_u16x8_t when_unset) {
+  return wav_u16x8_bitselect(control, when_set, when_unset);
+}
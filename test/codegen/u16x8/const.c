@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(void) {
+  return wav_u16x8_const(1, 2, 3, 4, 5, 6, 7, 8);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u32x4_t
+test(wav_u16x8_t vec) {
+  return wav_u16x8_extend_low(vec);
+}
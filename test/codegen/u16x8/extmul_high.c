@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u32x4_t
+test(wav_u16x8_t a, wav_u16x8_t b) {
+  return wav_u16x8_extmul_high(a, b);
+}
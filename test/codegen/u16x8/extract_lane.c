@@ -0,0 +1,6 @@
+#include "wav.h"
+
+uint16_t
+test(wav_u16x8_t v) {
+  return wav_u16x8_extract_lane(v, 1);
+}
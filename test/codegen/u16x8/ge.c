@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_b16x8_t
+test(wav_u16x8_t lhs, wav_u16x8_t rhs) {
+  return wav_u16x8_ge(lhs, rhs);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(uint8_t values[8]) {
+  return wav_u16x8_load_extend(values);
+}
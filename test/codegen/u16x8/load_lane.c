@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(wav_u16x8_t v, const uint16_t * src) {
+  return wav_u16x8_load_lane(v, 1, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(const uint16_t *a) {
+  return wav_u16x8_load_splat(a);
+}
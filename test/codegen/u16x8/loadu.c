@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(const void *src) {
+  return wav_u16x8_loadu(src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(const void *a) {
+  return wav_u16x8_loadu_splat(a);
+}
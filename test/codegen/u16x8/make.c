@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(uint16_t c0, uint16_t c1, uint16_t c2, uint16_t c3, uint16_t c4, uint16_t c5, uint16_t c6, uint16_t c7) {
+  return wav_u16x8_make(c0, c1, c2, c3, c4, c5, c6, c7);
+}
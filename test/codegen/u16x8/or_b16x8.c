@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(wav_u16x8_t a, wav_b16x8_t b) {
+  return wav_u16x8_or_b16x8(a, b);
+}
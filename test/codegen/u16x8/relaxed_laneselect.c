@@ -0,0 +1,7 @@
+#include "wav.h"
+
+__attribute__((__target__("relaxed-simd")))
+wav_u16x8_t
+test(wav_b16x8_t control, wav_u16x8_t when_set, wav_u16x8_t when_unset) {
+  return wav_u16x8_relaxed_laneselect(control, when_set, when_unset);
+}
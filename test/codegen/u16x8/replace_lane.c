@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(wav_u16x8_t v, uint16_t value) {
+  return wav_u16x8_replace_lane(v, 1, value);
+}
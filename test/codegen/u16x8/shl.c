@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(wav_u16x8_t a, int count) {
+  return wav_u16x8_shl(a, count);
+}
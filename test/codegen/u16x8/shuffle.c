@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(wav_u16x8_t a, wav_u16x8_t b) {
+  return wav_u16x8_shuffle(a, b, 1, 4, 7, 10, 13, 0, 3, 6);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(uint16_t value) {
+  return wav_u16x8_splat(value);
+}
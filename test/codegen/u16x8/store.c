@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(uint16_t dest[4], wav_u16x8_t src) {
+  wav_u16x8_store(dest, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(uint16_t * dest, wav_u16x8_t v) {
+  wav_u16x8_store_lane(dest, v, 1);
+}
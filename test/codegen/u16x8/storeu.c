@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(void *dest, wav_u16x8_t src) {
+  wav_u16x8_storeu(dest, src);
+}
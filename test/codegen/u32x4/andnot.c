@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u32x4_t
+test(wav_u32x4_t a, wav_u32x4_t b) {
+  return wav_u32x4_andnot(a, b);
+}
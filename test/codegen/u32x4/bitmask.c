@@ -0,0 +1,6 @@
+#include "wav.h"
+
+unsigned int
+test(wav_u32x4_t a) {
+  return wav_u32x4_bitmask(a);
+}
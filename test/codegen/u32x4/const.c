@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u32x4_t
+test(void) {
+  return wav_u32x4_const(1, 2, 3, 4);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u64x2_t
+test(wav_u32x4_t vec) {
+  return wav_u32x4_extend_high(vec);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+uint32_t
+test(wav_u32x4_t v) {
+  return wav_u32x4_extract_lane(v, 1);
+}
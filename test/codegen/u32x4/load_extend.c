@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u32x4_t
+test(uint16_t values[4]) {
+  return wav_u32x4_load_extend(values);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u32x4_t
+test(wav_u32x4_t v, const uint32_t * src) {
+  return wav_u32x4_load_lane(v, 1, src);
+}
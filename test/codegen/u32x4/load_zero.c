@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u32x4_t
+test(const uint32_t *a) {
+  return wav_u32x4_load_zero(a);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u32x4_t
+test(const uint32_t src[4]) {
+  return wav_u32x4_loada(src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_b32x4_t
+test(wav_u32x4_t lhs, wav_u32x4_t rhs) {
+  return wav_u32x4_lt(lhs, rhs);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u32x4_t
+test(uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3) {
+  return wav_u32x4_make(c0, c1, c2, c3);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u32x4_t
+test(wav_u32x4_t v, uint32_t value) {
+  return wav_u32x4_replace_lane(v, 1, value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u32x4_t
+test(wav_u32x4_t a, int count) {
+  return wav_u32x4_shr(a, count);
+}
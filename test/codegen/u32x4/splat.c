@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u32x4_t
+test(uint32_t value) {
+  return wav_u32x4_splat(value);
+}
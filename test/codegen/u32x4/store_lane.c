@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(uint32_t * dest, wav_u32x4_t v) {
+  wav_u32x4_store_lane(dest, v, 1);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(uint32_t dest[4], wav_u32x4_t src) {
+  wav_u32x4_storea(dest, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(void *dest, wav_u32x4_t src) {
+  wav_u32x4_storeu(dest, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+_Bool
+test(wav_u64x2_t value) {
+  return wav_u64x2_all_true(value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u64x2_t
+test(wav_b64x2_t control, wav_u64x2_t when_set, wav_u64x2_t when_unset) {
+  return wav_u64x2_bitselect(control, when_set, when_unset);
+}
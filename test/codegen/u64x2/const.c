@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u64x2_t
+test(void) {
+  return wav_u64x2_const(1, 2);
+}
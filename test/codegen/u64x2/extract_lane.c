@@ -0,0 +1,6 @@
+#include "wav.h"
+
+uint64_t
+test(wav_u64x2_t v) {
+  return wav_u64x2_extract_lane(v, 1);
+}
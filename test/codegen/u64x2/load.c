@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u64x2_t
+test(const uint64_t src[2]) {
+  return wav_u64x2_load(src);
+}
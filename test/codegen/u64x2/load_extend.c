@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u64x2_t
+test(uint32_t values[2]) {
+  return wav_u64x2_load_extend(values);
+}
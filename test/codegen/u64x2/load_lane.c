@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u64x2_t
+test(wav_u64x2_t v, const uint64_t * src) {
+  return wav_u64x2_load_lane(v, 1, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u64x2_t
+test(const void *a) {
+  return wav_u64x2_loadu_splat(a);
+}
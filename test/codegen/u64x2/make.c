@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u64x2_t
+test(uint64_t c0, uint64_t c1) {
+  return wav_u64x2_make(c0, c1);
+}
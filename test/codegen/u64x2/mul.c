@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u64x2_t
+test(wav_u64x2_t a, wav_u64x2_t b) {
+  return wav_u64x2_mul(a, b);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u64x2_t
+test(wav_u64x2_t v, uint64_t value) {
+  return wav_u64x2_replace_lane(v, 1, value);
+}
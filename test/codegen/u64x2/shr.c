@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u64x2_t
+test(wav_u64x2_t a, int count) {
+  return wav_u64x2_shr(a, count);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u64x2_t
+test(uint64_t value) {
+  return wav_u64x2_splat(value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(uint64_t * dest, wav_u64x2_t v) {
+  wav_u64x2_store_lane(dest, v, 1);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(uint64_t dest[2], wav_u64x2_t src) {
+  wav_u64x2_storea(dest, src);
+}
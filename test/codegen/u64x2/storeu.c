@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(void *dest, wav_u64x2_t src) {
+  wav_u64x2_storeu(dest, src);
+}
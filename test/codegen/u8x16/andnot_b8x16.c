@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u8x16_t
+test(wav_u8x16_t a, wav_b8x16_t b) {
+  return wav_u8x16_andnot_b8x16(a, b);
+}
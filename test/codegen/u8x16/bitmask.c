@@ -0,0 +1,6 @@
+#include "wav.h"
+
+unsigned int
+test(wav_u8x16_t a) {
+  return wav_u8x16_bitmask(a);
+}
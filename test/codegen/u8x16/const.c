@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u8x16_t
+test(void) {
+  return wav_u8x16_const(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+}
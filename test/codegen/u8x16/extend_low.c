@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u16x8_t
+test(wav_u8x16_t vec) {
+  return wav_u8x16_extend_low(vec);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+uint8_t
+test(wav_u8x16_t v) {
+  return wav_u8x16_extract_lane(v, 1);
+}
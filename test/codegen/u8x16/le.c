@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_b8x16_t
+test(wav_u8x16_t lhs, wav_u8x16_t rhs) {
+  return wav_u8x16_le(lhs, rhs);
+}
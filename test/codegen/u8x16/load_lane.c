@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u8x16_t
+test(wav_u8x16_t v, const uint8_t * src) {
+  return wav_u8x16_load_lane(v, 1, src);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u8x16_t
+test(const void * src, size_t n) {
+  return wav_u8x16_load_partial(src, n);
+}
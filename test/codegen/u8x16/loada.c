@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u8x16_t
+test(const uint8_t src[16]) {
+  return wav_u8x16_loada(src);
+}
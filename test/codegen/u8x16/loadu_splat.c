@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u8x16_t
+test(const void *a) {
+  return wav_u8x16_loadu_splat(a);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u8x16_t
+test(wav_u8x16_t a) {
+  return wav_u8x16_popcnt(a);
+}
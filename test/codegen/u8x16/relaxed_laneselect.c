@@ -0,0 +1,7 @@
+#include "wav.h"
+
+__attribute__((__target__("relaxed-simd")))
+wav_u8x16_t
+test(wav_b8x16_t control, wav_u8x16_t when_set, wav_u8x16_t when_unset) {
+  return wav_u8x16_relaxed_laneselect(control, when_set, when_unset);
+}
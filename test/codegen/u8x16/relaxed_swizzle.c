@@ -0,0 +1,7 @@
+#include "wav.h"
+
+__attribute__((__target__("relaxed-simd")))
+wav_u8x16_t
+test(wav_u8x16_t data, wav_u8x16_t idx) {
+  return wav_u8x16_relaxed_swizzle(data, idx);
+}
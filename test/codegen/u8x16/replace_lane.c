@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u8x16_t
+test(wav_u8x16_t v, uint8_t value) {
+  return wav_u8x16_replace_lane(v, 1, value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+wav_u8x16_t
+test(uint8_t value) {
+  return wav_u8x16_splat(value);
+}
@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(uint8_t * dest, wav_u8x16_t v) {
+  wav_u8x16_store_lane(dest, v, 1);
+}
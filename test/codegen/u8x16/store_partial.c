@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(void * dest, wav_u8x16_t src, size_t n) {
+  wav_u8x16_store_partial(dest, src, n);
+}
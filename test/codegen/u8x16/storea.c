@@ -0,0 +1,6 @@
+#include "wav.h"
+
+void
+test(uint8_t dest[16], wav_u8x16_t src) {
+  wav_u8x16_storea(dest, src);
+}
@@ -0,0 +1,133 @@
+/* Dispatch test
+ *
+ * A kernel file for wav_dispatch.h.  Every version of each kernel the
+ * CPU can run is called directly and compared against scalar code, so
+ * both the SSSE3/SSE4.1 code wav.h compiles for dispatch and the
+ * fallbacks get tested.  The tests build it with only SSE2 enabled,
+ * and again with SSSE3 and SSE4.1. */
+
+#define WAV_EMULATION 1
+#define WAV_DISPATCH_INCLUDE "dispatch.c"
+#include "wav_dispatch.h"
+
+/* wav_f32x4_ceil (ROUNDPS with SSE4.1) */
+static void
+WAV_DISPATCH_NAME(test_ceil)(float * buf, size_t len) {
+  for (size_t i = 0 ; i + 4 <= len ; i += 4)
+    wav_f32x4_storeu(&buf[i], wav_f32x4_ceil(wav_f32x4_loadu(&buf[i])));
+}
+
+/* wav_i8x16_popcnt (PSHUFB with SSSE3) */
+static void
+WAV_DISPATCH_NAME(test_popcnt)(uint8_t * buf, size_t len) {
+  for (size_t i = 0 ; i + 16 <= len ; i += 16)
+    wav_u8x16_storeu(&buf[i], wav_u8x16_popcnt(wav_u8x16_loadu(&buf[i])));
+}
+
+/* wav_u8x16_swizzle (PSHUFB with SSSE3), including indices >= 16 */
+static void
+WAV_DISPATCH_NAME(test_swizzle)(uint8_t * buf, size_t len, const uint8_t table[16]) {
+  const wav_u8x16_t t = wav_u8x16_loadu(table);
+  for (size_t i = 0 ; i + 16 <= len ; i += 16)
+    wav_u8x16_storeu(&buf[i], wav_u8x16_swizzle(t, wav_u8x16_loadu(&buf[i])));
+}
+
+/* wav_i64x2_all_true (PCMPEQQ with SSE4.1) */
+static size_t
+WAV_DISPATCH_NAME(test_all_true)(const int64_t * buf, size_t len) {
+  size_t r = 0;
+  for (size_t i = 0 ; i + 2 <= len ; i += 2)
+    r += wav_i64x2_all_true(wav_i64x2_loadu(&buf[i]));
+  return r;
+}
+
+#if WAV_DISPATCH_ONCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+WAV_DISPATCH_EXPORT(void, test_ceil, (float * buf, size_t len))
+WAV_DISPATCH_EXPORT(void, test_popcnt, (uint8_t * buf, size_t len))
+WAV_DISPATCH_EXPORT(void, test_swizzle, (uint8_t * buf, size_t len, const uint8_t table[16]))
+WAV_DISPATCH_EXPORT(size_t, test_all_true, (const int64_t * buf, size_t len))
+
+#define TEST_LEN 256
+
+static int failures = 0;
+
+static void
+check(int ok, const char * version, const char * kernel, size_t i) {
+  if (!ok) {
+    fprintf(stderr, "%s/%s: wrong result at %zu\n", version, kernel, i);
+    failures++;
+  }
+}
+
+static void
+test_version(
+    const char * version,
+    void (*ceil_fn)(float *, size_t),
+    void (*popcnt_fn)(uint8_t *, size_t),
+    void (*swizzle_fn)(uint8_t *, size_t, const uint8_t[16]),
+    size_t (*all_true_fn)(const int64_t *, size_t)) {
+  float f[TEST_LEN];
+  uint8_t u[TEST_LEN];
+  int64_t l[TEST_LEN];
+  uint8_t table[16];
+  size_t expected_all_true = 0;
+
+  for (size_t i = 0 ; i < TEST_LEN ; i++) {
+    f[i] = ((float) i - (TEST_LEN / 2)) * 0.37f;
+    u[i] = (uint8_t) (i * 37);
+    l[i] = (i % 3 == 0) ? 0 : (int64_t) i;
+  }
+  for (size_t i = 0 ; i < 16 ; i++)
+    table[i] = (uint8_t) (200 - i);
+  for (size_t i = 0 ; i < TEST_LEN ; i += 2)
+    expected_all_true += (l[i] != 0 && l[i + 1] != 0);
+
+  ceil_fn(f, TEST_LEN);
+  for (size_t i = 0 ; i < TEST_LEN ; i++)
+    check(f[i] == ceilf(((float) i - (TEST_LEN / 2)) * 0.37f), version, "ceil", i);
+
+  popcnt_fn(u, TEST_LEN);
+  for (size_t i = 0 ; i < TEST_LEN ; i++)
+    check(u[i] == __builtin_popcount((uint8_t) (i * 37)), version, "popcnt", i);
+
+  for (size_t i = 0 ; i < TEST_LEN ; i++)
+    u[i] = (uint8_t) i;
+  swizzle_fn(u, TEST_LEN, table);
+  for (size_t i = 0 ; i < TEST_LEN ; i++)
+    check(u[i] == ((i < 16) ? table[i] : 0), version, "swizzle", i);
+
+  check(all_true_fn(l, TEST_LEN) == expected_all_true, version, "all_true", 0);
+}
+
+#define TEST_VERSION(suffix) \
+  test_version(#suffix, test_ceil_##suffix, test_popcnt_##suffix, test_swizzle_##suffix, test_all_true_##suffix)
+
+int
+main(void) {
+  TEST_VERSION(baseline);
+
+  #if WAV_DISPATCH_ENABLED
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.1"))
+      TEST_VERSION(sse4_1);
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") &&
+        __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("popcnt")) {
+      TEST_VERSION(avx2);
+      if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+          __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl"))
+        TEST_VERSION(avx512);
+    }
+  #endif
+
+  /* Whichever version the dispatcher picks. */
+  test_version("dispatched",
+    WAV_DISPATCH(test_ceil), WAV_DISPATCH(test_popcnt),
+    WAV_DISPATCH(test_swizzle), WAV_DISPATCH(test_all_true));
+
+  return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+#endif
@@ -0,0 +1,169 @@
+/* wav_array.h kernels compared with scalar loops, for every length up
+ * to four vectors plus one, with dest and the inputs at every offset
+ * (in whole elements) from 16-byte alignment.
+ *
+ * That covers the partial head vector, the main loop, the single
+ * vectors after it and the partial tail, each on their own and in
+ * combination.  Every kernel is run both into a separate dest and in
+ * place (dest == a), and the bytes around dest must be left alone.
+ * One unary and one binary operation is tested per type; they all
+ * come from the same two macros in wav_array.h. */
+
+#include "test.h"
+#include "wav_array.h"
+
+#include <math.h>
+#include <stdalign.h>
+
+#define MAX_LEN ((16 * 4) + 1)
+#define MAX_BYTES ((16 * 4) + 8)
+
+/* dest goes 16 bytes plus the offset into dest_buf; the rest of the
+ * buffer is random bytes which must not change. */
+static alignas(16) uint8_t dest_buf[16 + 16 + MAX_BYTES + 16];
+static uint8_t guard[sizeof(dest_buf)];
+static alignas(16) uint8_t a_buf[16 + MAX_BYTES];
+static alignas(16) uint8_t b_buf[16 + MAX_BYTES];
+
+static void *
+reset_dest(size_t offset) {
+  wav_test_fill(guard, sizeof(guard));
+  memcpy(dest_buf, guard, sizeof(dest_buf));
+  return dest_buf + 16 + offset;
+}
+
+static void
+check_dest(const char * name, const char * how, const void * expected, size_t len, size_t bytes, size_t offset) {
+  const uint8_t * e = (const uint8_t *) expected;
+
+  for (size_t i = 0 ; i < sizeof(dest_buf) ; i++) {
+    const int inside = (i >= 16 + offset) && (i < 16 + offset + bytes);
+    const uint8_t x = inside ? e[i - 16 - offset] : guard[i];
+    wav_test_check(dest_buf[i] == x,
+      "%s%s: %zu elements, dest at offset %zu: byte %zu is 0x%02x, expected 0x%02x",
+      name, how, len, offset, i, dest_buf[i], x);
+  }
+}
+
+/* random is an expression producing one input element; expr is the
+ * scalar operation in terms of a[i]. */
+#define TEST_UNARY(Type, Element, op, random, expr) \
+  static void \
+  test_##Type##_##op(void) { \
+    const size_t lanes = 16 / sizeof(Element); \
+    Element a[MAX_LEN]; \
+    Element expected[MAX_LEN]; \
+    for (size_t len = 0 ; len <= (lanes * 4) + 1 ; len++) { \
+      const size_t bytes = len * sizeof(Element); \
+      for (size_t offset = 0 ; offset < 16 ; offset += sizeof(Element)) { \
+        const size_t a_offset = ((offset * 3) + 8) % 16; \
+        Element * dest; \
+        for (size_t i = 0 ; i < len ; i++) \
+          a[i] = (random); \
+        for (size_t i = 0 ; i < len ; i++) \
+          expected[i] = (expr); \
+        memcpy(a_buf + a_offset, a, bytes); \
+        \
+        dest = (Element *) reset_dest(offset); \
+        wav_##Type##_array_##op(dest, (const Element *) (a_buf + a_offset), len); \
+        check_dest(#Type "_array_" #op, "", expected, len, bytes, offset); \
+        \
+        dest = (Element *) reset_dest(offset); \
+        memcpy(dest, a, bytes); \
+        wav_##Type##_array_##op(dest, dest, len); \
+        check_dest(#Type "_array_" #op, " (in place)", expected, len, bytes, offset); \
+      } \
+    } \
+  }
+
+#define TEST_BINARY(Type, Element, op, random, expr) \
+  static void \
+  test_##Type##_##op(void) { \
+    const size_t lanes = 16 / sizeof(Element); \
+    Element a[MAX_LEN]; \
+    Element b[MAX_LEN]; \
+    Element expected[MAX_LEN]; \
+    for (size_t len = 0 ; len <= (lanes * 4) + 1 ; len++) { \
+      const size_t bytes = len * sizeof(Element); \
+      for (size_t offset = 0 ; offset < 16 ; offset += sizeof(Element)) { \
+        const size_t a_offset = ((offset * 3) + 8) % 16; \
+        const size_t b_offset = (offset * 5) % 16; \
+        Element * dest; \
+        for (size_t i = 0 ; i < len ; i++) { \
+          a[i] = (random); \
+          b[i] = (random); \
+        } \
+        for (size_t i = 0 ; i < len ; i++) \
+          expected[i] = (expr); \
+        memcpy(a_buf + a_offset, a, bytes); \
+        memcpy(b_buf + b_offset, b, bytes); \
+        \
+        dest = (Element *) reset_dest(offset); \
+        wav_##Type##_array_##op(dest, (const Element *) (a_buf + a_offset), (const Element *) (b_buf + b_offset), len); \
+        check_dest(#Type "_array_" #op, "", expected, len, bytes, offset); \
+        \
+        dest = (Element *) reset_dest(offset); \
+        memcpy(dest, a, bytes); \
+        wav_##Type##_array_##op(dest, dest, (const Element *) (b_buf + b_offset), len); \
+        check_dest(#Type "_array_" #op, " (in place)", expected, len, bytes, offset); \
+      } \
+    } \
+  }
+
+/* Small multiples of 1/8, so nothing rounds and there are no NaNs;
+ * the halves exercise round-to-even in nearest. */
+#define RANDOM_F32 ((float) ((int) (wav_test_rand() % 2001) - 1000) / 8.0f)
+#define RANDOM_F64 ((double) ((int) (wav_test_rand() % 2001) - 1000) / 8.0)
+#define RANDOM_B32 ((uint32_t) 0 - (uint32_t) (wav_test_rand() & 1))
+
+TEST_UNARY (i8x16,   int8_t, abs, (int8_t) wav_test_rand(), (int8_t) ((a[i] < 0) ? (0u - (uint8_t) a[i]) : (uint8_t) a[i]))
+TEST_BINARY(i8x16,   int8_t, add_sat, (int8_t) wav_test_rand(),
+  (int8_t) (((a[i] + b[i]) > INT8_MAX) ? INT8_MAX : (((a[i] + b[i]) < INT8_MIN) ? INT8_MIN : (a[i] + b[i]))))
+TEST_UNARY (i16x8,  int16_t, neg, (int16_t) wav_test_rand(), (int16_t) (0u - (uint16_t) a[i]))
+TEST_BINARY(i16x8,  int16_t, mul, (int16_t) wav_test_rand(), (int16_t) ((uint32_t) a[i] * (uint32_t) b[i]))
+TEST_UNARY (i32x4,  int32_t, abs, (int32_t) wav_test_rand(), (int32_t) ((a[i] < 0) ? (0u - (uint32_t) a[i]) : (uint32_t) a[i]))
+TEST_BINARY(i32x4,  int32_t, min, (int32_t) wav_test_rand(), (a[i] < b[i]) ? a[i] : b[i])
+TEST_UNARY (i64x2,  int64_t, neg, (int64_t) wav_test_rand(), (int64_t) (0u - (uint64_t) a[i]))
+TEST_BINARY(i64x2,  int64_t, mul, (int64_t) wav_test_rand(), (int64_t) ((uint64_t) a[i] * (uint64_t) b[i]))
+TEST_UNARY (u8x16,  uint8_t, popcnt, (uint8_t) wav_test_rand(), (uint8_t) __builtin_popcount(a[i]))
+TEST_BINARY(u8x16,  uint8_t, avgr, (uint8_t) wav_test_rand(), (uint8_t) ((a[i] + b[i] + 1) >> 1))
+TEST_UNARY (u16x8, uint16_t, not, (uint16_t) wav_test_rand(), (uint16_t) ~a[i])
+TEST_BINARY(u16x8, uint16_t, sub_sat, (uint16_t) wav_test_rand(), (uint16_t) ((a[i] > b[i]) ? (a[i] - b[i]) : 0))
+TEST_UNARY (u32x4, uint32_t, not, (uint32_t) wav_test_rand(), ~a[i])
+TEST_BINARY(u32x4, uint32_t, max, (uint32_t) wav_test_rand(), (a[i] > b[i]) ? a[i] : b[i])
+TEST_UNARY (u64x2, uint64_t, not, wav_test_rand(), ~a[i])
+TEST_BINARY(u64x2, uint64_t, andnot, wav_test_rand(), a[i] & ~b[i])
+TEST_UNARY (f32x4,    float, nearest, RANDOM_F32, nearbyintf(a[i]))
+TEST_BINARY(f32x4,    float, add, RANDOM_F32, a[i] + b[i])
+TEST_UNARY (f64x2,   double, floor, RANDOM_F64, floor(a[i]))
+TEST_BINARY(f64x2,   double, sub, RANDOM_F64, a[i] - b[i])
+TEST_UNARY (b32x4, uint32_t, not, RANDOM_B32, ~a[i])
+TEST_BINARY(b32x4, uint32_t, xor, RANDOM_B32, a[i] ^ b[i])
+
+int
+main(void) {
+  test_i8x16_abs();
+  test_i8x16_add_sat();
+  test_i16x8_neg();
+  test_i16x8_mul();
+  test_i32x4_abs();
+  test_i32x4_min();
+  test_i64x2_neg();
+  test_i64x2_mul();
+  test_u8x16_popcnt();
+  test_u8x16_avgr();
+  test_u16x8_not();
+  test_u16x8_sub_sat();
+  test_u32x4_not();
+  test_u32x4_max();
+  test_u64x2_not();
+  test_u64x2_andnot();
+  test_f32x4_nearest();
+  test_f32x4_add();
+  test_f64x2_floor();
+  test_f64x2_sub();
+  test_b32x4_not();
+  test_b32x4_xor();
+
+  return wav_test_result();
+}
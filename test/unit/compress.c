@@ -0,0 +1,251 @@
+/* wav_compress.h compared with scalar code.
+ *
+ * compress is tried with every mask (all 65536 for 8-bit lanes) on
+ * random vectors, and so is expand, except that for 8-bit lanes it
+ * gets a sample of the masks: every one with a single bit set or clear,
+ * every 8-bit pattern in each half, and some random ones.  Every filter predicate for every type is run on
+ * every length up to four vectors plus one, and a longer array, both
+ * into a separate dest and in place.  The inputs are drawn from a few
+ * interesting values (zero, the extremes, the sign bit for the 64-bit
+ * comparisons which are built from ge, and NaN and -0.0 for floats) so
+ * that every predicate keeps some elements and drops others.  dest
+ * must hold the kept elements, in order, and nothing past len may be
+ * written. */
+
+#include "test.h"
+#include "wav_compress.h"
+
+#include <math.h>
+
+#define MAX_LEN 1000
+
+/* Lanes of a boolean vector from the low bits of mask. */
+#define MASK(Bool, Unsigned, mask, lanes) \
+  wav_##Bool##_t m; \
+  do { \
+    Unsigned m_lanes_[16]; \
+    for (size_t i = 0 ; i < (lanes) ; i++) \
+      m_lanes_[i] = (Unsigned) (((mask) >> i) & 1 ? ~((Unsigned) 0) : 0); \
+    memcpy(&m, m_lanes_, sizeof(m)); \
+  } while (0)
+
+#define TEST_COMPRESS(Type, Element, Bool, Unsigned) \
+  static void \
+  test_##Type##_compress(void) { \
+    const size_t lanes = 16 / sizeof(Element); \
+    for (unsigned int mask = 0 ; mask < (1U << lanes) ; mask++) { \
+      wav_##Type##_t v, r; \
+      Element in[16]; \
+      Element expected[16] = { 0 }; \
+      size_t n = 0, count = 0; \
+      MASK(Bool, Unsigned, mask, lanes); \
+      wav_test_fill(in, sizeof(in)); \
+      memcpy(&v, in, sizeof(v)); \
+      for (size_t i = 0 ; i < lanes ; i++) { \
+        if ((mask >> i) & 1) \
+          expected[n++] = in[i]; \
+      } \
+      r = wav_##Type##_compress(v, m, &count); \
+      wav_test_check(count == n && memcmp(&r, expected, sizeof(r)) == 0, \
+        "%s_compress: wrong result for mask 0x%x", #Type, mask); \
+    } \
+  }
+
+TEST_COMPRESS(i8x16,   int8_t,  b8x16,  uint8_t)
+TEST_COMPRESS(u8x16,  uint8_t,  b8x16,  uint8_t)
+TEST_COMPRESS(i16x8,  int16_t,  b16x8, uint16_t)
+TEST_COMPRESS(u16x8, uint16_t,  b16x8, uint16_t)
+TEST_COMPRESS(i32x4,  int32_t,  b32x4, uint32_t)
+TEST_COMPRESS(u32x4, uint32_t,  b32x4, uint32_t)
+TEST_COMPRESS(f32x4,    float,  b32x4, uint32_t)
+TEST_COMPRESS(i64x2,  int64_t,  b64x2, uint64_t)
+TEST_COMPRESS(u64x2, uint64_t,  b64x2, uint64_t)
+TEST_COMPRESS(f64x2,   double,  b64x2, uint64_t)
+
+/* The scalar expand: the next lane of dense goes to each lane which is
+ * set in mask. */
+#define TEST_EXPAND_MASK_(Type, Element, Bool, Unsigned, mask) \
+  do { \
+    const size_t lanes = 16 / sizeof(Element); \
+    wav_##Type##_t dense, r; \
+    Element in[16]; \
+    Element expected[16] = { 0 }; \
+    size_t n = 0; \
+    MASK(Bool, Unsigned, mask, lanes); \
+    wav_test_fill(in, sizeof(in)); \
+    memcpy(&dense, in, sizeof(dense)); \
+    for (size_t i = 0 ; i < lanes ; i++) { \
+      if (((mask) >> i) & 1) \
+        expected[i] = in[n++]; \
+    } \
+    r = wav_##Type##_expand(dense, m); \
+    wav_test_check(memcmp(&r, expected, sizeof(r)) == 0, \
+      "%s_expand: wrong result for mask 0x%x", #Type, (unsigned int) (mask)); \
+  } while (0)
+
+#define TEST_EXPAND(Type, Element, Bool, Unsigned) \
+  static void \
+  test_##Type##_expand(void) { \
+    for (unsigned int mask = 0 ; mask < (1U << (16 / sizeof(Element))) ; mask++) \
+      TEST_EXPAND_MASK_(Type, Element, Bool, Unsigned, mask); \
+  }
+
+#define TEST_EXPAND_SAMPLED(Type, Element, Bool, Unsigned) \
+  static void \
+  test_##Type##_expand(void) { \
+    for (unsigned int bit = 0 ; bit < 16 ; bit++) { \
+      TEST_EXPAND_MASK_(Type, Element, Bool, Unsigned, 1U << bit); \
+      TEST_EXPAND_MASK_(Type, Element, Bool, Unsigned, 0xffffU & ~(1U << bit)); \
+    } \
+    for (unsigned int half = 0 ; half < 256 ; half++) { \
+      TEST_EXPAND_MASK_(Type, Element, Bool, Unsigned, half); \
+      TEST_EXPAND_MASK_(Type, Element, Bool, Unsigned, half << 8); \
+      TEST_EXPAND_MASK_(Type, Element, Bool, Unsigned, half | 0xff00U); \
+      TEST_EXPAND_MASK_(Type, Element, Bool, Unsigned, (half << 8) | 0xffU); \
+    } \
+    for (int k = 0 ; k < 4096 ; k++) { \
+      const unsigned int mask = (unsigned int) (wav_test_rand() & 0xffff); \
+      TEST_EXPAND_MASK_(Type, Element, Bool, Unsigned, mask); \
+    } \
+  }
+
+TEST_EXPAND_SAMPLED(i8x16,   int8_t,  b8x16,  uint8_t)
+TEST_EXPAND_SAMPLED(u8x16,  uint8_t,  b8x16,  uint8_t)
+TEST_EXPAND(i16x8,  int16_t,  b16x8, uint16_t)
+TEST_EXPAND(u16x8, uint16_t,  b16x8, uint16_t)
+TEST_EXPAND(i32x4,  int32_t,  b32x4, uint32_t)
+TEST_EXPAND(u32x4, uint32_t,  b32x4, uint32_t)
+TEST_EXPAND(f32x4,    float,  b32x4, uint32_t)
+TEST_EXPAND(i64x2,  int64_t,  b64x2, uint64_t)
+TEST_EXPAND(u64x2, uint64_t,  b64x2, uint64_t)
+TEST_EXPAND(f64x2,   double,  b64x2, uint64_t)
+
+static const uint8_t values_u8[] = { 0, 1, 2, 0x7f, 0x80, 0x81, 0xfe, 0xff };
+static const uint16_t values_u16[] = { 0, 1, 2, 0x7fff, 0x8000, 0x8001, 0xfffe, 0xffff };
+static const uint32_t values_u32[] = { 0, 1, 2, 0x7fffffff, 0x80000000, 0x80000001, 0xfffffffe, 0xffffffff };
+static const uint64_t values_u64[] = {
+  0, 1, 2, UINT64_C(0x7fffffffffffffff), UINT64_C(0x8000000000000000),
+  UINT64_C(0x8000000000000001), UINT64_C(0xfffffffffffffffe), UINT64_C(0xffffffffffffffff) };
+static float values_f32[8];
+
+/* Every length up to four vectors plus one, then MAX_LEN - 1 and
+ * MAX_LEN. */
+static size_t
+next_length(size_t len, size_t lanes) {
+  if (len < (lanes * 4) + 1)
+    return len + 1;
+  return (len < MAX_LEN - 1) ? MAX_LEN - 1 : len + 1;
+}
+
+#define SCALAR_eq(a, b) ((a) == (b))
+#define SCALAR_ne(a, b) ((a) != (b))
+#define SCALAR_lt(a, b) ((a) <  (b))
+#define SCALAR_le(a, b) ((a) <= (b))
+#define SCALAR_gt(a, b) ((a) >  (b))
+#define SCALAR_ge(a, b) ((a) >= (b))
+
+/* dest_buf has guard elements on both sides of dest, which start out
+ * random and must not change. */
+#define TEST_FILTER(Type, Element, Predicate, values) \
+  static void \
+  test_##Type##_filter_##Predicate(void) { \
+    const size_t lanes = 16 / sizeof(Element); \
+    static Element src[MAX_LEN]; \
+    static Element expected[MAX_LEN]; \
+    static Element dest_buf[MAX_LEN + 32]; \
+    static Element guard[MAX_LEN + 32]; \
+    Element * dest = dest_buf + 16; \
+    for (size_t len = 0 ; len <= MAX_LEN ; len = next_length(len, lanes)) { \
+      for (size_t k = 0 ; k < 8 ; k++) { \
+        const Element value = values[k]; \
+        size_t n = 0; \
+        for (size_t i = 0 ; i < len ; i++) { \
+          src[i] = values[wav_test_rand() % 8]; \
+          if (SCALAR_##Predicate(src[i], value)) \
+            expected[n++] = src[i]; \
+        } \
+        for (int in_place = 0 ; in_place < 2 ; in_place++) { \
+          size_t count; \
+          wav_test_fill(guard, sizeof(guard)); \
+          memcpy(dest_buf, guard, sizeof(dest_buf)); \
+          if (in_place) { \
+            memcpy(dest, src, len * sizeof(Element)); \
+            count = wav_##Type##_filter_##Predicate(dest, dest, len, value); \
+          } else { \
+            count = wav_##Type##_filter_##Predicate(dest, src, len, value); \
+          } \
+          wav_test_check(count == n && memcmp(dest, expected, n * sizeof(Element)) == 0, \
+            "%s_filter_%s%s: wrong result for %zu elements, value #%zu", \
+            #Type, #Predicate, in_place ? " (in place)" : "", len, k); \
+          wav_test_check(memcmp(dest_buf, guard, 16 * sizeof(Element)) == 0 && \
+                         memcmp(dest + len, guard + 16 + len, 16 * sizeof(Element)) == 0, \
+            "%s_filter_%s%s: wrote outside of dest for %zu elements, value #%zu", \
+            #Type, #Predicate, in_place ? " (in place)" : "", len, k); \
+        } \
+      } \
+    } \
+  }
+
+#define TEST_FILTERS(Type, Element, values) \
+  TEST_FILTER(Type, Element, eq, values) \
+  TEST_FILTER(Type, Element, ne, values) \
+  TEST_FILTER(Type, Element, lt, values) \
+  TEST_FILTER(Type, Element, le, values) \
+  TEST_FILTER(Type, Element, gt, values) \
+  TEST_FILTER(Type, Element, ge, values)
+
+TEST_FILTERS(u8x16,  uint8_t,  values_u8)
+TEST_FILTERS(u16x8, uint16_t, values_u16)
+TEST_FILTERS(u32x4, uint32_t, values_u32)
+TEST_FILTERS(u64x2, uint64_t, values_u64)
+TEST_FILTERS(f32x4,    float, values_f32)
+
+#define RUN_FILTERS(Type) \
+  test_##Type##_filter_eq(); \
+  test_##Type##_filter_ne(); \
+  test_##Type##_filter_lt(); \
+  test_##Type##_filter_le(); \
+  test_##Type##_filter_gt(); \
+  test_##Type##_filter_ge()
+
+int
+main(void) {
+  values_f32[0] = -INFINITY;
+  values_f32[1] = -2.5f;
+  values_f32[2] = -0.0f;
+  values_f32[3] = 0.0f;
+  values_f32[4] = 1.0f;
+  values_f32[5] = 3.5f;
+  values_f32[6] = INFINITY;
+  values_f32[7] = NAN;
+
+  test_i8x16_compress();
+  test_u8x16_compress();
+  test_i16x8_compress();
+  test_u16x8_compress();
+  test_i32x4_compress();
+  test_u32x4_compress();
+  test_f32x4_compress();
+  test_i64x2_compress();
+  test_u64x2_compress();
+  test_f64x2_compress();
+
+  test_i8x16_expand();
+  test_u8x16_expand();
+  test_i16x8_expand();
+  test_u16x8_expand();
+  test_i32x4_expand();
+  test_u32x4_expand();
+  test_f32x4_expand();
+  test_i64x2_expand();
+  test_u64x2_expand();
+  test_f64x2_expand();
+
+  RUN_FILTERS(u8x16);
+  RUN_FILTERS(u16x8);
+  RUN_FILTERS(u32x4);
+  RUN_FILTERS(u64x2);
+  RUN_FILTERS(f32x4);
+
+  return wav_test_result();
+}
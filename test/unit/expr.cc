@@ -0,0 +1,178 @@
+/* wav_expr.h expressions evaluated with wav::eval compared with the
+ * same expressions on scalars.
+ *
+ * Every expression is evaluated for each length from 0 to three
+ * vectors plus one (so the two-vector loop, the single vector after
+ * it and the partial tail all run), into a separate dest and in place
+ * over the first array.  Nothing after the last element of dest may
+ * change.  The expressions cover each operator, the fused a * b + c
+ * forms, and vector leaves mixed with array leaves.
+ *
+ * Float inputs are small multiples of 1/8, so nothing rounds and a
+ * fused multiply-add gives the same result as a separate one. */
+
+#include "test.h"
+#include "wav_expr.h"
+
+#include <type_traits>
+
+#define MAX_LEN ((16 * 3) + 1)
+
+template <typename Element>
+static typename std::enable_if<std::is_integral<Element>::value, Element>::type
+random_element() {
+  return static_cast<Element>(wav_test_rand());
+}
+
+template <typename Element>
+static typename std::enable_if<std::is_floating_point<Element>::value, Element>::type
+random_element() {
+  return static_cast<Element>(static_cast<int>(wav_test_rand() % 2001) - 1000) / 8;
+}
+
+/* build(a, b, c, d) returns the expression over the four arrays;
+ * scalar(a, b, c, d) computes one element of it. */
+template <typename Element, typename Build, typename Scalar>
+static void
+test_expr(const char * name, Build build, Scalar scalar) {
+  const size_t lanes = 16 / sizeof(Element);
+  Element a[MAX_LEN], b[MAX_LEN], c[MAX_LEN], d[MAX_LEN];
+  Element expected[MAX_LEN];
+  /* dest starts one vector in, after random guard elements. */
+  Element dest_buf[MAX_LEN + 32];
+  Element guard[MAX_LEN + 32];
+  Element * dest = dest_buf + lanes;
+
+  for (size_t len = 0 ; len <= (lanes * 3) + 1 ; len++) {
+    for (size_t i = 0 ; i < len ; i++) {
+      a[i] = random_element<Element>();
+      b[i] = random_element<Element>();
+      c[i] = random_element<Element>();
+      d[i] = random_element<Element>();
+      expected[i] = scalar(a[i], b[i], c[i], d[i]);
+    }
+
+    for (int in_place = 0 ; in_place < 2 ; in_place++) {
+      wav_test_fill(guard, sizeof(guard));
+      memcpy(dest_buf, guard, sizeof(dest_buf));
+      if (in_place) {
+        memcpy(dest, a, len * sizeof(Element));
+        wav::eval(dest, build(dest, b, c, d), len);
+      } else {
+        wav::eval(dest, build(a, b, c, d), len);
+      }
+
+      for (size_t i = 0 ; i < sizeof(dest_buf) / sizeof(Element) ; i++) {
+        const int inside = (i >= lanes) && (i < lanes + len);
+        const Element * x = inside ? &(expected[i - lanes]) : &(guard[i]);
+        wav_test_check(memcmp(&(dest_buf[i]), x, sizeof(Element)) == 0,
+          "%s%s: %zu elements: element %zd is wrong",
+          name, in_place ? " (in place)" : "", len, (ptrdiff_t) i - (ptrdiff_t) lanes);
+      }
+    }
+  }
+}
+
+/* Expressions of vectors only, which wav::eval returns directly;
+ * compared with the eager operators. */
+template <typename Vector>
+static void
+test_eval_vector(const char * name) {
+  for (int k = 0 ; k < 100 ; k++) {
+    Vector x, y, z, r, expected;
+    wav_test_fill(&x, sizeof(x));
+    wav_test_fill(&y, sizeof(y));
+    wav_test_fill(&z, sizeof(z));
+
+    r = wav::eval(wav::lazy(x) * y + z);
+    expected = wav_add(wav_mul(x, y), z);
+    wav_test_check(memcmp(&r, &expected, sizeof(r)) == 0, "%s: x * y + z is wrong", name);
+
+    r = wav::eval(wav::max(wav::lazy(x) - y, z) * x);
+    expected = wav_mul(wav_max(wav_sub(x, y), z), x);
+    wav_test_check(memcmp(&r, &expected, sizeof(r)) == 0, "%s: max(x - y, z) * x is wrong", name);
+  }
+}
+
+#define ARRAYS(Element) const Element * a, const Element * b, const Element * c, const Element * d
+#define SCALARS(Element) Element a, Element b, Element c, Element d
+
+template <typename Element>
+static Element
+scalar_min(Element a, Element b) {
+  return (b < a) ? b : a;
+}
+
+template <typename Element>
+static Element
+scalar_max(Element a, Element b) {
+  return (b > a) ? b : a;
+}
+
+template <typename Element, typename Vector>
+static void
+test_float(const char * type) {
+  const Vector k = wav_splat(static_cast<Element>(8));
+  char name[64];
+
+  #define TEST_FLOAT(description, expression, scalar) \
+    snprintf(name, sizeof(name), "%s: %s", type, description); \
+    test_expr<Element>(name, \
+      [k](ARRAYS(Element)) { (void) k; (void) d; return expression; }, \
+      [](SCALARS(Element)) { (void) d; return static_cast<Element>(scalar); })
+
+  TEST_FLOAT("a * b + c", wav::array(a) * wav::array(b) + wav::array(c), a * b + c);
+  TEST_FLOAT("c + a * b", wav::array(c) + wav::array(a) * wav::array(b), c + a * b);
+  TEST_FLOAT("a * b + c * d", wav::array(a) * wav::array(b) + wav::array(c) * wav::array(d), a * b + c * d);
+  TEST_FLOAT("a * 8 + c", wav::array(a) * k + wav::array(c), a * 8 + c);
+  TEST_FLOAT("8 * a - b", wav::lazy(k) * wav::array(a) - wav::array(b), 8 * a - b);
+  TEST_FLOAT("-(a - b) / 8", -(wav::array(a) - wav::array(b)) / k, -(a - b) / 8);
+  TEST_FLOAT("min(a, b) * c + max(c, d)",
+    wav::min(wav::array(a), wav::array(b)) * wav::array(c) + wav::max(wav::array(c), wav::array(d)),
+    scalar_min(a, b) * c + scalar_max(c, d));
+
+  #undef TEST_FLOAT
+
+  test_eval_vector<Vector>(type);
+}
+
+int
+main(void) {
+  test_float<float, wav_f32x4_t>("f32x4");
+  test_float<double, wav_f64x2_t>("f64x2");
+
+  /* Integer arithmetic wraps, so the scalar versions do it in the
+   * unsigned type. */
+  {
+    const wav_i32x4_t k = wav_i32x4_splat(0x5a5a5a5a);
+    test_expr<int32_t>("i32x4: a * b + c",
+      [](ARRAYS(int32_t)) { (void) d; return wav::array(a) * wav::array(b) + wav::array(c); },
+      [](SCALARS(int32_t)) { (void) d; return static_cast<int32_t>(static_cast<uint32_t>(a) * static_cast<uint32_t>(b) + static_cast<uint32_t>(c)); });
+    test_expr<int32_t>("i32x4: (a & b) | (c ^ k)",
+      [k](ARRAYS(int32_t)) { (void) d; return (wav::array(a) & wav::array(b)) | (wav::array(c) ^ k); },
+      [](SCALARS(int32_t)) { (void) d; return static_cast<int32_t>((a & b) | (c ^ 0x5a5a5a5a)); });
+    test_expr<int32_t>("i32x4: min(a, b) - max(c, d)",
+      [](ARRAYS(int32_t)) { return wav::min(wav::array(a), wav::array(b)) - wav::max(wav::array(c), wav::array(d)); },
+      [](SCALARS(int32_t)) { return static_cast<int32_t>(static_cast<uint32_t>(scalar_min(a, b)) - static_cast<uint32_t>(scalar_max(c, d))); });
+    test_expr<int32_t>("i32x4: -(a + b)",
+      [](ARRAYS(int32_t)) { (void) c; (void) d; return -(wav::array(a) + wav::array(b)); },
+      [](SCALARS(int32_t)) { (void) c; (void) d; return static_cast<int32_t>(0u - (static_cast<uint32_t>(a) + static_cast<uint32_t>(b))); });
+    test_eval_vector<wav_i32x4_t>("i32x4");
+  }
+
+  test_expr<int16_t>("i16x8: a * b + c * d",
+    [](ARRAYS(int16_t)) { return wav::array(a) * wav::array(b) + wav::array(c) * wav::array(d); },
+    [](SCALARS(int16_t)) { return static_cast<int16_t>(static_cast<uint32_t>(a) * static_cast<uint32_t>(b) + static_cast<uint32_t>(c) * static_cast<uint32_t>(d)); });
+
+  {
+    const wav_u8x16_t k = wav_u8x16_splat(0xa5);
+    test_expr<uint8_t>("u8x16: min(a, b) + (c ^ k)",
+      [k](ARRAYS(uint8_t)) { (void) d; return wav::min(wav::array(a), wav::array(b)) + (wav::array(c) ^ k); },
+      [](SCALARS(uint8_t)) { (void) d; return static_cast<uint8_t>(scalar_min(a, b) + (c ^ 0xa5)); });
+    test_expr<uint8_t>("u8x16: max(a - b, c) | d",
+      [](ARRAYS(uint8_t)) { return wav::max(wav::array(a) - wav::array(b), wav::array(c)) | wav::array(d); },
+      [](SCALARS(uint8_t)) { return static_cast<uint8_t>(scalar_max(static_cast<uint8_t>(a - b), c) | d); });
+  }
+
+  return wav_test_result();
+}
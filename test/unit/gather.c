@@ -0,0 +1,152 @@
+/* wav_gather.h compared with scalar loads and stores.
+ *
+ * The 32- and 64-bit gathers and scatters use a base pointer in the
+ * middle of a buffer, with indices on both sides of it: some spread
+ * over the whole buffer, and some from a range of only a few elements,
+ * so scatters often store several lanes to the same index (where the
+ * highest lane must win).  Scatters must not touch anything else in
+ * the buffer.
+ *
+ * The u8 and u16 table gathers are run with every table length which
+ * is a multiple of the lanes up to a few chunks, and with tables of up
+ * to and past 256 (u8) or 65536 (u16) entries, where the entries past
+ * the largest index can't be reached.  Indices include 0, the last
+ * entry, the first index past the end, and the largest value; lanes
+ * whose index is out of range must be 0. */
+
+#include "test.h"
+#include "wav_gather.h"
+
+#define BUFFER_LEN 2048
+
+/* Index from [-range, range) */
+#define RANDOM_INDEX(range) ((int64_t) (wav_test_rand() % (2 * (uint64_t) (range))) - (int64_t) (range))
+
+#define TEST_GATHER(Type, Element, Index, IndexElement) \
+  static void \
+  test_##Type##_gather(void) { \
+    const size_t lanes = 16 / sizeof(Element); \
+    static Element buf[BUFFER_LEN]; \
+    static Element expected_buf[BUFFER_LEN]; \
+    Element * base = buf + (BUFFER_LEN / 2); \
+    for (int k = 0 ; k < 4096 ; k++) { \
+      const int64_t range = (k & 1) ? (BUFFER_LEN / 2) : 3; \
+      IndexElement indices[16]; \
+      Element values[16]; \
+      Element expected[16]; \
+      wav_##Index##_t idx; \
+      wav_##Type##_t v, r; \
+      for (size_t i = 0 ; i < lanes ; i++) \
+        indices[i] = (IndexElement) RANDOM_INDEX(range); \
+      memcpy(&idx, indices, sizeof(idx)); \
+      \
+      wav_test_fill(buf, sizeof(buf)); \
+      for (size_t i = 0 ; i < lanes ; i++) \
+        expected[i] = base[indices[i]]; \
+      r = wav_##Type##_gather(base, idx); \
+      wav_test_check(memcmp(&r, expected, sizeof(r)) == 0, \
+        "%s_gather: wrong result for indices within %d", #Type, (int) range); \
+      \
+      wav_test_fill(values, sizeof(values)); \
+      memcpy(&v, values, sizeof(v)); \
+      memcpy(expected_buf, buf, sizeof(buf)); \
+      for (size_t i = 0 ; i < lanes ; i++) \
+        expected_buf[(BUFFER_LEN / 2) + indices[i]] = values[i]; \
+      wav_##Type##_scatter(base, idx, v); \
+      wav_test_check(memcmp(buf, expected_buf, sizeof(buf)) == 0, \
+        "%s_scatter: wrong result for indices within %d", #Type, (int) range); \
+    } \
+  }
+
+TEST_GATHER(i32x4,  int32_t, i32x4, int32_t)
+TEST_GATHER(u32x4, uint32_t, i32x4, int32_t)
+TEST_GATHER(f32x4,    float, i32x4, int32_t)
+TEST_GATHER(i64x2,  int64_t, i64x2, int64_t)
+TEST_GATHER(u64x2, uint64_t, i64x2, int64_t)
+TEST_GATHER(f64x2,   double, i64x2, int64_t)
+
+/* An index for a table of len entries: often an edge (0, the last
+ * entry, the first one past the end, or the largest value), otherwise
+ * anywhere up to a little past the end, or anywhere at all. */
+static uint64_t
+table_index(size_t len, uint64_t max) {
+  const uint64_t r = wav_test_rand();
+  switch (r % 8) {
+    case 0:
+      return 0;
+    case 1:
+      return (len - 1) & max;
+    case 2:
+      return len & max;
+    case 3:
+      return max;
+    case 4:
+      return (r >> 8) & max;
+    default:
+      return ((r >> 8) % (len + 32)) & max;
+  }
+}
+
+static void
+test_u8x16_table_gather(void) {
+  static uint8_t table[512];
+
+  for (size_t len = 16 ; len <= 512 ; len += (len < 288) ? 16 : 224) {
+    wav_test_fill(table, sizeof(table));
+    for (int k = 0 ; k < 256 ; k++) {
+      uint8_t indices[16];
+      uint8_t expected[16];
+      wav_u8x16_t idx, r;
+      for (size_t i = 0 ; i < 16 ; i++) {
+        indices[i] = (uint8_t) table_index(len, UINT8_MAX);
+        expected[i] = (indices[i] < len) ? table[indices[i]] : 0;
+      }
+      memcpy(&idx, indices, sizeof(idx));
+      r = wav_u8x16_gather(table, len, idx);
+      wav_test_check(memcmp(&r, expected, sizeof(r)) == 0,
+        "u8x16_gather: wrong result for a table of %zu entries", len);
+    }
+  }
+}
+
+static void
+test_u16x8_table_gather(void) {
+  static const size_t long_lens[] = { 256, 264, 4096, 65528, 65536, 65544 };
+  static uint16_t table[65544];
+
+  wav_test_fill(table, sizeof(table));
+  for (size_t l = 0 ; l < 8 + (sizeof(long_lens) / sizeof(long_lens[0])) ; l++) {
+    /* Every multiple of 8 up to 64, then the long ones, which get
+     * fewer lookups since every lookup reads the whole table. */
+    const size_t len = (l < 8) ? (l + 1) * 8 : long_lens[l - 8];
+    const int lookups = (len <= 4096) ? 256 : 16;
+    for (int k = 0 ; k < lookups ; k++) {
+      uint16_t indices[8];
+      uint16_t expected[8];
+      wav_u16x8_t idx, r;
+      for (size_t i = 0 ; i < 8 ; i++) {
+        indices[i] = (uint16_t) table_index(len, UINT16_MAX);
+        expected[i] = (indices[i] < len) ? table[indices[i]] : 0;
+      }
+      memcpy(&idx, indices, sizeof(idx));
+      r = wav_u16x8_gather(table, len, idx);
+      wav_test_check(memcmp(&r, expected, sizeof(r)) == 0,
+        "u16x8_gather: wrong result for a table of %zu entries", len);
+    }
+  }
+}
+
+int
+main(void) {
+  test_i32x4_gather();
+  test_u32x4_gather();
+  test_f32x4_gather();
+  test_i64x2_gather();
+  test_u64x2_gather();
+  test_f64x2_gather();
+
+  test_u8x16_table_gather();
+  test_u16x8_table_gather();
+
+  return wav_test_result();
+}
@@ -0,0 +1,105 @@
+/* wav_histogram_u8 and wav_histogram_u16 compared with the scalar
+ * loop.
+ *
+ * wav_histogram_u16 picks a strategy by the number of bins (compare
+ * and count up to WAV_HISTOGRAM_COMPARE_BINS, four sub-histograms up
+ * to 256, two up to WAV_HISTOGRAM_WIDE_BINS, then counting directly
+ * into hist), so it's tried on either side of each of those
+ * boundaries, and at 4096 and 65536.  The values include ones past
+ * the last bin, which must be skipped (and counted as skipped), and
+ * 65535.  Every length up to a few vectors is tried, so the scalar
+ * tails run, on uniform data and on data where most elements land in
+ * the same bin.  hist must be completely overwritten, and nothing
+ * after its last bin may be touched. */
+
+#include "test.h"
+#include "wav_histogram.h"
+
+#define MAX_LEN 1000
+
+static uint8_t src_u8[MAX_LEN];
+static uint16_t src_u16[MAX_LEN];
+static uint32_t hist[65536 + 16];
+static uint32_t expected[65536 + 16];
+
+/* Every length up to four vectors of u8 plus one, then MAX_LEN. */
+static size_t
+next_length(size_t len) {
+  return (len < (16 * 4) + 1) ? len + 1 : ((len < MAX_LEN) ? MAX_LEN : len + 1);
+}
+
+static void
+test_u8(void) {
+  for (size_t len = 0 ; len <= MAX_LEN ; len = next_length(len)) {
+    for (int skewed = 0 ; skewed < 2 ; skewed++) {
+      for (size_t i = 0 ; i < len ; i++) {
+        const uint64_t r = wav_test_rand();
+        src_u8[i] = (uint8_t) ((skewed && (r & 7) != 0) ? 42 : (r >> 56));
+      }
+
+      memset(expected, 0, 256 * sizeof(uint32_t));
+      for (size_t i = 0 ; i < len ; i++)
+        expected[src_u8[i]]++;
+
+      wav_test_fill(hist, 256 * sizeof(uint32_t));
+      wav_histogram_u8(hist, src_u8, len);
+      wav_test_check(memcmp(hist, expected, 256 * sizeof(uint32_t)) == 0,
+        "histogram_u8: wrong result for %zu elements%s", len, skewed ? " (skewed)" : "");
+    }
+  }
+}
+
+static void
+test_u16(size_t bins) {
+  /* Values go a little past the last bin, so some are skipped. */
+  const size_t range = (bins < 65536 - (bins / 4) - 1) ? bins + (bins / 4) + 1 : 65536;
+
+  for (size_t len = 0 ; len <= MAX_LEN ; len = next_length(len)) {
+    for (int skewed = 0 ; skewed < 2 ; skewed++) {
+      size_t skipped = 0;
+
+      for (size_t i = 0 ; i < len ; i++) {
+        const uint64_t r = wav_test_rand();
+        if (skewed && (r & 7) != 0)
+          src_u16[i] = (uint16_t) (bins - 1);
+        else if ((r & 0xf0) == 0)
+          src_u16[i] = 65535;
+        else
+          src_u16[i] = (uint16_t) ((r >> 32) % range);
+      }
+
+      memset(expected, 0, bins * sizeof(uint32_t));
+      for (size_t i = 0 ; i < len ; i++) {
+        if (src_u16[i] < bins)
+          expected[src_u16[i]]++;
+        else
+          skipped++;
+      }
+
+      wav_test_fill(hist, sizeof(hist));
+      memcpy(expected + bins, hist + bins, 16 * sizeof(uint32_t));
+      wav_test_check(wav_histogram_u16(hist, bins, src_u16, len) == skipped &&
+                     memcmp(hist, expected, (bins + 16) * sizeof(uint32_t)) == 0,
+        "histogram_u16: wrong result for %zu bins, %zu elements%s", bins, len, skewed ? " (skewed)" : "");
+    }
+  }
+}
+
+int
+main(void) {
+  static const size_t bins[] = {
+    1, 2,
+    WAV_HISTOGRAM_COMPARE_BINS - 1, WAV_HISTOGRAM_COMPARE_BINS, WAV_HISTOGRAM_COMPARE_BINS + 1,
+    255, 256, 257,
+    WAV_HISTOGRAM_WIDE_BINS - 1, WAV_HISTOGRAM_WIDE_BINS, WAV_HISTOGRAM_WIDE_BINS + 1,
+    4095, 4096, 4097,
+    65535, 65536
+  };
+
+  test_u8();
+
+  for (size_t b = 0 ; b < sizeof(bins) / sizeof(bins[0]) ; b++)
+    test_u16(bins[b]);
+
+  return wav_test_result();
+}
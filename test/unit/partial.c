@@ -0,0 +1,117 @@
+/* wav_*_load_partial, wav_*_load_partial_overread and
+ * wav_*_store_partial for every length at every offset from an
+ * aligned address.
+ *
+ * The loads must return the first n elements and zeros after them;
+ * the overreading load is also tried right before a page boundary,
+ * where it has to fall back to load_partial.  The stores must write
+ * exactly n elements and leave every other byte of the buffer alone. */
+
+#include "test.h"
+
+#include <stdalign.h>
+
+static alignas(WAV_PAGE_SIZE) uint8_t pages[2 * WAV_PAGE_SIZE];
+
+static void
+check_load(const char * name, const void * v, const uint8_t * src, size_t bytes, size_t offset) {
+  uint8_t r[16];
+
+  memcpy(r, v, sizeof(r));
+  for (size_t i = 0 ; i < 16 ; i++) {
+    const uint8_t expected = (i < bytes) ? src[i] : 0;
+    wav_test_check(r[i] == expected,
+      "%s: %zu bytes at offset %zu: byte %zu is 0x%02x, expected 0x%02x",
+      name, bytes, offset, i, r[i], expected);
+  }
+}
+
+#define TEST_LOAD(Type, Element) \
+  static void \
+  test_load_##Type(void) { \
+    const size_t lanes = 16 / sizeof(Element); \
+    for (size_t offset = 0 ; offset < 16 ; offset++) { \
+      for (size_t n = 0 ; n <= lanes ; n++) { \
+        const uint8_t * src = pages + offset; \
+        wav_##Type##_t r = wav_##Type##_load_partial(src, n); \
+        check_load(#Type "_load_partial", &r, src, n * sizeof(Element), offset); \
+        r = wav_##Type##_load_partial_overread(src, n); \
+        check_load(#Type "_load_partial_overread", &r, src, n * sizeof(Element), offset); \
+        /* Ends just before the page boundary; the 16-byte load would \
+         * cross it. */ \
+        src = pages + WAV_PAGE_SIZE - (n * sizeof(Element)) - offset; \
+        r = wav_##Type##_load_partial_overread(src, n); \
+        check_load(#Type "_load_partial_overread (page end)", &r, src, n * sizeof(Element), offset); \
+      } \
+    } \
+  }
+
+#define TEST_STORE(Type, Element) \
+  static void \
+  test_store_##Type(void) { \
+    const size_t lanes = 16 / sizeof(Element); \
+    uint8_t v[16]; \
+    uint8_t before[48]; \
+    uint8_t after[48]; \
+    wav_##Type##_t vec; \
+    wav_test_fill(v, sizeof(v)); \
+    memcpy(&vec, v, sizeof(vec)); \
+    for (size_t offset = 0 ; offset < 16 ; offset++) { \
+      for (size_t n = 0 ; n <= lanes ; n++) { \
+        const size_t bytes = n * sizeof(Element); \
+        wav_test_fill(before, sizeof(before)); \
+        memcpy(after, before, sizeof(after)); \
+        wav_##Type##_store_partial(after + 16 + offset, vec, n); \
+        for (size_t i = 0 ; i < sizeof(after) ; i++) { \
+          const int inside = (i >= 16 + offset) && (i < 16 + offset + bytes); \
+          const uint8_t expected = inside ? v[i - 16 - offset] : before[i]; \
+          wav_test_check(after[i] == expected, \
+            "%s: %zu lanes at offset %zu: byte %zu is 0x%02x, expected 0x%02x", \
+            #Type "_store_partial", n, offset, i, after[i], expected); \
+        } \
+      } \
+    } \
+  }
+
+TEST_LOAD(u8x16, uint8_t)
+TEST_LOAD(i8x16, int8_t)
+TEST_LOAD(u16x8, uint16_t)
+TEST_LOAD(f16x8, uint16_t)
+TEST_LOAD(i32x4, int32_t)
+TEST_LOAD(f32x4, float)
+TEST_LOAD(u64x2, uint64_t)
+TEST_LOAD(f64x2, double)
+
+TEST_STORE(u8x16, uint8_t)
+TEST_STORE(i8x16, int8_t)
+TEST_STORE(u16x8, uint16_t)
+TEST_STORE(f16x8, uint16_t)
+TEST_STORE(i32x4, int32_t)
+TEST_STORE(f32x4, float)
+TEST_STORE(u64x2, uint64_t)
+TEST_STORE(f64x2, double)
+
+int
+main(void) {
+  wav_test_fill(pages, sizeof(pages));
+
+  test_load_u8x16();
+  test_load_i8x16();
+  test_load_u16x8();
+  test_load_f16x8();
+  test_load_i32x4();
+  test_load_f32x4();
+  test_load_u64x2();
+  test_load_f64x2();
+
+  test_store_u8x16();
+  test_store_i8x16();
+  test_store_u16x8();
+  test_store_f16x8();
+  test_store_i32x4();
+  test_store_f32x4();
+  test_store_u64x2();
+  test_store_f64x2();
+
+  return wav_test_result();
+}
@@ -0,0 +1,228 @@
+/* wav_reduce.h compared with scalar loops.
+ *
+ * The register reductions (including the _wide sums) get random
+ * vectors, and the _wide sums also get vectors with every lane at the
+ * minimum or maximum.  wav_*_array_sum and wav_*_array_minmax get
+ * every length up to a few vectors; the sums also get lengths on
+ * either side of one, two and three accumulator blocks (128 vectors
+ * for 8-bit lanes, 16384 for 16-bit), filled with random values and
+ * with the minimum and maximum values, which is where a narrow
+ * accumulator would overflow.
+ *
+ * Float inputs are small multiples of 1/8, so the sums are exact in
+ * any order and there are no NaNs. */
+
+#include "test.h"
+#include "wav_reduce.h"
+
+#include <stdalign.h>
+
+#define RANDOM_F32 ((float) ((int) (wav_test_rand() % 2001) - 1000) / 8.0f)
+#define RANDOM_F64 ((double) ((int) (wav_test_rand() % 2001) - 1000) / 8.0)
+
+/* Enough for three blocks of 16-bit sums, plus a few vectors. */
+#define MAX_BYTES ((3 * 16384 * 16) + 64)
+
+static alignas(16) uint8_t buf[MAX_BYTES];
+
+/* One step of each reduction on scalars.  Adds wrap, like the vector
+ * versions; Unsigned is the unsigned type of the same width (or the
+ * element type itself for floats). */
+#define SCALAR_add(Element, Unsigned, r, x) ((Element) ((Unsigned) (r) + (Unsigned) (x)))
+#define SCALAR_and(Element, Unsigned, r, x) ((Element) ((r) & (x)))
+#define SCALAR_or(Element, Unsigned, r, x)  ((Element) ((r) | (x)))
+#define SCALAR_xor(Element, Unsigned, r, x) ((Element) ((r) ^ (x)))
+#define SCALAR_min(Element, Unsigned, r, x) (((x) < (r)) ? (x) : (r))
+#define SCALAR_max(Element, Unsigned, r, x) (((x) > (r)) ? (x) : (r))
+
+#define TEST_REDUCE(Type, Element, Unsigned, op, random) \
+  static void \
+  test_##Type##_reduce_##op(void) { \
+    const size_t lanes = 16 / sizeof(Element); \
+    for (int k = 0 ; k < 1000 ; k++) { \
+      wav_##Type##_t v; \
+      Element expected; \
+      for (size_t i = 0 ; i < lanes ; i++) \
+        v.values[i] = (random); \
+      expected = v.values[0]; \
+      for (size_t i = 1 ; i < lanes ; i++) \
+        expected = SCALAR_##op(Element, Unsigned, expected, v.values[i]); \
+      wav_test_check(wav_##Type##_reduce_##op(v) == expected, \
+        "%s_reduce_%s: wrong result for vector %d", #Type, #op, k); \
+    } \
+  }
+
+#define TEST_REDUCE_INT(Type, Element, Unsigned) \
+  TEST_REDUCE(Type, Element, Unsigned, add, (Element) wav_test_rand()) \
+  TEST_REDUCE(Type, Element, Unsigned, and, (Element) wav_test_rand()) \
+  TEST_REDUCE(Type, Element, Unsigned, or,  (Element) wav_test_rand()) \
+  TEST_REDUCE(Type, Element, Unsigned, xor, (Element) wav_test_rand()) \
+  TEST_REDUCE(Type, Element, Unsigned, min, (Element) wav_test_rand()) \
+  TEST_REDUCE(Type, Element, Unsigned, max, (Element) wav_test_rand())
+
+TEST_REDUCE_INT(i8x16,   int8_t,  uint8_t)
+TEST_REDUCE_INT(i16x8,  int16_t, uint16_t)
+TEST_REDUCE_INT(i32x4,  int32_t, uint32_t)
+TEST_REDUCE_INT(i64x2,  int64_t, uint64_t)
+TEST_REDUCE_INT(u8x16,  uint8_t,  uint8_t)
+TEST_REDUCE_INT(u16x8, uint16_t, uint16_t)
+TEST_REDUCE_INT(u32x4, uint32_t, uint32_t)
+TEST_REDUCE_INT(u64x2, uint64_t, uint64_t)
+TEST_REDUCE(f32x4,  float,  float, add, RANDOM_F32)
+TEST_REDUCE(f32x4,  float,  float, min, RANDOM_F32)
+TEST_REDUCE(f32x4,  float,  float, max, RANDOM_F32)
+TEST_REDUCE(f64x2, double, double, add, RANDOM_F64)
+TEST_REDUCE(f64x2, double, double, min, RANDOM_F64)
+TEST_REDUCE(f64x2, double, double, max, RANDOM_F64)
+
+/* Vector 0 has every lane at lo, vector 1 every lane at hi, and the
+ * rest are random. */
+#define TEST_REDUCE_ADD_WIDE(Type, Element, Wide, lo, hi) \
+  static void \
+  test_##Type##_reduce_add_wide(void) { \
+    const size_t lanes = 16 / sizeof(Element); \
+    for (int k = 0 ; k < 1000 ; k++) { \
+      wav_##Type##_t v; \
+      Wide expected = 0; \
+      for (size_t i = 0 ; i < lanes ; i++) { \
+        v.values[i] = (k == 0) ? (lo) : ((k == 1) ? (hi) : (Element) wav_test_rand()); \
+        expected += v.values[i]; \
+      } \
+      wav_test_check(wav_##Type##_reduce_add_wide(v) == expected, \
+        "%s_reduce_add_wide: wrong result for vector %d", #Type, k); \
+    } \
+  }
+
+TEST_REDUCE_ADD_WIDE(i8x16,   int8_t,  int32_t,  INT8_MIN,   INT8_MAX)
+TEST_REDUCE_ADD_WIDE(i16x8,  int16_t,  int32_t, INT16_MIN,  INT16_MAX)
+TEST_REDUCE_ADD_WIDE(u8x16,  uint8_t, uint32_t,         0,  UINT8_MAX)
+TEST_REDUCE_ADD_WIDE(u16x8, uint16_t, uint32_t,         0, UINT16_MAX)
+
+/* Acc is what the scalar sum is accumulated in: uint64_t for integers
+ * (so it wraps like the 64-bit sums, and is exact for the others) and
+ * double for floats.  block is the accumulator block size in vectors;
+ * for the types without blocks it's just a longer length to try. */
+#define TEST_ARRAY_SUM(Type, Element, Sum, Acc, random, lo, hi, block) \
+  static void \
+  test_##Type##_array_sum(void) { \
+    const size_t lanes = 16 / sizeof(Element); \
+    Element * src = (Element *) buf; \
+    size_t lengths[(4 * 16) + 9]; \
+    size_t n = 0; \
+    for (size_t len = 0 ; len <= (lanes * 4) ; len++) \
+      lengths[n++] = len; \
+    for (size_t m = 1 ; m <= 3 ; m++) { \
+      lengths[n++] = (block * lanes * m) - 1; \
+      lengths[n++] = block * lanes * m; \
+      lengths[n++] = (block * lanes * m) + 1; \
+    } \
+    for (int fill = 0 ; fill < 3 ; fill++) { \
+      for (size_t i = 0 ; i < lengths[n - 1] ; i++) \
+        src[i] = (fill == 0) ? (random) : ((fill == 1) ? (lo) : (hi)); \
+      for (size_t l = 0 ; l < n ; l++) { \
+        const size_t len = lengths[l]; \
+        Acc expected = 0; \
+        for (size_t i = 0 ; i < len ; i++) \
+          expected += (Acc) src[i]; \
+        wav_test_check(wav_##Type##_array_sum(src, len) == (Sum) expected, \
+          "%s_array_sum: wrong result for %zu elements (fill %d)", #Type, len, fill); \
+      } \
+    } \
+  }
+
+TEST_ARRAY_SUM(i8x16,   int8_t,  int64_t, uint64_t, (int8_t) wav_test_rand(),   INT8_MIN,   INT8_MAX,   128)
+TEST_ARRAY_SUM(u8x16,  uint8_t, uint64_t, uint64_t, (uint8_t) wav_test_rand(),         0,  UINT8_MAX,   128)
+TEST_ARRAY_SUM(i16x8,  int16_t,  int64_t, uint64_t, (int16_t) wav_test_rand(), INT16_MIN,  INT16_MAX, 16384)
+TEST_ARRAY_SUM(u16x8, uint16_t, uint64_t, uint64_t, (uint16_t) wav_test_rand(),        0, UINT16_MAX, 16384)
+TEST_ARRAY_SUM(i32x4,  int32_t,  int64_t, uint64_t, (int32_t) wav_test_rand(), INT32_MIN,  INT32_MAX,   256)
+TEST_ARRAY_SUM(u32x4, uint32_t, uint64_t, uint64_t, (uint32_t) wav_test_rand(),        0, UINT32_MAX,   256)
+TEST_ARRAY_SUM(i64x2,  int64_t,  int64_t, uint64_t, (int64_t) wav_test_rand(), INT64_MIN,  INT64_MAX,   256)
+TEST_ARRAY_SUM(u64x2, uint64_t, uint64_t, uint64_t, wav_test_rand(),                   0, UINT64_MAX,   256)
+TEST_ARRAY_SUM(f32x4,    float,    float,   double, RANDOM_F32,                  -125.0f,     125.0f,   256)
+TEST_ARRAY_SUM(f64x2,   double,   double,   double, RANDOM_F64,                   -125.0,      125.0,   256)
+
+#define TEST_ARRAY_MINMAX(Type, Element, random) \
+  static void \
+  test_##Type##_array_minmax(void) { \
+    const size_t lanes = 16 / sizeof(Element); \
+    Element * src = (Element *) buf; \
+    Element min = 42, max = 42; \
+    wav_test_check(!wav_##Type##_array_minmax(src, 0, &min, &max) && min == 42 && max == 42, \
+      "%s_array_minmax: wrong result for 0 elements", #Type); \
+    for (size_t len = 1 ; len <= (lanes * 4) + 1 ; len++) { \
+      for (int k = 0 ; k < 100 ; k++) { \
+        Element expected_min, expected_max; \
+        for (size_t i = 0 ; i < len ; i++) \
+          src[i] = (random); \
+        expected_min = expected_max = src[0]; \
+        for (size_t i = 1 ; i < len ; i++) { \
+          expected_min = SCALAR_min(Element, Element, expected_min, src[i]); \
+          expected_max = SCALAR_max(Element, Element, expected_max, src[i]); \
+        } \
+        wav_test_check(wav_##Type##_array_minmax(src, len, &min, &max) && min == expected_min && max == expected_max, \
+          "%s_array_minmax: wrong result for %zu elements", #Type, len); \
+      } \
+    } \
+  }
+
+TEST_ARRAY_MINMAX(i8x16,   int8_t, (int8_t) wav_test_rand())
+TEST_ARRAY_MINMAX(i16x8,  int16_t, (int16_t) wav_test_rand())
+TEST_ARRAY_MINMAX(i32x4,  int32_t, (int32_t) wav_test_rand())
+TEST_ARRAY_MINMAX(u8x16,  uint8_t, (uint8_t) wav_test_rand())
+TEST_ARRAY_MINMAX(u16x8, uint16_t, (uint16_t) wav_test_rand())
+TEST_ARRAY_MINMAX(u32x4, uint32_t, (uint32_t) wav_test_rand())
+TEST_ARRAY_MINMAX(f32x4,    float, RANDOM_F32)
+TEST_ARRAY_MINMAX(f64x2,   double, RANDOM_F64)
+
+#define RUN_REDUCE_INT(Type) \
+  test_##Type##_reduce_add(); \
+  test_##Type##_reduce_and(); \
+  test_##Type##_reduce_or(); \
+  test_##Type##_reduce_xor(); \
+  test_##Type##_reduce_min(); \
+  test_##Type##_reduce_max()
+
+int
+main(void) {
+  RUN_REDUCE_INT(i8x16);
+  RUN_REDUCE_INT(i16x8);
+  RUN_REDUCE_INT(i32x4);
+  RUN_REDUCE_INT(i64x2);
+  RUN_REDUCE_INT(u8x16);
+  RUN_REDUCE_INT(u16x8);
+  RUN_REDUCE_INT(u32x4);
+  RUN_REDUCE_INT(u64x2);
+  test_f32x4_reduce_add();
+  test_f32x4_reduce_min();
+  test_f32x4_reduce_max();
+  test_f64x2_reduce_add();
+  test_f64x2_reduce_min();
+  test_f64x2_reduce_max();
+
+  test_i8x16_reduce_add_wide();
+  test_i16x8_reduce_add_wide();
+  test_u8x16_reduce_add_wide();
+  test_u16x8_reduce_add_wide();
+
+  test_i8x16_array_sum();
+  test_u8x16_array_sum();
+  test_i16x8_array_sum();
+  test_u16x8_array_sum();
+  test_i32x4_array_sum();
+  test_u32x4_array_sum();
+  test_i64x2_array_sum();
+  test_u64x2_array_sum();
+  test_f32x4_array_sum();
+  test_f64x2_array_sum();
+
+  test_i8x16_array_minmax();
+  test_i16x8_array_minmax();
+  test_i32x4_array_minmax();
+  test_u8x16_array_minmax();
+  test_u16x8_array_minmax();
+  test_u32x4_array_minmax();
+  test_f32x4_array_minmax();
+  test_f64x2_array_minmax();
+
+  return wav_test_result();
+}
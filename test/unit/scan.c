@@ -0,0 +1,92 @@
+/* wav_*_array_scan and wav_*_array_scan_exclusive compared with a
+ * running total, for every length up to three vectors plus one (so
+ * every tail length is covered) and a longer array, into a separate
+ * dest and in place.  Nothing past len may be written, and the
+ * returned total must match.
+ *
+ * Float inputs are small multiples of 1/8, so the sums are exact in
+ * any order.  An array of -0.0 must scan to -0.0 everywhere, which
+ * only works if the lanes past the end of the tail hold -0.0 rather
+ * than 0. */
+
+#include "test.h"
+#include "wav_scan.h"
+
+#define MAX_LEN 1000
+
+#define RANDOM_F32 ((float) ((int) (wav_test_rand() % 2001) - 1000) / 8.0f)
+#define RANDOM_F64 ((double) ((int) (wav_test_rand() % 2001) - 1000) / 8.0)
+
+/* Every length up to three vectors plus one, then MAX_LEN. */
+static size_t
+next_length(size_t len, size_t lanes) {
+  return (len < (lanes * 3) + 1) ? len + 1 : ((len < MAX_LEN) ? MAX_LEN : len + 1);
+}
+
+/* Acc is the type the scalar total is kept in; the unsigned type of
+ * the same width for integers, so it wraps like the vector version. */
+#define TEST_SCAN(Type, Element, Acc, Identity, random) \
+  static void \
+  test_##Type##_scan(void) { \
+    const size_t lanes = 16 / sizeof(Element); \
+    static Element src[MAX_LEN]; \
+    static Element expected[MAX_LEN]; \
+    static Element expected_exclusive[MAX_LEN]; \
+    static Element dest_buf[MAX_LEN + 16]; \
+    static Element guard[MAX_LEN + 16]; \
+    for (size_t len = 0 ; len <= MAX_LEN ; len = next_length(len, lanes)) { \
+      for (int fill = 0 ; fill < 2 ; fill++) { \
+        Acc total = (Acc) (Identity); \
+        for (size_t i = 0 ; i < len ; i++) { \
+          src[i] = (fill == 0) ? (random) : (Element) (Identity); \
+          expected_exclusive[i] = (Element) total; \
+          total = (Acc) (total + (Acc) src[i]); \
+          expected[i] = (Element) total; \
+        } \
+        for (int in_place = 0 ; in_place < 2 ; in_place++) { \
+          for (int exclusive = 0 ; exclusive < 2 ; exclusive++) { \
+            const Element * s = in_place ? dest_buf : src; \
+            const Element expected_total = (Element) total; \
+            Element r; \
+            wav_test_fill(guard, sizeof(guard)); \
+            memcpy(dest_buf, guard, sizeof(dest_buf)); \
+            if (in_place) \
+              memcpy(dest_buf, src, len * sizeof(Element)); \
+            r = exclusive ? wav_##Type##_array_scan_exclusive(dest_buf, s, len) : wav_##Type##_array_scan(dest_buf, s, len); \
+            wav_test_check(memcmp(dest_buf, exclusive ? expected_exclusive : expected, len * sizeof(Element)) == 0 && \
+                           memcmp(&r, &expected_total, sizeof(Element)) == 0 && \
+                           memcmp(dest_buf + len, guard + len, 16 * sizeof(Element)) == 0, \
+              "%s_array_scan%s%s: wrong result for %zu elements%s", #Type, exclusive ? "_exclusive" : "", \
+              in_place ? " (in place)" : "", len, fill ? " of the identity" : ""); \
+          } \
+        } \
+      } \
+    } \
+  }
+
+TEST_SCAN(i8x16,   int8_t,  uint8_t,     0, (int8_t) wav_test_rand())
+TEST_SCAN(i16x8,  int16_t, uint16_t,     0, (int16_t) wav_test_rand())
+TEST_SCAN(i32x4,  int32_t, uint32_t,     0, (int32_t) wav_test_rand())
+TEST_SCAN(i64x2,  int64_t, uint64_t,     0, (int64_t) wav_test_rand())
+TEST_SCAN(u8x16,  uint8_t,  uint8_t,     0, (uint8_t) wav_test_rand())
+TEST_SCAN(u16x8, uint16_t, uint16_t,     0, (uint16_t) wav_test_rand())
+TEST_SCAN(u32x4, uint32_t, uint32_t,     0, (uint32_t) wav_test_rand())
+TEST_SCAN(u64x2, uint64_t, uint64_t,     0, wav_test_rand())
+TEST_SCAN(f32x4,    float,    float, -0.0f, RANDOM_F32)
+TEST_SCAN(f64x2,   double,   double, -0.0,  RANDOM_F64)
+
+int
+main(void) {
+  test_i8x16_scan();
+  test_i16x8_scan();
+  test_i32x4_scan();
+  test_i64x2_scan();
+  test_u8x16_scan();
+  test_u16x8_scan();
+  test_u32x4_scan();
+  test_u64x2_scan();
+  test_f32x4_scan();
+  test_f64x2_scan();
+
+  return wav_test_result();
+}
@@ -0,0 +1,136 @@
+/* wav_search.h compared with std::lower_bound.
+ *
+ * Trees are built for every length up to a few hundred, then longer
+ * ones up to several thousand, including every length within a node of
+ * a complete tree (where another level is added).  The sorted arrays
+ * either have gaps between the elements, so some keys are absent, or
+ * are full of duplicates and include 0 and the largest value.  Every
+ * element is looked up, along with the values either side of it, 0 and
+ * the largest value, with kary_lower_bound and with
+ * kary_lower_bound_batch (on a count which isn't a multiple of
+ * WAV_SEARCH_BATCH, so the scalar tail runs too).  kary_build must not
+ * write past kary_size(len) elements. */
+
+#include "test.h"
+#include "wav_search.h"
+
+#include <algorithm>
+#include <limits>
+
+#define MAX_LEN 8192
+#define MAX_KEYS ((3 * MAX_LEN) + 2)
+
+/* The next length to try: every length up to 300, then steps of about
+ * 1/16th, plus every length within `lanes` of a complete tree of
+ * (lanes + 1)^k - 1 elements. */
+static size_t
+next_length(size_t len, size_t lanes) {
+  size_t complete = lanes;
+
+  if (len < 300)
+    return len + 1;
+
+  while (complete + lanes < len)
+    complete = ((complete + 1) * (lanes + 1)) - 1;
+  if (complete <= len + lanes)
+    return len + 1;
+
+  return std::min(len + 1 + (len / 16), complete - lanes);
+}
+
+template <typename Element>
+static void
+test_search(const char * type,
+            size_t (* size)(size_t),
+            void (* build)(Element *, const Element *, size_t),
+            size_t (* lower_bound)(const Element *, size_t, Element),
+            void (* lower_bound_batch)(const Element *, size_t, const Element *, size_t *, size_t)) {
+  const size_t lanes = 16 / sizeof(Element);
+  const Element max = std::numeric_limits<Element>::max();
+  static Element sorted[MAX_LEN];
+  static Element keys[MAX_KEYS];
+  static size_t results[MAX_KEYS];
+  alignas(16) static Element tree[MAX_LEN + 16];
+  static Element guard[MAX_LEN + 16];
+
+  for (size_t len = 0 ; len <= MAX_LEN ; len = next_length(len, lanes)) {
+    for (int duplicates = 0 ; duplicates < 2 ; duplicates++) {
+      size_t count = 0;
+
+      /* Gaps of 2 to 5 starting above 2, or runs of a few values from
+       * the whole range with the extremes at either end. */
+      for (size_t i = 0 ; i < len ; i++) {
+        if (!duplicates)
+          sorted[i] = static_cast<Element>(((i == 0) ? 1 : sorted[i - 1]) + 2 + (wav_test_rand() % 4));
+        else
+          sorted[i] = static_cast<Element>((wav_test_rand() % 8) * (max / 7));
+      }
+      std::sort(sorted, sorted + len);
+      if (duplicates && len > 0) {
+        sorted[0] = 0;
+        sorted[len - 1] = max;
+      }
+
+      wav_test_fill(guard, sizeof(guard));
+      memcpy(tree, guard, sizeof(tree));
+      build(tree, sorted, len);
+      wav_test_check(memcmp(tree + size(len), guard + size(len), 16 * sizeof(Element)) == 0,
+        "%s_kary_build: wrote past the tree for %zu elements", type, len);
+
+      keys[count++] = 0;
+      keys[count++] = max;
+      for (size_t i = 0 ; i < len ; i++) {
+        keys[count++] = static_cast<Element>(sorted[i] - 1);
+        keys[count++] = sorted[i];
+        keys[count++] = static_cast<Element>(sorted[i] + 1);
+      }
+
+      for (size_t i = 0 ; i < count ; i++) {
+        const size_t expected = static_cast<size_t>(std::lower_bound(sorted, sorted + len, keys[i]) - sorted);
+        const size_t r = lower_bound(tree, len, keys[i]);
+        wav_test_check(r == expected, "%s_kary_lower_bound: %zu elements%s, key %u: got %zu, expected %zu",
+          type, len, duplicates ? " (duplicates)" : "", static_cast<unsigned int>(keys[i]), r, expected);
+      }
+
+      /* One fewer than count, so the batch doesn't end on a multiple
+       * of WAV_SEARCH_BATCH for every length. */
+      if (count > 1)
+        count--;
+      memset(results, 0xff, sizeof(results));
+      lower_bound_batch(tree, len, keys, results, count);
+      for (size_t i = 0 ; i < count ; i++) {
+        const size_t expected = static_cast<size_t>(std::lower_bound(sorted, sorted + len, keys[i]) - sorted);
+        wav_test_check(results[i] == expected, "%s_kary_lower_bound_batch: %zu elements%s, key #%zu (%u): got %zu, expected %zu",
+          type, len, duplicates ? " (duplicates)" : "", i, static_cast<unsigned int>(keys[i]), results[i], expected);
+      }
+      wav_test_check(results[count] == SIZE_MAX,
+        "%s_kary_lower_bound_batch: wrote past results for %zu elements", type, len);
+    }
+  }
+
+  /* Every count up to a few batches, on one tree. */
+  for (size_t i = 0 ; i < 300 ; i++)
+    sorted[i] = static_cast<Element>(3 * i);
+  build(tree, sorted, 300);
+  for (size_t i = 0 ; i < (WAV_SEARCH_BATCH * 3) + 1 ; i++)
+    keys[i] = static_cast<Element>(wav_test_rand() % 1000);
+  for (size_t count = 0 ; count <= (WAV_SEARCH_BATCH * 3) + 1 ; count++) {
+    memset(results, 0xff, sizeof(results));
+    lower_bound_batch(tree, 300, keys, results, count);
+    for (size_t i = 0 ; i < count ; i++) {
+      const size_t expected = static_cast<size_t>(std::lower_bound(sorted, sorted + 300, keys[i]) - sorted);
+      wav_test_check(results[i] == expected, "%s_kary_lower_bound_batch: %zu keys: key #%zu is wrong", type, count, i);
+    }
+    wav_test_check(results[count] == SIZE_MAX, "%s_kary_lower_bound_batch: wrote past %zu results", type, count);
+  }
+}
+
+int
+main(void) {
+  test_search<uint16_t>("u16x8", wav_u16x8_kary_size, wav_u16x8_kary_build,
+    wav_u16x8_kary_lower_bound, wav_u16x8_kary_lower_bound_batch);
+  test_search<uint32_t>("u32x4", wav_u32x4_kary_size, wav_u32x4_kary_build,
+    wav_u32x4_kary_lower_bound, wav_u32x4_kary_lower_bound_batch);
+
+  return wav_test_result();
+}
@@ -0,0 +1,178 @@
+/* wav_set.h compared with std::set_intersection, std::set_union,
+ * std::set_difference and std::merge.
+ *
+ * Every pair of lengths up to a few vectors plus one is tried on
+ * random lists drawn from a small universe (so they overlap), some of
+ * them at the top of the range so UINT32_MAX is included.  Then there
+ * are empty, identical, disjoint (one list after the other, and
+ * interleaved) and subset pairs, pairs where one list is long enough
+ * for the galloping search (in both orders), and merges of lists with
+ * duplicates.  Intersection and difference are also run in place over
+ * a.  Nothing past the room dest is documented to need may be
+ * written. */
+
+#include "test.h"
+#include "wav_set.h"
+
+#include <algorithm>
+
+#define MAX_LEN 8192
+#define MAX_SMALL_LEN ((4 * 4) + 1)
+
+static uint32_t a[MAX_LEN];
+static uint32_t b[MAX_LEN];
+static uint32_t expected[2 * MAX_LEN];
+static uint32_t dest_buf[(2 * MAX_LEN) + 16];
+static uint32_t guard[(2 * MAX_LEN) + 16];
+
+/* Exactly len sorted, unique values from [base, base + universe). */
+static void
+random_list(uint32_t * dest, size_t len, uint32_t base, uint32_t universe) {
+  size_t n = 0;
+  for (uint32_t id = 0 ; id < universe && n < len ; id++) {
+    if ((wav_test_rand() % (universe - id)) < (len - n))
+      dest[n++] = base + id;
+  }
+}
+
+typedef size_t (* set_function)(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len);
+
+static size_t
+intersection_std(uint32_t * dest, const uint32_t * x, size_t x_len, const uint32_t * y, size_t y_len) {
+  return static_cast<size_t>(std::set_intersection(x, x + x_len, y, y + y_len, dest) - dest);
+}
+
+static size_t
+union_std(uint32_t * dest, const uint32_t * x, size_t x_len, const uint32_t * y, size_t y_len) {
+  return static_cast<size_t>(std::set_union(x, x + x_len, y, y + y_len, dest) - dest);
+}
+
+static size_t
+difference_std(uint32_t * dest, const uint32_t * x, size_t x_len, const uint32_t * y, size_t y_len) {
+  return static_cast<size_t>(std::set_difference(x, x + x_len, y, y + y_len, dest) - dest);
+}
+
+static size_t
+merge_std(uint32_t * dest, const uint32_t * x, size_t x_len, const uint32_t * y, size_t y_len) {
+  std::merge(x, x + x_len, y, y + y_len, dest);
+  return x_len + y_len;
+}
+
+static size_t
+merge_wav(uint32_t * dest, const uint32_t * x, size_t x_len, const uint32_t * y, size_t y_len) {
+  wav_u32x4_array_merge(dest, x, x_len, y, y_len);
+  return x_len + y_len;
+}
+
+/* room is how much of dest the function may write; if in_place, a is
+ * copied to dest first and passed as both. */
+static void
+check(const char * name, const char * shape, set_function wav, set_function reference,
+      size_t a_len, size_t b_len, size_t room, int in_place) {
+  const size_t expected_n = reference(expected, a, a_len, b, b_len);
+  size_t n;
+
+  wav_test_fill(guard, sizeof(guard));
+  memcpy(dest_buf, guard, sizeof(dest_buf));
+  if (in_place) {
+    memcpy(dest_buf, a, a_len * sizeof(uint32_t));
+    n = wav(dest_buf, dest_buf, a_len, b, b_len);
+  } else {
+    n = wav(dest_buf, a, a_len, b, b_len);
+  }
+
+  wav_test_check(n == expected_n && memcmp(dest_buf, expected, n * sizeof(uint32_t)) == 0,
+    "u32x4_%s%s: wrong result for %zu and %zu elements (%s)",
+    name, in_place ? " (in place)" : "", a_len, b_len, shape);
+  wav_test_check(memcmp(dest_buf + room, guard + room, 16 * sizeof(uint32_t)) == 0,
+    "u32x4_%s%s: wrote past dest for %zu and %zu elements (%s)",
+    name, in_place ? " (in place)" : "", a_len, b_len, shape);
+}
+
+static void
+check_all(const char * shape, size_t a_len, size_t b_len) {
+  check("set_intersection", shape, wav_u32x4_set_intersection, intersection_std, a_len, b_len, a_len, 0);
+  check("set_intersection", shape, wav_u32x4_set_intersection, intersection_std, a_len, b_len, a_len, 1);
+  check("set_difference", shape, wav_u32x4_set_difference, difference_std, a_len, b_len, a_len, 0);
+  check("set_difference", shape, wav_u32x4_set_difference, difference_std, a_len, b_len, a_len, 1);
+  check("set_union", shape, wav_u32x4_set_union, union_std, a_len, b_len, a_len + b_len, 0);
+  check("array_merge", shape, merge_wav, merge_std, a_len, b_len, a_len + b_len, 0);
+}
+
+/* Random lists, then the same lists the other way around. */
+static void
+check_random(const char * shape, size_t a_len, size_t b_len, uint32_t base, uint32_t universe) {
+  random_list(a, a_len, base, universe);
+  random_list(b, b_len, base, universe);
+  check_all(shape, a_len, b_len);
+
+  std::swap_ranges(a, a + std::max(a_len, b_len), b);
+  check_all(shape, b_len, a_len);
+}
+
+int
+main(void) {
+  for (size_t a_len = 0 ; a_len <= MAX_SMALL_LEN ; a_len++) {
+    for (size_t b_len = 0 ; b_len <= MAX_SMALL_LEN ; b_len++) {
+      const uint32_t universe = static_cast<uint32_t>(a_len + b_len + 4);
+
+      random_list(a, a_len, 0, universe);
+      random_list(b, b_len, 0, universe);
+      check_all("random", a_len, b_len);
+
+      random_list(a, a_len, UINT32_MAX - universe + 1, universe);
+      random_list(b, b_len, UINT32_MAX - universe + 1, universe);
+      check_all("random, ending at UINT32_MAX", a_len, b_len);
+
+      /* a entirely before b. */
+      random_list(a, a_len, 0, universe);
+      random_list(b, b_len, universe, universe);
+      check_all("disjoint", a_len, b_len);
+
+      /* Even and odd numbers. */
+      for (size_t i = 0 ; i < a_len ; i++)
+        a[i] = static_cast<uint32_t>(2 * i);
+      for (size_t i = 0 ; i < b_len ; i++)
+        b[i] = static_cast<uint32_t>((2 * i) + 1);
+      check_all("interleaved", a_len, b_len);
+
+      /* Lists with duplicates, which only merge accepts. */
+      for (size_t i = 0 ; i < a_len ; i++)
+        a[i] = static_cast<uint32_t>(wav_test_rand() % 4);
+      for (size_t i = 0 ; i < b_len ; i++)
+        b[i] = static_cast<uint32_t>(wav_test_rand() % 4);
+      std::sort(a, a + a_len);
+      std::sort(b, b + b_len);
+      check("array_merge", "duplicates", merge_wav, merge_std, a_len, b_len, a_len + b_len, 0);
+    }
+
+    /* b the same as a, and a subset of it. */
+    random_list(a, a_len, 0, static_cast<uint32_t>((2 * a_len) + 1));
+    memcpy(b, a, a_len * sizeof(uint32_t));
+    check_all("identical", a_len, a_len);
+    for (size_t half = 0 ; half <= a_len ; half++) {
+      random_list(b, half, 0, static_cast<uint32_t>(a_len));
+      for (size_t i = 0 ; i < half ; i++)
+        b[i] = a[b[i]];
+      check_all("subset", a_len, half);
+      std::swap_ranges(a, a + a_len, b);
+      check_all("superset", half, a_len);
+      std::swap_ranges(a, a + a_len, b);
+    }
+  }
+
+  /* Long enough for the galloping search. */
+  for (size_t short_len = 1 ; short_len <= MAX_SMALL_LEN ; short_len++) {
+    const size_t long_len = ((short_len + 1) * WAV_SET_GALLOP_RATIO) + (wav_test_rand() % 64);
+    check_random("galloping", short_len, long_len, 0, static_cast<uint32_t>(long_len * 2));
+    check_random("galloping, sparse", short_len, long_len, 0, static_cast<uint32_t>(long_len * 64));
+    check_random("galloping, ending at UINT32_MAX", short_len, long_len,
+      UINT32_MAX - static_cast<uint32_t>(long_len * 2) + 1, static_cast<uint32_t>(long_len * 2));
+  }
+
+  check_random("long", 1000, 1000, 0, 4000);
+  check_random("long", 1000, 3000, 0, 4000);
+  check_random("long", MAX_LEN, MAX_LEN, 0, 4 * MAX_LEN);
+
+  return wav_test_result();
+}
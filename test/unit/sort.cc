@@ -0,0 +1,206 @@
+/* wav_sort.h compared with std::sort.
+ *
+ * Every network (sort4/sort8/sort16 for 32-bit lanes, sort8/sort16/
+ * sort32 for 16-bit lanes) and every merge is run on random data, on
+ * registers full of one value, on data which is already sorted or
+ * reversed, and on data drawn from a few distinct values (the extremes,
+ * zero, and for floats the infinities and -0.0).  The merges get two
+ * sequences which have each been sorted with std::sort.
+ *
+ * wav_*_array_sort is run on the same kinds of data for every length
+ * up to 64 (which covers the small sorts and the first few partitions)
+ * and some longer arrays, and nothing on either side of the array may
+ * be touched.
+ *
+ * Floats are small multiples of 1/8, and never NaN, which the networks
+ * don't support.  The networks order -0.0 before 0.0 but std::sort
+ * doesn't, so results are compared with == rather than memcmp. */
+
+#include "test.h"
+#include "wav_sort.h"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#define REPETITIONS 256
+
+enum distribution {
+  DISTRIBUTION_RANDOM,
+  DISTRIBUTION_EQUAL,
+  DISTRIBUTION_SORTED,
+  DISTRIBUTION_REVERSED,
+  DISTRIBUTION_FEW_DISTINCT
+};
+
+static const char * const distribution_names[] = { "random", "equal", "sorted", "reversed", "few distinct" };
+
+#define DISTRIBUTIONS 5
+
+template <typename Element>
+static typename std::enable_if<std::is_integral<Element>::value, Element>::type
+random_element() {
+  return static_cast<Element>(wav_test_rand());
+}
+
+template <typename Element>
+static typename std::enable_if<std::is_floating_point<Element>::value, Element>::type
+random_element() {
+  return static_cast<Element>(static_cast<int>(wav_test_rand() % 2001) - 1000) / 8;
+}
+
+/* One of a few values which sit on the edges of the type. */
+template <typename Element>
+static Element
+few_distinct_element() {
+  typedef std::numeric_limits<Element> limits;
+  const Element values[] = {
+    limits::lowest(), limits::max(), static_cast<Element>(0), static_cast<Element>(1),
+    limits::has_infinity ? -limits::infinity() : limits::lowest(),
+    limits::has_infinity ? limits::infinity() : limits::max(),
+    static_cast<Element>(limits::is_signed ? -0.0 : 0)
+  };
+  return values[wav_test_rand() % (sizeof(values) / sizeof(values[0]))];
+}
+
+template <typename Element>
+static void
+fill(Element * data, size_t len, distribution d) {
+  const Element value = random_element<Element>();
+  for (size_t i = 0 ; i < len ; i++) {
+    switch (d) {
+      case DISTRIBUTION_EQUAL:
+        data[i] = value;
+        break;
+      case DISTRIBUTION_FEW_DISTINCT:
+        data[i] = few_distinct_element<Element>();
+        break;
+      default:
+        data[i] = random_element<Element>();
+        break;
+    }
+  }
+
+  if (d == DISTRIBUTION_SORTED)
+    std::sort(data, data + len);
+  else if (d == DISTRIBUTION_REVERSED)
+    std::sort(data, data + len, [](Element a, Element b) { return b < a; });
+}
+
+template <typename Element>
+static bool
+equal(const Element * a, const Element * b, size_t len) {
+  for (size_t i = 0 ; i < len ; i++) {
+    if (!(a[i] == b[i]))
+      return false;
+  }
+  return true;
+}
+
+/* Sort (or, if merge, merge the two sorted halves of) `registers`
+ * vectors of random data, and compare with std::sort. */
+template <typename Vector, typename Element>
+static void
+test_network(const char * type, size_t registers, bool merge) {
+  const size_t lanes = sizeof(Vector) / sizeof(Element);
+  const size_t len = lanes * registers;
+
+  for (int d = 0 ; d < DISTRIBUTIONS ; d++) {
+    for (int k = 0 ; k < REPETITIONS ; k++) {
+      Element in[32], expected[32], out[32];
+      Vector v[4];
+
+      fill(in, len, static_cast<distribution>(d));
+      if (merge) {
+        std::sort(in, in + (len / 2));
+        std::sort(in + (len / 2), in + len);
+      }
+      memcpy(expected, in, len * sizeof(Element));
+      std::sort(expected, expected + len);
+      memcpy(v, in, len * sizeof(Element));
+
+      if (merge) {
+        if (registers == 2)
+          wav_merge(&(v[0]), &(v[1]));
+        else
+          wav_merge(&(v[0]), &(v[1]), &(v[2]), &(v[3]));
+      } else {
+        if (registers == 1)
+          v[0] = wav_sort(v[0]);
+        else if (registers == 2)
+          wav_sort(&(v[0]), &(v[1]));
+        else
+          wav_sort(&(v[0]), &(v[1]), &(v[2]), &(v[3]));
+      }
+
+      memcpy(out, v, len * sizeof(Element));
+      wav_test_check(equal(out, expected, len), "%s_%s%zu: wrong result for %s data",
+        type, merge ? "merge" : "sort", len, distribution_names[d]);
+    }
+  }
+}
+
+template <typename Vector, typename Element>
+static void
+test_networks(const char * type) {
+  test_network<Vector, Element>(type, 1, false);
+  test_network<Vector, Element>(type, 2, false);
+  test_network<Vector, Element>(type, 4, false);
+  test_network<Vector, Element>(type, 2, true);
+  test_network<Vector, Element>(type, 4, true);
+}
+
+/* Every length up to MAX_SMALL_LEN, then a few longer ones. */
+#define MAX_SMALL_LEN 64
+#define MAX_LEN 10000
+
+static size_t
+next_length(size_t len) {
+  if (len < MAX_SMALL_LEN)
+    return len + 1;
+  return (len < 1000) ? 1000 : ((len < MAX_LEN) ? MAX_LEN : len + 1);
+}
+
+template <typename Element>
+static void
+test_array_sort(const char * type) {
+  static Element expected[MAX_LEN];
+  static Element data_buf[MAX_LEN + 32];
+  static Element guard[MAX_LEN + 32];
+  Element * data = data_buf + 16;
+
+  for (size_t len = 0 ; len <= MAX_LEN ; len = next_length(len)) {
+    for (int d = 0 ; d < DISTRIBUTIONS ; d++) {
+      wav_test_fill(guard, sizeof(guard));
+      memcpy(data_buf, guard, sizeof(data_buf));
+      fill(data, len, static_cast<distribution>(d));
+      memcpy(expected, data, len * sizeof(Element));
+      std::sort(expected, expected + len);
+
+      wav_sort(data, len);
+      wav_test_check(equal(data, expected, len), "%s_array_sort: wrong result for %zu elements of %s data",
+        type, len, distribution_names[d]);
+      wav_test_check(memcmp(data_buf, guard, 16 * sizeof(Element)) == 0 &&
+                     memcmp(data + len, guard + 16 + len, 16 * sizeof(Element)) == 0,
+        "%s_array_sort: wrote outside of the array for %zu elements of %s data",
+        type, len, distribution_names[d]);
+    }
+  }
+}
+
+int
+main(void) {
+  test_networks<wav_i16x8_t,  int16_t>("i16x8");
+  test_networks<wav_u16x8_t, uint16_t>("u16x8");
+  test_networks<wav_i32x4_t,  int32_t>("i32x4");
+  test_networks<wav_u32x4_t, uint32_t>("u32x4");
+  test_networks<wav_f32x4_t,    float>("f32x4");
+
+  test_array_sort< int32_t>("i32x4");
+  test_array_sort<uint32_t>("u32x4");
+  test_array_sort< int64_t>("i64x2");
+  test_array_sort<uint64_t>("u64x2");
+  test_array_sort<   float>("f32x4");
+
+  return wav_test_result();
+}
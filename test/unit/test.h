@@ -0,0 +1,115 @@
+/* WAV unit test helpers
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* Shared code for the programs in test/unit/.
+ *
+ * Each program tests one header against scalar code and exits with a
+ * non-zero status if anything is wrong.  wav_test_check() prints a
+ * message for each failure (the first WAV_TEST_MAX_FAILURES of them,
+ * anyway) and wav_test_result() returns the exit status for main().
+ *
+ * Inputs come from wav_test_rand(), a fixed-seed xorshift, so every
+ * run (and every backend) sees the same values. */
+
+#if !defined(WAV_TEST_H)
+#define WAV_TEST_H
+
+#if !defined(WAV_EMULATION) && !defined(__wasm_simd128__)
+  #define WAV_EMULATION 1
+#endif
+
+#include "wav.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(WAV_TEST_MAX_FAILURES)
+  #define WAV_TEST_MAX_FAILURES 20
+#endif
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+static int wav_test_failures_ = 0;
+
+/* If ok is false, print the message (printf-style) and count a
+ * failure. */
+static inline void
+#if defined(__GNUC__)
+__attribute__((__format__(__printf__, 2, 3)))
+#endif
+wav_test_check(int ok, const char * format, ...) {
+  va_list args;
+
+  if (ok)
+    return;
+
+  if (wav_test_failures_++ < WAV_TEST_MAX_FAILURES) {
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fputc('\n', stderr);
+  }
+}
+
+static inline int
+wav_test_result(void) {
+  if (wav_test_failures_ > WAV_TEST_MAX_FAILURES)
+    fprintf(stderr, "(%d more failures)\n", wav_test_failures_ - WAV_TEST_MAX_FAILURES);
+  return (wav_test_failures_ == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static uint64_t wav_test_rand_state_ = UINT64_C(0x9e3779b97f4a7c15);
+
+static inline uint64_t
+wav_test_rand(void) {
+  uint64_t x = wav_test_rand_state_;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  wav_test_rand_state_ = x;
+  return x;
+}
+
+/* Fill buf with size random bytes. */
+static inline void
+wav_test_fill(void * buf, size_t size) {
+  unsigned char * p = (unsigned char *) buf;
+  for (size_t i = 0 ; i < size ; i++)
+    p[i] = (unsigned char) (wav_test_rand() >> 56);
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* !defined(WAV_TEST_H) */
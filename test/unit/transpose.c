@@ -0,0 +1,101 @@
+/* wav_transpose.h compared with scalar transposes.
+ *
+ * The register-level transposes are run on random rows for every type.
+ * The array transposes are run on every combination of a few row and
+ * column counts: 0, 1, either side of one and two blocks, and either
+ * side of one and two WAV_TRANSPOSE_TILE tiles, plus a tile and a
+ * partial block, so that whole blocks, the scalar edges and partial
+ * tiles all run.  Nothing past the end of dest may be written. */
+
+#include "test.h"
+#include "wav_transpose.h"
+
+#define MAX_DIM ((2 * WAV_TRANSPOSE_TILE) + 16 + 3)
+
+#define TEST_TRANSPOSE(Type, Element) \
+  static void \
+  test_##Type##_transpose(void) { \
+    const size_t lanes = 16 / sizeof(Element); \
+    for (int k = 0 ; k < 100 ; k++) { \
+      wav_##Type##_t rows[16]; \
+      Element in[16 * 16]; \
+      Element expected[16 * 16]; \
+      wav_test_fill(in, sizeof(in)); \
+      for (size_t r = 0 ; r < lanes ; r++) { \
+        for (size_t c = 0 ; c < lanes ; c++) \
+          expected[(c * lanes) + r] = in[(r * lanes) + c]; \
+      } \
+      memcpy(rows, in, lanes * sizeof(rows[0])); \
+      wav_##Type##_transpose(rows); \
+      wav_test_check(memcmp(rows, expected, lanes * sizeof(rows[0])) == 0, \
+        "%s_transpose: wrong result", #Type); \
+    } \
+  }
+
+#define TEST_ARRAY_TRANSPOSE(Type, Element) \
+  static void \
+  test_##Type##_array_transpose(void) { \
+    const size_t lanes = 16 / sizeof(Element); \
+    const size_t dims[] = { \
+      0, 1, 2, lanes - 1, lanes, lanes + 1, (2 * lanes) - 1, (2 * lanes) + 3, \
+      WAV_TRANSPOSE_TILE - 1, WAV_TRANSPOSE_TILE, WAV_TRANSPOSE_TILE + 1, \
+      WAV_TRANSPOSE_TILE + lanes + 3, (2 * WAV_TRANSPOSE_TILE) + 1, MAX_DIM \
+    }; \
+    static Element src[MAX_DIM * MAX_DIM]; \
+    static Element expected[MAX_DIM * MAX_DIM]; \
+    static Element dest[(MAX_DIM * MAX_DIM) + 16]; \
+    static Element guard[(MAX_DIM * MAX_DIM) + 16]; \
+    for (size_t i = 0 ; i < sizeof(dims) / sizeof(dims[0]) ; i++) { \
+      for (size_t j = 0 ; j < sizeof(dims) / sizeof(dims[0]) ; j++) { \
+        const size_t rows = dims[i]; \
+        const size_t cols = dims[j]; \
+        wav_test_fill(src, rows * cols * sizeof(Element)); \
+        for (size_t r = 0 ; r < rows ; r++) { \
+          for (size_t c = 0 ; c < cols ; c++) \
+            expected[(c * rows) + r] = src[(r * cols) + c]; \
+        } \
+        wav_test_fill(guard, sizeof(guard)); \
+        memcpy(dest, guard, sizeof(dest)); \
+        wav_##Type##_array_transpose(dest, src, rows, cols); \
+        wav_test_check(memcmp(dest, expected, rows * cols * sizeof(Element)) == 0, \
+          "%s_array_transpose: wrong result for %zu x %zu", #Type, rows, cols); \
+        wav_test_check(memcmp(dest + (rows * cols), guard + (rows * cols), 16 * sizeof(Element)) == 0, \
+          "%s_array_transpose: wrote past dest for %zu x %zu", #Type, rows, cols); \
+      } \
+    } \
+  }
+
+#define TEST_TRANSPOSES(Type, Element) \
+  TEST_TRANSPOSE(Type, Element) \
+  TEST_ARRAY_TRANSPOSE(Type, Element)
+
+TEST_TRANSPOSES(i8x16,   int8_t)
+TEST_TRANSPOSES(i16x8,  int16_t)
+TEST_TRANSPOSES(i32x4,  int32_t)
+TEST_TRANSPOSES(i64x2,  int64_t)
+TEST_TRANSPOSES(u8x16,  uint8_t)
+TEST_TRANSPOSES(u16x8, uint16_t)
+TEST_TRANSPOSES(u32x4, uint32_t)
+TEST_TRANSPOSES(u64x2, uint64_t)
+TEST_TRANSPOSES(f32x4,    float)
+TEST_TRANSPOSES(f64x2,   double)
+
+#define RUN_TRANSPOSES(Type) \
+  test_##Type##_transpose(); \
+  test_##Type##_array_transpose()
+
+int
+main(void) {
+  RUN_TRANSPOSES(i8x16);
+  RUN_TRANSPOSES(i16x8);
+  RUN_TRANSPOSES(i32x4);
+  RUN_TRANSPOSES(i64x2);
+  RUN_TRANSPOSES(u8x16);
+  RUN_TRANSPOSES(u16x8);
+  RUN_TRANSPOSES(u32x4);
+  RUN_TRANSPOSES(u64x2);
+  RUN_TRANSPOSES(f32x4);
+  RUN_TRANSPOSES(f64x2);
+
+  return wav_test_result();
+}
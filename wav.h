@@ -30,6 +30,7 @@
 #if !defined(WAV_H)
 #define WAV_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -89,6 +90,10 @@ typedef struct { uint64_t values __attribute__((__vector_size__(16),__aligned__(
 typedef struct {    float values __attribute__((__vector_size__(16),__aligned__(16))); } wav_f32x4_t;
 typedef struct {   double values __attribute__((__vector_size__(16),__aligned__(16))); } wav_f64x2_t;
 
+/* Half-precision values are stored as their binary16 bit patterns;
+ * see the "Half-precision floating point" section below. */
+typedef struct { uint16_t values __attribute__((__vector_size__(16),__aligned__(16))); } wav_f16x8_t;
+
 /* If desired WAV can work even when the WASM SIMD128 target is not
  * enabled.  WASM SIMD128 instructions will *not* be generated, but
  * this makes it a bit easier to develop code using WAV; you can simply
@@ -115,10 +120,174 @@ typedef struct {   double values __attribute__((__vector_size__(16),__aligned__(
   #define WAV_PORTABLE_SLOW(bugnum) 1
   #define WAV_FUNCTION_ATTRIBUTES static inline __attribute__((__always_inline__,__artificial__))
   #define WAV_OVERLOAD_ATTRIBUTES static inline __attribute__((__always_inline__,__overloadable__))
+  #define WAV_RELAXED_FUNCTION_ATTRIBUTES WAV_FUNCTION_ATTRIBUTES
+  #define WAV_RELAXED_OVERLOAD_ATTRIBUTES WAV_OVERLOAD_ATTRIBUTES
+  #define WAV_KERNEL_ATTRIBUTES static inline
 #else
   #define WAV_PORTABLE_SLOW(bugnum) 0
   #define WAV_FUNCTION_ATTRIBUTES static inline __attribute__(( __artificial__ ,__target__("simd128"),__always_inline__))
   #define WAV_OVERLOAD_ATTRIBUTES static inline __attribute__((__overloadable__,__target__("simd128"),__always_inline__))
+  #define WAV_RELAXED_FUNCTION_ATTRIBUTES static inline __attribute__(( __artificial__ ,__target__("simd128,relaxed-simd"),__always_inline__))
+  #define WAV_RELAXED_OVERLOAD_ATTRIBUTES static inline __attribute__((__overloadable__,__target__("simd128,relaxed-simd"),__always_inline__))
+  #define WAV_KERNEL_ATTRIBUTES static inline __attribute__((__target__("simd128")))
+#endif
+
+/* WAV_KERNEL_ATTRIBUTES is for the loops in the companion headers
+ * (wav_array.h, etc.); unlike the other functions they aren't forced
+ * inline, so the compiler is free to keep one copy. */
+
+/* If you define WAV_WARN_SLOW to 1 prior to including this header,
+ * each WAV_PORTABLE_SLOW implementation which ends up in your code
+ * generates a warning (-Wattribute-warning) naming the LLVM bug,
+ * attributed to the function it was inlined into.  Since the warning
+ * comes from the backend, only code which is actually emitted is
+ * reported; to get a list of every slow path a translation unit
+ * pulled in, build it with WAV_WARN_SLOW=1 and filter the output:
+ *
+ *   clang ... -DWAV_WARN_SLOW=1 -c foo.c 2>&1 | grep -o 'WAV_PORTABLE_SLOW([^)]*)' | sort | uniq -c
+ *
+ * If wav.h is in a system include directory you'll also need
+ * -Wsystem-headers.  This mode adds a call to an empty function to
+ * each slow path, so it is only intended for diagnostic builds.
+ *
+ * Natively there are no slow paths, so WAV_PORTABLE_SLOW_PATH expands
+ * to nothing there; that lets generic code which is only slow when
+ * emulating (load_lane, extmul_low, etc.) carry the marker. */
+#if !defined(WAV_WARN_SLOW)
+  #define WAV_WARN_SLOW 0
+#endif
+
+#if WAV_WARN_SLOW && WAV_PORTABLE_SLOW(0)
+  #define WAV_DEFINE_SLOW_PATH_(bugnum, description) \
+    static __attribute__((__noinline__,__unused__,__warning__("WAV_PORTABLE_SLOW(" #bugnum "): " description))) \
+    void wav_portable_slow_##bugnum##_(void) { \
+      __asm__ __volatile__(""); \
+    }
+
+  WAV_DEFINE_SLOW_PATH_(TODO, "portable implementation may be slow; no LLVM bug filed yet")
+  WAV_DEFINE_SLOW_PATH_(50232, "portable implementation may be slow; see LLVM bug 50232")
+  WAV_DEFINE_SLOW_PATH_(50247, "portable implementation may be slow; see LLVM bug 50247")
+  WAV_DEFINE_SLOW_PATH_(50792, "portable implementation may be slow; see LLVM bug 50792")
+  WAV_DEFINE_SLOW_PATH_(50793, "portable implementation may be slow; see LLVM bug 50793")
+  WAV_DEFINE_SLOW_PATH_(50794, "portable implementation may be slow; see LLVM bug 50794")
+  WAV_DEFINE_SLOW_PATH_(50795, "portable implementation may be slow; see LLVM bug 50795")
+  WAV_DEFINE_SLOW_PATH_(50796, "portable implementation may be slow; see LLVM bug 50796")
+  WAV_DEFINE_SLOW_PATH_(50798, "portable implementation may be slow; see LLVM bug 50798")
+  WAV_DEFINE_SLOW_PATH_(50799, "portable implementation may be slow; see LLVM bug 50799")
+  WAV_DEFINE_SLOW_PATH_(50800, "portable implementation may be slow; see LLVM bug 50800")
+  WAV_DEFINE_SLOW_PATH_(50805, "portable implementation may be slow; see LLVM bug 50805")
+  WAV_DEFINE_SLOW_PATH_(50806, "portable implementation may be slow; see LLVM bug 50806")
+  WAV_DEFINE_SLOW_PATH_(50808, "portable implementation may be slow; see LLVM bug 50808")
+  WAV_DEFINE_SLOW_PATH_(50810, "portable implementation may be slow; see LLVM bug 50810")
+
+  /* Every WAV_PORTABLE_SLOW branch starts with this.  If you add a
+   * new bug number, add it to the list above. */
+  #define WAV_PORTABLE_SLOW_PATH(bugnum) wav_portable_slow_##bugnum##_()
+#else
+  #define WAV_PORTABLE_SLOW_PATH(bugnum) ((void) 0)
+#endif
+
+/* When emulating WASM SIMD128 on x86 we can do a lot better than the
+ * portable implementations for many functions by calling the SSE
+ * intrinsics directly.  These are used automatically when the
+ * relevant ISA extension is enabled at compile time (e.g., -msse4.1);
+ * WAV will not add target attributes on its own.  If you would rather
+ * use the portable implementations (for example, to test them) you
+ * can define WAV_X86_SSE2, WAV_X86_SSSE3, and/or WAV_X86_SSE4_1 to 0
+ * prior to including this header.  Disabling one level also disables
+ * every level above it.  WAV_X86_F16C (the half-precision conversion
+ * instructions) works the same way, and depends on WAV_X86_SSE2.
+ *
+ * All of these implementations must produce the same results as WASM
+ * SIMD128, including for NaNs, saturation, and out-of-range indices,
+ * so some of them are a bit more involved than a single intrinsic.
+ *
+ * If WAV_X86_DISPATCH is defined to 1 (wav_dispatch.h does this) and
+ * SSE2 is available, the SSSE3 and SSE4.1 implementations which are
+ * not enabled at compile time are compiled anyway, using the target
+ * attribute, and each function checks __builtin_cpu_supports before
+ * falling back on the SSE2 or portable version.  The check is a test
+ * of a bit in a global the compiler knows can't alias vectors, so it
+ * is normally hoisted out of loops, and in code compiled for a target
+ * which includes the extension the SSSE3/SSE4.1 version is inlined.
+ * Levels which were explicitly disabled stay disabled. */
+#if !defined(__wasm_simd128__) && (defined(WAV_EMULATION) && (WAV_EMULATION == 1))
+  #if !defined(WAV_X86_DISPATCH)
+    #define WAV_X86_DISPATCH 0
+  #endif
+
+  #if !defined(WAV_X86_SSE2)
+    #if defined(__SSE2__)
+      #define WAV_X86_SSE2 1
+    #else
+      #define WAV_X86_SSE2 0
+    #endif
+  #endif
+
+  #if !defined(WAV_X86_SSSE3)
+    #if defined(__SSSE3__)
+      #define WAV_X86_SSSE3 WAV_X86_SSE2
+    #else
+      #define WAV_X86_SSSE3 0
+      #define WAV_X86_SSSE3_DISPATCH_ (WAV_X86_SSE2 && WAV_X86_DISPATCH)
+    #endif
+  #endif
+  #if !defined(WAV_X86_SSSE3_DISPATCH_)
+    #define WAV_X86_SSSE3_DISPATCH_ 0
+  #endif
+
+  #if !defined(WAV_X86_SSE4_1)
+    #if defined(__SSE4_1__)
+      #define WAV_X86_SSE4_1 WAV_X86_SSSE3
+    #else
+      #define WAV_X86_SSE4_1 0
+      #define WAV_X86_SSE4_1_DISPATCH_ ((WAV_X86_SSSE3 || WAV_X86_SSSE3_DISPATCH_) && WAV_X86_DISPATCH)
+    #endif
+  #endif
+  #if !defined(WAV_X86_SSE4_1_DISPATCH_)
+    #define WAV_X86_SSE4_1_DISPATCH_ 0
+  #endif
+
+  #if !defined(WAV_X86_F16C)
+    #if defined(__F16C__)
+      #define WAV_X86_F16C WAV_X86_SSE2
+    #else
+      #define WAV_X86_F16C 0
+    #endif
+  #endif
+
+  #if WAV_X86_SSE2
+    #include <immintrin.h>
+  #endif
+#else
+  #undef WAV_X86_SSE2
+  #undef WAV_X86_SSSE3
+  #undef WAV_X86_SSE4_1
+  #undef WAV_X86_F16C
+  #undef WAV_X86_DISPATCH
+  #define WAV_X86_SSE2 0
+  #define WAV_X86_SSSE3 0
+  #define WAV_X86_SSE4_1 0
+  #define WAV_X86_F16C 0
+  #define WAV_X86_DISPATCH 0
+  #define WAV_X86_SSSE3_DISPATCH_ 0
+  #define WAV_X86_SSE4_1_DISPATCH_ 0
+#endif
+
+/* Attributes for the SSSE3 and SSE4.1 versions of functions; these
+ * are only inlined unconditionally when the extension is enabled at
+ * compile time, since they can't be inlined into functions which
+ * don't support it. */
+#if WAV_X86_SSSE3
+  #define WAV_X86_SSSE3_FUNCTION_ATTRIBUTES_ WAV_FUNCTION_ATTRIBUTES
+#else
+  #define WAV_X86_SSSE3_FUNCTION_ATTRIBUTES_ static inline __attribute__((__target__("ssse3")))
+#endif
+
+#if WAV_X86_SSE4_1
+  #define WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_ WAV_FUNCTION_ATTRIBUTES
+#else
+  #define WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_ static inline __attribute__((__target__("sse4.1")))
 #endif
 
 #if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L)
@@ -368,6 +537,36 @@ WAV_DEFINE_REINTERPRET_FUNCTION_( wav_v128_t, wav_b8x16_t, wav_b8x16_as_v128)
 WAV_DEFINE_REINTERPRET_FUNCTION_( wav_v128_t, wav_b16x8_t, wav_b16x8_as_v128)
 WAV_DEFINE_REINTERPRET_FUNCTION_( wav_v128_t, wav_b32x4_t, wav_b32x4_as_v128)
 WAV_DEFINE_REINTERPRET_FUNCTION_( wav_v128_t, wav_b64x2_t, wav_b64x2_as_v128)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t, wav_i8x16_t, wav_i8x16_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t, wav_i16x8_t, wav_i16x8_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t, wav_i32x4_t, wav_i32x4_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t, wav_i64x2_t, wav_i64x2_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t, wav_u8x16_t, wav_u8x16_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t, wav_u16x8_t, wav_u16x8_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t, wav_u32x4_t, wav_u32x4_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t, wav_u64x2_t, wav_u64x2_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t, wav_f32x4_t, wav_f32x4_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t, wav_f64x2_t, wav_f64x2_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t, wav_b8x16_t, wav_b8x16_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t, wav_b16x8_t, wav_b16x8_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t, wav_b32x4_t, wav_b32x4_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t, wav_b64x2_t, wav_b64x2_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f16x8_t,  wav_v128_t, wav_v128_as_f16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_i8x16_t, wav_f16x8_t, wav_f16x8_as_i8x16)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_i16x8_t, wav_f16x8_t, wav_f16x8_as_i16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_i32x4_t, wav_f16x8_t, wav_f16x8_as_i32x4)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_i64x2_t, wav_f16x8_t, wav_f16x8_as_i64x2)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_u8x16_t, wav_f16x8_t, wav_f16x8_as_u8x16)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_u16x8_t, wav_f16x8_t, wav_f16x8_as_u16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_u32x4_t, wav_f16x8_t, wav_f16x8_as_u32x4)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_u64x2_t, wav_f16x8_t, wav_f16x8_as_u64x2)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f32x4_t, wav_f16x8_t, wav_f16x8_as_f32x4)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_f64x2_t, wav_f16x8_t, wav_f16x8_as_f64x2)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_b8x16_t, wav_f16x8_t, wav_f16x8_as_b8x16)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_b16x8_t, wav_f16x8_t, wav_f16x8_as_b16x8)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_b32x4_t, wav_f16x8_t, wav_f16x8_as_b32x4)
+WAV_DEFINE_REINTERPRET_FUNCTION_(wav_b64x2_t, wav_f16x8_t, wav_f16x8_as_b64x2)
+WAV_DEFINE_REINTERPRET_FUNCTION_( wav_v128_t, wav_f16x8_t, wav_f16x8_as_v128)
 
 WAV_OVERLOAD_ATTRIBUTES wav_i8x16_t wav_as_i8x16(wav_i16x8_t value) { return wav_i16x8_as_i8x16(value); }
 WAV_OVERLOAD_ATTRIBUTES wav_i8x16_t wav_as_i8x16(wav_i32x4_t value) { return wav_i32x4_as_i8x16(value); }
@@ -579,6 +778,36 @@ WAV_OVERLOAD_ATTRIBUTES  wav_v128_t  wav_as_v128(wav_b8x16_t value) { return  wa
 WAV_OVERLOAD_ATTRIBUTES  wav_v128_t  wav_as_v128(wav_b16x8_t value) { return  wav_b16x8_as_v128(value); }
 WAV_OVERLOAD_ATTRIBUTES  wav_v128_t  wav_as_v128(wav_b32x4_t value) { return  wav_b32x4_as_v128(value); }
 WAV_OVERLOAD_ATTRIBUTES  wav_v128_t  wav_as_v128(wav_b64x2_t value) { return  wav_b64x2_as_v128(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8(wav_i8x16_t value) { return wav_i8x16_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8(wav_i16x8_t value) { return wav_i16x8_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8(wav_i32x4_t value) { return wav_i32x4_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8(wav_i64x2_t value) { return wav_i64x2_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8(wav_u8x16_t value) { return wav_u8x16_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8(wav_u16x8_t value) { return wav_u16x8_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8(wav_u32x4_t value) { return wav_u32x4_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8(wav_u64x2_t value) { return wav_u64x2_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8(wav_f32x4_t value) { return wav_f32x4_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8(wav_f64x2_t value) { return wav_f64x2_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8(wav_b8x16_t value) { return wav_b8x16_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8(wav_b16x8_t value) { return wav_b16x8_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8(wav_b32x4_t value) { return wav_b32x4_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8(wav_b64x2_t value) { return wav_b64x2_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_as_f16x8( wav_v128_t value) { return  wav_v128_as_f16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_i8x16_t wav_as_i8x16(wav_f16x8_t value) { return wav_f16x8_as_i8x16(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_i16x8_t wav_as_i16x8(wav_f16x8_t value) { return wav_f16x8_as_i16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_i32x4_t wav_as_i32x4(wav_f16x8_t value) { return wav_f16x8_as_i32x4(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_i64x2_t wav_as_i64x2(wav_f16x8_t value) { return wav_f16x8_as_i64x2(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_u8x16_t wav_as_u8x16(wav_f16x8_t value) { return wav_f16x8_as_u8x16(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_u16x8_t wav_as_u16x8(wav_f16x8_t value) { return wav_f16x8_as_u16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_u32x4_t wav_as_u32x4(wav_f16x8_t value) { return wav_f16x8_as_u32x4(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_u64x2_t wav_as_u64x2(wav_f16x8_t value) { return wav_f16x8_as_u64x2(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f32x4_t wav_as_f32x4(wav_f16x8_t value) { return wav_f16x8_as_f32x4(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_as_f64x2(wav_f16x8_t value) { return wav_f16x8_as_f64x2(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_b8x16_t wav_as_b8x16(wav_f16x8_t value) { return wav_f16x8_as_b8x16(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_b16x8_t wav_as_b16x8(wav_f16x8_t value) { return wav_f16x8_as_b16x8(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_b32x4_t wav_as_b32x4(wav_f16x8_t value) { return wav_f16x8_as_b32x4(value); }
+WAV_OVERLOAD_ATTRIBUTES wav_b64x2_t wav_as_b64x2(wav_f16x8_t value) { return wav_f16x8_as_b64x2(value); }
+WAV_OVERLOAD_ATTRIBUTES  wav_v128_t  wav_as_v128(wav_f16x8_t value) { return  wav_f16x8_as_v128(value); }
 
 /* load
  *
@@ -3689,7 +3918,15 @@ wav_u32x4_min(wav_u32x4_t a, wav_u32x4_t b)  {
 WAV_FUNCTION_ATTRIBUTES
 wav_f32x4_t
 wav_f32x4_min(wav_f32x4_t a, wav_f32x4_t b)  {
-  #if WAV_PORTABLE_SLOW(50805)
+  #if WAV_X86_SSE2
+    /* MINP[SD] returns the second operand if either input is NaN or
+     * both are zero.  ORing both orders gives us -0.0 for mixed zeros,
+     * then any lane with a NaN input is replaced with a canonical NaN. */
+    __m128 t = _mm_or_ps(_mm_min_ps(a.values, b.values), _mm_min_ps(b.values, a.values));
+    __m128 n = _mm_cmpunord_ps(a.values, b.values);
+    return (wav_f32x4_t) { _mm_or_ps(_mm_andnot_ps(n, t), _mm_and_ps(n, _mm_set1_ps(__builtin_nanf("")))) };
+  #elif WAV_PORTABLE_SLOW(50805)
+    WAV_PORTABLE_SLOW_PATH(50805);
     return wav_f32x4_blend(
       wav_b32x4_or(
         wav_f32x4_ne(a, a),
@@ -3705,7 +3942,15 @@ wav_f32x4_min(wav_f32x4_t a, wav_f32x4_t b)  {
 WAV_FUNCTION_ATTRIBUTES
 wav_f64x2_t
 wav_f64x2_min(wav_f64x2_t a, wav_f64x2_t b)  {
-  #if WAV_PORTABLE_SLOW(50805)
+  #if WAV_X86_SSE2
+    /* MINP[SD] returns the second operand if either input is NaN or
+     * both are zero.  ORing both orders gives us -0.0 for mixed zeros,
+     * then any lane with a NaN input is replaced with a canonical NaN. */
+    __m128d t = _mm_or_pd(_mm_min_pd(a.values, b.values), _mm_min_pd(b.values, a.values));
+    __m128d n = _mm_cmpunord_pd(a.values, b.values);
+    return (wav_f64x2_t) { _mm_or_pd(_mm_andnot_pd(n, t), _mm_and_pd(n, _mm_set1_pd(__builtin_nan("")))) };
+  #elif WAV_PORTABLE_SLOW(50805)
+    WAV_PORTABLE_SLOW_PATH(50805);
     return wav_f64x2_blend(
       wav_b64x2_or(
         wav_f64x2_ne(a, a),
@@ -3772,7 +4017,13 @@ wav_u32x4_max(wav_u32x4_t a, wav_u32x4_t b)  {
 WAV_FUNCTION_ATTRIBUTES
 wav_f32x4_t
 wav_f32x4_max(wav_f32x4_t a, wav_f32x4_t b)  {
-  #if WAV_PORTABLE_SLOW(50805)
+  #if WAV_X86_SSE2
+    /* See wav_f32x4_min for an explanation. */
+    __m128 t = _mm_and_ps(_mm_max_ps(a.values, b.values), _mm_max_ps(b.values, a.values));
+    __m128 n = _mm_cmpunord_ps(a.values, b.values);
+    return (wav_f32x4_t) { _mm_or_ps(_mm_andnot_ps(n, t), _mm_and_ps(n, _mm_set1_ps(__builtin_nanf("")))) };
+  #elif WAV_PORTABLE_SLOW(50805)
+    WAV_PORTABLE_SLOW_PATH(50805);
     return wav_f32x4_blend(
       wav_b32x4_or(
         wav_f32x4_ne(a, a),
@@ -3788,7 +4039,13 @@ wav_f32x4_max(wav_f32x4_t a, wav_f32x4_t b)  {
 WAV_FUNCTION_ATTRIBUTES
 wav_f64x2_t
 wav_f64x2_max(wav_f64x2_t a, wav_f64x2_t b)  {
-  #if WAV_PORTABLE_SLOW(50805)
+  #if WAV_X86_SSE2
+    /* See wav_f64x2_min for an explanation. */
+    __m128d t = _mm_and_pd(_mm_max_pd(a.values, b.values), _mm_max_pd(b.values, a.values));
+    __m128d n = _mm_cmpunord_pd(a.values, b.values);
+    return (wav_f64x2_t) { _mm_or_pd(_mm_andnot_pd(n, t), _mm_and_pd(n, _mm_set1_pd(__builtin_nan("")))) };
+  #elif WAV_PORTABLE_SLOW(50805)
+    WAV_PORTABLE_SLOW_PATH(50805);
     return wav_f64x2_blend(
       wav_b64x2_or(
         wav_f64x2_ne(a, a),
@@ -3978,22 +4235,38 @@ WAV_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_max(wav_f64x2_t a, wav_f64x2_t b) { retu
  * input vector a specified in the second input vector s.
  */
 
+#if WAV_X86_SSSE3 || WAV_X86_SSSE3_DISPATCH_
+WAV_X86_SSSE3_FUNCTION_ATTRIBUTES_
+wav_i8x16_t
+wav_i8x16_swizzle_ssse3_(wav_i8x16_t data, wav_i8x16_t idx) {
+  /* PSHUFB only looks at the low 4 bits and zeroes the lane if the high
+   * bit is set; adding 0x70 with unsigned saturation pushes every index
+   * above 15 into the high range without disturbing the others. */
+  return (wav_i8x16_t) { (__typeof__(data.values)) _mm_shuffle_epi8((__m128i) data.values, _mm_adds_epu8((__m128i) idx.values, _mm_set1_epi8(0x70))) };
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_i8x16_t
 wav_i8x16_swizzle(wav_i8x16_t data, wav_i8x16_t idx) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSSE3_DISPATCH_
+    if (__builtin_cpu_supports("ssse3"))
+      return wav_i8x16_swizzle_ssse3_(data, idx);
+  #endif
+  #if WAV_X86_SSSE3
+    return wav_i8x16_swizzle_ssse3_(data, idx);
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    /* The two-argument form of __builtin_shufflevector accepts a
+     * variable mask but only looks at the low bits of each index, so
+     * we have to zero out-of-range lanes ourselves.  The comparison
+     * is unsigned so negative indices are out of range, too. */
+    uint8_t uidx __attribute__((__vector_size__(16))) = (__typeof__(uidx)) idx.values;
     wav_i8x16_t r;
-
-    for (int i = 0 ; i < 16 ; i++) {
-      r.values[i] =
-        ((idx.values[i] & 15) == idx.values[i]) ?
-          data.values[idx.values[i]] : 0;
-    }
-
-    #pragma clang diagnostic push /* This is a false positive */
-    #pragma clang diagnostic ignored "-Wconditional-uninitialized"
+    r.values =
+      __builtin_shufflevector(data.values, idx.values & 15) &
+      (__typeof__(r.values)) (uidx < 16);
     return r;
-    #pragma clang diagnostic pop
   #else
     return (wav_i8x16_t) { __builtin_wasm_swizzle_i8x16(data.values, idx.values) };
   #endif
@@ -4340,7 +4613,10 @@ WAV_OVERLOAD_ATTRIBUTES wav_f64x2_t operator-(wav_f64x2_t vec) { return wav_f64x
 WAV_FUNCTION_ATTRIBUTES
 wav_f32x4_t
 wav_f32x4_sqrt(wav_f32x4_t vec) {
-  #if WAV_PORTABLE_SLOW(50247)
+  #if WAV_X86_SSE2
+    return (wav_f32x4_t) { _mm_sqrt_ps(vec.values) };
+  #elif WAV_PORTABLE_SLOW(50247)
+    WAV_PORTABLE_SLOW_PATH(50247);
     wav_f32x4_t r;
 
     for (int i = 0 ; i < 4 ; i++) {
@@ -4359,7 +4635,10 @@ wav_f32x4_sqrt(wav_f32x4_t vec) {
 WAV_FUNCTION_ATTRIBUTES
 wav_f64x2_t
 wav_f64x2_sqrt(wav_f64x2_t vec) {
-  #if WAV_PORTABLE_SLOW(50247)
+  #if WAV_X86_SSE2
+    return (wav_f64x2_t) { _mm_sqrt_pd(vec.values) };
+  #elif WAV_PORTABLE_SLOW(50247)
+    WAV_PORTABLE_SLOW_PATH(50247);
     wav_f64x2_t r;
 
     for (int i = 0 ; i < 2 ; i++) {
@@ -4384,10 +4663,25 @@ WAV_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_sqrt(wav_f64x2_t vec) { return wav_f64x2
  * the input.
  */
 
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_f32x4_t
+wav_f32x4_ceil_sse4_1_(wav_f32x4_t vec) {
+  return (wav_f32x4_t) { _mm_round_ps(vec.values, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC) };
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_f32x4_t
 wav_f32x4_ceil(wav_f32x4_t vec) {
-  #if WAV_PORTABLE_SLOW(50247)
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_f32x4_ceil_sse4_1_(vec);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_f32x4_ceil_sse4_1_(vec);
+  #elif WAV_PORTABLE_SLOW(50247)
+    WAV_PORTABLE_SLOW_PATH(50247);
     wav_f32x4_t r;
 
     for (int i = 0 ; i < 4 ; i++) {
@@ -4403,10 +4697,25 @@ wav_f32x4_ceil(wav_f32x4_t vec) {
   #endif
 }
 
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_f64x2_t
+wav_f64x2_ceil_sse4_1_(wav_f64x2_t vec) {
+  return (wav_f64x2_t) { _mm_round_pd(vec.values, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC) };
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_f64x2_t
 wav_f64x2_ceil(wav_f64x2_t vec) {
-  #if WAV_PORTABLE_SLOW(50247)
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_f64x2_ceil_sse4_1_(vec);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_f64x2_ceil_sse4_1_(vec);
+  #elif WAV_PORTABLE_SLOW(50247)
+    WAV_PORTABLE_SLOW_PATH(50247);
     wav_f64x2_t r;
 
     for (int i = 0 ; i < 2 ; i++) {
@@ -4431,10 +4740,25 @@ WAV_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_ceil(wav_f64x2_t vec) { return wav_f64x2
  * the input.
  */
 
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_f32x4_t
+wav_f32x4_floor_sse4_1_(wav_f32x4_t vec) {
+  return (wav_f32x4_t) { _mm_round_ps(vec.values, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC) };
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_f32x4_t
 wav_f32x4_floor(wav_f32x4_t vec) {
-  #if WAV_PORTABLE_SLOW(50247)
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_f32x4_floor_sse4_1_(vec);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_f32x4_floor_sse4_1_(vec);
+  #elif WAV_PORTABLE_SLOW(50247)
+    WAV_PORTABLE_SLOW_PATH(50247);
     wav_f32x4_t r;
 
     for (int i = 0 ; i < 4 ; i++) {
@@ -4450,10 +4774,25 @@ wav_f32x4_floor(wav_f32x4_t vec) {
   #endif
 }
 
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_f64x2_t
+wav_f64x2_floor_sse4_1_(wav_f64x2_t vec) {
+  return (wav_f64x2_t) { _mm_round_pd(vec.values, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC) };
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_f64x2_t
 wav_f64x2_floor(wav_f64x2_t vec) {
-  #if WAV_PORTABLE_SLOW(50247)
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_f64x2_floor_sse4_1_(vec);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_f64x2_floor_sse4_1_(vec);
+  #elif WAV_PORTABLE_SLOW(50247)
+    WAV_PORTABLE_SLOW_PATH(50247);
     wav_f64x2_t r;
 
     for (int i = 0 ; i < 2 ; i++) {
@@ -4478,10 +4817,25 @@ WAV_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_floor(wav_f64x2_t vec) { return wav_f64x
  * not larger than the input.
  */
 
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_f32x4_t
+wav_f32x4_trunc_sse4_1_(wav_f32x4_t vec) {
+  return (wav_f32x4_t) { _mm_round_ps(vec.values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC) };
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_f32x4_t
 wav_f32x4_trunc(wav_f32x4_t vec) {
-  #if WAV_PORTABLE_SLOW(50247)
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_f32x4_trunc_sse4_1_(vec);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_f32x4_trunc_sse4_1_(vec);
+  #elif WAV_PORTABLE_SLOW(50247)
+    WAV_PORTABLE_SLOW_PATH(50247);
     wav_f32x4_t r;
 
     for (int i = 0 ; i < 4 ; i++) {
@@ -4497,10 +4851,25 @@ wav_f32x4_trunc(wav_f32x4_t vec) {
   #endif
 }
 
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_f64x2_t
+wav_f64x2_trunc_sse4_1_(wav_f64x2_t vec) {
+  return (wav_f64x2_t) { _mm_round_pd(vec.values, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC) };
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_f64x2_t
 wav_f64x2_trunc(wav_f64x2_t vec) {
-  #if WAV_PORTABLE_SLOW(50247)
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_f64x2_trunc_sse4_1_(vec);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_f64x2_trunc_sse4_1_(vec);
+  #elif WAV_PORTABLE_SLOW(50247)
+    WAV_PORTABLE_SLOW_PATH(50247);
     wav_f64x2_t r;
 
     for (int i = 0 ; i < 2 ; i++) {
@@ -4525,14 +4894,29 @@ WAV_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_trunc(wav_f64x2_t vec) { return wav_f64x
  * equally near, rounds to the even one.
  */
 
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_f32x4_t
+wav_f32x4_nearest_sse4_1_(wav_f32x4_t vec) {
+  return (wav_f32x4_t) { _mm_round_ps(vec.values, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) };
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_f32x4_t
 wav_f32x4_nearest(wav_f32x4_t vec) {
-  #if WAV_PORTABLE_SLOW(50247)
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_f32x4_nearest_sse4_1_(vec);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_f32x4_nearest_sse4_1_(vec);
+  #elif WAV_PORTABLE_SLOW(50247)
+    WAV_PORTABLE_SLOW_PATH(50247);
     wav_f32x4_t r;
 
     for (int i = 0 ; i < 4 ; i++) {
-      r.values[i] = __builtin_roundf(vec.values[i]);
+      r.values[i] = __builtin_nearbyintf(vec.values[i]);
     }
 
     #pragma clang diagnostic push /* This is a false positive */
@@ -4544,14 +4928,29 @@ wav_f32x4_nearest(wav_f32x4_t vec) {
   #endif
 }
 
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_f64x2_t
+wav_f64x2_nearest_sse4_1_(wav_f64x2_t vec) {
+  return (wav_f64x2_t) { _mm_round_pd(vec.values, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) };
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_f64x2_t
 wav_f64x2_nearest(wav_f64x2_t vec) {
-  #if WAV_PORTABLE_SLOW(50247)
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_f64x2_nearest_sse4_1_(vec);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_f64x2_nearest_sse4_1_(vec);
+  #elif WAV_PORTABLE_SLOW(50247)
+    WAV_PORTABLE_SLOW_PATH(50247);
     wav_f64x2_t r;
 
     for (int i = 0 ; i < 2 ; i++) {
-      r.values[i] = __builtin_round(vec.values[i]);
+      r.values[i] = __builtin_nearbyint(vec.values[i]);
     }
 
     #pragma clang diagnostic push /* This is a false positive */
@@ -4672,16 +5071,17 @@ WAV_OVERLOAD_ATTRIBUTES wav_u64x2_t wav_extend_low(wav_u32x4_t vec) { return wav
 WAV_FUNCTION_ATTRIBUTES
 wav_f64x2_t
 wav_f32x4_promote_low(wav_f32x4_t vec) {
-  #if WAV_PORTABLE_SLOW(50232)
+  #if WAV_X86_SSE2
+    return (wav_f64x2_t) { _mm_cvtps_pd(vec.values) };
+  #else
+    WAV_PORTABLE_SLOW_PATH(50232);
     wav_f64x2_t r;
     r.values = __builtin_convertvector(__builtin_shufflevector(vec.values, vec.values, 0, 1), __typeof__(r.values));
     return r;
-  #else
-    return (wav_f64x2_t) { __builtin_wasm_promote_low_f32x4_f64x2(vec.values) };
   #endif
 }
 
-WAV_FUNCTION_ATTRIBUTES wav_f64x2_t wav_promote_low(wav_f32x4_t vec) { return wav_f32x4_promote_low(vec); }
+WAV_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_promote_low(wav_f32x4_t vec) { return wav_f32x4_promote_low(vec); }
 
 /* extend_high -- Integer to integer extension
  *
@@ -4792,7 +5192,12 @@ WAV_OVERLOAD_ATTRIBUTES wav_u64x2_t wav_extend_high(wav_u32x4_t vec) { return wa
 WAV_FUNCTION_ATTRIBUTES
 wav_i8x16_t
 wav_i16x8_narrow(wav_i16x8_t a, wav_i16x8_t b) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSE2
+    wav_i8x16_t r;
+    r.values = (__typeof__(r.values)) _mm_packs_epi16((__m128i) a.values, (__m128i) b.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
     wav_i8x16_t r;
     a = wav_i16x8_max(wav_i16x8_min(a, wav_i16x8_splat(INT8_MAX)), wav_i16x8_splat(INT8_MIN));
     b = wav_i16x8_max(wav_i16x8_min(b, wav_i16x8_splat(INT8_MAX)), wav_i16x8_splat(INT8_MIN));
@@ -4806,7 +5211,12 @@ wav_i16x8_narrow(wav_i16x8_t a, wav_i16x8_t b) {
 WAV_FUNCTION_ATTRIBUTES
 wav_i16x8_t
 wav_i32x4_narrow(wav_i32x4_t a, wav_i32x4_t b) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSE2
+    wav_i16x8_t r;
+    r.values = (__typeof__(r.values)) _mm_packs_epi32((__m128i) a.values, (__m128i) b.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
     wav_i16x8_t r;
     a = wav_i32x4_max(wav_i32x4_min(a, wav_i32x4_splat(INT16_MAX)), wav_i32x4_splat(INT16_MIN));
     b = wav_i32x4_max(wav_i32x4_min(b, wav_i32x4_splat(INT16_MAX)), wav_i32x4_splat(INT16_MIN));
@@ -4825,7 +5235,12 @@ WAV_OVERLOAD_ATTRIBUTES wav_i16x8_t wav_narrow(wav_i32x4_t a, wav_i32x4_t b) { r
 WAV_FUNCTION_ATTRIBUTES
 wav_u8x16_t
 wav_i16x8_narrow_u(wav_i16x8_t a, wav_i16x8_t b) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSE2
+    wav_u8x16_t r;
+    r.values = (__typeof__(r.values)) _mm_packus_epi16((__m128i) a.values, (__m128i) b.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
     wav_u8x16_t r;
     a = wav_i16x8_max(wav_i16x8_min(a, wav_i16x8_splat(UINT8_MAX)), wav_i16x8_splat(0));
     b = wav_i16x8_max(wav_i16x8_min(b, wav_i16x8_splat(UINT8_MAX)), wav_i16x8_splat(0));
@@ -4836,10 +5251,27 @@ wav_i16x8_narrow_u(wav_i16x8_t a, wav_i16x8_t b) {
   #endif
 }
 
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_u16x8_t
+wav_i32x4_narrow_u_sse4_1_(wav_i32x4_t a, wav_i32x4_t b) {
+  wav_u16x8_t r;
+  r.values = (__typeof__(r.values)) _mm_packus_epi32((__m128i) a.values, (__m128i) b.values);
+  return r;
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_u16x8_t
 wav_i32x4_narrow_u(wav_i32x4_t a, wav_i32x4_t b) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_i32x4_narrow_u_sse4_1_(a, b);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_i32x4_narrow_u_sse4_1_(a, b);
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
     wav_u16x8_t r;
     a = wav_i32x4_max(wav_i32x4_min(a, wav_i32x4_splat(UINT16_MAX)), wav_i32x4_splat(0));
     b = wav_i32x4_max(wav_i32x4_min(b, wav_i32x4_splat(UINT16_MAX)), wav_i32x4_splat(0));
@@ -4865,21 +5297,16 @@ WAV_OVERLOAD_ATTRIBUTES wav_u16x8_t wav_narrow_u(wav_i32x4_t a, wav_i32x4_t b) {
 WAV_FUNCTION_ATTRIBUTES
 wav_f32x4_t
 wav_f64x2_demote(wav_f64x2_t a) {
-  #if WAV_PORTABLE_SLOW(TODO)
-    return (wav_f32x4_t) { (float) a.values[0], (float) a.values[1], 0.0f, 0.0f };
+  #if WAV_X86_SSE2
+    return (wav_f32x4_t) { _mm_cvtpd_ps(a.values) };
   #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return (wav_f32x4_t) { (float) a.values[0], (float) a.values[1], 0.0f, 0.0f };
+  #else
     wav_f32x4_t r;
     __typeof__(a.values) z = { 0.0, 0.0 };
     r.values = __builtin_convertvector(__builtin_shufflevector(a.values, z, 0, 1, 2, 3), __typeof__(r.values));
     return r;
-  #elif WAV_PORTABLE_SLOW(TODO)
-    wav_f32x4_t r;
-    float f32x2_a __attribute__((__vector_size__(8))) = __builtin_convertvector(a.values, __typeof__(f32x2_a));
-    __typeof__(f32x2_a) f32x2_z = { 0.0f, 0.0f };
-    r.values = __builtin_shufflevector(f32x2_a, f32x2_z, 0, 1, 2, 3);
-    return r;
-  #else
-    return (wav_f32x4_t) { __builtin_wasm_demote_zero_f64x2_f32x4(a.values) };
   #endif
 }
 
@@ -4942,21 +5369,30 @@ wav_i32x4_t
 wav_f32x4_trunc_sat_i32x4(wav_f32x4_t a) {
   wav_i32x4_t r;
 
-  #if !defined(__wasm_simd128__)
-    a =
-      wav_f32x4_and_b32x4(
-        wav_f32x4_min(
-          wav_f32x4_max(
-            a,
-            wav_f32x4_splat((float) INT32_MIN)
+  #if WAV_X86_SSE2
+    /* CVTTPS2DQ returns INT32_MIN for anything out of range (including
+     * NaN), so we only need to fix up NaN and positive overflow. */
+    __m128i t = _mm_cvttps_epi32(a.values);
+    t = _mm_xor_si128(t, _mm_castps_si128(_mm_cmpge_ps(a.values, _mm_set1_ps(2147483648.0f))));
+    t = _mm_and_si128(t, _mm_castps_si128(_mm_cmpord_ps(a.values, a.values)));
+    r.values = (__typeof__(r.values)) t;
+  #else
+    #if !defined(__wasm_simd128__)
+      a =
+        wav_f32x4_and_b32x4(
+          wav_f32x4_min(
+            wav_f32x4_max(
+              a,
+              wav_f32x4_splat((float) INT32_MIN)
+            ),
+            wav_f32x4_splat((float) INT32_MAX)
           ),
-          wav_f32x4_splat((float) INT32_MAX)
-        ),
-        wav_f32x4_eq(a, a)
-      );
-  #endif
+          wav_f32x4_eq(a, a)
+        );
+    #endif
 
-  r.values = __builtin_convertvector(a.values, __typeof__(r.values));
+    r.values = __builtin_convertvector(a.values, __typeof__(r.values));
+  #endif
 
   return r;
 }
@@ -4966,21 +5402,33 @@ wav_u32x4_t
 wav_f32x4_trunc_sat_u32x4(wav_f32x4_t a) {
   wav_u32x4_t r;
 
-  #if !defined(__wasm_simd128__)
-    a =
-      wav_f32x4_and_b32x4(
-        wav_f32x4_min(
-          wav_f32x4_max(
-            a,
-            wav_f32x4_splat(0.0f)
+  #if WAV_X86_SSE2
+    /* MAXPS returns the second operand for NaN, so this takes care of
+     * both negative numbers and NaN.  Values >= 2^31 are converted
+     * after subtracting 2^31, then anything >= 2^32 saturates. */
+    __m128 v = _mm_max_ps(a.values, _mm_setzero_ps());
+    __m128 two31 = _mm_set1_ps(2147483648.0f);
+    __m128i lo = _mm_cvttps_epi32(v);
+    __m128i hi = _mm_and_si128(_mm_cvttps_epi32(_mm_sub_ps(v, two31)), _mm_castps_si128(_mm_cmpge_ps(v, two31)));
+    __m128i ovf = _mm_castps_si128(_mm_cmpge_ps(v, _mm_set1_ps(4294967296.0f)));
+    r.values = (__typeof__(r.values)) _mm_or_si128(_mm_or_si128(lo, hi), ovf);
+  #else
+    #if !defined(__wasm_simd128__)
+      a =
+        wav_f32x4_and_b32x4(
+          wav_f32x4_min(
+            wav_f32x4_max(
+              a,
+              wav_f32x4_splat(0.0f)
+            ),
+            wav_f32x4_splat((float) UINT32_MAX)
           ),
-          wav_f32x4_splat((float) UINT32_MAX)
-        ),
-        wav_f32x4_eq(a, a)
-      );
-  #endif
+          wav_f32x4_eq(a, a)
+        );
+    #endif
 
-  r.values = __builtin_convertvector(a.values, __typeof__(r.values));
+    r.values = __builtin_convertvector(a.values, __typeof__(r.values));
+  #endif
 
   return r;
 }
@@ -4993,7 +5441,16 @@ WAV_OVERLOAD_ATTRIBUTES wav_u32x4_t wav_trunc_sat_u32x4(wav_f32x4_t a) { return
 WAV_FUNCTION_ATTRIBUTES
 wav_i32x4_t
 wav_f64x2_trunc_sat_zero_i32x4(wav_f64x2_t a) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSE2
+    /* CVTTPD2DQ already zeroes the upper lanes and returns INT32_MIN on
+     * negative overflow; clamp the top and zero out NaNs first. */
+    __m128d v = _mm_and_pd(a.values, _mm_cmpord_pd(a.values, a.values));
+    v = _mm_min_pd(v, _mm_set1_pd((double) INT32_MAX));
+    wav_i32x4_t r;
+    r.values = (__typeof__(r.values)) _mm_cvttpd_epi32(v);
+    return r;
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
     wav_i32x4_t r;
 
     #if !defined(__wasm_simd128__)
@@ -5023,14 +5480,35 @@ wav_f64x2_trunc_sat_zero_i32x4(wav_f64x2_t a) {
 
     return r;
   #else
-    return (wav_i32x4_t) { __builtin_wasm_trunc_sat_zero_s_f64x2_i32x4(a.values) };
+    return (wav_i32x4_t) { __builtin_wasm_trunc_sat_s_zero_f64x2_i32x4(a.values) };
   #endif
 }
 
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_u32x4_t
+wav_f64x2_trunc_sat_zero_u32x4_sse4_1_(wav_f64x2_t a) {
+  /* Clamp (MAXPD also turns NaN into 0), truncate, then shift into
+   * the signed range so CVTTPD2DQ can handle it. */
+  __m128d v = _mm_min_pd(_mm_max_pd(a.values, _mm_setzero_pd()), _mm_set1_pd((double) UINT32_MAX));
+  v = _mm_sub_pd(_mm_round_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC), _mm_set1_pd(2147483648.0));
+  wav_u32x4_t r;
+  r.values = (__typeof__(r.values)) _mm_xor_si128(_mm_cvttpd_epi32(v), _mm_set_epi32(0, 0, INT32_MIN, INT32_MIN));
+  return r;
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_u32x4_t
 wav_f64x2_trunc_sat_zero_u32x4(wav_f64x2_t a) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_f64x2_trunc_sat_zero_u32x4_sse4_1_(a);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_f64x2_trunc_sat_zero_u32x4_sse4_1_(a);
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
     wav_u32x4_t r;
 
     #if !defined(__wasm_simd128__)
@@ -5060,7 +5538,7 @@ wav_f64x2_trunc_sat_zero_u32x4(wav_f64x2_t a) {
 
     return r;
   #else
-    return (wav_u32x4_t) { __builtin_wasm_trunc_sat_zero_u_f64x2_i32x4(a.values) };
+    return (wav_u32x4_t) { __builtin_wasm_trunc_sat_u_zero_f64x2_i32x4(a.values) };
   #endif
 }
 
@@ -5076,72 +5554,108 @@ WAV_OVERLOAD_ATTRIBUTES wav_u32x4_t wav_trunc_sat_zero_u32x4(wav_f64x2_t a) { re
 WAV_FUNCTION_ATTRIBUTES
 wav_i16x8_t
 wav_i8x16_extmul_low(wav_i8x16_t a, wav_i8x16_t b) {
-  #if WAV_PORTABLE_SLOW(50806)
-    return (wav_i16x8_t) {
-      __builtin_convertvector(
-        __builtin_shufflevector(a, a, 0, 1, 2, 3, 4, 5, 6, 7),
-        __typeof__(int16_t __attribute__((__vector_size__(16))))
-      )
-      *
-      __builtin_convertvector(
-        __builtin_shufflevector(b, b, 0, 1, 2, 3, 4, 5, 6, 7),
-        __typeof__(int16_t __attribute__((__vector_size__(16))))
-      );
-    };
-  #elif WAV_PORTABLE_SLOW(50806)
-    return wav_i16x8_mul(wav_i8x16_extend_low(a), wav_i8x16_extend_low(b));
+  #if WAV_X86_SSE2
+    wav_i16x8_t r;
+    r.values = (__typeof__(r.values)) _mm_mullo_epi16(
+      _mm_srai_epi16(_mm_unpacklo_epi8((__m128i) a.values, (__m128i) a.values), 8),
+      _mm_srai_epi16(_mm_unpacklo_epi8((__m128i) b.values, (__m128i) b.values), 8)
+    );
+    return r;
   #else
-    return (wav_i16x8_t) { __builtin_wasm_extmul_low_i8x16_s_i16x8(a.values, b.values) };
+    WAV_PORTABLE_SLOW_PATH(50806);
+    return wav_i16x8_mul(wav_i8x16_extend_low(a), wav_i8x16_extend_low(b));
   #endif
 }
 
 WAV_FUNCTION_ATTRIBUTES
 wav_i32x4_t
 wav_i16x8_extmul_low(wav_i16x8_t a, wav_i16x8_t b) {
-  #if WAV_PORTABLE_SLOW(50806)
-    return wav_i32x4_mul(wav_i16x8_extend_low(a), wav_i16x8_extend_low(b));
+  #if WAV_X86_SSE2
+    wav_i32x4_t r;
+    r.values = (__typeof__(r.values)) _mm_unpacklo_epi16(
+      _mm_mullo_epi16((__m128i) a.values, (__m128i) b.values),
+      _mm_mulhi_epi16((__m128i) a.values, (__m128i) b.values)
+    );
+    return r;
   #else
-    return (wav_i32x4_t) { __builtin_wasm_extmul_low_i16x8_s_i32x4(a.values, b.values) };
+    WAV_PORTABLE_SLOW_PATH(50806);
+    return wav_i32x4_mul(wav_i16x8_extend_low(a), wav_i16x8_extend_low(b));
   #endif
 }
 
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_i64x2_t
+wav_i32x4_extmul_low_sse4_1_(wav_i32x4_t a, wav_i32x4_t b) {
+  wav_i64x2_t r;
+  r.values = (__typeof__(r.values)) _mm_mul_epi32(
+    _mm_unpacklo_epi32((__m128i) a.values, (__m128i) a.values),
+    _mm_unpacklo_epi32((__m128i) b.values, (__m128i) b.values)
+  );
+  return r;
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_i64x2_t
 wav_i32x4_extmul_low(wav_i32x4_t a, wav_i32x4_t b) {
-  #if WAV_PORTABLE_SLOW(50806)
-    return wav_i64x2_mul(wav_i32x4_extend_low(a), wav_i32x4_extend_low(b));
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_i32x4_extmul_low_sse4_1_(a, b);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_i32x4_extmul_low_sse4_1_(a, b);
   #else
-    return (wav_i64x2_t) { __builtin_wasm_extmul_low_i32x4_s_i64x2(a.values, b.values) };
+    WAV_PORTABLE_SLOW_PATH(50806);
+    return wav_i64x2_mul(wav_i32x4_extend_low(a), wav_i32x4_extend_low(b));
   #endif
 }
 
 WAV_FUNCTION_ATTRIBUTES
 wav_u16x8_t
 wav_u8x16_extmul_low(wav_u8x16_t a, wav_u8x16_t b) {
-  #if WAV_PORTABLE_SLOW(50806)
-    return (wav_u16x8_t) { wav_u8x16_extend_low(a).values * wav_u8x16_extend_low(b).values };
+  #if WAV_X86_SSE2
+    wav_u16x8_t r;
+    r.values = (__typeof__(r.values)) _mm_mullo_epi16(
+      _mm_unpacklo_epi8((__m128i) a.values, _mm_setzero_si128()),
+      _mm_unpacklo_epi8((__m128i) b.values, _mm_setzero_si128())
+    );
+    return r;
   #else
-    return (wav_u16x8_t) { __builtin_wasm_extmul_low_i8x16_u_i16x8(a.values, b.values) };
+    WAV_PORTABLE_SLOW_PATH(50806);
+    return (wav_u16x8_t) { wav_u8x16_extend_low(a).values * wav_u8x16_extend_low(b).values };
   #endif
 }
 
 WAV_FUNCTION_ATTRIBUTES
 wav_u32x4_t
 wav_u16x8_extmul_low(wav_u16x8_t a, wav_u16x8_t b) {
-  #if WAV_PORTABLE_SLOW(50806)
-    return (wav_u32x4_t) { wav_u16x8_extend_low(a).values * wav_u16x8_extend_low(b).values };
+  #if WAV_X86_SSE2
+    wav_u32x4_t r;
+    r.values = (__typeof__(r.values)) _mm_unpacklo_epi16(
+      _mm_mullo_epi16((__m128i) a.values, (__m128i) b.values),
+      _mm_mulhi_epu16((__m128i) a.values, (__m128i) b.values)
+    );
+    return r;
   #else
-    return (wav_u32x4_t) { __builtin_wasm_extmul_low_i16x8_u_i32x4(a.values, b.values) };
+    WAV_PORTABLE_SLOW_PATH(50806);
+    return (wav_u32x4_t) { wav_u16x8_extend_low(a).values * wav_u16x8_extend_low(b).values };
   #endif
 }
 
 WAV_FUNCTION_ATTRIBUTES
 wav_u64x2_t
 wav_u32x4_extmul_low(wav_u32x4_t a, wav_u32x4_t b) {
-  #if WAV_PORTABLE_SLOW(50806)
-    return (wav_u64x2_t) { wav_u32x4_extend_low(a).values * wav_u32x4_extend_low(b).values };
+  #if WAV_X86_SSE2
+    wav_u64x2_t r;
+    r.values = (__typeof__(r.values)) _mm_mul_epu32(
+      _mm_unpacklo_epi32((__m128i) a.values, (__m128i) a.values),
+      _mm_unpacklo_epi32((__m128i) b.values, (__m128i) b.values)
+    );
+    return r;
   #else
-    return (wav_u64x2_t) { __builtin_wasm_extmul_low_i32x4_u_i64x2(a.values, b.values) };
+    WAV_PORTABLE_SLOW_PATH(50806);
+    return (wav_u64x2_t) { wav_u32x4_extend_low(a).values * wav_u32x4_extend_low(b).values };
   #endif
 }
 
@@ -5161,60 +5675,108 @@ WAV_OVERLOAD_ATTRIBUTES wav_u64x2_t wav_extmul_low(wav_u32x4_t a, wav_u32x4_t b)
 WAV_FUNCTION_ATTRIBUTES
 wav_i16x8_t
 wav_i8x16_extmul_high(wav_i8x16_t a, wav_i8x16_t b) {
-  #if WAV_PORTABLE_SLOW(50806)
-    return wav_i16x8_mul(wav_i8x16_extend_high(a), wav_i8x16_extend_high(b));
+  #if WAV_X86_SSE2
+    wav_i16x8_t r;
+    r.values = (__typeof__(r.values)) _mm_mullo_epi16(
+      _mm_srai_epi16(_mm_unpackhi_epi8((__m128i) a.values, (__m128i) a.values), 8),
+      _mm_srai_epi16(_mm_unpackhi_epi8((__m128i) b.values, (__m128i) b.values), 8)
+    );
+    return r;
   #else
-    return (wav_i16x8_t) { __builtin_wasm_extmul_high_i8x16_s_i16x8(a.values, b.values) };
+    WAV_PORTABLE_SLOW_PATH(50806);
+    return wav_i16x8_mul(wav_i8x16_extend_high(a), wav_i8x16_extend_high(b));
   #endif
 }
 
 WAV_FUNCTION_ATTRIBUTES
 wav_i32x4_t
 wav_i16x8_extmul_high(wav_i16x8_t a, wav_i16x8_t b) {
-  #if WAV_PORTABLE_SLOW(50806)
-    return wav_i32x4_mul(wav_i16x8_extend_high(a), wav_i16x8_extend_high(b));
+  #if WAV_X86_SSE2
+    wav_i32x4_t r;
+    r.values = (__typeof__(r.values)) _mm_unpackhi_epi16(
+      _mm_mullo_epi16((__m128i) a.values, (__m128i) b.values),
+      _mm_mulhi_epi16((__m128i) a.values, (__m128i) b.values)
+    );
+    return r;
   #else
-    return (wav_i32x4_t) { __builtin_wasm_extmul_high_i16x8_s_i32x4(a.values, b.values) };
+    WAV_PORTABLE_SLOW_PATH(50806);
+    return wav_i32x4_mul(wav_i16x8_extend_high(a), wav_i16x8_extend_high(b));
   #endif
 }
 
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_i64x2_t
+wav_i32x4_extmul_high_sse4_1_(wav_i32x4_t a, wav_i32x4_t b) {
+  wav_i64x2_t r;
+  r.values = (__typeof__(r.values)) _mm_mul_epi32(
+    _mm_unpackhi_epi32((__m128i) a.values, (__m128i) a.values),
+    _mm_unpackhi_epi32((__m128i) b.values, (__m128i) b.values)
+  );
+  return r;
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_i64x2_t
 wav_i32x4_extmul_high(wav_i32x4_t a, wav_i32x4_t b) {
-  #if WAV_PORTABLE_SLOW(50806)
-    return wav_i64x2_mul(wav_i32x4_extend_high(a), wav_i32x4_extend_high(b));
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_i32x4_extmul_high_sse4_1_(a, b);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_i32x4_extmul_high_sse4_1_(a, b);
   #else
-    return (wav_i64x2_t) { __builtin_wasm_extmul_high_i32x4_s_i64x2(a.values, b.values) };
+    WAV_PORTABLE_SLOW_PATH(50806);
+    return wav_i64x2_mul(wav_i32x4_extend_high(a), wav_i32x4_extend_high(b));
   #endif
 }
 
 WAV_FUNCTION_ATTRIBUTES
 wav_u16x8_t
 wav_u8x16_extmul_high(wav_u8x16_t a, wav_u8x16_t b) {
-  #if WAV_PORTABLE_SLOW(50806)
-    return (wav_u16x8_t) { wav_u8x16_extend_high(a).values * wav_u8x16_extend_high(b).values };
+  #if WAV_X86_SSE2
+    wav_u16x8_t r;
+    r.values = (__typeof__(r.values)) _mm_mullo_epi16(
+      _mm_unpackhi_epi8((__m128i) a.values, _mm_setzero_si128()),
+      _mm_unpackhi_epi8((__m128i) b.values, _mm_setzero_si128())
+    );
+    return r;
   #else
-    return (wav_u16x8_t) { __builtin_wasm_extmul_high_i8x16_u_i16x8(a.values, b.values) };
+    WAV_PORTABLE_SLOW_PATH(50806);
+    return (wav_u16x8_t) { wav_u8x16_extend_high(a).values * wav_u8x16_extend_high(b).values };
   #endif
 }
 
 WAV_FUNCTION_ATTRIBUTES
 wav_u32x4_t
 wav_u16x8_extmul_high(wav_u16x8_t a, wav_u16x8_t b) {
-  #if WAV_PORTABLE_SLOW(50806)
-    return (wav_u32x4_t) { wav_u16x8_extend_high(a).values * wav_u16x8_extend_high(b).values };
+  #if WAV_X86_SSE2
+    wav_u32x4_t r;
+    r.values = (__typeof__(r.values)) _mm_unpackhi_epi16(
+      _mm_mullo_epi16((__m128i) a.values, (__m128i) b.values),
+      _mm_mulhi_epu16((__m128i) a.values, (__m128i) b.values)
+    );
+    return r;
   #else
-    return (wav_u32x4_t) { __builtin_wasm_extmul_high_i16x8_u_i32x4(a.values, b.values) };
+    WAV_PORTABLE_SLOW_PATH(50806);
+    return (wav_u32x4_t) { wav_u16x8_extend_high(a).values * wav_u16x8_extend_high(b).values };
   #endif
 }
 
 WAV_FUNCTION_ATTRIBUTES
 wav_u64x2_t
 wav_u32x4_extmul_high(wav_u32x4_t a, wav_u32x4_t b) {
-  #if WAV_PORTABLE_SLOW(50806)
-    return (wav_u64x2_t) { wav_u32x4_extend_high(a).values * wav_u32x4_extend_high(b).values };
+  #if WAV_X86_SSE2
+    wav_u64x2_t r;
+    r.values = (__typeof__(r.values)) _mm_mul_epu32(
+      _mm_unpackhi_epi32((__m128i) a.values, (__m128i) a.values),
+      _mm_unpackhi_epi32((__m128i) b.values, (__m128i) b.values)
+    );
+    return r;
   #else
-    return (wav_u64x2_t) { __builtin_wasm_extmul_high_i32x4_u_i64x2(a.values, b.values) };
+    WAV_PORTABLE_SLOW_PATH(50806);
+    return (wav_u64x2_t) { wav_u32x4_extend_high(a).values * wav_u32x4_extend_high(b).values };
   #endif
 }
 
@@ -5231,10 +5793,27 @@ WAV_OVERLOAD_ATTRIBUTES wav_u64x2_t wav_extmul_high(wav_u32x4_t a, wav_u32x4_t b
  * results (twice wider results than the inputs).
  */
 
+#if WAV_X86_SSSE3 || WAV_X86_SSSE3_DISPATCH_
+WAV_X86_SSSE3_FUNCTION_ATTRIBUTES_
+wav_i16x8_t
+wav_i8x16_extadd_pairwise_ssse3_(wav_i8x16_t v) {
+  wav_i16x8_t r;
+  r.values = (__typeof__(r.values)) _mm_maddubs_epi16(_mm_set1_epi8(1), (__m128i) v.values);
+  return r;
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_i16x8_t
 wav_i8x16_extadd_pairwise(wav_i8x16_t v) {
-  #if WAV_PORTABLE_SLOW(50808)
+  #if WAV_X86_SSSE3_DISPATCH_
+    if (__builtin_cpu_supports("ssse3"))
+      return wav_i8x16_extadd_pairwise_ssse3_(v);
+  #endif
+  #if WAV_X86_SSSE3
+    return wav_i8x16_extadd_pairwise_ssse3_(v);
+  #elif WAV_PORTABLE_SLOW(50808)
+    WAV_PORTABLE_SLOW_PATH(50808);
     wav_i16x8_t r;
     r.values =
       __builtin_convertvector(__builtin_shufflevector(v.values, v.values, 0, 2, 4, 6, 8, 10, 12, 14), __typeof__(r.values)) +
@@ -5248,7 +5827,12 @@ wav_i8x16_extadd_pairwise(wav_i8x16_t v) {
 WAV_FUNCTION_ATTRIBUTES
 wav_i32x4_t
 wav_i16x8_extadd_pairwise(wav_i16x8_t v) {
-  #if WAV_PORTABLE_SLOW(50808)
+  #if WAV_X86_SSE2
+    wav_i32x4_t r;
+    r.values = (__typeof__(r.values)) _mm_madd_epi16((__m128i) v.values, _mm_set1_epi16(1));
+    return r;
+  #elif WAV_PORTABLE_SLOW(50808)
+    WAV_PORTABLE_SLOW_PATH(50808);
     wav_i32x4_t r;
     r.values =
       __builtin_convertvector(__builtin_shufflevector(v.values, v.values, 0, 2, 4, 6), __typeof__(r.values)) +
@@ -5259,10 +5843,27 @@ wav_i16x8_extadd_pairwise(wav_i16x8_t v) {
   #endif
 }
 
+#if WAV_X86_SSSE3 || WAV_X86_SSSE3_DISPATCH_
+WAV_X86_SSSE3_FUNCTION_ATTRIBUTES_
+wav_u16x8_t
+wav_u8x16_extadd_pairwise_ssse3_(wav_u8x16_t v) {
+  wav_u16x8_t r;
+  r.values = (__typeof__(r.values)) _mm_maddubs_epi16((__m128i) v.values, _mm_set1_epi8(1));
+  return r;
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_u16x8_t
 wav_u8x16_extadd_pairwise(wav_u8x16_t v) {
-  #if WAV_PORTABLE_SLOW(50808)
+  #if WAV_X86_SSSE3_DISPATCH_
+    if (__builtin_cpu_supports("ssse3"))
+      return wav_u8x16_extadd_pairwise_ssse3_(v);
+  #endif
+  #if WAV_X86_SSSE3
+    return wav_u8x16_extadd_pairwise_ssse3_(v);
+  #elif WAV_PORTABLE_SLOW(50808)
+    WAV_PORTABLE_SLOW_PATH(50808);
     wav_u16x8_t r;
     r.values =
       __builtin_convertvector(__builtin_shufflevector(v.values, v.values, 0, 2, 4, 6, 8, 10, 12, 14), __typeof__(r.values)) +
@@ -5276,7 +5877,18 @@ wav_u8x16_extadd_pairwise(wav_u8x16_t v) {
 WAV_FUNCTION_ATTRIBUTES
 wav_u32x4_t
 wav_u16x8_extadd_pairwise(wav_u16x8_t v) {
-  #if WAV_PORTABLE_SLOW(50808)
+  #if WAV_X86_SSE2
+    /* PMADDWD is signed-only, so bias the inputs into the signed range
+     * and add the bias (2 * 0x8000) back afterwards. */
+    wav_u32x4_t r;
+    r.values =
+      (__typeof__(r.values)) _mm_add_epi32(
+        _mm_madd_epi16(_mm_xor_si128((__m128i) v.values, _mm_set1_epi16(INT16_MIN)), _mm_set1_epi16(1)),
+        _mm_set1_epi32(0x10000)
+      );
+    return r;
+  #elif WAV_PORTABLE_SLOW(50808)
+    WAV_PORTABLE_SLOW_PATH(50808);
     wav_u32x4_t r;
     r.values =
       __builtin_convertvector(__builtin_shufflevector(v.values, v.values, 0, 2, 4, 6), __typeof__(r.values)) +
@@ -5301,7 +5913,12 @@ WAV_OVERLOAD_ATTRIBUTES wav_u32x4_t wav_extadd_pairwise(wav_u16x8_t v) { return
 WAV_FUNCTION_ATTRIBUTES
 wav_i32x4_t
 wav_i16x8_dot(wav_i16x8_t a, wav_i16x8_t b) {
-  #if WAV_PORTABLE_SLOW(50810)
+  #if WAV_X86_SSE2
+    wav_i32x4_t r;
+    r.values = (__typeof__(r.values)) _mm_madd_epi16((__m128i) a.values, (__m128i) b.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(50810)
+    WAV_PORTABLE_SLOW_PATH(50810);
     int32_t p __attribute__((__vector_size__(32))) =
       __builtin_convertvector(a.values, __typeof__(p)) *
       __builtin_convertvector(b.values, __typeof__(p));
@@ -5324,9 +5941,14 @@ WAV_OVERLOAD_ATTRIBUTES wav_i32x4_t wav_dot(wav_i16x8_t a, wav_i16x8_t b) { retu
 WAV_FUNCTION_ATTRIBUTES
 wav_i8x16_t
 wav_i8x16_add_sat(wav_i8x16_t a, wav_i8x16_t b) {
-  #if WAV_PORTABLE_SLOW(TODO)
-    wav_u8x16_t au = wav_i8x16_as_u8x16(a);
-    wav_u8x16_t bu = wav_i8x16_as_u8x16(b);
+  #if WAV_X86_SSE2
+    wav_i8x16_t r;
+    r.values = (__typeof__(r.values)) _mm_adds_epi8((__m128i) a.values, (__m128i) b.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    wav_u8x16_t au = wav_i8x16_as_u8x16(a);
+    wav_u8x16_t bu = wav_i8x16_as_u8x16(b);
     wav_u8x16_t ru = wav_u8x16_add(au, bu);
 
     au.values = (au.values >> 7) + INT8_MAX;
@@ -5354,7 +5976,12 @@ wav_i8x16_add_sat(wav_i8x16_t a, wav_i8x16_t b) {
 WAV_FUNCTION_ATTRIBUTES
 wav_i16x8_t
 wav_i16x8_add_sat(wav_i16x8_t a, wav_i16x8_t b) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSE2
+    wav_i16x8_t r;
+    r.values = (__typeof__(r.values)) _mm_adds_epi16((__m128i) a.values, (__m128i) b.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
     wav_u16x8_t au = wav_i16x8_as_u16x8(a);
     wav_u16x8_t bu = wav_i16x8_as_u16x8(b);
     wav_u16x8_t ru = wav_u16x8_add(au, bu);
@@ -5384,7 +6011,12 @@ wav_i16x8_add_sat(wav_i16x8_t a, wav_i16x8_t b) {
 WAV_FUNCTION_ATTRIBUTES
 wav_u8x16_t
 wav_u8x16_add_sat(wav_u8x16_t a, wav_u8x16_t b) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSE2
+    wav_u8x16_t r;
+    r.values = (__typeof__(r.values)) _mm_adds_epu8((__m128i) a.values, (__m128i) b.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
     wav_u8x16_t r = wav_u8x16_add(a, b);
     r.values |= r.values < a.values;
     return r;
@@ -5396,7 +6028,12 @@ wav_u8x16_add_sat(wav_u8x16_t a, wav_u8x16_t b) {
 WAV_FUNCTION_ATTRIBUTES
 wav_u16x8_t
 wav_u16x8_add_sat(wav_u16x8_t a, wav_u16x8_t b) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSE2
+    wav_u16x8_t r;
+    r.values = (__typeof__(r.values)) _mm_adds_epu16((__m128i) a.values, (__m128i) b.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
     wav_u16x8_t r = wav_u16x8_add(a, b);
     r.values |= r.values < a.values;
     return r;
@@ -5418,7 +6055,12 @@ WAV_OVERLOAD_ATTRIBUTES wav_u16x8_t wav_add_sat(wav_u16x8_t a, wav_u16x8_t b) {
 WAV_FUNCTION_ATTRIBUTES
 wav_i8x16_t
 wav_i8x16_sub_sat(wav_i8x16_t a, wav_i8x16_t b) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSE2
+    wav_i8x16_t r;
+    r.values = (__typeof__(r.values)) _mm_subs_epi8((__m128i) a.values, (__m128i) b.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
     wav_u8x16_t au = wav_i8x16_as_u8x16(a);
     wav_u8x16_t bu = wav_i8x16_as_u8x16(b);
     wav_u8x16_t ru = wav_u8x16_sub(au, bu);
@@ -5448,7 +6090,12 @@ wav_i8x16_sub_sat(wav_i8x16_t a, wav_i8x16_t b) {
 WAV_FUNCTION_ATTRIBUTES
 wav_i16x8_t
 wav_i16x8_sub_sat(wav_i16x8_t a, wav_i16x8_t b) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSE2
+    wav_i16x8_t r;
+    r.values = (__typeof__(r.values)) _mm_subs_epi16((__m128i) a.values, (__m128i) b.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
     wav_u16x8_t au = wav_i16x8_as_u16x8(a);
     wav_u16x8_t bu = wav_i16x8_as_u16x8(b);
     wav_u16x8_t ru = wav_u16x8_sub(au, bu);
@@ -5478,7 +6125,12 @@ wav_i16x8_sub_sat(wav_i16x8_t a, wav_i16x8_t b) {
 WAV_FUNCTION_ATTRIBUTES
 wav_u8x16_t
 wav_u8x16_sub_sat(wav_u8x16_t a, wav_u8x16_t b) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSE2
+    wav_u8x16_t r;
+    r.values = (__typeof__(r.values)) _mm_subs_epu8((__m128i) a.values, (__m128i) b.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
     wav_u8x16_t r = wav_u8x16_sub(a, b);
     r.values &= r.values <= a.values;
     return r;
@@ -5490,7 +6142,12 @@ wav_u8x16_sub_sat(wav_u8x16_t a, wav_u8x16_t b) {
 WAV_FUNCTION_ATTRIBUTES
 wav_u16x8_t
 wav_u16x8_sub_sat(wav_u16x8_t a, wav_u16x8_t b) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSE2
+    wav_u16x8_t r;
+    r.values = (__typeof__(r.values)) _mm_subs_epu16((__m128i) a.values, (__m128i) b.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
     wav_u16x8_t r = wav_u16x8_sub(a, b);
     r.values &= r.values <= a.values;
     return r;
@@ -5509,10 +6166,31 @@ WAV_OVERLOAD_ATTRIBUTES wav_u16x8_t wav_sub_sat(wav_u16x8_t a, wav_u16x8_t b) {
  * Lane-wise saturating rounding multiplication in Q15 format
  */
 
+#if WAV_X86_SSSE3 || WAV_X86_SSSE3_DISPATCH_
+WAV_X86_SSSE3_FUNCTION_ATTRIBUTES_
+wav_i16x8_t
+wav_i16x8_q15mulr_sat_ssse3_(wav_i16x8_t a, wav_i16x8_t b) {
+  /* PMULHRSW wraps instead of saturating, which only happens for
+   * INT16_MIN * INT16_MIN; no other inputs can produce INT16_MIN, so we
+   * can just flip those lanes to INT16_MAX. */
+  __m128i t = _mm_mulhrs_epi16((__m128i) a.values, (__m128i) b.values);
+  wav_i16x8_t r;
+  r.values = (__typeof__(r.values)) _mm_xor_si128(t, _mm_cmpeq_epi16(t, _mm_set1_epi16(INT16_MIN)));
+  return r;
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_i16x8_t
 wav_i16x8_q15mulr_sat(wav_i16x8_t a, wav_i16x8_t b) {
-  #if WAV_PORTABLE_SLOW(TODO)
+  #if WAV_X86_SSSE3_DISPATCH_
+    if (__builtin_cpu_supports("ssse3"))
+      return wav_i16x8_q15mulr_sat_ssse3_(a, b);
+  #endif
+  #if WAV_X86_SSSE3
+    return wav_i16x8_q15mulr_sat_ssse3_(a, b);
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
     wav_i16x8_t r;
     int32_t __attribute__((__vector_size__(32))) tmp;
 
@@ -5552,7 +6230,10 @@ WAV_OVERLOAD_ATTRIBUTES wav_i16x8_t wav_q15mulr_sat(wav_i16x8_t a, wav_i16x8_t b
 WAV_FUNCTION_ATTRIBUTES
 wav_f32x4_t
 wav_f32x4_pmin(wav_f32x4_t a, wav_f32x4_t b)  {
-  #if WAV_PORTABLE_SLOW(50793)
+  #if WAV_X86_SSE2
+    return (wav_f32x4_t) { _mm_min_ps(b.values, a.values) };
+  #elif WAV_PORTABLE_SLOW(50793)
+    WAV_PORTABLE_SLOW_PATH(50793);
     return wav_f32x4_blend(wav_f32x4_lt(b, a), b, a);
   #else
     return (wav_f32x4_t) { __builtin_wasm_pmin_f32x4(a.values, b.values) };
@@ -5562,7 +6243,10 @@ wav_f32x4_pmin(wav_f32x4_t a, wav_f32x4_t b)  {
 WAV_FUNCTION_ATTRIBUTES
 wav_f64x2_t
 wav_f64x2_pmin(wav_f64x2_t a, wav_f64x2_t b)  {
-  #if WAV_PORTABLE_SLOW(50793)
+  #if WAV_X86_SSE2
+    return (wav_f64x2_t) { _mm_min_pd(b.values, a.values) };
+  #elif WAV_PORTABLE_SLOW(50793)
+    WAV_PORTABLE_SLOW_PATH(50793);
     return wav_f64x2_blend(wav_f64x2_lt(b, a), b, a);
   #else
     return (wav_f64x2_t) { __builtin_wasm_pmin_f64x2(a.values, b.values) };
@@ -5580,7 +6264,10 @@ WAV_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_pmin(wav_f64x2_t a, wav_f64x2_t b) { ret
 WAV_FUNCTION_ATTRIBUTES
 wav_f32x4_t
 wav_f32x4_pmax(wav_f32x4_t a, wav_f32x4_t b)  {
-  #if WAV_PORTABLE_SLOW(50793)
+  #if WAV_X86_SSE2
+    return (wav_f32x4_t) { _mm_max_ps(b.values, a.values) };
+  #elif WAV_PORTABLE_SLOW(50793)
+    WAV_PORTABLE_SLOW_PATH(50793);
     return wav_f32x4_blend(wav_f32x4_lt(a, b), b, a);
   #else
     return (wav_f32x4_t) { __builtin_wasm_pmax_f32x4(a.values, b.values) };
@@ -5590,7 +6277,10 @@ wav_f32x4_pmax(wav_f32x4_t a, wav_f32x4_t b)  {
 WAV_FUNCTION_ATTRIBUTES
 wav_f64x2_t
 wav_f64x2_pmax(wav_f64x2_t a, wav_f64x2_t b)  {
-  #if WAV_PORTABLE_SLOW(50793)
+  #if WAV_X86_SSE2
+    return (wav_f64x2_t) { _mm_max_pd(b.values, a.values) };
+  #elif WAV_PORTABLE_SLOW(50793)
+    WAV_PORTABLE_SLOW_PATH(50793);
     return wav_f64x2_blend(wav_f64x2_lt(a, b), b, a);
   #else
     return (wav_f64x2_t) { __builtin_wasm_pmax_f64x2(a.values, b.values) };
@@ -5608,9 +6298,15 @@ WAV_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_pmax(wav_f64x2_t a, wav_f64x2_t b) { ret
 WAV_FUNCTION_ATTRIBUTES
 wav_u8x16_t
 wav_u8x16_avgr(wav_u8x16_t a, wav_u8x16_t b)  {
-  #if WAV_PORTABLE_SLOW(50794)
+  #if WAV_X86_SSE2
     wav_u8x16_t r;
-    r.values = (a.values + b.values + 1) >> 1;
+    r.values = (__typeof__(r.values)) _mm_avg_epu8((__m128i) a.values, (__m128i) b.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(50794)
+    WAV_PORTABLE_SLOW_PATH(50794);
+    /* (a + b + 1) >> 1 without overflowing the lane. */
+    wav_u8x16_t r;
+    r.values = (a.values | b.values) - ((a.values ^ b.values) >> 1);
     return r;
   #else
     return (wav_u8x16_t) { __builtin_wasm_avgr_u_i8x16(a.values, b.values) };
@@ -5620,9 +6316,15 @@ wav_u8x16_avgr(wav_u8x16_t a, wav_u8x16_t b)  {
 WAV_FUNCTION_ATTRIBUTES
 wav_u16x8_t
 wav_u16x8_avgr(wav_u16x8_t a, wav_u16x8_t b)  {
-  #if WAV_PORTABLE_SLOW(50794)
+  #if WAV_X86_SSE2
     wav_u16x8_t r;
-    r.values = (a.values + b.values + 1) >> 1;
+    r.values = (__typeof__(r.values)) _mm_avg_epu16((__m128i) a.values, (__m128i) b.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(50794)
+    WAV_PORTABLE_SLOW_PATH(50794);
+    /* (a + b + 1) >> 1 without overflowing the lane. */
+    wav_u16x8_t r;
+    r.values = (a.values | b.values) - ((a.values ^ b.values) >> 1);
     return r;
   #else
     return (wav_u16x8_t) { __builtin_wasm_avgr_u_i16x8(a.values, b.values) };
@@ -5672,7 +6374,10 @@ wav_i64x2_abs(wav_i64x2_t a) {
 WAV_FUNCTION_ATTRIBUTES
 wav_f32x4_t
 wav_f32x4_abs(wav_f32x4_t a) {
-  #if WAV_PORTABLE_SLOW(50247)
+  #if WAV_X86_SSE2
+    return (wav_f32x4_t) { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.values) };
+  #elif WAV_PORTABLE_SLOW(50247)
+    WAV_PORTABLE_SLOW_PATH(50247);
     wav_f32x4_t r;
 
     for (int i = 0 ; i < 4 ; i++) {
@@ -5691,7 +6396,10 @@ wav_f32x4_abs(wav_f32x4_t a) {
 WAV_FUNCTION_ATTRIBUTES
 wav_f64x2_t
 wav_f64x2_abs(wav_f64x2_t a) {
-  #if WAV_PORTABLE_SLOW(50247)
+  #if WAV_X86_SSE2
+    return (wav_f64x2_t) { _mm_andnot_pd(_mm_set1_pd(-0.0), a.values) };
+  #elif WAV_PORTABLE_SLOW(50247)
+    WAV_PORTABLE_SLOW_PATH(50247);
     wav_f64x2_t r;
 
     for (int i = 0 ; i < 2 ; i++) {
@@ -5869,20 +6577,43 @@ WAV_OVERLOAD_ATTRIBUTES wav_u64x2_t operator>>(wav_u64x2_t a, int count) { retur
  * Count the number of bits set to one within each lane.
  */
 
+#if WAV_X86_SSSE3 || WAV_X86_SSSE3_DISPATCH_
+WAV_X86_SSSE3_FUNCTION_ATTRIBUTES_
+wav_i8x16_t
+wav_i8x16_popcnt_ssse3_(wav_i8x16_t a) {
+  /* Look up the count for each nibble with PSHUFB, which is much
+   * cheaper than counting bits.  The nibbles are always in range, so
+   * this doesn't need the index fixup wav_u8x16_swizzle does. */
+  const __m128i lut = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  wav_u8x16_t v = wav_i8x16_as_u8x16(a);
+
+  return wav_u8x16_as_i8x16(
+    wav_u8x16_add(
+      (wav_u8x16_t) { (__typeof__(v.values)) _mm_shuffle_epi8(lut, (__m128i) wav_u8x16_and(v, wav_u8x16_splat(15)).values) },
+      (wav_u8x16_t) { (__typeof__(v.values)) _mm_shuffle_epi8(lut, (__m128i) wav_u8x16_shr(v, 4).values) }
+    )
+  );
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 wav_i8x16_t
 wav_i8x16_popcnt(wav_i8x16_t a) {
-  #if WAV_PORTABLE_SLOW(50795)
-    wav_i8x16_t r;
-
-    for (int i = 0 ; i < 16 ; i++) {
-      r.values[i] = (int8_t) __builtin_popcount((unsigned int) a.values[i]);
-    }
-
-    #pragma clang diagnostic push
-    #pragma clang diagnostic ignored "-Wconditional-uninitialized" /* ??? */
-    return r;
-    #pragma clang diagnostic pop
+  #if WAV_X86_SSSE3_DISPATCH_
+    if (__builtin_cpu_supports("ssse3"))
+      return wav_i8x16_popcnt_ssse3_(a);
+  #endif
+  #if WAV_X86_SSSE3
+    return wav_i8x16_popcnt_ssse3_(a);
+  #elif WAV_PORTABLE_SLOW(50795)
+    WAV_PORTABLE_SLOW_PATH(50795);
+    /* Without a native byte shuffle the table lookup is no faster than
+     * the scalar loop, so count the bits in parallel instead. */
+    uint8_t v __attribute__((__vector_size__(16))) = (__typeof__(v)) a.values;
+    v = v - ((v >> 1) & 0x55);
+    v = (v & 0x33) + ((v >> 2) & 0x33);
+    v = (v + (v >> 4)) & 0x0f;
+    return (wav_i8x16_t) { (__typeof__(a.values)) v };
   #else
     return (wav_i8x16_t) { __builtin_wasm_popcnt_i8x16(a.values) };
   #endif
@@ -5902,11 +6633,28 @@ WAV_OVERLOAD_ATTRIBUTES wav_u8x16_t wav_popcnt(wav_u8x16_t a) { return wav_u8x16
  * These functions return 1 if any bit in a is non-zero, 0 otherwise.
  */
 
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+bool
+wav_i64x2_any_true_sse4_1_(wav_i64x2_t value) {
+  return !_mm_testz_si128((__m128i) value.values, (__m128i) value.values);
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 bool
 wav_i64x2_any_true(wav_i64x2_t value) {
-  #if WAV_PORTABLE_SLOW(50796)
-    int32_t r = 0;
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_i64x2_any_true_sse4_1_(value);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_i64x2_any_true_sse4_1_(value);
+  #elif WAV_X86_SSE2
+    return _mm_movemask_epi8(_mm_cmpeq_epi8((__m128i) value.values, _mm_setzero_si128())) != 0xffff;
+  #elif WAV_PORTABLE_SLOW(50796)
+    WAV_PORTABLE_SLOW_PATH(50796);
+    int64_t r = 0;
     for (int i = 0 ; i < 2 ; i++) {
       r |= value.values[i];
     }
@@ -6003,7 +6751,10 @@ WAV_OVERLOAD_ATTRIBUTES bool wav_any_true(wav_b64x2_t a) { return wav_b64x2_any_
 WAV_FUNCTION_ATTRIBUTES
 bool
 wav_i8x16_all_true(wav_i8x16_t value) {
-  #if WAV_PORTABLE_SLOW(50798)
+  #if WAV_X86_SSE2
+    return _mm_movemask_epi8(_mm_cmpeq_epi8((__m128i) value.values, _mm_setzero_si128())) == 0;
+  #elif WAV_PORTABLE_SLOW(50798)
+    WAV_PORTABLE_SLOW_PATH(50798);
     bool r = 1;
     for (int i = 0 ; i < 16 ; i++)
       r &= !!(value.values[i]);
@@ -6016,7 +6767,10 @@ wav_i8x16_all_true(wav_i8x16_t value) {
 WAV_FUNCTION_ATTRIBUTES
 bool
 wav_i16x8_all_true(wav_i16x8_t value) {
-  #if WAV_PORTABLE_SLOW(50798)
+  #if WAV_X86_SSE2
+    return _mm_movemask_epi8(_mm_cmpeq_epi16((__m128i) value.values, _mm_setzero_si128())) == 0;
+  #elif WAV_PORTABLE_SLOW(50798)
+    WAV_PORTABLE_SLOW_PATH(50798);
     bool r = 1;
     for (int i = 0 ; i < 8 ; i++)
       r &= !!(value.values[i]);
@@ -6029,7 +6783,10 @@ wav_i16x8_all_true(wav_i16x8_t value) {
 WAV_FUNCTION_ATTRIBUTES
 bool
 wav_i32x4_all_true(wav_i32x4_t value) {
-  #if WAV_PORTABLE_SLOW(50798)
+  #if WAV_X86_SSE2
+    return _mm_movemask_epi8(_mm_cmpeq_epi32((__m128i) value.values, _mm_setzero_si128())) == 0;
+  #elif WAV_PORTABLE_SLOW(50798)
+    WAV_PORTABLE_SLOW_PATH(50798);
     bool r = 1;
     for (int i = 0 ; i < 4 ; i++)
       r &= !!(value.values[i]);
@@ -6039,10 +6796,29 @@ wav_i32x4_all_true(wav_i32x4_t value) {
   #endif
 }
 
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+bool
+wav_i64x2_all_true_sse4_1_(wav_i64x2_t value) {
+  return _mm_movemask_epi8(_mm_cmpeq_epi64((__m128i) value.values, _mm_setzero_si128())) == 0;
+}
+#endif
+
 WAV_FUNCTION_ATTRIBUTES
 bool
 wav_i64x2_all_true(wav_i64x2_t value) {
-  #if WAV_PORTABLE_SLOW(50798)
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_i64x2_all_true_sse4_1_(value);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_i64x2_all_true_sse4_1_(value);
+  #elif WAV_X86_SSE2
+    __m128i z = _mm_cmpeq_epi32((__m128i) value.values, _mm_setzero_si128());
+    z = _mm_and_si128(z, _mm_shuffle_epi32(z, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_movemask_epi8(z) == 0;
+  #elif WAV_PORTABLE_SLOW(50798)
+    WAV_PORTABLE_SLOW_PATH(50798);
     bool r = 1;
     for (int i = 0 ; i < 2 ; i++)
       r &= !!(value.values[i]);
@@ -6122,21 +6898,15 @@ WAV_OVERLOAD_ATTRIBUTES bool wav_all_true(wav_b64x2_t a) { return wav_b64x2_all_
 WAV_FUNCTION_ATTRIBUTES
 wav_i32x4_t
 wav_i32x4_load_zero(const int32_t * a) {
-  #if WAV_PORTABLE_SLOW(50799)
-    return (wav_i32x4_t) { { *a, 0, 0, 0 } };
-  #else
-    return (wav_i32x4_t) { __builtin_wasm_load32_zero(a) };
-  #endif
+  WAV_PORTABLE_SLOW_PATH(50799);
+  return (wav_i32x4_t) { { *a, 0, 0, 0 } };
 }
 
 WAV_FUNCTION_ATTRIBUTES
 wav_i64x2_t
 wav_i64x2_load_zero(const int64_t * a) {
-  #if WAV_PORTABLE_SLOW(50799)
-    return (wav_i64x2_t) { { *a, 0 } };
-  #else
-    return (wav_i64x2_t) { __builtin_wasm_load64_zero(a) };
-  #endif
+  WAV_PORTABLE_SLOW_PATH(50799);
+  return (wav_i64x2_t) { { *a, 0 } };
 }
 
 WAV_FUNCTION_ATTRIBUTES
@@ -6339,239 +7109,246 @@ wav_f64x2_loadu_splat(const void * a) {
  * bypassed as is.
  */
 
-/* The overloaded version is not implemented yet since the intrinsic
- * is not usable for it; lane must be an ICE, so this has to be
- * implemented as a macro.  */
-
-#if WAV_PORTABLE_SLOW(50792)
-  WAV_FUNCTION_ATTRIBUTES wav_i8x16_t wav_i8x16_load_lane(wav_i8x16_t dest, const int lane, const   int8_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { dest.values[lane] = *src; return v; }
-  WAV_FUNCTION_ATTRIBUTES wav_i16x8_t wav_i16x8_load_lane(wav_i16x8_t dest, const int lane, const  int16_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { dest.values[lane] = *src; return v; }
-  WAV_FUNCTION_ATTRIBUTES wav_i32x4_t wav_i32x4_load_lane(wav_i32x4_t dest, const int lane, const  int32_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { dest.values[lane] = *src; return v; }
-  WAV_FUNCTION_ATTRIBUTES wav_i64x2_t wav_i64x2_load_lane(wav_i64x2_t dest, const int lane, const  int64_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { dest.values[lane] = *src; return v; }
-  WAV_FUNCTION_ATTRIBUTES wav_u8x16_t wav_u8x16_load_lane(wav_u8x16_t dest, const int lane, const  uint8_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { dest.values[lane] = *src; return v; }
-  WAV_FUNCTION_ATTRIBUTES wav_u16x8_t wav_u16x8_load_lane(wav_u16x8_t dest, const int lane, const uint16_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { dest.values[lane] = *src; return v; }
-  WAV_FUNCTION_ATTRIBUTES wav_u32x4_t wav_u32x4_load_lane(wav_u32x4_t dest, const int lane, const uint32_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { dest.values[lane] = *src; return v; }
-  WAV_FUNCTION_ATTRIBUTES wav_u64x2_t wav_u64x2_load_lane(wav_u64x2_t dest, const int lane, const uint64_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { dest.values[lane] = *src; return v; }
-  WAV_FUNCTION_ATTRIBUTES wav_f32x4_t wav_f32x4_load_lane(wav_f32x4_t dest, const int lane, const    float * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { dest.values[lane] = *src; return v; }
-  WAV_FUNCTION_ATTRIBUTES wav_f64x2_t wav_f64x2_load_lane(wav_f64x2_t dest, const int lane, const   double * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { dest.values[lane] = *src; return v; }
-
-  WAV_OVERLOAD_ATTRIBUTES wav_i8x16_t wav_load_lane(wav_i8x16_t dest, const int lane, const   int8_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { dest.values[lane] = *src; return v; }
-  WAV_OVERLOAD_ATTRIBUTES wav_i16x8_t wav_load_lane(wav_i16x8_t dest, const int lane, const  int16_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { dest.values[lane] = *src; return v; }
-  WAV_OVERLOAD_ATTRIBUTES wav_i32x4_t wav_load_lane(wav_i32x4_t dest, const int lane, const  int32_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { dest.values[lane] = *src; return v; }
-  WAV_OVERLOAD_ATTRIBUTES wav_i64x2_t wav_load_lane(wav_i64x2_t dest, const int lane, const  int64_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { dest.values[lane] = *src; return v; }
-  WAV_OVERLOAD_ATTRIBUTES wav_u8x16_t wav_load_lane(wav_u8x16_t dest, const int lane, const  uint8_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { dest.values[lane] = *src; return v; }
-  WAV_OVERLOAD_ATTRIBUTES wav_u16x8_t wav_load_lane(wav_u16x8_t dest, const int lane, const uint16_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { dest.values[lane] = *src; return v; }
-  WAV_OVERLOAD_ATTRIBUTES wav_u32x4_t wav_load_lane(wav_u32x4_t dest, const int lane, const uint32_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { dest.values[lane] = *src; return v; }
-  WAV_OVERLOAD_ATTRIBUTES wav_u64x2_t wav_load_lane(wav_u64x2_t dest, const int lane, const uint64_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { dest.values[lane] = *src; return v; }
-  WAV_OVERLOAD_ATTRIBUTES wav_f32x4_t wav_load_lane(wav_f32x4_t dest, const int lane, const    float * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { dest.values[lane] = *src; return v; }
-  WAV_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_load_lane(wav_f64x2_t dest, const int lane, const   double * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { dest.values[lane] = *src; return v; }
-#else
-  #define wav_i8x16_load_lane(dest, lane, src) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    _Pragma("clang diagnostic ignored \"-Wcast-qual\"") \
-    (wav_i8x16_t) { __builtin_wasm_load8_lane ((int8_t *) (src), (dest).values, (lane)) }; \
-    _Pragma("clang diagnostic pop") \
-  }))
-  #define wav_i16x8_load_lane(dest, lane, src) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    _Pragma("clang diagnostic ignored \"-Wcast-qual\"") \
-    (wav_i16x8_t) { __builtin_wasm_load16_lane((int16_t *) (src), (dest).values, (lane)) }; \
-    _Pragma("clang diagnostic pop") \
-  }))
-  #define wav_i32x4_load_lane(dest, lane, src) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    _Pragma("clang diagnostic ignored \"-Wcast-qual\"") \
-    (wav_i32x4_t) { __builtin_wasm_load32_lane((int32_t *) (src), (dest).values, (lane)) }; \
-    _Pragma("clang diagnostic pop") \
-  }))
-  #define wav_i64x2_load_lane(dest, lane, src) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    _Pragma("clang diagnostic ignored \"-Wcast-qual\"") \
-    (wav_i64x2_t) { __builtin_wasm_load64_lane((int64_t *) (src), (dest).values, (lane)) }; \
-    _Pragma("clang diagnostic pop") \
-  }))
-  #define wav_u8x16_load_lane(dest, lane, src) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    _Pragma("clang diagnostic ignored \"-Wcast-qual\"") \
-    (__typeof__(dest)) { \
-      (__typeof__((dest).values)) __builtin_wasm_load8_lane( \
-        (int8_t *) (value), \
-        (int8_t __attribute__((__vector_size__(16)))) ((dest).values), \
-        (lane) \
-      ) \
-    }; \
-    _Pragma("clang diagnostic pop") \
-  }))
-  #define wav_u16x8_load_lane(dest, lane, src) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    _Pragma("clang diagnostic ignored \"-Wcast-qual\"") \
-    (__typeof__(dest)) { \
-      (__typeof__((dest).values)) __builtin_wasm_load16_lane( \
-        (int16_t *) (src), \
-        (int16_t __attribute__((__vector_size__(16)))) ((dest).values), \
-        (lane) \
-      ) \
-    }; \
-    _Pragma("clang diagnostic pop") \
-  }))
-  #define wav_u32x4_load_lane(dest, lane, src) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    _Pragma("clang diagnostic ignored \"-Wcast-qual\"") \
-    (__typeof__(dest)) { \
-      (__typeof__((dest).values)) __builtin_wasm_load32_lane( \
-        (int32_t *) (src), \
-        (int32_t __attribute__((__vector_size__(16)))) ((dest).values), \
-        (lane) \
-      ) \
-    }; \
-    _Pragma("clang diagnostic pop") \
-  }))
-  #define wav_u64x2_load_lane(dest, lane, src) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    _Pragma("clang diagnostic ignored \"-Wcast-qual\"") \
-    (__typeof__(dest)) { \
-      (__typeof__((dest).values)) __builtin_wasm_load64_lane( \
-        (int64_t *) (src), \
-        (int64_t __attribute__((__vector_size__(16)))) ((dest).values), \
-        (lane) \
-      ) \
-    }; \
-    _Pragma("clang diagnostic pop") \
-  }))
-  #define wav_f32x4_load_lane(dest, lane, src) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    _Pragma("clang diagnostic ignored \"-Wcast-qual\"") \
-    (__typeof__(dest)) { \
-      (__typeof__((dest).values)) __builtin_wasm_load32_lane( \
-        (int32_t *) (src), \
-        (int32_t __attribute__((__vector_size__(16)))) ((dest).values), \
-        (lane) \
-      ) \
-    }; \
-    _Pragma("clang diagnostic pop") \
-  }))
-  #define wav_f64x2_load_lane(dest, lane, src) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    _Pragma("clang diagnostic ignored \"-Wcast-qual\"") \
-    (__typeof__(dest)) { \
-      (__typeof__((dest).values)) __builtin_wasm_load64_lane( \
-        (int64_t *) (src), \
-        (int64_t __attribute__((__vector_size__(16)))) ((dest).values), \
-        (lane) \
-      ) \
-    }; \
-    _Pragma("clang diagnostic pop") \
-  }))
-#endif
+WAV_FUNCTION_ATTRIBUTES wav_i8x16_t wav_i8x16_load_lane(wav_i8x16_t dest, const int lane, const   int8_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_FUNCTION_ATTRIBUTES wav_i16x8_t wav_i16x8_load_lane(wav_i16x8_t dest, const int lane, const  int16_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_FUNCTION_ATTRIBUTES wav_i32x4_t wav_i32x4_load_lane(wav_i32x4_t dest, const int lane, const  int32_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_FUNCTION_ATTRIBUTES wav_i64x2_t wav_i64x2_load_lane(wav_i64x2_t dest, const int lane, const  int64_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_FUNCTION_ATTRIBUTES wav_u8x16_t wav_u8x16_load_lane(wav_u8x16_t dest, const int lane, const  uint8_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_FUNCTION_ATTRIBUTES wav_u16x8_t wav_u16x8_load_lane(wav_u16x8_t dest, const int lane, const uint16_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_FUNCTION_ATTRIBUTES wav_u32x4_t wav_u32x4_load_lane(wav_u32x4_t dest, const int lane, const uint32_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_FUNCTION_ATTRIBUTES wav_u64x2_t wav_u64x2_load_lane(wav_u64x2_t dest, const int lane, const uint64_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_FUNCTION_ATTRIBUTES wav_f32x4_t wav_f32x4_load_lane(wav_f32x4_t dest, const int lane, const    float * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { WAV_PORTABLE_SLOW_PATH(50792); wav_u32x4_t r = wav_f32x4_as_u32x4(dest); uint32_t v; __builtin_memcpy(&v, src, sizeof(v)); r.values[lane] = v; return wav_u32x4_as_f32x4(r); }
+WAV_FUNCTION_ATTRIBUTES wav_f64x2_t wav_f64x2_load_lane(wav_f64x2_t dest, const int lane, const   double * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { WAV_PORTABLE_SLOW_PATH(50792); wav_u64x2_t r = wav_f64x2_as_u64x2(dest); uint64_t v; __builtin_memcpy(&v, src, sizeof(v)); r.values[lane] = v; return wav_u64x2_as_f64x2(r); }
+
+WAV_OVERLOAD_ATTRIBUTES wav_i8x16_t wav_load_lane(wav_i8x16_t dest, const int lane, const   int8_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_OVERLOAD_ATTRIBUTES wav_i16x8_t wav_load_lane(wav_i16x8_t dest, const int lane, const  int16_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_OVERLOAD_ATTRIBUTES wav_i32x4_t wav_load_lane(wav_i32x4_t dest, const int lane, const  int32_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_OVERLOAD_ATTRIBUTES wav_i64x2_t wav_load_lane(wav_i64x2_t dest, const int lane, const  int64_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_OVERLOAD_ATTRIBUTES wav_u8x16_t wav_load_lane(wav_u8x16_t dest, const int lane, const  uint8_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_OVERLOAD_ATTRIBUTES wav_u16x8_t wav_load_lane(wav_u16x8_t dest, const int lane, const uint16_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_OVERLOAD_ATTRIBUTES wav_u32x4_t wav_load_lane(wav_u32x4_t dest, const int lane, const uint32_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_OVERLOAD_ATTRIBUTES wav_u64x2_t wav_load_lane(wav_u64x2_t dest, const int lane, const uint64_t * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { WAV_PORTABLE_SLOW_PATH(50792); dest.values[lane] = *src; return dest; }
+WAV_OVERLOAD_ATTRIBUTES wav_f32x4_t wav_load_lane(wav_f32x4_t dest, const int lane, const    float * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { WAV_PORTABLE_SLOW_PATH(50792); wav_u32x4_t r = wav_f32x4_as_u32x4(dest); uint32_t v; __builtin_memcpy(&v, src, sizeof(v)); r.values[lane] = v; return wav_u32x4_as_f32x4(r); }
+WAV_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_load_lane(wav_f64x2_t dest, const int lane, const   double * src) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { WAV_PORTABLE_SLOW_PATH(50792); wav_u64x2_t r = wav_f64x2_as_u64x2(dest); uint64_t v; __builtin_memcpy(&v, src, sizeof(v)); r.values[lane] = v; return wav_u64x2_as_f64x2(r); }
 
 /* store_lane -- Load Lane
  *
  * Store into m the lane of data specified.
  */
 
-/* The overloaded version is not implemented yet since the intrinsic
- * is not usable for it; lane must be an ICE, so this has to be
- * implemented as a macro.  */
-
-#if WAV_PORTABLE_SLOW(50800)
-  WAV_FUNCTION_ATTRIBUTES void wav_i8x16_store_lane(  int8_t * dest, wav_i8x16_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { *dest = src.values[lane]; }
-  WAV_FUNCTION_ATTRIBUTES void wav_i16x8_store_lane( int16_t * dest, wav_i16x8_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { *dest = src.values[lane]; }
-  WAV_FUNCTION_ATTRIBUTES void wav_i32x4_store_lane( int32_t * dest, wav_i32x4_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { *dest = src.values[lane]; }
-  WAV_FUNCTION_ATTRIBUTES void wav_i64x2_store_lane( int64_t * dest, wav_i64x2_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { *dest = src.values[lane]; }
-  WAV_FUNCTION_ATTRIBUTES void wav_u8x16_store_lane( uint8_t * dest, wav_u8x16_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { *dest = src.values[lane]; }
-  WAV_FUNCTION_ATTRIBUTES void wav_u16x8_store_lane(uint16_t * dest, wav_u16x8_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { *dest = src.values[lane]; }
-  WAV_FUNCTION_ATTRIBUTES void wav_u32x4_store_lane(uint32_t * dest, wav_u32x4_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { *dest = src.values[lane]; }
-  WAV_FUNCTION_ATTRIBUTES void wav_u64x2_store_lane(uint64_t * dest, wav_u64x2_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { *dest = src.values[lane]; }
-  WAV_FUNCTION_ATTRIBUTES void wav_f32x4_store_lane(   float * dest, wav_f32x4_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { *dest = src.values[lane]; }
-  WAV_FUNCTION_ATTRIBUTES void wav_f64x2_store_lane(  double * dest, wav_f64x2_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { *dest = src.values[lane]; }
-
-  WAV_OVERLOAD_ATTRIBUTES void wav_store_lane(  int8_t * dest, wav_i8x16_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { *dest = src.values[lane]; }
-  WAV_OVERLOAD_ATTRIBUTES void wav_store_lane( int16_t * dest, wav_i16x8_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { *dest = src.values[lane]; }
-  WAV_OVERLOAD_ATTRIBUTES void wav_store_lane( int32_t * dest, wav_i32x4_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { *dest = src.values[lane]; }
-  WAV_OVERLOAD_ATTRIBUTES void wav_store_lane( int64_t * dest, wav_i64x2_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { *dest = src.values[lane]; }
-  WAV_OVERLOAD_ATTRIBUTES void wav_store_lane( uint8_t * dest, wav_u8x16_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { *dest = src.values[lane]; }
-  WAV_OVERLOAD_ATTRIBUTES void wav_store_lane(uint16_t * dest, wav_u16x8_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { *dest = src.values[lane]; }
-  WAV_OVERLOAD_ATTRIBUTES void wav_store_lane(uint32_t * dest, wav_u32x4_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { *dest = src.values[lane]; }
-  WAV_OVERLOAD_ATTRIBUTES void wav_store_lane(uint64_t * dest, wav_u64x2_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { *dest = src.values[lane]; }
-  WAV_OVERLOAD_ATTRIBUTES void wav_store_lane(   float * dest, wav_f32x4_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { *dest = src.values[lane]; }
-  WAV_OVERLOAD_ATTRIBUTES void wav_store_lane(  double * dest, wav_f64x2_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { *dest = src.values[lane]; }
+WAV_FUNCTION_ATTRIBUTES void wav_i8x16_store_lane(  int8_t * dest, wav_i8x16_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_FUNCTION_ATTRIBUTES void wav_i16x8_store_lane( int16_t * dest, wav_i16x8_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_FUNCTION_ATTRIBUTES void wav_i32x4_store_lane( int32_t * dest, wav_i32x4_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_FUNCTION_ATTRIBUTES void wav_i64x2_store_lane( int64_t * dest, wav_i64x2_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_FUNCTION_ATTRIBUTES void wav_u8x16_store_lane( uint8_t * dest, wav_u8x16_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_FUNCTION_ATTRIBUTES void wav_u16x8_store_lane(uint16_t * dest, wav_u16x8_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_FUNCTION_ATTRIBUTES void wav_u32x4_store_lane(uint32_t * dest, wav_u32x4_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_FUNCTION_ATTRIBUTES void wav_u64x2_store_lane(uint64_t * dest, wav_u64x2_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_FUNCTION_ATTRIBUTES void wav_f32x4_store_lane(   float * dest, wav_f32x4_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { WAV_PORTABLE_SLOW_PATH(50800); const uint32_t v = wav_f32x4_as_u32x4(src).values[lane]; __builtin_memcpy(dest, &v, sizeof(v)); }
+WAV_FUNCTION_ATTRIBUTES void wav_f64x2_store_lane(  double * dest, wav_f64x2_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { WAV_PORTABLE_SLOW_PATH(50800); const uint64_t v = wav_f64x2_as_u64x2(src).values[lane]; __builtin_memcpy(dest, &v, sizeof(v)); }
+
+WAV_OVERLOAD_ATTRIBUTES void wav_store_lane(  int8_t * dest, wav_i8x16_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_lane( int16_t * dest, wav_i16x8_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_lane( int32_t * dest, wav_i32x4_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_lane( int64_t * dest, wav_i64x2_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_lane( uint8_t * dest, wav_u8x16_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0, 15) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_lane(uint16_t * dest, wav_u16x8_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  7) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_lane(uint32_t * dest, wav_u32x4_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_lane(uint64_t * dest, wav_u64x2_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { WAV_PORTABLE_SLOW_PATH(50800); *dest = src.values[lane]; }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_lane(   float * dest, wav_f32x4_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  3) { WAV_PORTABLE_SLOW_PATH(50800); const uint32_t v = wav_f32x4_as_u32x4(src).values[lane]; __builtin_memcpy(dest, &v, sizeof(v)); }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_lane(  double * dest, wav_f64x2_t src, const int lane) WAV_REQUIRE_CONSTANT_RANGE_PARAM(lane, 0,  1) { WAV_PORTABLE_SLOW_PATH(50800); const uint64_t v = wav_f64x2_as_u64x2(src).values[lane]; __builtin_memcpy(dest, &v, sizeof(v)); }
+
+/* load_partial -- Load the first n lanes
+ *
+ * Load n elements from src into the lowest n lanes of the result, and
+ * set the remaining lanes to zero.  Only those n elements are read, so
+ * this can be used for the tail of a buffer instead of a scalar loop.
+ * n must be no greater than the number of lanes.
+ *
+ * The load is split into 8, 4, 2, and 1 byte scalar loads which are
+ * combined with make, so it takes between one and four loads.
+ */
+
+#if !defined(__wasm_simd128__) && (defined(WAV_EMULATION) && (WAV_EMULATION == 1))
+WAV_FUNCTION_ATTRIBUTES
+wav_u8x16_t
+wav_u8x16_load_partial(const void * src, size_t n) {
+  /* Natively a variable-length memcpy is fine; on WebAssembly it
+   * would be a call into libc, so the version below uses fixed-size
+   * pieces instead. */
+  wav_u8x16_t r = wav_u8x16_splat(0);
+  __builtin_memcpy(&r, src, (n < sizeof(r)) ? n : sizeof(r));
+  return r;
+}
 #else
-  #define wav_i8x16_store_lane(dest, src, lane) (__extension__({ __builtin_wasm_store8_lane ((dest), (src).values, (lane)); }))
-  #define wav_i16x8_store_lane(dest, src, lane) (__extension__({ __builtin_wasm_store16_lane((dest), (src).values, (lane)); }))
-  #define wav_i32x4_store_lane(dest, src, lane) (__extension__({ __builtin_wasm_store32_lane((dest), (src).values, (lane)); }))
-  #define wav_i64x2_store_lane(dest, src, lane) (__extension__({ __builtin_wasm_store64_lane((dest), (src).values, (lane)); }))
-  #define wav_u8x16_store_lane(dest, src, lane) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    __builtin_wasm_store8_lane( \
-      (int8_t *) (dest), \
-      (int8_t __attribute__((__vector_size__(16)))) ((src).values), \
-      (lane) \
-    ); \
-    _Pragma("clang diagnostic pop") \
-  }))
-  #define wav_u16x8_store_lane(dest, src, lane) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    __builtin_wasm_store16_lane( \
-      (int16_t *) (dest), \
-      (int16_t __attribute__((__vector_size__(16)))) ((src).values), \
-      (lane) \
-    ); \
-    _Pragma("clang diagnostic pop") \
-  }))
-  #define wav_u32x4_store_lane(dest, src, lane) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    __builtin_wasm_store32_lane( \
-      (int32_t *) (dest), \
-      (int32_t __attribute__((__vector_size__(16)))) ((src).values), \
-      (lane) \
-    ); \
-    _Pragma("clang diagnostic pop") \
-  }))
-  #define wav_u64x2_store_lane(dest, src, lane) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    __builtin_wasm_store64_lane( \
-      (int64_t *) (dest), \
-      (int64_t __attribute__((__vector_size__(16)))) ((src).values), \
-      (lane) \
-    ); \
-    _Pragma("clang diagnostic pop") \
-  }))
-  #define wav_f32x4_store_lane(dest, src, lane) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    __builtin_wasm_store32_lane( \
-      (int32_t *) (dest), \
-      (int32_t __attribute__((__vector_size__(16)))) ((src).values), \
-      (lane) \
-    ); \
-    _Pragma("clang diagnostic pop") \
-  }))
-  #define wav_f64x2_store_lane(dest, src, lane) (__extension__({ \
-    _Pragma("clang diagnostic push") \
-    _Pragma("clang diagnostic ignored \"-Wold-style-cast\"") \
-    __builtin_wasm_store64_lane( \
-      (int64_t *) (dest), \
-      (int64_t __attribute__((__vector_size__(16)))) ((src).values), \
-      (lane) \
-    ); \
-    _Pragma("clang diagnostic pop") \
-  }))
+WAV_FUNCTION_ATTRIBUTES
+wav_u8x16_t
+wav_u8x16_load_partial(const void * src, size_t n) {
+  const uint8_t * src8 = (const uint8_t *) src;
+  uint64_t head = 0;
+  uint32_t t32 = 0;
+  uint16_t t16 = 0;
+  uint8_t t8 = 0;
+  uint64_t tail;
+
+  if (n >= 16) {
+    return wav_u8x16_loadu(src);
+  }
+
+  if (n & 8) { __builtin_memcpy(&head, src8, sizeof(head)); src8 += sizeof(head); }
+  if (n & 4) { __builtin_memcpy(&t32,  src8, sizeof(t32));  src8 += sizeof(t32);  }
+  if (n & 2) { __builtin_memcpy(&t16,  src8, sizeof(t16));  src8 += sizeof(t16);  }
+  if (n & 1) { t8 = *src8; }
+
+  /* The bytes after the first 8 fit in one 64-bit lane (WebAssembly is
+   * little-endian). */
+  tail = ((uint64_t) t32) | (((uint64_t) t16) << (8 * (n & 4))) | (((uint64_t) t8) << (8 * (n & 6)));
+
+  if (n & 8) {
+    return wav_u64x2_as_u8x16(wav_u64x2_make(head, tail));
+  } else {
+    return wav_u64x2_as_u8x16(wav_u64x2_make(tail, 0));
+  }
+}
+#endif
+
+WAV_FUNCTION_ATTRIBUTES wav_i8x16_t wav_i8x16_load_partial(const void * src, size_t n) { return wav_u8x16_as_i8x16(wav_u8x16_load_partial(src, n * sizeof(  int8_t))); }
+WAV_FUNCTION_ATTRIBUTES wav_i16x8_t wav_i16x8_load_partial(const void * src, size_t n) { return wav_u8x16_as_i16x8(wav_u8x16_load_partial(src, n * sizeof( int16_t))); }
+WAV_FUNCTION_ATTRIBUTES wav_i32x4_t wav_i32x4_load_partial(const void * src, size_t n) { return wav_u8x16_as_i32x4(wav_u8x16_load_partial(src, n * sizeof( int32_t))); }
+WAV_FUNCTION_ATTRIBUTES wav_i64x2_t wav_i64x2_load_partial(const void * src, size_t n) { return wav_u8x16_as_i64x2(wav_u8x16_load_partial(src, n * sizeof( int64_t))); }
+WAV_FUNCTION_ATTRIBUTES wav_u16x8_t wav_u16x8_load_partial(const void * src, size_t n) { return wav_u8x16_as_u16x8(wav_u8x16_load_partial(src, n * sizeof(uint16_t))); }
+WAV_FUNCTION_ATTRIBUTES wav_u32x4_t wav_u32x4_load_partial(const void * src, size_t n) { return wav_u8x16_as_u32x4(wav_u8x16_load_partial(src, n * sizeof(uint32_t))); }
+WAV_FUNCTION_ATTRIBUTES wav_u64x2_t wav_u64x2_load_partial(const void * src, size_t n) { return wav_u8x16_as_u64x2(wav_u8x16_load_partial(src, n * sizeof(uint64_t))); }
+WAV_FUNCTION_ATTRIBUTES wav_f32x4_t wav_f32x4_load_partial(const void * src, size_t n) { return wav_u8x16_as_f32x4(wav_u8x16_load_partial(src, n * sizeof(   float))); }
+WAV_FUNCTION_ATTRIBUTES wav_f64x2_t wav_f64x2_load_partial(const void * src, size_t n) { return wav_u8x16_as_f64x2(wav_u8x16_load_partial(src, n * sizeof(  double))); }
+WAV_FUNCTION_ATTRIBUTES wav_f16x8_t wav_f16x8_load_partial(const void * src, size_t n) { return wav_u8x16_as_f16x8(wav_u8x16_load_partial(src, n * sizeof(uint16_t))); }
+
+/* load_partial_overread -- Load the first n lanes, reading past them
+ *
+ * Same result as load_partial, but if the 16 bytes starting at src
+ * are all within one WAV_PAGE_SIZE-aligned page this does a single
+ * unaligned load of all 16 bytes and zeroes the extra lanes.  Memory
+ * protection works at page granularity, so the extra bytes can always
+ * be read without faulting even when they are past the end of the
+ * buffer; only loads which straddle a page boundary (which, for
+ * random addresses, is 15 in 4096) take the slower path.
+ *
+ * This is mostly intended for native code built with WAV_EMULATION.
+ * WASM linear memory grows in 64 KiB pages, so the default page size
+ * of 4096 is safe there too, and can be raised with -DWAV_PAGE_SIZE.
+ *
+ * Note that reading past the end of an object is still undefined
+ * behavior as far as C is concerned, and it will upset tools like
+ * AddressSanitizer and Valgrind.  When AddressSanitizer or
+ * MemorySanitizer is detected, or if WAV_LOAD_PARTIAL_OVERREAD is
+ * defined to 0, this is just load_partial.
+ */
+
+#if !defined(WAV_PAGE_SIZE)
+  #define WAV_PAGE_SIZE 4096
+#endif
+
+#if !defined(WAV_LOAD_PARTIAL_OVERREAD)
+  #if defined(__SANITIZE_ADDRESS__)
+    #define WAV_LOAD_PARTIAL_OVERREAD 0
+  #elif defined(__has_feature)
+    #if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer)
+      #define WAV_LOAD_PARTIAL_OVERREAD 0
+    #endif
+  #endif
+#endif
+#if !defined(WAV_LOAD_PARTIAL_OVERREAD)
+  #define WAV_LOAD_PARTIAL_OVERREAD 1
+#endif
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u8x16_t
+wav_u8x16_load_partial_overread(const void * src, size_t n) {
+  #if WAV_LOAD_PARTIAL_OVERREAD
+    if ((((uintptr_t) src) & (WAV_PAGE_SIZE - 1)) <= (WAV_PAGE_SIZE - 16)) {
+      const wav_u8x16_t lane = { { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } };
+      const wav_u8x16_t count = wav_u8x16_splat((uint8_t) ((n < 16) ? n : 16));
+      return wav_u8x16_and(wav_u8x16_loadu(src), wav_b8x16_as_u8x16(wav_u8x16_lt(lane, count)));
+    }
+  #endif
+
+  return wav_u8x16_load_partial(src, n);
+}
+
+WAV_FUNCTION_ATTRIBUTES wav_i8x16_t wav_i8x16_load_partial_overread(const void * src, size_t n) { return wav_u8x16_as_i8x16(wav_u8x16_load_partial_overread(src, n * sizeof(  int8_t))); }
+WAV_FUNCTION_ATTRIBUTES wav_i16x8_t wav_i16x8_load_partial_overread(const void * src, size_t n) { return wav_u8x16_as_i16x8(wav_u8x16_load_partial_overread(src, n * sizeof( int16_t))); }
+WAV_FUNCTION_ATTRIBUTES wav_i32x4_t wav_i32x4_load_partial_overread(const void * src, size_t n) { return wav_u8x16_as_i32x4(wav_u8x16_load_partial_overread(src, n * sizeof( int32_t))); }
+WAV_FUNCTION_ATTRIBUTES wav_i64x2_t wav_i64x2_load_partial_overread(const void * src, size_t n) { return wav_u8x16_as_i64x2(wav_u8x16_load_partial_overread(src, n * sizeof( int64_t))); }
+WAV_FUNCTION_ATTRIBUTES wav_u16x8_t wav_u16x8_load_partial_overread(const void * src, size_t n) { return wav_u8x16_as_u16x8(wav_u8x16_load_partial_overread(src, n * sizeof(uint16_t))); }
+WAV_FUNCTION_ATTRIBUTES wav_u32x4_t wav_u32x4_load_partial_overread(const void * src, size_t n) { return wav_u8x16_as_u32x4(wav_u8x16_load_partial_overread(src, n * sizeof(uint32_t))); }
+WAV_FUNCTION_ATTRIBUTES wav_u64x2_t wav_u64x2_load_partial_overread(const void * src, size_t n) { return wav_u8x16_as_u64x2(wav_u8x16_load_partial_overread(src, n * sizeof(uint64_t))); }
+WAV_FUNCTION_ATTRIBUTES wav_f32x4_t wav_f32x4_load_partial_overread(const void * src, size_t n) { return wav_u8x16_as_f32x4(wav_u8x16_load_partial_overread(src, n * sizeof(   float))); }
+WAV_FUNCTION_ATTRIBUTES wav_f64x2_t wav_f64x2_load_partial_overread(const void * src, size_t n) { return wav_u8x16_as_f64x2(wav_u8x16_load_partial_overread(src, n * sizeof(  double))); }
+WAV_FUNCTION_ATTRIBUTES wav_f16x8_t wav_f16x8_load_partial_overread(const void * src, size_t n) { return wav_u8x16_as_f16x8(wav_u8x16_load_partial_overread(src, n * sizeof(uint16_t))); }
+
+/* store_partial -- Store the first n lanes
+ *
+ * Store the lowest n lanes of src to dest.  Nothing past those n
+ * elements is written.  n must be no greater than the number of lanes.
+ */
+
+#if !defined(__wasm_simd128__) && (defined(WAV_EMULATION) && (WAV_EMULATION == 1))
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u8x16_store_partial(void * dest, wav_u8x16_t src, size_t n) {
+  __builtin_memcpy(dest, &src, (n < sizeof(src)) ? n : sizeof(src));
+}
+#else
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u8x16_store_partial(void * dest, wav_u8x16_t src, size_t n) {
+  uint8_t * dest8 = (uint8_t *) dest;
+  const wav_u64x2_t src64 = wav_u8x16_as_u64x2(src);
+  uint64_t rest;
+
+  if (n >= 16) {
+    wav_u8x16_storeu(dest, src);
+    return;
+  }
+
+  if (n & 8) {
+    const uint64_t head = wav_u64x2_extract_lane(src64, 0);
+    __builtin_memcpy(dest8, &head, sizeof(head));
+    dest8 += sizeof(head);
+    rest = wav_u64x2_extract_lane(src64, 1);
+  } else {
+    rest = wav_u64x2_extract_lane(src64, 0);
+  }
+
+  if (n & 4) { const uint32_t t32 = (uint32_t) rest; __builtin_memcpy(dest8, &t32, sizeof(t32)); dest8 += sizeof(t32); rest >>= 32; }
+  if (n & 2) { const uint16_t t16 = (uint16_t) rest; __builtin_memcpy(dest8, &t16, sizeof(t16)); dest8 += sizeof(t16); rest >>= 16; }
+  if (n & 1) { *dest8 = (uint8_t) rest; }
+}
 #endif
 
+WAV_FUNCTION_ATTRIBUTES void wav_i8x16_store_partial(void * dest, wav_i8x16_t src, size_t n) { wav_u8x16_store_partial(dest, wav_i8x16_as_u8x16(src), n * sizeof(  int8_t)); }
+WAV_FUNCTION_ATTRIBUTES void wav_i16x8_store_partial(void * dest, wav_i16x8_t src, size_t n) { wav_u8x16_store_partial(dest, wav_i16x8_as_u8x16(src), n * sizeof( int16_t)); }
+WAV_FUNCTION_ATTRIBUTES void wav_i32x4_store_partial(void * dest, wav_i32x4_t src, size_t n) { wav_u8x16_store_partial(dest, wav_i32x4_as_u8x16(src), n * sizeof( int32_t)); }
+WAV_FUNCTION_ATTRIBUTES void wav_i64x2_store_partial(void * dest, wav_i64x2_t src, size_t n) { wav_u8x16_store_partial(dest, wav_i64x2_as_u8x16(src), n * sizeof( int64_t)); }
+WAV_FUNCTION_ATTRIBUTES void wav_u16x8_store_partial(void * dest, wav_u16x8_t src, size_t n) { wav_u8x16_store_partial(dest, wav_u16x8_as_u8x16(src), n * sizeof(uint16_t)); }
+WAV_FUNCTION_ATTRIBUTES void wav_u32x4_store_partial(void * dest, wav_u32x4_t src, size_t n) { wav_u8x16_store_partial(dest, wav_u32x4_as_u8x16(src), n * sizeof(uint32_t)); }
+WAV_FUNCTION_ATTRIBUTES void wav_u64x2_store_partial(void * dest, wav_u64x2_t src, size_t n) { wav_u8x16_store_partial(dest, wav_u64x2_as_u8x16(src), n * sizeof(uint64_t)); }
+WAV_FUNCTION_ATTRIBUTES void wav_f32x4_store_partial(void * dest, wav_f32x4_t src, size_t n) { wav_u8x16_store_partial(dest, wav_f32x4_as_u8x16(src), n * sizeof(   float)); }
+WAV_FUNCTION_ATTRIBUTES void wav_f64x2_store_partial(void * dest, wav_f64x2_t src, size_t n) { wav_u8x16_store_partial(dest, wav_f64x2_as_u8x16(src), n * sizeof(  double)); }
+WAV_FUNCTION_ATTRIBUTES void wav_f16x8_store_partial(void * dest, wav_f16x8_t src, size_t n) { wav_u8x16_store_partial(dest, wav_f16x8_as_u8x16(src), n * sizeof(uint16_t)); }
+
+WAV_OVERLOAD_ATTRIBUTES void wav_store_partial(void * dest, wav_i8x16_t src, size_t n) { wav_i8x16_store_partial(dest, src, n); }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_partial(void * dest, wav_i16x8_t src, size_t n) { wav_i16x8_store_partial(dest, src, n); }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_partial(void * dest, wav_i32x4_t src, size_t n) { wav_i32x4_store_partial(dest, src, n); }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_partial(void * dest, wav_i64x2_t src, size_t n) { wav_i64x2_store_partial(dest, src, n); }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_partial(void * dest, wav_u8x16_t src, size_t n) { wav_u8x16_store_partial(dest, src, n); }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_partial(void * dest, wav_u16x8_t src, size_t n) { wav_u16x8_store_partial(dest, src, n); }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_partial(void * dest, wav_u32x4_t src, size_t n) { wav_u32x4_store_partial(dest, src, n); }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_partial(void * dest, wav_u64x2_t src, size_t n) { wav_u64x2_store_partial(dest, src, n); }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_partial(void * dest, wav_f32x4_t src, size_t n) { wav_f32x4_store_partial(dest, src, n); }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_partial(void * dest, wav_f64x2_t src, size_t n) { wav_f64x2_store_partial(dest, src, n); }
+WAV_OVERLOAD_ATTRIBUTES void wav_store_partial(void * dest, wav_f16x8_t src, size_t n) { wav_f16x8_store_partial(dest, src, n); }
+
 /* load_extend -- Load and Extend
  *
  * Fetch consecutive integers up to 32-bit wide and produce a vector
@@ -6654,14 +7431,18 @@ WAV_OVERLOAD_ATTRIBUTES wav_u64x2_t wav_load_extend(WAV_ALIGNED(8) uint32_t a[WA
 WAV_FUNCTION_ATTRIBUTES
 unsigned int
 wav_i8x16_bitmask(wav_i8x16_t a) {
-  #if WAV_PORTABLE_SLOW(TODO)
-    unsigned int r = 0;
-
-    for (int i = 0 ; i < 16 ; i++) {
-      r |= ((unsigned int) (a.values[i] < 0)) << i;
-    }
-
-    return r;
+  #if WAV_X86_SSE2
+    return (unsigned int) _mm_movemask_epi8((__m128i) a.values);
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    /* Move the sign bit of each lane to the bottom, then multiply to
+     * gather the 8 bits of each 64-bit half into the top byte.  Each
+     * partial product lands on a distinct bit, so nothing carries into
+     * the top byte.  Like WASM, this assumes little-endian lanes. */
+    uint64_t t __attribute__((__vector_size__(16))) =
+      (__typeof__(t)) (((uint8_t __attribute__((__vector_size__(16)))) a.values) >> 7);
+    t = (t * UINT64_C(0x0102040810204080)) >> 56;
+    return (unsigned int) (t[0] | (t[1] << 8));
   #else
     return (unsigned int) __builtin_wasm_bitmask_i8x16(a.values);
   #endif
@@ -6670,14 +7451,15 @@ wav_i8x16_bitmask(wav_i8x16_t a) {
 WAV_FUNCTION_ATTRIBUTES
 unsigned int
 wav_i16x8_bitmask(wav_i16x8_t a) {
-  #if WAV_PORTABLE_SLOW(TODO)
-    unsigned int r = 0;
-
-    for (int i = 0 ; i < 8 ; i++) {
-      r |= ((unsigned int) (a.values[i] < 0)) << i;
-    }
-
-    return r;
+  #if WAV_X86_SSE2
+    return (unsigned int) _mm_movemask_epi8(_mm_packs_epi16((__m128i) a.values, _mm_setzero_si128()));
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    /* Narrow to one byte per lane, then see wav_i8x16_bitmask. */
+    uint8_t b __attribute__((__vector_size__(8))) =
+      __builtin_convertvector(((uint16_t __attribute__((__vector_size__(16)))) a.values) >> 15, __typeof__(b));
+    uint64_t t = ((uint64_t __attribute__((__vector_size__(8)))) b)[0];
+    return (unsigned int) ((t * UINT64_C(0x0102040810204080)) >> 56);
   #else
     return (unsigned int) __builtin_wasm_bitmask_i16x8(a.values);
   #endif
@@ -6686,14 +7468,15 @@ wav_i16x8_bitmask(wav_i16x8_t a) {
 WAV_FUNCTION_ATTRIBUTES
 unsigned int
 wav_i32x4_bitmask(wav_i32x4_t a) {
-  #if WAV_PORTABLE_SLOW(TODO)
-    unsigned int r = 0;
-
-    for (int i = 0 ; i < 4 ; i++) {
-      r |= ((unsigned int) (a.values[i] < 0)) << i;
-    }
-
-    return r;
+  #if WAV_X86_SSE2
+    return (unsigned int) _mm_movemask_ps((__m128) a.values);
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    /* Narrow to one byte per lane, then see wav_i8x16_bitmask. */
+    uint8_t b __attribute__((__vector_size__(4))) =
+      __builtin_convertvector(((uint32_t __attribute__((__vector_size__(16)))) a.values) >> 31, __typeof__(b));
+    uint32_t t = ((uint32_t __attribute__((__vector_size__(4)))) b)[0];
+    return (unsigned int) ((t * UINT32_C(0x10204080)) >> 28);
   #else
     return (unsigned int) __builtin_wasm_bitmask_i32x4(a.values);
   #endif
@@ -6702,14 +7485,13 @@ wav_i32x4_bitmask(wav_i32x4_t a) {
 WAV_FUNCTION_ATTRIBUTES
 unsigned int
 wav_i64x2_bitmask(wav_i64x2_t a) {
-  #if WAV_PORTABLE_SLOW(TODO)
-    unsigned int r = 0;
-
-    for (int i = 0 ; i < 2 ; i++) {
-      r |= ((unsigned int) (a.values[i] < 0)) << i;
-    }
-
-    return r;
+  #if WAV_X86_SSE2
+    return (unsigned int) _mm_movemask_pd((__m128d) a.values);
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    uint64_t t __attribute__((__vector_size__(16))) = (__typeof__(t)) a.values;
+    t >>= 63;
+    return (unsigned int) (t[0] | (t[1] << 1));
   #else
     return (unsigned int) __builtin_wasm_bitmask_i64x2(a.values);
   #endif
@@ -6776,6 +7558,681 @@ WAV_OVERLOAD_ATTRIBUTES unsigned int wav_bitmask(wav_b16x8_t a) { return wav_b16
 WAV_OVERLOAD_ATTRIBUTES unsigned int wav_bitmask(wav_b32x4_t a) { return wav_b32x4_bitmask(a); }
 WAV_OVERLOAD_ATTRIBUTES unsigned int wav_bitmask(wav_b64x2_t a) { return wav_b64x2_bitmask(a); }
 
+
+/* Relaxed SIMD
+ *
+ * These functions are from the relaxed SIMD proposal, which adds
+ * instructions whose results are allowed to vary between
+ * implementations for some inputs (for example, whether an FMA is
+ * fused, or what happens to out-of-range lanes) in exchange for mapping
+ * to a single native instruction.  Code using them must work with any
+ * of the permitted results.
+ *
+ * When targeting WebAssembly they require the relaxed-simd target
+ * feature (e.g., -mrelaxed-simd).  In emulation mode they return one
+ * of the permitted results; on x86 we use whatever the native
+ * instruction produces, elsewhere we use the deterministic version
+ * from WASM SIMD128.
+ */
+
+/* relaxed_madd -- Relaxed fused multiply-add
+ *
+ * Computes a * b + c, either fused (with a single rounding) or not.
+ */
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_f32x4_t
+wav_f32x4_relaxed_madd(wav_f32x4_t a, wav_f32x4_t b, wav_f32x4_t c) {
+  #if WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_f32x4_add(wav_f32x4_mul(a, b), c);
+  #else
+    return (wav_f32x4_t) { __builtin_wasm_relaxed_madd_f32x4(a.values, b.values, c.values) };
+  #endif
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_f64x2_t
+wav_f64x2_relaxed_madd(wav_f64x2_t a, wav_f64x2_t b, wav_f64x2_t c) {
+  #if WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_f64x2_add(wav_f64x2_mul(a, b), c);
+  #else
+    return (wav_f64x2_t) { __builtin_wasm_relaxed_madd_f64x2(a.values, b.values, c.values) };
+  #endif
+}
+
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_f32x4_t wav_relaxed_madd(wav_f32x4_t a, wav_f32x4_t b, wav_f32x4_t c) { return wav_f32x4_relaxed_madd(a, b, c); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_relaxed_madd(wav_f64x2_t a, wav_f64x2_t b, wav_f64x2_t c) { return wav_f64x2_relaxed_madd(a, b, c); }
+
+/* relaxed_nmadd -- Relaxed fused negative multiply-add
+ *
+ * Computes -(a * b) + c, either fused (with a single rounding) or not.
+ */
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_f32x4_t
+wav_f32x4_relaxed_nmadd(wav_f32x4_t a, wav_f32x4_t b, wav_f32x4_t c) {
+  #if WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_f32x4_sub(c, wav_f32x4_mul(a, b));
+  #else
+    return (wav_f32x4_t) { __builtin_wasm_relaxed_nmadd_f32x4(a.values, b.values, c.values) };
+  #endif
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_f64x2_t
+wav_f64x2_relaxed_nmadd(wav_f64x2_t a, wav_f64x2_t b, wav_f64x2_t c) {
+  #if WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_f64x2_sub(c, wav_f64x2_mul(a, b));
+  #else
+    return (wav_f64x2_t) { __builtin_wasm_relaxed_nmadd_f64x2(a.values, b.values, c.values) };
+  #endif
+}
+
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_f32x4_t wav_relaxed_nmadd(wav_f32x4_t a, wav_f32x4_t b, wav_f32x4_t c) { return wav_f32x4_relaxed_nmadd(a, b, c); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_relaxed_nmadd(wav_f64x2_t a, wav_f64x2_t b, wav_f64x2_t c) { return wav_f64x2_relaxed_nmadd(a, b, c); }
+
+/* relaxed_swizzle -- Relaxed swizzling using variable indices
+ *
+ * Like swizzle, except that the result for lanes where the index is
+ * out of range (> 15) is implementation-defined.
+ */
+
+#if WAV_X86_SSSE3 || WAV_X86_SSSE3_DISPATCH_
+WAV_X86_SSSE3_FUNCTION_ATTRIBUTES_
+wav_i8x16_t
+wav_i8x16_relaxed_swizzle_ssse3_(wav_i8x16_t data, wav_i8x16_t idx) {
+  return (wav_i8x16_t) { (__typeof__(data.values)) _mm_shuffle_epi8((__m128i) data.values, (__m128i) idx.values) };
+}
+#endif
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_i8x16_t
+wav_i8x16_relaxed_swizzle(wav_i8x16_t data, wav_i8x16_t idx) {
+  #if WAV_X86_SSSE3_DISPATCH_
+    if (__builtin_cpu_supports("ssse3"))
+      return wav_i8x16_relaxed_swizzle_ssse3_(data, idx);
+  #endif
+  #if WAV_X86_SSSE3
+    return wav_i8x16_relaxed_swizzle_ssse3_(data, idx);
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_i8x16_swizzle(data, idx);
+  #else
+    return (wav_i8x16_t) { __builtin_wasm_relaxed_swizzle_i8x16(data.values, idx.values) };
+  #endif
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_u8x16_t
+wav_u8x16_relaxed_swizzle(wav_u8x16_t data, wav_u8x16_t idx) {
+  return
+    wav_i8x16_as_u8x16(
+      wav_i8x16_relaxed_swizzle(
+        wav_u8x16_as_i8x16(data),
+        wav_u8x16_as_i8x16(idx)
+      )
+    );
+}
+
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_i8x16_t wav_relaxed_swizzle(wav_i8x16_t data, wav_i8x16_t idx) { return wav_i8x16_relaxed_swizzle(data, idx); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_u8x16_t wav_relaxed_swizzle(wav_u8x16_t data, wav_u8x16_t idx) { return wav_u8x16_relaxed_swizzle(data, idx); }
+
+/* relaxed_laneselect -- Relaxed lane selection
+ *
+ * Selects lanes from when_set or when_unset based on control.  In
+ * relaxed SIMD the result is only fully defined if each lane of the
+ * mask is all ones or all zeros, but that is always the case for
+ * WAV's boolean types, so this behaves exactly like blend; it just
+ * maps to a cheaper instruction on some hardware.
+ */
+
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_i8x16_t
+wav_i8x16_relaxed_laneselect_sse4_1_(wav_b8x16_t control, wav_i8x16_t when_set, wav_i8x16_t when_unset) {
+  return (wav_i8x16_t) { (__typeof__(when_set.values)) _mm_blendv_epi8((__m128i) when_unset.values, (__m128i) when_set.values, (__m128i) control.values) };
+}
+#endif
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_i8x16_t
+wav_i8x16_relaxed_laneselect(wav_b8x16_t control, wav_i8x16_t when_set, wav_i8x16_t when_unset) {
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_i8x16_relaxed_laneselect_sse4_1_(control, when_set, when_unset);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_i8x16_relaxed_laneselect_sse4_1_(control, when_set, when_unset);
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_i8x16_blend(control, when_set, when_unset);
+  #else
+    return (wav_i8x16_t) { __builtin_wasm_relaxed_laneselect_i8x16(when_set.values, when_unset.values, (__typeof__(when_set.values)) control.values) };
+  #endif
+}
+
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_i16x8_t
+wav_i16x8_relaxed_laneselect_sse4_1_(wav_b16x8_t control, wav_i16x8_t when_set, wav_i16x8_t when_unset) {
+  return (wav_i16x8_t) { (__typeof__(when_set.values)) _mm_blendv_epi8((__m128i) when_unset.values, (__m128i) when_set.values, (__m128i) control.values) };
+}
+#endif
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_i16x8_t
+wav_i16x8_relaxed_laneselect(wav_b16x8_t control, wav_i16x8_t when_set, wav_i16x8_t when_unset) {
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_i16x8_relaxed_laneselect_sse4_1_(control, when_set, when_unset);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_i16x8_relaxed_laneselect_sse4_1_(control, when_set, when_unset);
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_i16x8_blend(control, when_set, when_unset);
+  #else
+    return (wav_i16x8_t) { __builtin_wasm_relaxed_laneselect_i16x8(when_set.values, when_unset.values, (__typeof__(when_set.values)) control.values) };
+  #endif
+}
+
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_i32x4_t
+wav_i32x4_relaxed_laneselect_sse4_1_(wav_b32x4_t control, wav_i32x4_t when_set, wav_i32x4_t when_unset) {
+  return (wav_i32x4_t) { (__typeof__(when_set.values)) _mm_blendv_epi8((__m128i) when_unset.values, (__m128i) when_set.values, (__m128i) control.values) };
+}
+#endif
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_i32x4_t
+wav_i32x4_relaxed_laneselect(wav_b32x4_t control, wav_i32x4_t when_set, wav_i32x4_t when_unset) {
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_i32x4_relaxed_laneselect_sse4_1_(control, when_set, when_unset);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_i32x4_relaxed_laneselect_sse4_1_(control, when_set, when_unset);
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_i32x4_blend(control, when_set, when_unset);
+  #else
+    return (wav_i32x4_t) { __builtin_wasm_relaxed_laneselect_i32x4(when_set.values, when_unset.values, (__typeof__(when_set.values)) control.values) };
+  #endif
+}
+
+#if WAV_X86_SSE4_1 || WAV_X86_SSE4_1_DISPATCH_
+WAV_X86_SSE4_1_FUNCTION_ATTRIBUTES_
+wav_i64x2_t
+wav_i64x2_relaxed_laneselect_sse4_1_(wav_b64x2_t control, wav_i64x2_t when_set, wav_i64x2_t when_unset) {
+  return (wav_i64x2_t) { (__typeof__(when_set.values)) _mm_blendv_epi8((__m128i) when_unset.values, (__m128i) when_set.values, (__m128i) control.values) };
+}
+#endif
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_i64x2_t
+wav_i64x2_relaxed_laneselect(wav_b64x2_t control, wav_i64x2_t when_set, wav_i64x2_t when_unset) {
+  #if WAV_X86_SSE4_1_DISPATCH_
+    if (__builtin_cpu_supports("sse4.1"))
+      return wav_i64x2_relaxed_laneselect_sse4_1_(control, when_set, when_unset);
+  #endif
+  #if WAV_X86_SSE4_1
+    return wav_i64x2_relaxed_laneselect_sse4_1_(control, when_set, when_unset);
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_i64x2_blend(control, when_set, when_unset);
+  #else
+    return (wav_i64x2_t) { __builtin_wasm_relaxed_laneselect_i64x2(when_set.values, when_unset.values, (__typeof__(when_set.values)) control.values) };
+  #endif
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_u8x16_t
+wav_u8x16_relaxed_laneselect(wav_b8x16_t control, wav_u8x16_t when_set, wav_u8x16_t when_unset) {
+  return wav_i8x16_as_u8x16(wav_i8x16_relaxed_laneselect(control, wav_u8x16_as_i8x16(when_set), wav_u8x16_as_i8x16(when_unset)));
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_u16x8_t
+wav_u16x8_relaxed_laneselect(wav_b16x8_t control, wav_u16x8_t when_set, wav_u16x8_t when_unset) {
+  return wav_i16x8_as_u16x8(wav_i16x8_relaxed_laneselect(control, wav_u16x8_as_i16x8(when_set), wav_u16x8_as_i16x8(when_unset)));
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_u32x4_t
+wav_u32x4_relaxed_laneselect(wav_b32x4_t control, wav_u32x4_t when_set, wav_u32x4_t when_unset) {
+  return wav_i32x4_as_u32x4(wav_i32x4_relaxed_laneselect(control, wav_u32x4_as_i32x4(when_set), wav_u32x4_as_i32x4(when_unset)));
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_u64x2_t
+wav_u64x2_relaxed_laneselect(wav_b64x2_t control, wav_u64x2_t when_set, wav_u64x2_t when_unset) {
+  return wav_i64x2_as_u64x2(wav_i64x2_relaxed_laneselect(control, wav_u64x2_as_i64x2(when_set), wav_u64x2_as_i64x2(when_unset)));
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_f32x4_t
+wav_f32x4_relaxed_laneselect(wav_b32x4_t control, wav_f32x4_t when_set, wav_f32x4_t when_unset) {
+  return wav_i32x4_as_f32x4(wav_i32x4_relaxed_laneselect(control, wav_f32x4_as_i32x4(when_set), wav_f32x4_as_i32x4(when_unset)));
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_f64x2_t
+wav_f64x2_relaxed_laneselect(wav_b64x2_t control, wav_f64x2_t when_set, wav_f64x2_t when_unset) {
+  return wav_i64x2_as_f64x2(wav_i64x2_relaxed_laneselect(control, wav_f64x2_as_i64x2(when_set), wav_f64x2_as_i64x2(when_unset)));
+}
+
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_i8x16_t wav_relaxed_laneselect(wav_b8x16_t control, wav_i8x16_t when_set, wav_i8x16_t when_unset) { return wav_i8x16_relaxed_laneselect(control, when_set, when_unset); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_i16x8_t wav_relaxed_laneselect(wav_b16x8_t control, wav_i16x8_t when_set, wav_i16x8_t when_unset) { return wav_i16x8_relaxed_laneselect(control, when_set, when_unset); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_i32x4_t wav_relaxed_laneselect(wav_b32x4_t control, wav_i32x4_t when_set, wav_i32x4_t when_unset) { return wav_i32x4_relaxed_laneselect(control, when_set, when_unset); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_i64x2_t wav_relaxed_laneselect(wav_b64x2_t control, wav_i64x2_t when_set, wav_i64x2_t when_unset) { return wav_i64x2_relaxed_laneselect(control, when_set, when_unset); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_u8x16_t wav_relaxed_laneselect(wav_b8x16_t control, wav_u8x16_t when_set, wav_u8x16_t when_unset) { return wav_u8x16_relaxed_laneselect(control, when_set, when_unset); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_u16x8_t wav_relaxed_laneselect(wav_b16x8_t control, wav_u16x8_t when_set, wav_u16x8_t when_unset) { return wav_u16x8_relaxed_laneselect(control, when_set, when_unset); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_u32x4_t wav_relaxed_laneselect(wav_b32x4_t control, wav_u32x4_t when_set, wav_u32x4_t when_unset) { return wav_u32x4_relaxed_laneselect(control, when_set, when_unset); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_u64x2_t wav_relaxed_laneselect(wav_b64x2_t control, wav_u64x2_t when_set, wav_u64x2_t when_unset) { return wav_u64x2_relaxed_laneselect(control, when_set, when_unset); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_f32x4_t wav_relaxed_laneselect(wav_b32x4_t control, wav_f32x4_t when_set, wav_f32x4_t when_unset) { return wav_f32x4_relaxed_laneselect(control, when_set, when_unset); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_relaxed_laneselect(wav_b64x2_t control, wav_f64x2_t when_set, wav_f64x2_t when_unset) { return wav_f64x2_relaxed_laneselect(control, when_set, when_unset); }
+
+/* relaxed_min -- Relaxed floating-point minimum
+ *
+ * Like min, except that the result is implementation-defined if
+ * either input is NaN, or if the inputs are zeros of opposite sign.
+ */
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_f32x4_t
+wav_f32x4_relaxed_min(wav_f32x4_t a, wav_f32x4_t b) {
+  #if WAV_X86_SSE2
+    return (wav_f32x4_t) { _mm_min_ps(a.values, b.values) };
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_f32x4_min(a, b);
+  #else
+    return (wav_f32x4_t) { __builtin_wasm_relaxed_min_f32x4(a.values, b.values) };
+  #endif
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_f64x2_t
+wav_f64x2_relaxed_min(wav_f64x2_t a, wav_f64x2_t b) {
+  #if WAV_X86_SSE2
+    return (wav_f64x2_t) { _mm_min_pd(a.values, b.values) };
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_f64x2_min(a, b);
+  #else
+    return (wav_f64x2_t) { __builtin_wasm_relaxed_min_f64x2(a.values, b.values) };
+  #endif
+}
+
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_f32x4_t wav_relaxed_min(wav_f32x4_t a, wav_f32x4_t b) { return wav_f32x4_relaxed_min(a, b); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_relaxed_min(wav_f64x2_t a, wav_f64x2_t b) { return wav_f64x2_relaxed_min(a, b); }
+
+/* relaxed_max -- Relaxed floating-point maximum
+ *
+ * Like max, except that the result is implementation-defined if
+ * either input is NaN, or if the inputs are zeros of opposite sign.
+ */
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_f32x4_t
+wav_f32x4_relaxed_max(wav_f32x4_t a, wav_f32x4_t b) {
+  #if WAV_X86_SSE2
+    return (wav_f32x4_t) { _mm_max_ps(a.values, b.values) };
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_f32x4_max(a, b);
+  #else
+    return (wav_f32x4_t) { __builtin_wasm_relaxed_max_f32x4(a.values, b.values) };
+  #endif
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_f64x2_t
+wav_f64x2_relaxed_max(wav_f64x2_t a, wav_f64x2_t b) {
+  #if WAV_X86_SSE2
+    return (wav_f64x2_t) { _mm_max_pd(a.values, b.values) };
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_f64x2_max(a, b);
+  #else
+    return (wav_f64x2_t) { __builtin_wasm_relaxed_max_f64x2(a.values, b.values) };
+  #endif
+}
+
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_f32x4_t wav_relaxed_max(wav_f32x4_t a, wav_f32x4_t b) { return wav_f32x4_relaxed_max(a, b); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_f64x2_t wav_relaxed_max(wav_f64x2_t a, wav_f64x2_t b) { return wav_f64x2_relaxed_max(a, b); }
+
+/* relaxed_trunc -- Relaxed truncation to integer
+ *
+ * Like trunc_sat, except that the result is implementation-defined
+ * for NaN and for values which are out of range.
+ */
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_i32x4_t
+wav_f32x4_relaxed_trunc_i32x4(wav_f32x4_t a) {
+  #if WAV_X86_SSE2
+    wav_i32x4_t r;
+    r.values = (__typeof__(r.values)) _mm_cvttps_epi32(a.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_f32x4_trunc_sat_i32x4(a);
+  #else
+    return (wav_i32x4_t) { __builtin_wasm_relaxed_trunc_s_i32x4_f32x4(a.values) };
+  #endif
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_u32x4_t
+wav_f32x4_relaxed_trunc_u32x4(wav_f32x4_t a) {
+  #if WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_f32x4_trunc_sat_u32x4(a);
+  #else
+    return (wav_u32x4_t) { __builtin_wasm_relaxed_trunc_u_i32x4_f32x4(a.values) };
+  #endif
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_i32x4_t
+wav_f64x2_relaxed_trunc_zero_i32x4(wav_f64x2_t a) {
+  #if WAV_X86_SSE2
+    wav_i32x4_t r;
+    r.values = (__typeof__(r.values)) _mm_cvttpd_epi32(a.values);
+    return r;
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_f64x2_trunc_sat_zero_i32x4(a);
+  #else
+    return (wav_i32x4_t) { __builtin_wasm_relaxed_trunc_s_zero_i32x4_f64x2(a.values) };
+  #endif
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_u32x4_t
+wav_f64x2_relaxed_trunc_zero_u32x4(wav_f64x2_t a) {
+  #if WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_f64x2_trunc_sat_zero_u32x4(a);
+  #else
+    return (wav_u32x4_t) { __builtin_wasm_relaxed_trunc_u_zero_i32x4_f64x2(a.values) };
+  #endif
+}
+
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_i32x4_t wav_relaxed_trunc_i32x4(wav_f32x4_t a) { return wav_f32x4_relaxed_trunc_i32x4(a); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_u32x4_t wav_relaxed_trunc_u32x4(wav_f32x4_t a) { return wav_f32x4_relaxed_trunc_u32x4(a); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_i32x4_t wav_relaxed_trunc_zero_i32x4(wav_f64x2_t a) { return wav_f64x2_relaxed_trunc_zero_i32x4(a); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_u32x4_t wav_relaxed_trunc_zero_u32x4(wav_f64x2_t a) { return wav_f64x2_relaxed_trunc_zero_u32x4(a); }
+
+/* relaxed_q15mulr -- Relaxed Q-format rounding multiplication
+ *
+ * Like q15mulr_sat, except that the result of INT16_MIN * INT16_MIN
+ * may be either INT16_MAX or INT16_MIN.
+ */
+
+#if WAV_X86_SSSE3 || WAV_X86_SSSE3_DISPATCH_
+WAV_X86_SSSE3_FUNCTION_ATTRIBUTES_
+wav_i16x8_t
+wav_i16x8_relaxed_q15mulr_ssse3_(wav_i16x8_t a, wav_i16x8_t b) {
+  return (wav_i16x8_t) { (__typeof__(a.values)) _mm_mulhrs_epi16((__m128i) a.values, (__m128i) b.values) };
+}
+#endif
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_i16x8_t
+wav_i16x8_relaxed_q15mulr(wav_i16x8_t a, wav_i16x8_t b) {
+  #if WAV_X86_SSSE3_DISPATCH_
+    if (__builtin_cpu_supports("ssse3"))
+      return wav_i16x8_relaxed_q15mulr_ssse3_(a, b);
+  #endif
+  #if WAV_X86_SSSE3
+    return wav_i16x8_relaxed_q15mulr_ssse3_(a, b);
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_i16x8_q15mulr_sat(a, b);
+  #else
+    return (wav_i16x8_t) { __builtin_wasm_relaxed_q15mulr_s_i16x8(a.values, b.values) };
+  #endif
+}
+
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_i16x8_t wav_relaxed_q15mulr(wav_i16x8_t a, wav_i16x8_t b) { return wav_i16x8_relaxed_q15mulr(a, b); }
+
+/* relaxed_dot_i7x16 -- Relaxed 8-bit dot product
+ *
+ * Multiplies the signed 8-bit lanes of a by the lanes of b, then adds
+ * adjacent pairs of the 16-bit results.  The lanes of b should be in
+ * [0, 127] (i.e., 7-bit integers); if they aren't, whether they are
+ * treated as signed or unsigned, and whether the addition saturates,
+ * is implementation-defined.
+ *
+ * relaxed_dot_i7x16_add additionally adds each group of 4 products to
+ * the corresponding 32-bit lane of c.
+ */
+
+#if WAV_X86_SSSE3 || WAV_X86_SSSE3_DISPATCH_
+WAV_X86_SSSE3_FUNCTION_ATTRIBUTES_
+wav_i16x8_t
+wav_i8x16_relaxed_dot_i7x16_ssse3_(wav_i8x16_t a, wav_i8x16_t b) {
+  /* PMADDUBSW treats the first operand as unsigned. */
+  wav_i16x8_t r;
+  r.values = (__typeof__(r.values)) _mm_maddubs_epi16((__m128i) b.values, (__m128i) a.values);
+  return r;
+}
+#endif
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_i16x8_t
+wav_i8x16_relaxed_dot_i7x16(wav_i8x16_t a, wav_i8x16_t b) {
+  #if WAV_X86_SSSE3_DISPATCH_
+    if (__builtin_cpu_supports("ssse3"))
+      return wav_i8x16_relaxed_dot_i7x16_ssse3_(a, b);
+  #endif
+  #if WAV_X86_SSSE3
+    return wav_i8x16_relaxed_dot_i7x16_ssse3_(a, b);
+  #elif WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    wav_i16x8_t r;
+    r.values =
+      __builtin_convertvector(__builtin_shufflevector(a.values, a.values, 0, 2, 4, 6, 8, 10, 12, 14), __typeof__(r.values)) *
+      __builtin_convertvector(__builtin_shufflevector(b.values, b.values, 0, 2, 4, 6, 8, 10, 12, 14), __typeof__(r.values)) +
+      __builtin_convertvector(__builtin_shufflevector(a.values, a.values, 1, 3, 5, 7, 9, 11, 13, 15), __typeof__(r.values)) *
+      __builtin_convertvector(__builtin_shufflevector(b.values, b.values, 1, 3, 5, 7, 9, 11, 13, 15), __typeof__(r.values));
+    return r;
+  #else
+    return (wav_i16x8_t) { __builtin_wasm_relaxed_dot_i8x16_i7x16_s_i16x8(a.values, b.values) };
+  #endif
+}
+
+WAV_RELAXED_FUNCTION_ATTRIBUTES
+wav_i32x4_t
+wav_i8x16_relaxed_dot_i7x16_add(wav_i8x16_t a, wav_i8x16_t b, wav_i32x4_t c) {
+  #if WAV_PORTABLE_SLOW(TODO)
+    WAV_PORTABLE_SLOW_PATH(TODO);
+    return wav_i32x4_add(wav_i16x8_extadd_pairwise(wav_i8x16_relaxed_dot_i7x16(a, b)), c);
+  #else
+    return (wav_i32x4_t) { __builtin_wasm_relaxed_dot_i8x16_i7x16_add_s_i32x4(a.values, b.values, c.values) };
+  #endif
+}
+
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_i16x8_t wav_relaxed_dot_i7x16(wav_i8x16_t a, wav_i8x16_t b) { return wav_i8x16_relaxed_dot_i7x16(a, b); }
+WAV_RELAXED_OVERLOAD_ATTRIBUTES wav_i32x4_t wav_relaxed_dot_i7x16_add(wav_i8x16_t a, wav_i8x16_t b, wav_i32x4_t c) { return wav_i8x16_relaxed_dot_i7x16_add(a, b, c); }
+
+
+/* Half-precision floating point
+ *
+ * wav_f16x8_t holds eight IEEE 754 binary16 values, like the f16x8
+ * type from the FP16 proposal.  The values are stored as their bit
+ * patterns (so loads and stores use uint16_t), and since neither C
+ * nor WASM SIMD128 has half-precision arithmetic the only operations
+ * are conversions to and from f32x4; to do math, promote to
+ * single-precision and demote the result.
+ *
+ * The conversions are built from integer operations (plus a single
+ * floating-point operation for subnormals), so they work on any target
+ * without the FP16 extension.  When emulating on x86 with F16C enabled
+ * (e.g., -mf16c) we use the native conversion instructions instead. */
+
+WAV_FUNCTION_ATTRIBUTES
+wav_f16x8_t
+wav_f16x8_load(const uint16_t src[WAV_ARRAY_LENGTH(8)]) {
+  wav_f16x8_t r;
+  __builtin_memcpy(&r, src, sizeof(r));
+  return r;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_f16x8_t
+wav_f16x8_loadu(const void * src) {
+  wav_f16x8_t r;
+  __builtin_memcpy(&r, src, sizeof(r));
+  return r;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_f16x8_store(uint16_t dest[WAV_ARRAY_LENGTH(8)], wav_f16x8_t src) {
+  __builtin_memcpy(dest, &src, sizeof(src));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_f16x8_storeu(void * dest, wav_f16x8_t src) {
+  __builtin_memcpy(dest, &src, sizeof(src));
+}
+
+/* Converts the binary16 values in the low 16 bits of each lane to
+ * single-precision.  This is exact, so there is no rounding to worry
+ * about. */
+WAV_FUNCTION_ATTRIBUTES
+wav_f32x4_t
+wav_f16x8_promote_u32x4_(wav_u32x4_t vec) {
+  const __typeof__(vec.values) sign = (vec.values & 0x8000) << 16;
+  const __typeof__(vec.values) abs = vec.values & 0x7fff;
+
+  /* Normal numbers just need the exponent rebiased (from 15 to 127).
+   * Doing that a second time for infinity and NaN leaves them with an
+   * exponent of all ones, and keeps the NaN payload. */
+  __typeof__(vec.values) r = (abs << 13) + 0x38000000;
+  r += ((__typeof__(r)) (abs >= 0x7c00)) & 0x38000000;
+
+  /* Zero and subnormals are the mantissa times 2^-24, which is exactly
+   * representable as a (normal) single-precision value. */
+  float subnormal __attribute__((__vector_size__(16))) =
+    __builtin_convertvector(abs, __typeof__(subnormal)) * 5.9604644775390625e-08f;
+  const __typeof__(r) is_subnormal = (__typeof__(r)) (abs < 0x0400);
+  r = (is_subnormal & (__typeof__(r)) subnormal) | (~is_subnormal & r);
+
+  wav_f32x4_t res;
+  res.values = (__typeof__(res.values)) (r | sign);
+  return res;
+}
+
+/* Converts to binary16, rounding to nearest-even, and returns the
+ * result in the low 16 bits of each lane. */
+WAV_FUNCTION_ATTRIBUTES
+wav_u32x4_t
+wav_f32x4_demote_u32x4_(wav_f32x4_t vec) {
+  wav_u32x4_t r;
+  const __typeof__(r.values) bits = (__typeof__(bits)) vec.values;
+  const __typeof__(r.values) sign = (bits >> 16) & 0x8000;
+  const __typeof__(r.values) abs = bits & 0x7fffffff;
+
+  /* Normal results: rebias the exponent and round the mantissa to
+   * nearest-even.  A carry out of the mantissa correctly bumps the
+   * exponent. */
+  r.values = (abs - 0x38000000 + 0x0fff + ((abs >> 13) & 1)) >> 13;
+
+  /* Subnormal results (below 2^-14): adding 0.5 puts the binary16
+   * subnormal ULP (2^-24) in the last bit of the single-precision
+   * mantissa, so the FPU does the rounding for us. */
+  float f __attribute__((__vector_size__(16))) = (__typeof__(f)) abs;
+  f += 0.5f;
+  const __typeof__(r.values) is_subnormal = (__typeof__(r.values)) (abs < 0x38800000);
+  r.values = (is_subnormal & ((__typeof__(r.values)) f - 0x3f000000)) | (~is_subnormal & r.values);
+
+  /* Anything which rounds to 65536 or more (including infinity)
+   * becomes infinity.  NaNs are quieted and keep the top of their
+   * payload. */
+  const __typeof__(r.values) is_inf = (__typeof__(r.values)) (abs >= 0x477ff000);
+  r.values = (is_inf & 0x7c00) | (~is_inf & r.values);
+  const __typeof__(r.values) is_nan = (__typeof__(r.values)) (abs > 0x7f800000);
+  r.values = (is_nan & (((abs >> 13) & 0x03ff) | 0x7e00)) | (~is_nan & r.values);
+
+  r.values |= sign;
+  return r;
+}
+
+/* promote_low -- Half-precision floating point to single-precision
+ *
+ * Conversion of the four lower half-precision floating point lanes to
+ * the four single-precision lanes of the result.
+ */
+
+WAV_FUNCTION_ATTRIBUTES
+wav_f32x4_t
+wav_f16x8_promote_low(wav_f16x8_t vec) {
+  #if WAV_X86_F16C
+    return (wav_f32x4_t) { _mm_cvtph_ps((__m128i) vec.values) };
+  #else
+    return wav_f16x8_promote_u32x4_(wav_u16x8_extend_low(wav_f16x8_as_u16x8(vec)));
+  #endif
+}
+
+WAV_OVERLOAD_ATTRIBUTES wav_f32x4_t wav_promote_low(wav_f16x8_t vec) { return wav_f16x8_promote_low(vec); }
+
+/* promote_high -- Half-precision floating point to single-precision
+ *
+ * Conversion of the four higher half-precision floating point lanes to
+ * the four single-precision lanes of the result.
+ */
+
+WAV_FUNCTION_ATTRIBUTES
+wav_f32x4_t
+wav_f16x8_promote_high(wav_f16x8_t vec) {
+  #if WAV_X86_F16C
+    return (wav_f32x4_t) { _mm_cvtph_ps(_mm_unpackhi_epi64((__m128i) vec.values, (__m128i) vec.values)) };
+  #else
+    return wav_f16x8_promote_u32x4_(wav_u16x8_extend_high(wav_f16x8_as_u16x8(vec)));
+  #endif
+}
+
+WAV_OVERLOAD_ATTRIBUTES wav_f32x4_t wav_promote_high(wav_f16x8_t vec) { return wav_f16x8_promote_high(vec); }
+
+/* demote -- Single-precision floating point to half-precision
+ *
+ * Conversion of the single-precision floating point lanes of a to the
+ * lower four half-precision lanes of the result, and the lanes of b to
+ * the higher four.  If the conversion result is not representable as
+ * a half-precision floating point number, it is rounded to the
+ * nearest-even representable number; values too large to represent
+ * become infinity.
+ */
+
+WAV_FUNCTION_ATTRIBUTES
+wav_f16x8_t
+wav_f32x4_demote(wav_f32x4_t a, wav_f32x4_t b) {
+  wav_f16x8_t r;
+  #if WAV_X86_F16C
+    r.values = (__typeof__(r.values)) _mm_unpacklo_epi64(
+      _mm_cvtps_ph(a.values, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC),
+      _mm_cvtps_ph(b.values, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)
+    );
+  #else
+    uint16_t lo __attribute__((__vector_size__(8))) = __builtin_convertvector(wav_f32x4_demote_u32x4_(a).values, __typeof__(lo));
+    __typeof__(lo) hi = __builtin_convertvector(wav_f32x4_demote_u32x4_(b).values, __typeof__(hi));
+    r.values = __builtin_shufflevector(lo, hi, 0, 1, 2, 3, 4, 5, 6, 7);
+  #endif
+  return r;
+}
+
+WAV_OVERLOAD_ATTRIBUTES wav_f16x8_t wav_demote(wav_f32x4_t a, wav_f32x4_t b) { return wav_f32x4_demote(a, b); }
+
 #pragma clang diagnostic pop
 
 #endif /* !defined(WAV_H) */
@@ -0,0 +1,360 @@
+/* WAV arrays
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* Element-wise kernels over whole arrays.
+ *
+ * For every WAV operation which takes one or two vectors and returns a
+ * vector of the same type, this header provides a function which
+ * applies it to arrays of any length:
+ *
+ *   void wav_f32x4_array_add(float dest[], const float a[], const float b[], size_t len);
+ *   void wav_f32x4_array_sqrt(float dest[], const float src[], size_t len);
+ *
+ * len is the number of elements, not vectors.  For the boolean types
+ * the arrays hold the lane values (all bits set or all clear) as
+ * unsigned integers of the lane width.  dest may be the same as one
+ * of the inputs (i.e., the operation may be done in place), but must
+ * not otherwise overlap them.
+ *
+ * The main loop works on four vectors at a time so the loads and
+ * operations don't form a single dependency chain.  Before it, a
+ * partial vector brings dest up to 16-byte alignment, and after it any
+ * remaining elements are processed as one more partial vector instead
+ * of with a scalar loop.  Partial vectors are loaded and stored using
+ * load_partial and store_partial, so nothing outside of the arrays is
+ * ever read or written. */
+
+#if !defined(WAV_ARRAY_H)
+#define WAV_ARRAY_H
+
+#include <stddef.h>
+#include "wav.h"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc99-extensions"
+#pragma clang diagnostic ignored "-Wc11-extensions"
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#pragma clang diagnostic ignored "-Wold-style-cast"
+#pragma clang diagnostic ignored "-Wcast-align"
+
+/* Number of elements to process before the main loop so that dest is
+ * 16-byte aligned.  If the whole array fits in a single vector we
+ * just do it all at once. */
+WAV_FUNCTION_ATTRIBUTES
+size_t
+wav_array_head_length_(const void * dest, size_t element_size, size_t len) {
+  const uintptr_t misalignment = ((uintptr_t) dest) & 15;
+  size_t head;
+
+  if (len <= (16 / element_size)) {
+    return len;
+  } else if ((misalignment % element_size) != 0) {
+    /* dest isn't even aligned to the element size; don't bother. */
+    return 0;
+  }
+
+  head = ((16 - misalignment) & 15) / element_size;
+  return (head < len) ? head : len;
+}
+
+/* Per-type loads and stores.  These work for the boolean types too,
+ * which have no load or store functions in wav.h; the partial ones are
+ * wav_u8x16_load_partial and wav_u8x16_store_partial underneath. */
+#define WAV_ARRAY_DEFINE_TYPE_(Type, Element) \
+  WAV_FUNCTION_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_array_##Type##_loadu_(const Element * src) { \
+    wav_##Type##_t r; \
+    __builtin_memcpy(&r, src, sizeof(r)); \
+    return r; \
+  } \
+  \
+  WAV_FUNCTION_ATTRIBUTES \
+  void \
+  wav_array_##Type##_storeu_(Element * dest, wav_##Type##_t src) { \
+    __builtin_memcpy(dest, &src, sizeof(src)); \
+  } \
+  \
+  WAV_FUNCTION_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_array_##Type##_load_partial_(const Element * src, size_t len) { \
+    return wav_v128_as_##Type(wav_u8x16_as_v128(wav_u8x16_load_partial(src, len * sizeof(Element)))); \
+  } \
+  \
+  WAV_FUNCTION_ATTRIBUTES \
+  void \
+  wav_array_##Type##_store_partial_(Element * dest, wav_##Type##_t src, size_t len) { \
+    wav_u8x16_store_partial(dest, wav_v128_as_u8x16(wav_##Type##_as_v128(src)), len * sizeof(Element)); \
+  }
+
+#define WAV_ARRAY_DEFINE_UNARY_(Type, Element, Operation) \
+  WAV_KERNEL_ATTRIBUTES \
+  void \
+  wav_##Type##_array_##Operation(Element * dest, const Element * src, size_t len) { \
+    const size_t lanes = sizeof(wav_##Type##_t) / sizeof(Element); \
+    size_t i = wav_array_head_length_(dest, sizeof(Element), len); \
+    \
+    if (i != 0) { \
+      wav_array_##Type##_store_partial_(dest, wav_##Type##_##Operation(wav_array_##Type##_load_partial_(src, i)), i); \
+    } \
+    \
+    for ( ; (len - i) >= (lanes * 4) ; i += lanes * 4) { \
+      const wav_##Type##_t v0 = wav_array_##Type##_loadu_(&(src[i + (lanes * 0)])); \
+      const wav_##Type##_t v1 = wav_array_##Type##_loadu_(&(src[i + (lanes * 1)])); \
+      const wav_##Type##_t v2 = wav_array_##Type##_loadu_(&(src[i + (lanes * 2)])); \
+      const wav_##Type##_t v3 = wav_array_##Type##_loadu_(&(src[i + (lanes * 3)])); \
+      wav_array_##Type##_storeu_(&(dest[i + (lanes * 0)]), wav_##Type##_##Operation(v0)); \
+      wav_array_##Type##_storeu_(&(dest[i + (lanes * 1)]), wav_##Type##_##Operation(v1)); \
+      wav_array_##Type##_storeu_(&(dest[i + (lanes * 2)]), wav_##Type##_##Operation(v2)); \
+      wav_array_##Type##_storeu_(&(dest[i + (lanes * 3)]), wav_##Type##_##Operation(v3)); \
+    } \
+    \
+    for ( ; (len - i) >= lanes ; i += lanes) { \
+      wav_array_##Type##_storeu_(&(dest[i]), wav_##Type##_##Operation(wav_array_##Type##_loadu_(&(src[i])))); \
+    } \
+    \
+    if (i != len) { \
+      wav_array_##Type##_store_partial_(&(dest[i]), wav_##Type##_##Operation(wav_array_##Type##_load_partial_(&(src[i]), len - i)), len - i); \
+    } \
+  }
+
+#define WAV_ARRAY_DEFINE_BINARY_(Type, Element, Operation) \
+  WAV_KERNEL_ATTRIBUTES \
+  void \
+  wav_##Type##_array_##Operation(Element * dest, const Element * a, const Element * b, size_t len) { \
+    const size_t lanes = sizeof(wav_##Type##_t) / sizeof(Element); \
+    size_t i = wav_array_head_length_(dest, sizeof(Element), len); \
+    \
+    if (i != 0) { \
+      wav_array_##Type##_store_partial_(dest, \
+        wav_##Type##_##Operation(wav_array_##Type##_load_partial_(a, i), wav_array_##Type##_load_partial_(b, i)), i); \
+    } \
+    \
+    for ( ; (len - i) >= (lanes * 4) ; i += lanes * 4) { \
+      const wav_##Type##_t a0 = wav_array_##Type##_loadu_(&(a[i + (lanes * 0)])); \
+      const wav_##Type##_t a1 = wav_array_##Type##_loadu_(&(a[i + (lanes * 1)])); \
+      const wav_##Type##_t a2 = wav_array_##Type##_loadu_(&(a[i + (lanes * 2)])); \
+      const wav_##Type##_t a3 = wav_array_##Type##_loadu_(&(a[i + (lanes * 3)])); \
+      const wav_##Type##_t b0 = wav_array_##Type##_loadu_(&(b[i + (lanes * 0)])); \
+      const wav_##Type##_t b1 = wav_array_##Type##_loadu_(&(b[i + (lanes * 1)])); \
+      const wav_##Type##_t b2 = wav_array_##Type##_loadu_(&(b[i + (lanes * 2)])); \
+      const wav_##Type##_t b3 = wav_array_##Type##_loadu_(&(b[i + (lanes * 3)])); \
+      wav_array_##Type##_storeu_(&(dest[i + (lanes * 0)]), wav_##Type##_##Operation(a0, b0)); \
+      wav_array_##Type##_storeu_(&(dest[i + (lanes * 1)]), wav_##Type##_##Operation(a1, b1)); \
+      wav_array_##Type##_storeu_(&(dest[i + (lanes * 2)]), wav_##Type##_##Operation(a2, b2)); \
+      wav_array_##Type##_storeu_(&(dest[i + (lanes * 3)]), wav_##Type##_##Operation(a3, b3)); \
+    } \
+    \
+    for ( ; (len - i) >= lanes ; i += lanes) { \
+      wav_array_##Type##_storeu_(&(dest[i]), \
+        wav_##Type##_##Operation(wav_array_##Type##_loadu_(&(a[i])), wav_array_##Type##_loadu_(&(b[i])))); \
+    } \
+    \
+    if (i != len) { \
+      wav_array_##Type##_store_partial_(&(dest[i]), \
+        wav_##Type##_##Operation(wav_array_##Type##_load_partial_(&(a[i]), len - i), wav_array_##Type##_load_partial_(&(b[i]), len - i)), len - i); \
+    } \
+  }
+
+WAV_ARRAY_DEFINE_TYPE_(i8x16,   int8_t)
+WAV_ARRAY_DEFINE_TYPE_(i16x8,  int16_t)
+WAV_ARRAY_DEFINE_TYPE_(i32x4,  int32_t)
+WAV_ARRAY_DEFINE_TYPE_(i64x2,  int64_t)
+WAV_ARRAY_DEFINE_TYPE_(u8x16,  uint8_t)
+WAV_ARRAY_DEFINE_TYPE_(u16x8, uint16_t)
+WAV_ARRAY_DEFINE_TYPE_(u32x4, uint32_t)
+WAV_ARRAY_DEFINE_TYPE_(u64x2, uint64_t)
+WAV_ARRAY_DEFINE_TYPE_(f32x4,    float)
+WAV_ARRAY_DEFINE_TYPE_(f64x2,   double)
+WAV_ARRAY_DEFINE_TYPE_(b8x16,  uint8_t)
+WAV_ARRAY_DEFINE_TYPE_(b16x8, uint16_t)
+WAV_ARRAY_DEFINE_TYPE_(b32x4, uint32_t)
+WAV_ARRAY_DEFINE_TYPE_(b64x2, uint64_t)
+
+WAV_ARRAY_DEFINE_UNARY_ (i8x16,   int8_t, not)
+WAV_ARRAY_DEFINE_UNARY_ (i8x16,   int8_t, neg)
+WAV_ARRAY_DEFINE_UNARY_ (i8x16,   int8_t, abs)
+WAV_ARRAY_DEFINE_UNARY_ (i8x16,   int8_t, popcnt)
+WAV_ARRAY_DEFINE_BINARY_(i8x16,   int8_t, add)
+WAV_ARRAY_DEFINE_BINARY_(i8x16,   int8_t, sub)
+WAV_ARRAY_DEFINE_BINARY_(i8x16,   int8_t, min)
+WAV_ARRAY_DEFINE_BINARY_(i8x16,   int8_t, max)
+WAV_ARRAY_DEFINE_BINARY_(i8x16,   int8_t, add_sat)
+WAV_ARRAY_DEFINE_BINARY_(i8x16,   int8_t, sub_sat)
+WAV_ARRAY_DEFINE_BINARY_(i8x16,   int8_t, and)
+WAV_ARRAY_DEFINE_BINARY_(i8x16,   int8_t, or)
+WAV_ARRAY_DEFINE_BINARY_(i8x16,   int8_t, xor)
+WAV_ARRAY_DEFINE_BINARY_(i8x16,   int8_t, andnot)
+
+WAV_ARRAY_DEFINE_UNARY_ (i16x8,  int16_t, not)
+WAV_ARRAY_DEFINE_UNARY_ (i16x8,  int16_t, neg)
+WAV_ARRAY_DEFINE_UNARY_ (i16x8,  int16_t, abs)
+WAV_ARRAY_DEFINE_BINARY_(i16x8,  int16_t, add)
+WAV_ARRAY_DEFINE_BINARY_(i16x8,  int16_t, sub)
+WAV_ARRAY_DEFINE_BINARY_(i16x8,  int16_t, mul)
+WAV_ARRAY_DEFINE_BINARY_(i16x8,  int16_t, min)
+WAV_ARRAY_DEFINE_BINARY_(i16x8,  int16_t, max)
+WAV_ARRAY_DEFINE_BINARY_(i16x8,  int16_t, add_sat)
+WAV_ARRAY_DEFINE_BINARY_(i16x8,  int16_t, sub_sat)
+WAV_ARRAY_DEFINE_BINARY_(i16x8,  int16_t, and)
+WAV_ARRAY_DEFINE_BINARY_(i16x8,  int16_t, or)
+WAV_ARRAY_DEFINE_BINARY_(i16x8,  int16_t, xor)
+WAV_ARRAY_DEFINE_BINARY_(i16x8,  int16_t, andnot)
+
+WAV_ARRAY_DEFINE_UNARY_ (i32x4,  int32_t, not)
+WAV_ARRAY_DEFINE_UNARY_ (i32x4,  int32_t, neg)
+WAV_ARRAY_DEFINE_UNARY_ (i32x4,  int32_t, abs)
+WAV_ARRAY_DEFINE_BINARY_(i32x4,  int32_t, add)
+WAV_ARRAY_DEFINE_BINARY_(i32x4,  int32_t, sub)
+WAV_ARRAY_DEFINE_BINARY_(i32x4,  int32_t, mul)
+WAV_ARRAY_DEFINE_BINARY_(i32x4,  int32_t, min)
+WAV_ARRAY_DEFINE_BINARY_(i32x4,  int32_t, max)
+WAV_ARRAY_DEFINE_BINARY_(i32x4,  int32_t, and)
+WAV_ARRAY_DEFINE_BINARY_(i32x4,  int32_t, or)
+WAV_ARRAY_DEFINE_BINARY_(i32x4,  int32_t, xor)
+WAV_ARRAY_DEFINE_BINARY_(i32x4,  int32_t, andnot)
+
+WAV_ARRAY_DEFINE_UNARY_ (i64x2,  int64_t, not)
+WAV_ARRAY_DEFINE_UNARY_ (i64x2,  int64_t, neg)
+WAV_ARRAY_DEFINE_UNARY_ (i64x2,  int64_t, abs)
+WAV_ARRAY_DEFINE_BINARY_(i64x2,  int64_t, add)
+WAV_ARRAY_DEFINE_BINARY_(i64x2,  int64_t, sub)
+WAV_ARRAY_DEFINE_BINARY_(i64x2,  int64_t, mul)
+WAV_ARRAY_DEFINE_BINARY_(i64x2,  int64_t, and)
+WAV_ARRAY_DEFINE_BINARY_(i64x2,  int64_t, or)
+WAV_ARRAY_DEFINE_BINARY_(i64x2,  int64_t, xor)
+WAV_ARRAY_DEFINE_BINARY_(i64x2,  int64_t, andnot)
+
+WAV_ARRAY_DEFINE_UNARY_ (u8x16,  uint8_t, not)
+WAV_ARRAY_DEFINE_UNARY_ (u8x16,  uint8_t, popcnt)
+WAV_ARRAY_DEFINE_BINARY_(u8x16,  uint8_t, add)
+WAV_ARRAY_DEFINE_BINARY_(u8x16,  uint8_t, sub)
+WAV_ARRAY_DEFINE_BINARY_(u8x16,  uint8_t, min)
+WAV_ARRAY_DEFINE_BINARY_(u8x16,  uint8_t, max)
+WAV_ARRAY_DEFINE_BINARY_(u8x16,  uint8_t, add_sat)
+WAV_ARRAY_DEFINE_BINARY_(u8x16,  uint8_t, sub_sat)
+WAV_ARRAY_DEFINE_BINARY_(u8x16,  uint8_t, avgr)
+WAV_ARRAY_DEFINE_BINARY_(u8x16,  uint8_t, and)
+WAV_ARRAY_DEFINE_BINARY_(u8x16,  uint8_t, or)
+WAV_ARRAY_DEFINE_BINARY_(u8x16,  uint8_t, xor)
+WAV_ARRAY_DEFINE_BINARY_(u8x16,  uint8_t, andnot)
+
+WAV_ARRAY_DEFINE_UNARY_ (u16x8, uint16_t, not)
+WAV_ARRAY_DEFINE_BINARY_(u16x8, uint16_t, add)
+WAV_ARRAY_DEFINE_BINARY_(u16x8, uint16_t, sub)
+WAV_ARRAY_DEFINE_BINARY_(u16x8, uint16_t, mul)
+WAV_ARRAY_DEFINE_BINARY_(u16x8, uint16_t, min)
+WAV_ARRAY_DEFINE_BINARY_(u16x8, uint16_t, max)
+WAV_ARRAY_DEFINE_BINARY_(u16x8, uint16_t, add_sat)
+WAV_ARRAY_DEFINE_BINARY_(u16x8, uint16_t, sub_sat)
+WAV_ARRAY_DEFINE_BINARY_(u16x8, uint16_t, avgr)
+WAV_ARRAY_DEFINE_BINARY_(u16x8, uint16_t, and)
+WAV_ARRAY_DEFINE_BINARY_(u16x8, uint16_t, or)
+WAV_ARRAY_DEFINE_BINARY_(u16x8, uint16_t, xor)
+WAV_ARRAY_DEFINE_BINARY_(u16x8, uint16_t, andnot)
+
+WAV_ARRAY_DEFINE_UNARY_ (u32x4, uint32_t, not)
+WAV_ARRAY_DEFINE_BINARY_(u32x4, uint32_t, add)
+WAV_ARRAY_DEFINE_BINARY_(u32x4, uint32_t, sub)
+WAV_ARRAY_DEFINE_BINARY_(u32x4, uint32_t, mul)
+WAV_ARRAY_DEFINE_BINARY_(u32x4, uint32_t, min)
+WAV_ARRAY_DEFINE_BINARY_(u32x4, uint32_t, max)
+WAV_ARRAY_DEFINE_BINARY_(u32x4, uint32_t, and)
+WAV_ARRAY_DEFINE_BINARY_(u32x4, uint32_t, or)
+WAV_ARRAY_DEFINE_BINARY_(u32x4, uint32_t, xor)
+WAV_ARRAY_DEFINE_BINARY_(u32x4, uint32_t, andnot)
+
+WAV_ARRAY_DEFINE_UNARY_ (u64x2, uint64_t, not)
+WAV_ARRAY_DEFINE_BINARY_(u64x2, uint64_t, add)
+WAV_ARRAY_DEFINE_BINARY_(u64x2, uint64_t, sub)
+WAV_ARRAY_DEFINE_BINARY_(u64x2, uint64_t, mul)
+WAV_ARRAY_DEFINE_BINARY_(u64x2, uint64_t, and)
+WAV_ARRAY_DEFINE_BINARY_(u64x2, uint64_t, or)
+WAV_ARRAY_DEFINE_BINARY_(u64x2, uint64_t, xor)
+WAV_ARRAY_DEFINE_BINARY_(u64x2, uint64_t, andnot)
+
+WAV_ARRAY_DEFINE_UNARY_ (f32x4,    float, neg)
+WAV_ARRAY_DEFINE_UNARY_ (f32x4,    float, abs)
+WAV_ARRAY_DEFINE_UNARY_ (f32x4,    float, sqrt)
+WAV_ARRAY_DEFINE_UNARY_ (f32x4,    float, ceil)
+WAV_ARRAY_DEFINE_UNARY_ (f32x4,    float, floor)
+WAV_ARRAY_DEFINE_UNARY_ (f32x4,    float, trunc)
+WAV_ARRAY_DEFINE_UNARY_ (f32x4,    float, nearest)
+WAV_ARRAY_DEFINE_BINARY_(f32x4,    float, add)
+WAV_ARRAY_DEFINE_BINARY_(f32x4,    float, sub)
+WAV_ARRAY_DEFINE_BINARY_(f32x4,    float, mul)
+WAV_ARRAY_DEFINE_BINARY_(f32x4,    float, div)
+WAV_ARRAY_DEFINE_BINARY_(f32x4,    float, min)
+WAV_ARRAY_DEFINE_BINARY_(f32x4,    float, max)
+WAV_ARRAY_DEFINE_BINARY_(f32x4,    float, pmin)
+WAV_ARRAY_DEFINE_BINARY_(f32x4,    float, pmax)
+
+WAV_ARRAY_DEFINE_UNARY_ (f64x2,   double, neg)
+WAV_ARRAY_DEFINE_UNARY_ (f64x2,   double, abs)
+WAV_ARRAY_DEFINE_UNARY_ (f64x2,   double, sqrt)
+WAV_ARRAY_DEFINE_UNARY_ (f64x2,   double, ceil)
+WAV_ARRAY_DEFINE_UNARY_ (f64x2,   double, floor)
+WAV_ARRAY_DEFINE_UNARY_ (f64x2,   double, trunc)
+WAV_ARRAY_DEFINE_UNARY_ (f64x2,   double, nearest)
+WAV_ARRAY_DEFINE_BINARY_(f64x2,   double, add)
+WAV_ARRAY_DEFINE_BINARY_(f64x2,   double, sub)
+WAV_ARRAY_DEFINE_BINARY_(f64x2,   double, mul)
+WAV_ARRAY_DEFINE_BINARY_(f64x2,   double, div)
+WAV_ARRAY_DEFINE_BINARY_(f64x2,   double, min)
+WAV_ARRAY_DEFINE_BINARY_(f64x2,   double, max)
+WAV_ARRAY_DEFINE_BINARY_(f64x2,   double, pmin)
+WAV_ARRAY_DEFINE_BINARY_(f64x2,   double, pmax)
+
+WAV_ARRAY_DEFINE_UNARY_ (b8x16,  uint8_t, not)
+WAV_ARRAY_DEFINE_BINARY_(b8x16,  uint8_t, and)
+WAV_ARRAY_DEFINE_BINARY_(b8x16,  uint8_t, or)
+WAV_ARRAY_DEFINE_BINARY_(b8x16,  uint8_t, xor)
+WAV_ARRAY_DEFINE_BINARY_(b8x16,  uint8_t, andnot)
+
+WAV_ARRAY_DEFINE_UNARY_ (b16x8, uint16_t, not)
+WAV_ARRAY_DEFINE_BINARY_(b16x8, uint16_t, and)
+WAV_ARRAY_DEFINE_BINARY_(b16x8, uint16_t, or)
+WAV_ARRAY_DEFINE_BINARY_(b16x8, uint16_t, xor)
+WAV_ARRAY_DEFINE_BINARY_(b16x8, uint16_t, andnot)
+
+WAV_ARRAY_DEFINE_UNARY_ (b32x4, uint32_t, not)
+WAV_ARRAY_DEFINE_BINARY_(b32x4, uint32_t, and)
+WAV_ARRAY_DEFINE_BINARY_(b32x4, uint32_t, or)
+WAV_ARRAY_DEFINE_BINARY_(b32x4, uint32_t, xor)
+WAV_ARRAY_DEFINE_BINARY_(b32x4, uint32_t, andnot)
+
+WAV_ARRAY_DEFINE_UNARY_ (b64x2, uint64_t, not)
+WAV_ARRAY_DEFINE_BINARY_(b64x2, uint64_t, and)
+WAV_ARRAY_DEFINE_BINARY_(b64x2, uint64_t, or)
+WAV_ARRAY_DEFINE_BINARY_(b64x2, uint64_t, xor)
+WAV_ARRAY_DEFINE_BINARY_(b64x2, uint64_t, andnot)
+
+#pragma clang diagnostic pop
+
+#endif /* !defined(WAV_ARRAY_H) */
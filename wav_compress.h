@@ -0,0 +1,510 @@
+/* WAV compress
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* Stream compaction.
+ *
+ * WASM SIMD has no compress instruction, so these are built from
+ * bitmask and a swizzle with indices from a lookup table.
+ *
+ * Register-level compress moves the lanes selected by a mask to the
+ * bottom of the vector, in order, and zeroes the rest:
+ *
+ *   wav_u32x4_t wav_u32x4_compress(wav_u32x4_t v, wav_b32x4_t mask, size_t * count);
+ *
+ * *count is set to the number of lanes selected.
+ *
+ * Expand is the inverse; it moves the lowest lanes of a vector to the
+ * lanes selected by a mask, in order, and zeroes the rest:
+ *
+ *   wav_u32x4_t wav_u32x4_expand(wav_u32x4_t dense, wav_b32x4_t mask);
+ *
+ * The filter kernels keep the elements of an array which compare
+ * (eq, ne, lt, le, gt, or ge) to a value, and return how many were
+ * kept:
+ *
+ *   size_t wav_u32x4_filter_lt(uint32_t dest[], const uint32_t src[], size_t len, uint32_t value);
+ *
+ * They're available for u8x16, u16x8, u32x4, u64x2, and f32x4, and as
+ * wav_filter_eq, wav_filter_lt, etc. overloads.  dest must have room
+ * for len elements; whole vectors are stored so elements past the
+ * returned count may be overwritten.  dest may be the same as src.
+ *
+ * Compress uses a 2 KiB table with the indices of the set bits for
+ * every 8-bit mask.  Wider lanes turn those into byte indices, and
+ * 8-bit lanes compress each half separately then slide the upper half
+ * down with a second swizzle.  Expand has a second table with the
+ * destination of each lane, which only needs a single swizzle even for
+ * 8-bit lanes. */
+
+#if !defined(WAV_COMPRESS_H)
+#define WAV_COMPRESS_H
+
+#include <stddef.h>
+#include "wav.h"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc99-extensions"
+#pragma clang diagnostic ignored "-Wc11-extensions"
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#pragma clang diagnostic ignored "-Wold-style-cast"
+
+/* For each 8-bit mask, the indices of the set bits (starting with the
+ * least significant byte), followed by 16s; 16 and anything derived
+ * from it is out of range for swizzle, so those lanes become zero. */
+static const uint64_t wav_compress_table_[256] = {
+  UINT64_C(0x1010101010101010), UINT64_C(0x1010101010101000), UINT64_C(0x1010101010101001), UINT64_C(0x1010101010100100),
+  UINT64_C(0x1010101010101002), UINT64_C(0x1010101010100200), UINT64_C(0x1010101010100201), UINT64_C(0x1010101010020100),
+  UINT64_C(0x1010101010101003), UINT64_C(0x1010101010100300), UINT64_C(0x1010101010100301), UINT64_C(0x1010101010030100),
+  UINT64_C(0x1010101010100302), UINT64_C(0x1010101010030200), UINT64_C(0x1010101010030201), UINT64_C(0x1010101003020100),
+  UINT64_C(0x1010101010101004), UINT64_C(0x1010101010100400), UINT64_C(0x1010101010100401), UINT64_C(0x1010101010040100),
+  UINT64_C(0x1010101010100402), UINT64_C(0x1010101010040200), UINT64_C(0x1010101010040201), UINT64_C(0x1010101004020100),
+  UINT64_C(0x1010101010100403), UINT64_C(0x1010101010040300), UINT64_C(0x1010101010040301), UINT64_C(0x1010101004030100),
+  UINT64_C(0x1010101010040302), UINT64_C(0x1010101004030200), UINT64_C(0x1010101004030201), UINT64_C(0x1010100403020100),
+  UINT64_C(0x1010101010101005), UINT64_C(0x1010101010100500), UINT64_C(0x1010101010100501), UINT64_C(0x1010101010050100),
+  UINT64_C(0x1010101010100502), UINT64_C(0x1010101010050200), UINT64_C(0x1010101010050201), UINT64_C(0x1010101005020100),
+  UINT64_C(0x1010101010100503), UINT64_C(0x1010101010050300), UINT64_C(0x1010101010050301), UINT64_C(0x1010101005030100),
+  UINT64_C(0x1010101010050302), UINT64_C(0x1010101005030200), UINT64_C(0x1010101005030201), UINT64_C(0x1010100503020100),
+  UINT64_C(0x1010101010100504), UINT64_C(0x1010101010050400), UINT64_C(0x1010101010050401), UINT64_C(0x1010101005040100),
+  UINT64_C(0x1010101010050402), UINT64_C(0x1010101005040200), UINT64_C(0x1010101005040201), UINT64_C(0x1010100504020100),
+  UINT64_C(0x1010101010050403), UINT64_C(0x1010101005040300), UINT64_C(0x1010101005040301), UINT64_C(0x1010100504030100),
+  UINT64_C(0x1010101005040302), UINT64_C(0x1010100504030200), UINT64_C(0x1010100504030201), UINT64_C(0x1010050403020100),
+  UINT64_C(0x1010101010101006), UINT64_C(0x1010101010100600), UINT64_C(0x1010101010100601), UINT64_C(0x1010101010060100),
+  UINT64_C(0x1010101010100602), UINT64_C(0x1010101010060200), UINT64_C(0x1010101010060201), UINT64_C(0x1010101006020100),
+  UINT64_C(0x1010101010100603), UINT64_C(0x1010101010060300), UINT64_C(0x1010101010060301), UINT64_C(0x1010101006030100),
+  UINT64_C(0x1010101010060302), UINT64_C(0x1010101006030200), UINT64_C(0x1010101006030201), UINT64_C(0x1010100603020100),
+  UINT64_C(0x1010101010100604), UINT64_C(0x1010101010060400), UINT64_C(0x1010101010060401), UINT64_C(0x1010101006040100),
+  UINT64_C(0x1010101010060402), UINT64_C(0x1010101006040200), UINT64_C(0x1010101006040201), UINT64_C(0x1010100604020100),
+  UINT64_C(0x1010101010060403), UINT64_C(0x1010101006040300), UINT64_C(0x1010101006040301), UINT64_C(0x1010100604030100),
+  UINT64_C(0x1010101006040302), UINT64_C(0x1010100604030200), UINT64_C(0x1010100604030201), UINT64_C(0x1010060403020100),
+  UINT64_C(0x1010101010100605), UINT64_C(0x1010101010060500), UINT64_C(0x1010101010060501), UINT64_C(0x1010101006050100),
+  UINT64_C(0x1010101010060502), UINT64_C(0x1010101006050200), UINT64_C(0x1010101006050201), UINT64_C(0x1010100605020100),
+  UINT64_C(0x1010101010060503), UINT64_C(0x1010101006050300), UINT64_C(0x1010101006050301), UINT64_C(0x1010100605030100),
+  UINT64_C(0x1010101006050302), UINT64_C(0x1010100605030200), UINT64_C(0x1010100605030201), UINT64_C(0x1010060503020100),
+  UINT64_C(0x1010101010060504), UINT64_C(0x1010101006050400), UINT64_C(0x1010101006050401), UINT64_C(0x1010100605040100),
+  UINT64_C(0x1010101006050402), UINT64_C(0x1010100605040200), UINT64_C(0x1010100605040201), UINT64_C(0x1010060504020100),
+  UINT64_C(0x1010101006050403), UINT64_C(0x1010100605040300), UINT64_C(0x1010100605040301), UINT64_C(0x1010060504030100),
+  UINT64_C(0x1010100605040302), UINT64_C(0x1010060504030200), UINT64_C(0x1010060504030201), UINT64_C(0x1006050403020100),
+  UINT64_C(0x1010101010101007), UINT64_C(0x1010101010100700), UINT64_C(0x1010101010100701), UINT64_C(0x1010101010070100),
+  UINT64_C(0x1010101010100702), UINT64_C(0x1010101010070200), UINT64_C(0x1010101010070201), UINT64_C(0x1010101007020100),
+  UINT64_C(0x1010101010100703), UINT64_C(0x1010101010070300), UINT64_C(0x1010101010070301), UINT64_C(0x1010101007030100),
+  UINT64_C(0x1010101010070302), UINT64_C(0x1010101007030200), UINT64_C(0x1010101007030201), UINT64_C(0x1010100703020100),
+  UINT64_C(0x1010101010100704), UINT64_C(0x1010101010070400), UINT64_C(0x1010101010070401), UINT64_C(0x1010101007040100),
+  UINT64_C(0x1010101010070402), UINT64_C(0x1010101007040200), UINT64_C(0x1010101007040201), UINT64_C(0x1010100704020100),
+  UINT64_C(0x1010101010070403), UINT64_C(0x1010101007040300), UINT64_C(0x1010101007040301), UINT64_C(0x1010100704030100),
+  UINT64_C(0x1010101007040302), UINT64_C(0x1010100704030200), UINT64_C(0x1010100704030201), UINT64_C(0x1010070403020100),
+  UINT64_C(0x1010101010100705), UINT64_C(0x1010101010070500), UINT64_C(0x1010101010070501), UINT64_C(0x1010101007050100),
+  UINT64_C(0x1010101010070502), UINT64_C(0x1010101007050200), UINT64_C(0x1010101007050201), UINT64_C(0x1010100705020100),
+  UINT64_C(0x1010101010070503), UINT64_C(0x1010101007050300), UINT64_C(0x1010101007050301), UINT64_C(0x1010100705030100),
+  UINT64_C(0x1010101007050302), UINT64_C(0x1010100705030200), UINT64_C(0x1010100705030201), UINT64_C(0x1010070503020100),
+  UINT64_C(0x1010101010070504), UINT64_C(0x1010101007050400), UINT64_C(0x1010101007050401), UINT64_C(0x1010100705040100),
+  UINT64_C(0x1010101007050402), UINT64_C(0x1010100705040200), UINT64_C(0x1010100705040201), UINT64_C(0x1010070504020100),
+  UINT64_C(0x1010101007050403), UINT64_C(0x1010100705040300), UINT64_C(0x1010100705040301), UINT64_C(0x1010070504030100),
+  UINT64_C(0x1010100705040302), UINT64_C(0x1010070504030200), UINT64_C(0x1010070504030201), UINT64_C(0x1007050403020100),
+  UINT64_C(0x1010101010100706), UINT64_C(0x1010101010070600), UINT64_C(0x1010101010070601), UINT64_C(0x1010101007060100),
+  UINT64_C(0x1010101010070602), UINT64_C(0x1010101007060200), UINT64_C(0x1010101007060201), UINT64_C(0x1010100706020100),
+  UINT64_C(0x1010101010070603), UINT64_C(0x1010101007060300), UINT64_C(0x1010101007060301), UINT64_C(0x1010100706030100),
+  UINT64_C(0x1010101007060302), UINT64_C(0x1010100706030200), UINT64_C(0x1010100706030201), UINT64_C(0x1010070603020100),
+  UINT64_C(0x1010101010070604), UINT64_C(0x1010101007060400), UINT64_C(0x1010101007060401), UINT64_C(0x1010100706040100),
+  UINT64_C(0x1010101007060402), UINT64_C(0x1010100706040200), UINT64_C(0x1010100706040201), UINT64_C(0x1010070604020100),
+  UINT64_C(0x1010101007060403), UINT64_C(0x1010100706040300), UINT64_C(0x1010100706040301), UINT64_C(0x1010070604030100),
+  UINT64_C(0x1010100706040302), UINT64_C(0x1010070604030200), UINT64_C(0x1010070604030201), UINT64_C(0x1007060403020100),
+  UINT64_C(0x1010101010070605), UINT64_C(0x1010101007060500), UINT64_C(0x1010101007060501), UINT64_C(0x1010100706050100),
+  UINT64_C(0x1010101007060502), UINT64_C(0x1010100706050200), UINT64_C(0x1010100706050201), UINT64_C(0x1010070605020100),
+  UINT64_C(0x1010101007060503), UINT64_C(0x1010100706050300), UINT64_C(0x1010100706050301), UINT64_C(0x1010070605030100),
+  UINT64_C(0x1010100706050302), UINT64_C(0x1010070605030200), UINT64_C(0x1010070605030201), UINT64_C(0x1007060503020100),
+  UINT64_C(0x1010101007060504), UINT64_C(0x1010100706050400), UINT64_C(0x1010100706050401), UINT64_C(0x1010070605040100),
+  UINT64_C(0x1010100706050402), UINT64_C(0x1010070605040200), UINT64_C(0x1010070605040201), UINT64_C(0x1007060504020100),
+  UINT64_C(0x1010100706050403), UINT64_C(0x1010070605040300), UINT64_C(0x1010070605040301), UINT64_C(0x1007060504030100),
+  UINT64_C(0x1010070605040302), UINT64_C(0x1007060504030200), UINT64_C(0x1007060504030201), UINT64_C(0x0706050403020100)
+};
+
+/* Lane indices for the lowest 8 bits of bits, in each 64-bit half. */
+WAV_FUNCTION_ATTRIBUTES
+wav_u8x16_t
+wav_compress_lane_indices_(unsigned int bits) {
+  return wav_u64x2_as_u8x16(wav_u64x2_splat(wav_compress_table_[bits & 0xff]));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u8x16_t
+wav_u8x16_compress_bits_(wav_u8x16_t v, unsigned int bits) {
+  const wav_u8x16_t lane = { { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } };
+  const uint8_t low_count = (uint8_t) __builtin_popcount(bits & 0xff);
+  wav_u64x2_t indices = wav_u64x2_splat(wav_compress_table_[bits & 0xff]);
+  wav_u8x16_t shift;
+
+  /* Pack each half in place; the upper half's lanes start at lane 8. */
+  indices = wav_u64x2_replace_lane(indices, 1, wav_compress_table_[(bits >> 8) & 0xff] + UINT64_C(0x0808080808080808));
+  v = wav_u8x16_swizzle(v, wav_u64x2_as_u8x16(indices));
+
+  /* Then move the upper half down so it follows the lower half. */
+  shift = wav_u8x16_and(
+    wav_b8x16_as_u8x16(wav_u8x16_ge(lane, wav_u8x16_splat(low_count))),
+    wav_u8x16_splat((uint8_t) (8 - low_count))
+  );
+  return wav_u8x16_swizzle(v, wav_u8x16_add(lane, shift));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u16x8_t
+wav_u16x8_compress_bits_(wav_u16x8_t v, unsigned int bits) {
+  const wav_u8x16_t byte = { { 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1 } };
+  wav_u8x16_t indices = wav_compress_lane_indices_(bits);
+  indices = wav_u8x16_shuffle(indices, indices, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7);
+  indices = wav_u8x16_add(wav_u8x16_shl(indices, 1), byte);
+  return wav_u8x16_as_u16x8(wav_u8x16_swizzle(wav_u16x8_as_u8x16(v), indices));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u32x4_t
+wav_u32x4_compress_bits_(wav_u32x4_t v, unsigned int bits) {
+  const wav_u8x16_t byte = { { 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3 } };
+  wav_u8x16_t indices = wav_compress_lane_indices_(bits);
+  indices = wav_u8x16_shuffle(indices, indices, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+  indices = wav_u8x16_add(wav_u8x16_shl(indices, 2), byte);
+  return wav_u8x16_as_u32x4(wav_u8x16_swizzle(wav_u32x4_as_u8x16(v), indices));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u64x2_t
+wav_u64x2_compress_bits_(wav_u64x2_t v, unsigned int bits) {
+  const wav_u8x16_t byte = { { 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7 } };
+  wav_u8x16_t indices = wav_compress_lane_indices_(bits);
+  indices = wav_u8x16_shuffle(indices, indices, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+  indices = wav_u8x16_add(wav_u8x16_shl(indices, 3), byte);
+  return wav_u8x16_as_u64x2(wav_u8x16_swizzle(wav_u64x2_as_u8x16(v), indices));
+}
+
+#define WAV_COMPRESS_DEFINE_BITS_(Type, Unsigned) \
+  WAV_FUNCTION_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_##Type##_compress_bits_(wav_##Type##_t v, unsigned int bits) { \
+    return wav_##Unsigned##_as_##Type(wav_##Unsigned##_compress_bits_(wav_##Type##_as_##Unsigned(v), bits)); \
+  }
+
+WAV_COMPRESS_DEFINE_BITS_(i8x16, u8x16)
+WAV_COMPRESS_DEFINE_BITS_(i16x8, u16x8)
+WAV_COMPRESS_DEFINE_BITS_(i32x4, u32x4)
+WAV_COMPRESS_DEFINE_BITS_(i64x2, u64x2)
+WAV_COMPRESS_DEFINE_BITS_(f32x4, u32x4)
+WAV_COMPRESS_DEFINE_BITS_(f64x2, u64x2)
+
+/* compress -- Pack selected lanes
+ *
+ * Move the lanes of v for which mask is true to the lowest lanes of
+ * the result, preserving their order, and set the remaining lanes to
+ * zero.  The number of lanes selected is stored in count.
+ */
+
+#define WAV_COMPRESS_DEFINE_(Type, Bool) \
+  WAV_FUNCTION_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_##Type##_compress(wav_##Type##_t v, wav_##Bool##_t mask, size_t * count) { \
+    const unsigned int bits = wav_##Bool##_bitmask(mask); \
+    *count = (size_t) __builtin_popcount(bits); \
+    return wav_##Type##_compress_bits_(v, bits); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_compress(wav_##Type##_t v, wav_##Bool##_t mask, size_t * count) { \
+    return wav_##Type##_compress(v, mask, count); \
+  }
+
+WAV_COMPRESS_DEFINE_(i8x16, b8x16)
+WAV_COMPRESS_DEFINE_(i16x8, b16x8)
+WAV_COMPRESS_DEFINE_(i32x4, b32x4)
+WAV_COMPRESS_DEFINE_(i64x2, b64x2)
+WAV_COMPRESS_DEFINE_(u8x16, b8x16)
+WAV_COMPRESS_DEFINE_(u16x8, b16x8)
+WAV_COMPRESS_DEFINE_(u32x4, b32x4)
+WAV_COMPRESS_DEFINE_(u64x2, b64x2)
+WAV_COMPRESS_DEFINE_(f32x4, b32x4)
+WAV_COMPRESS_DEFINE_(f64x2, b64x2)
+
+/* For each 8-bit mask, the index in the dense vector of each set bit
+ * (i.e., the number of set bits below it), and 16 for the unset bits
+ * so the lanes they select become zero. */
+static const uint64_t wav_expand_table_[256] = {
+  UINT64_C(0x1010101010101010), UINT64_C(0x1010101010101000), UINT64_C(0x1010101010100010), UINT64_C(0x1010101010100100),
+  UINT64_C(0x1010101010001010), UINT64_C(0x1010101010011000), UINT64_C(0x1010101010010010), UINT64_C(0x1010101010020100),
+  UINT64_C(0x1010101000101010), UINT64_C(0x1010101001101000), UINT64_C(0x1010101001100010), UINT64_C(0x1010101002100100),
+  UINT64_C(0x1010101001001010), UINT64_C(0x1010101002011000), UINT64_C(0x1010101002010010), UINT64_C(0x1010101003020100),
+  UINT64_C(0x1010100010101010), UINT64_C(0x1010100110101000), UINT64_C(0x1010100110100010), UINT64_C(0x1010100210100100),
+  UINT64_C(0x1010100110001010), UINT64_C(0x1010100210011000), UINT64_C(0x1010100210010010), UINT64_C(0x1010100310020100),
+  UINT64_C(0x1010100100101010), UINT64_C(0x1010100201101000), UINT64_C(0x1010100201100010), UINT64_C(0x1010100302100100),
+  UINT64_C(0x1010100201001010), UINT64_C(0x1010100302011000), UINT64_C(0x1010100302010010), UINT64_C(0x1010100403020100),
+  UINT64_C(0x1010001010101010), UINT64_C(0x1010011010101000), UINT64_C(0x1010011010100010), UINT64_C(0x1010021010100100),
+  UINT64_C(0x1010011010001010), UINT64_C(0x1010021010011000), UINT64_C(0x1010021010010010), UINT64_C(0x1010031010020100),
+  UINT64_C(0x1010011000101010), UINT64_C(0x1010021001101000), UINT64_C(0x1010021001100010), UINT64_C(0x1010031002100100),
+  UINT64_C(0x1010021001001010), UINT64_C(0x1010031002011000), UINT64_C(0x1010031002010010), UINT64_C(0x1010041003020100),
+  UINT64_C(0x1010010010101010), UINT64_C(0x1010020110101000), UINT64_C(0x1010020110100010), UINT64_C(0x1010030210100100),
+  UINT64_C(0x1010020110001010), UINT64_C(0x1010030210011000), UINT64_C(0x1010030210010010), UINT64_C(0x1010040310020100),
+  UINT64_C(0x1010020100101010), UINT64_C(0x1010030201101000), UINT64_C(0x1010030201100010), UINT64_C(0x1010040302100100),
+  UINT64_C(0x1010030201001010), UINT64_C(0x1010040302011000), UINT64_C(0x1010040302010010), UINT64_C(0x1010050403020100),
+  UINT64_C(0x1000101010101010), UINT64_C(0x1001101010101000), UINT64_C(0x1001101010100010), UINT64_C(0x1002101010100100),
+  UINT64_C(0x1001101010001010), UINT64_C(0x1002101010011000), UINT64_C(0x1002101010010010), UINT64_C(0x1003101010020100),
+  UINT64_C(0x1001101000101010), UINT64_C(0x1002101001101000), UINT64_C(0x1002101001100010), UINT64_C(0x1003101002100100),
+  UINT64_C(0x1002101001001010), UINT64_C(0x1003101002011000), UINT64_C(0x1003101002010010), UINT64_C(0x1004101003020100),
+  UINT64_C(0x1001100010101010), UINT64_C(0x1002100110101000), UINT64_C(0x1002100110100010), UINT64_C(0x1003100210100100),
+  UINT64_C(0x1002100110001010), UINT64_C(0x1003100210011000), UINT64_C(0x1003100210010010), UINT64_C(0x1004100310020100),
+  UINT64_C(0x1002100100101010), UINT64_C(0x1003100201101000), UINT64_C(0x1003100201100010), UINT64_C(0x1004100302100100),
+  UINT64_C(0x1003100201001010), UINT64_C(0x1004100302011000), UINT64_C(0x1004100302010010), UINT64_C(0x1005100403020100),
+  UINT64_C(0x1001001010101010), UINT64_C(0x1002011010101000), UINT64_C(0x1002011010100010), UINT64_C(0x1003021010100100),
+  UINT64_C(0x1002011010001010), UINT64_C(0x1003021010011000), UINT64_C(0x1003021010010010), UINT64_C(0x1004031010020100),
+  UINT64_C(0x1002011000101010), UINT64_C(0x1003021001101000), UINT64_C(0x1003021001100010), UINT64_C(0x1004031002100100),
+  UINT64_C(0x1003021001001010), UINT64_C(0x1004031002011000), UINT64_C(0x1004031002010010), UINT64_C(0x1005041003020100),
+  UINT64_C(0x1002010010101010), UINT64_C(0x1003020110101000), UINT64_C(0x1003020110100010), UINT64_C(0x1004030210100100),
+  UINT64_C(0x1003020110001010), UINT64_C(0x1004030210011000), UINT64_C(0x1004030210010010), UINT64_C(0x1005040310020100),
+  UINT64_C(0x1003020100101010), UINT64_C(0x1004030201101000), UINT64_C(0x1004030201100010), UINT64_C(0x1005040302100100),
+  UINT64_C(0x1004030201001010), UINT64_C(0x1005040302011000), UINT64_C(0x1005040302010010), UINT64_C(0x1006050403020100),
+  UINT64_C(0x0010101010101010), UINT64_C(0x0110101010101000), UINT64_C(0x0110101010100010), UINT64_C(0x0210101010100100),
+  UINT64_C(0x0110101010001010), UINT64_C(0x0210101010011000), UINT64_C(0x0210101010010010), UINT64_C(0x0310101010020100),
+  UINT64_C(0x0110101000101010), UINT64_C(0x0210101001101000), UINT64_C(0x0210101001100010), UINT64_C(0x0310101002100100),
+  UINT64_C(0x0210101001001010), UINT64_C(0x0310101002011000), UINT64_C(0x0310101002010010), UINT64_C(0x0410101003020100),
+  UINT64_C(0x0110100010101010), UINT64_C(0x0210100110101000), UINT64_C(0x0210100110100010), UINT64_C(0x0310100210100100),
+  UINT64_C(0x0210100110001010), UINT64_C(0x0310100210011000), UINT64_C(0x0310100210010010), UINT64_C(0x0410100310020100),
+  UINT64_C(0x0210100100101010), UINT64_C(0x0310100201101000), UINT64_C(0x0310100201100010), UINT64_C(0x0410100302100100),
+  UINT64_C(0x0310100201001010), UINT64_C(0x0410100302011000), UINT64_C(0x0410100302010010), UINT64_C(0x0510100403020100),
+  UINT64_C(0x0110001010101010), UINT64_C(0x0210011010101000), UINT64_C(0x0210011010100010), UINT64_C(0x0310021010100100),
+  UINT64_C(0x0210011010001010), UINT64_C(0x0310021010011000), UINT64_C(0x0310021010010010), UINT64_C(0x0410031010020100),
+  UINT64_C(0x0210011000101010), UINT64_C(0x0310021001101000), UINT64_C(0x0310021001100010), UINT64_C(0x0410031002100100),
+  UINT64_C(0x0310021001001010), UINT64_C(0x0410031002011000), UINT64_C(0x0410031002010010), UINT64_C(0x0510041003020100),
+  UINT64_C(0x0210010010101010), UINT64_C(0x0310020110101000), UINT64_C(0x0310020110100010), UINT64_C(0x0410030210100100),
+  UINT64_C(0x0310020110001010), UINT64_C(0x0410030210011000), UINT64_C(0x0410030210010010), UINT64_C(0x0510040310020100),
+  UINT64_C(0x0310020100101010), UINT64_C(0x0410030201101000), UINT64_C(0x0410030201100010), UINT64_C(0x0510040302100100),
+  UINT64_C(0x0410030201001010), UINT64_C(0x0510040302011000), UINT64_C(0x0510040302010010), UINT64_C(0x0610050403020100),
+  UINT64_C(0x0100101010101010), UINT64_C(0x0201101010101000), UINT64_C(0x0201101010100010), UINT64_C(0x0302101010100100),
+  UINT64_C(0x0201101010001010), UINT64_C(0x0302101010011000), UINT64_C(0x0302101010010010), UINT64_C(0x0403101010020100),
+  UINT64_C(0x0201101000101010), UINT64_C(0x0302101001101000), UINT64_C(0x0302101001100010), UINT64_C(0x0403101002100100),
+  UINT64_C(0x0302101001001010), UINT64_C(0x0403101002011000), UINT64_C(0x0403101002010010), UINT64_C(0x0504101003020100),
+  UINT64_C(0x0201100010101010), UINT64_C(0x0302100110101000), UINT64_C(0x0302100110100010), UINT64_C(0x0403100210100100),
+  UINT64_C(0x0302100110001010), UINT64_C(0x0403100210011000), UINT64_C(0x0403100210010010), UINT64_C(0x0504100310020100),
+  UINT64_C(0x0302100100101010), UINT64_C(0x0403100201101000), UINT64_C(0x0403100201100010), UINT64_C(0x0504100302100100),
+  UINT64_C(0x0403100201001010), UINT64_C(0x0504100302011000), UINT64_C(0x0504100302010010), UINT64_C(0x0605100403020100),
+  UINT64_C(0x0201001010101010), UINT64_C(0x0302011010101000), UINT64_C(0x0302011010100010), UINT64_C(0x0403021010100100),
+  UINT64_C(0x0302011010001010), UINT64_C(0x0403021010011000), UINT64_C(0x0403021010010010), UINT64_C(0x0504031010020100),
+  UINT64_C(0x0302011000101010), UINT64_C(0x0403021001101000), UINT64_C(0x0403021001100010), UINT64_C(0x0504031002100100),
+  UINT64_C(0x0403021001001010), UINT64_C(0x0504031002011000), UINT64_C(0x0504031002010010), UINT64_C(0x0605041003020100),
+  UINT64_C(0x0302010010101010), UINT64_C(0x0403020110101000), UINT64_C(0x0403020110100010), UINT64_C(0x0504030210100100),
+  UINT64_C(0x0403020110001010), UINT64_C(0x0504030210011000), UINT64_C(0x0504030210010010), UINT64_C(0x0605040310020100),
+  UINT64_C(0x0403020100101010), UINT64_C(0x0504030201101000), UINT64_C(0x0504030201100010), UINT64_C(0x0605040302100100),
+  UINT64_C(0x0504030201001010), UINT64_C(0x0605040302011000), UINT64_C(0x0605040302010010), UINT64_C(0x0706050403020100)
+};
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u8x16_t
+wav_u8x16_expand_bits_(wav_u8x16_t dense, unsigned int bits) {
+  /* The upper half's indices continue from however many lanes the
+   * lower half used; the 16s stay out of range. */
+  const uint64_t low_count = (uint64_t) __builtin_popcount(bits & 0xff);
+  wav_u64x2_t indices = wav_u64x2_splat(wav_expand_table_[bits & 0xff]);
+  indices = wav_u64x2_replace_lane(indices, 1, wav_expand_table_[(bits >> 8) & 0xff] + (low_count * UINT64_C(0x0101010101010101)));
+  return wav_u8x16_swizzle(dense, wav_u64x2_as_u8x16(indices));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u16x8_t
+wav_u16x8_expand_bits_(wav_u16x8_t dense, unsigned int bits) {
+  const wav_u8x16_t byte = { { 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1 } };
+  wav_u8x16_t indices = wav_u64x2_as_u8x16(wav_u64x2_splat(wav_expand_table_[bits & 0xff]));
+  indices = wav_u8x16_shuffle(indices, indices, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7);
+  indices = wav_u8x16_add(wav_u8x16_shl(indices, 1), byte);
+  return wav_u8x16_as_u16x8(wav_u8x16_swizzle(wav_u16x8_as_u8x16(dense), indices));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u32x4_t
+wav_u32x4_expand_bits_(wav_u32x4_t dense, unsigned int bits) {
+  const wav_u8x16_t byte = { { 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3 } };
+  wav_u8x16_t indices = wav_u64x2_as_u8x16(wav_u64x2_splat(wav_expand_table_[bits & 0xff]));
+  indices = wav_u8x16_shuffle(indices, indices, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+  indices = wav_u8x16_add(wav_u8x16_shl(indices, 2), byte);
+  return wav_u8x16_as_u32x4(wav_u8x16_swizzle(wav_u32x4_as_u8x16(dense), indices));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u64x2_t
+wav_u64x2_expand_bits_(wav_u64x2_t dense, unsigned int bits) {
+  const wav_u8x16_t byte = { { 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7 } };
+  wav_u8x16_t indices = wav_u64x2_as_u8x16(wav_u64x2_splat(wav_expand_table_[bits & 0xff]));
+  indices = wav_u8x16_shuffle(indices, indices, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+  indices = wav_u8x16_add(wav_u8x16_shl(indices, 3), byte);
+  return wav_u8x16_as_u64x2(wav_u8x16_swizzle(wav_u64x2_as_u8x16(dense), indices));
+}
+
+#define WAV_COMPRESS_DEFINE_EXPAND_BITS_(Type, Unsigned) \
+  WAV_FUNCTION_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_##Type##_expand_bits_(wav_##Type##_t dense, unsigned int bits) { \
+    return wav_##Unsigned##_as_##Type(wav_##Unsigned##_expand_bits_(wav_##Type##_as_##Unsigned(dense), bits)); \
+  }
+
+WAV_COMPRESS_DEFINE_EXPAND_BITS_(i8x16, u8x16)
+WAV_COMPRESS_DEFINE_EXPAND_BITS_(i16x8, u16x8)
+WAV_COMPRESS_DEFINE_EXPAND_BITS_(i32x4, u32x4)
+WAV_COMPRESS_DEFINE_EXPAND_BITS_(i64x2, u64x2)
+WAV_COMPRESS_DEFINE_EXPAND_BITS_(f32x4, u32x4)
+WAV_COMPRESS_DEFINE_EXPAND_BITS_(f64x2, u64x2)
+
+/* expand -- Scatter lanes to the positions selected by a mask
+ *
+ * The inverse of compress: the lowest lanes of dense are moved, in
+ * order, to the lanes for which mask is true, and the remaining lanes
+ * are set to zero.  Lanes of dense beyond the number of true lanes in
+ * mask are ignored.
+ */
+
+#define WAV_COMPRESS_DEFINE_EXPAND_(Type, Bool) \
+  WAV_FUNCTION_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_##Type##_expand(wav_##Type##_t dense, wav_##Bool##_t mask) { \
+    return wav_##Type##_expand_bits_(dense, wav_##Bool##_bitmask(mask)); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_expand(wav_##Type##_t dense, wav_##Bool##_t mask) { \
+    return wav_##Type##_expand(dense, mask); \
+  }
+
+WAV_COMPRESS_DEFINE_EXPAND_(i8x16, b8x16)
+WAV_COMPRESS_DEFINE_EXPAND_(i16x8, b16x8)
+WAV_COMPRESS_DEFINE_EXPAND_(i32x4, b32x4)
+WAV_COMPRESS_DEFINE_EXPAND_(i64x2, b64x2)
+WAV_COMPRESS_DEFINE_EXPAND_(u8x16, b8x16)
+WAV_COMPRESS_DEFINE_EXPAND_(u16x8, b16x8)
+WAV_COMPRESS_DEFINE_EXPAND_(u32x4, b32x4)
+WAV_COMPRESS_DEFINE_EXPAND_(u64x2, b64x2)
+WAV_COMPRESS_DEFINE_EXPAND_(f32x4, b32x4)
+WAV_COMPRESS_DEFINE_EXPAND_(f64x2, b64x2)
+
+/* wav.h only has eq, ne, and ge for u64x2; the other orderings are
+ * built from ge. */
+
+WAV_FUNCTION_ATTRIBUTES
+wav_b64x2_t
+wav_u64x2_lt_(wav_u64x2_t lhs, wav_u64x2_t rhs) {
+  return wav_b64x2_not(wav_u64x2_ge(lhs, rhs));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_b64x2_t
+wav_u64x2_le_(wav_u64x2_t lhs, wav_u64x2_t rhs) {
+  return wav_u64x2_ge(rhs, lhs);
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_b64x2_t
+wav_u64x2_gt_(wav_u64x2_t lhs, wav_u64x2_t rhs) {
+  return wav_b64x2_not(wav_u64x2_ge(rhs, lhs));
+}
+
+/* Each vector is compared, compressed, and stored at the current
+ * output position, which then advances by the number of lanes kept.
+ * For the tail the lanes past the end of the array are masked off
+ * before compressing, and only the kept lanes are stored.  Compare
+ * is the comparison function for Predicate. */
+#define WAV_COMPRESS_DEFINE_FILTER_(Type, Element, Bool, Predicate) \
+  WAV_COMPRESS_DEFINE_FILTER_CMP_(Type, Element, Bool, Predicate, wav_##Type##_##Predicate)
+
+#define WAV_COMPRESS_DEFINE_FILTER_CMP_(Type, Element, Bool, Predicate, Compare) \
+  WAV_KERNEL_ATTRIBUTES \
+  size_t \
+  wav_##Type##_filter_##Predicate(Element * dest, const Element * src, size_t len, Element value) { \
+    const size_t lanes = sizeof(wav_##Type##_t) / sizeof(Element); \
+    const wav_##Type##_t rhs = wav_##Type##_splat(value); \
+    size_t i = 0; \
+    size_t n = 0; \
+    \
+    for ( ; (len - i) >= lanes ; i += lanes) { \
+      const wav_##Type##_t v = wav_##Type##_loadu(&(src[i])); \
+      const unsigned int bits = wav_##Bool##_bitmask(Compare(v, rhs)); \
+      wav_##Type##_storeu(&(dest[n]), wav_##Type##_compress_bits_(v, bits)); \
+      n += (size_t) __builtin_popcount(bits); \
+    } \
+    \
+    if (i != len) { \
+      const wav_##Type##_t v = wav_##Type##_load_partial(&(src[i]), len - i); \
+      const unsigned int bits = wav_##Bool##_bitmask(Compare(v, rhs)) & ((1U << (len - i)) - 1); \
+      const size_t count = (size_t) __builtin_popcount(bits); \
+      wav_##Type##_store_partial(&(dest[n]), wav_##Type##_compress_bits_(v, bits), count); \
+      n += count; \
+    } \
+    \
+    return n; \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  size_t \
+  wav_filter_##Predicate(Element * dest, const Element * src, size_t len, Element value) { \
+    return wav_##Type##_filter_##Predicate(dest, src, len, value); \
+  }
+
+/* filter -- Keep the elements of an array which compare to a value
+ */
+
+WAV_COMPRESS_DEFINE_FILTER_(u8x16,  uint8_t, b8x16, eq)
+WAV_COMPRESS_DEFINE_FILTER_(u8x16,  uint8_t, b8x16, ne)
+WAV_COMPRESS_DEFINE_FILTER_(u8x16,  uint8_t, b8x16, lt)
+WAV_COMPRESS_DEFINE_FILTER_(u8x16,  uint8_t, b8x16, le)
+WAV_COMPRESS_DEFINE_FILTER_(u8x16,  uint8_t, b8x16, gt)
+WAV_COMPRESS_DEFINE_FILTER_(u8x16,  uint8_t, b8x16, ge)
+
+WAV_COMPRESS_DEFINE_FILTER_(u16x8, uint16_t, b16x8, eq)
+WAV_COMPRESS_DEFINE_FILTER_(u16x8, uint16_t, b16x8, ne)
+WAV_COMPRESS_DEFINE_FILTER_(u16x8, uint16_t, b16x8, lt)
+WAV_COMPRESS_DEFINE_FILTER_(u16x8, uint16_t, b16x8, le)
+WAV_COMPRESS_DEFINE_FILTER_(u16x8, uint16_t, b16x8, gt)
+WAV_COMPRESS_DEFINE_FILTER_(u16x8, uint16_t, b16x8, ge)
+
+WAV_COMPRESS_DEFINE_FILTER_(u32x4, uint32_t, b32x4, eq)
+WAV_COMPRESS_DEFINE_FILTER_(u32x4, uint32_t, b32x4, ne)
+WAV_COMPRESS_DEFINE_FILTER_(u32x4, uint32_t, b32x4, lt)
+WAV_COMPRESS_DEFINE_FILTER_(u32x4, uint32_t, b32x4, le)
+WAV_COMPRESS_DEFINE_FILTER_(u32x4, uint32_t, b32x4, gt)
+WAV_COMPRESS_DEFINE_FILTER_(u32x4, uint32_t, b32x4, ge)
+
+WAV_COMPRESS_DEFINE_FILTER_(u64x2, uint64_t, b64x2, eq)
+WAV_COMPRESS_DEFINE_FILTER_(u64x2, uint64_t, b64x2, ne)
+WAV_COMPRESS_DEFINE_FILTER_CMP_(u64x2, uint64_t, b64x2, lt, wav_u64x2_lt_)
+WAV_COMPRESS_DEFINE_FILTER_CMP_(u64x2, uint64_t, b64x2, le, wav_u64x2_le_)
+WAV_COMPRESS_DEFINE_FILTER_CMP_(u64x2, uint64_t, b64x2, gt, wav_u64x2_gt_)
+WAV_COMPRESS_DEFINE_FILTER_(u64x2, uint64_t, b64x2, ge)
+
+WAV_COMPRESS_DEFINE_FILTER_(f32x4,    float, b32x4, eq)
+WAV_COMPRESS_DEFINE_FILTER_(f32x4,    float, b32x4, ne)
+WAV_COMPRESS_DEFINE_FILTER_(f32x4,    float, b32x4, lt)
+WAV_COMPRESS_DEFINE_FILTER_(f32x4,    float, b32x4, le)
+WAV_COMPRESS_DEFINE_FILTER_(f32x4,    float, b32x4, gt)
+WAV_COMPRESS_DEFINE_FILTER_(f32x4,    float, b32x4, ge)
+
+#pragma clang diagnostic pop
+
+#endif /* !defined(WAV_COMPRESS_H) */
@@ -0,0 +1,226 @@
+/* WAV dispatch
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* Runtime CPU dispatch for kernels built with WAV_EMULATION on x86.
+ *
+ * A binary built in emulation mode only uses the ISA extensions which
+ * were enabled at compile time.  This header compiles your kernels
+ * several times, once for each of the x86 feature levels below (using
+ * the target attribute), and picks the best one the first time each
+ * kernel is called.
+ *
+ * Kernels live in their own source file, which includes this header
+ * after defining WAV_DISPATCH_INCLUDE to its own name.  Anything which
+ * should only be compiled once (including the export macros and any
+ * non-kernel code) goes inside an `#if WAV_DISPATCH_ONCE` block.  Note
+ * that the file is included from wav_dispatch.h, so WAV_DISPATCH_INCLUDE
+ * must be something the preprocessor can find from here (e.g., add the
+ * kernel's directory to the include path):
+ *
+ *   #define WAV_DISPATCH_INCLUDE "kernels.c"
+ *   #include "wav_dispatch.h"
+ *
+ *   static void
+ *   WAV_DISPATCH_NAME(scale)(float * buf, size_t len, float s) {
+ *     ... anything using the wav_* API ...
+ *   }
+ *
+ *   #if WAV_DISPATCH_ONCE
+ *     WAV_DISPATCH_EXPORT(void, scale, (float * buf, size_t len, float s))
+ *
+ *     void scale(float * buf, size_t len, float s) {
+ *       WAV_DISPATCH(scale)(buf, len, s);
+ *     }
+ *   #endif
+ *
+ * The levels are:
+ *
+ *   avx512   AVX-512 F, BW, DQ, and VL, plus everything in avx2
+ *   avx2     AVX2, BMI, BMI2, and POPCNT
+ *   sse4_1   SSE4.1
+ *   baseline whatever the file is compiled with
+ *
+ * FMA is deliberately left out; letting the compiler contract
+ * multiplications and additions would change results compared to
+ * WASM SIMD128.
+ *
+ * The target attribute only changes code generation; the explicit SSE
+ * implementations in wav.h are selected by the preprocessor, so every
+ * version would get the ones for the flags the file is compiled with.
+ * To avoid that, this header defines WAV_X86_DISPATCH to 1 before
+ * including wav.h, which makes wav.h compile its SSSE3 and SSE4.1 code
+ * with target attributes and choose it at run time (see the comment
+ * above WAV_X86_SSE2 in wav.h).  In the sse4_1, avx2 and avx512
+ * versions those are inlined; the baseline version calls them when the
+ * CPU supports them.  This requires SSE2 at compile time (the default
+ * on x86-64), and wav_dispatch.h must be included before wav.h.
+ *
+ * Kernels need WAV_DISPATCH_NAME because C has no namespaces: each
+ * version of a kernel is a separate function, so each needs its own
+ * symbol.  The target_clones attribute could generate the versions
+ * without renaming, but it needs ifunc support from the object format
+ * and C library (so not on macOS, Windows, or static musl builds) and
+ * clang 14 or later.  Only the kernel definitions and the calls
+ * between kernels need the macro; the wav_* calls inside them don't
+ * change.
+ *
+ * When dispatch isn't possible (not x86, or not in emulation mode)
+ * only the baseline version is compiled, and WAV_DISPATCH() simply
+ * returns it.  You can also force this by defining WAV_DISPATCH_DISABLE
+ * to 1. */
+
+#if !defined(WAV_DISPATCH_H)
+#define WAV_DISPATCH_H
+
+#if !defined(WAV_DISPATCH_DISABLE)
+  #define WAV_DISPATCH_DISABLE 0
+#endif
+
+#if \
+    (WAV_DISPATCH_DISABLE == 0) && \
+    (defined(__x86_64__) || defined(__i386__)) && \
+    !defined(__wasm_simd128__) && (defined(WAV_EMULATION) && (WAV_EMULATION == 1))
+  #define WAV_DISPATCH_ENABLED 1
+#else
+  #define WAV_DISPATCH_ENABLED 0
+#endif
+
+#if WAV_DISPATCH_ENABLED
+  #if defined(WAV_H) && !WAV_X86_DISPATCH
+    #error wav_dispatch.h must be included before wav.h (or define WAV_X86_DISPATCH to 1 before including wav.h)
+  #endif
+  #if !defined(WAV_X86_DISPATCH)
+    #define WAV_X86_DISPATCH 1
+  #endif
+#endif
+
+#include "wav.h"
+
+#define WAV_DISPATCH_CONCAT_EX_(name, suffix) name##_##suffix
+#define WAV_DISPATCH_CONCAT_(name, suffix) WAV_DISPATCH_CONCAT_EX_(name, suffix)
+
+/* WAV_DISPATCH_NAME -- Name of the current version of a kernel
+ *
+ * Use this when defining (or calling) a kernel from inside the
+ * dispatched code; it appends the suffix for the level currently being
+ * compiled.
+ */
+#define WAV_DISPATCH_NAME(name) WAV_DISPATCH_CONCAT_(name, WAV_DISPATCH_SUFFIX_)
+
+/* WAV_DISPATCH -- Get the best version of a kernel
+ *
+ * Returns a pointer to the best version of the kernel for the current
+ * CPU.  The kernel must have been exported with WAV_DISPATCH_EXPORT.
+ */
+#define WAV_DISPATCH(name) (name##_wav_dispatch_())
+
+/* WAV_DISPATCH_EXPORT -- Generate the dispatcher for a kernel
+ *
+ * Return type, name, and (parenthesized) parameter list must match
+ * the kernel.  The selected version is cached after the first call.
+ */
+#if WAV_DISPATCH_ENABLED
+  #define WAV_DISPATCH_EXPORT(ret, name, params) \
+    static ret (*name##_wav_dispatch_(void)) params { \
+      static ret (*selected) params = 0; \
+      ret (*fn) params = __atomic_load_n(&selected, __ATOMIC_RELAXED); \
+      if (fn == 0) { \
+        __builtin_cpu_init(); \
+        const int avx2 = \
+          __builtin_cpu_supports("avx2") && \
+          __builtin_cpu_supports("bmi") && \
+          __builtin_cpu_supports("bmi2") && \
+          __builtin_cpu_supports("popcnt"); \
+        if ( \
+            avx2 && \
+            __builtin_cpu_supports("avx512f") && \
+            __builtin_cpu_supports("avx512bw") && \
+            __builtin_cpu_supports("avx512dq") && \
+            __builtin_cpu_supports("avx512vl")) { \
+          fn = name##_avx512; \
+        } else if (avx2) { \
+          fn = name##_avx2; \
+        } else if (__builtin_cpu_supports("sse4.1")) { \
+          fn = name##_sse4_1; \
+        } else { \
+          fn = name##_baseline; \
+        } \
+        __atomic_store_n(&selected, fn, __ATOMIC_RELAXED); \
+      } \
+      return fn; \
+    }
+#else
+  #define WAV_DISPATCH_EXPORT(ret, name, params) \
+    static ret (*name##_wav_dispatch_(void)) params { \
+      return name##_baseline; \
+    }
+#endif
+
+#endif /* !defined(WAV_DISPATCH_H) */
+
+/* Everything below runs each time this header is included from the
+ * top level of the kernel file, but is skipped when the kernel file
+ * is re-included from here. */
+#if !defined(WAV_DISPATCH_NESTED_)
+  #if !defined(WAV_DISPATCH_INCLUDE)
+    #error Define WAV_DISPATCH_INCLUDE to the name of the kernel file before including wav_dispatch.h
+  #endif
+
+  #define WAV_DISPATCH_NESTED_ 1
+
+  #if defined(WAV_DISPATCH_ONCE)
+    #undef WAV_DISPATCH_ONCE
+  #endif
+  #define WAV_DISPATCH_ONCE 0
+
+  #if WAV_DISPATCH_ENABLED
+    #define WAV_DISPATCH_SUFFIX_ avx512
+    #pragma clang attribute push (__attribute__((__target__("avx512f,avx512bw,avx512dq,avx512vl,bmi,bmi2,popcnt"))), apply_to = function)
+    #include WAV_DISPATCH_INCLUDE
+    #pragma clang attribute pop
+    #undef WAV_DISPATCH_SUFFIX_
+
+    #define WAV_DISPATCH_SUFFIX_ avx2
+    #pragma clang attribute push (__attribute__((__target__("avx2,bmi,bmi2,popcnt"))), apply_to = function)
+    #include WAV_DISPATCH_INCLUDE
+    #pragma clang attribute pop
+    #undef WAV_DISPATCH_SUFFIX_
+
+    #define WAV_DISPATCH_SUFFIX_ sse4_1
+    #pragma clang attribute push (__attribute__((__target__("sse4.1"))), apply_to = function)
+    #include WAV_DISPATCH_INCLUDE
+    #pragma clang attribute pop
+    #undef WAV_DISPATCH_SUFFIX_
+  #endif
+
+  /* The rest of the kernel file is the baseline version. */
+  #define WAV_DISPATCH_SUFFIX_ baseline
+  #undef WAV_DISPATCH_ONCE
+  #define WAV_DISPATCH_ONCE 1
+#endif
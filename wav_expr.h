@@ -0,0 +1,365 @@
+/* WAV expression templates
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* Expression templates for C++.
+ *
+ * The operators in wav.h evaluate eagerly; each one returns a vector.
+ * This header adds a lazy layer on top: wrapping an array (or a
+ * vector) turns the operators into builders for an expression tree,
+ * which is only evaluated when you ask for it:
+ *
+ *   wav::eval(dest, wav::array(a) * wav::array(b) + wav::array(c), len);
+ *
+ * evaluates the whole expression in a single pass over the arrays,
+ * one vector at a time, instead of one pass (and one temporary array)
+ * per operator.  The tail is handled with load_partial and
+ * store_partial, so nothing outside of the arrays is touched.  dest
+ * may be one of the inputs.
+ *
+ * Leaves can be arrays (wav::array(ptr)) or vectors (wav::lazy(v), or
+ * just a vector on either side of an operator, which is used for every
+ * element); wav::eval(expr) without a destination evaluates an
+ * expression of vectors and returns the result.  The supported
+ * operations are +, -, *, /, &, |, ^, unary -, wav::min, and
+ * wav::max; like the eager operators, they are only available for the
+ * types for which wav.h implements them.
+ *
+ * x * y + z (or z + x * y) on f32x4 or f64x2 lanes is evaluated with
+ * relaxed_madd if the relaxed-simd target is enabled (e.g.,
+ * -mrelaxed-simd), so the result may or may not be rounded once
+ * depending on the implementation.  Define WAV_EXPR_RELAXED_MADD to 0
+ * to always use a separate multiplication and addition.
+ *
+ * Every node is a small struct of leaves and the member functions are
+ * always inlined, so at -O0 the tree still collapses into the loop
+ * body rather than a chain of calls. */
+
+#if !defined(WAV_EXPR_H)
+#define WAV_EXPR_H
+
+#if !defined(__cplusplus)
+  #error wav_expr.h requires C++
+#endif
+
+#include <cstddef>
+#include <type_traits>
+#include "wav.h"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc++98-compat"
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#pragma clang diagnostic ignored "-Wold-style-cast"
+#pragma clang diagnostic ignored "-Wpadded"
+
+#if !defined(WAV_EXPR_RELAXED_MADD)
+  #if defined(__wasm_relaxed_simd__)
+    #define WAV_EXPR_RELAXED_MADD 1
+  #else
+    #define WAV_EXPR_RELAXED_MADD 0
+  #endif
+#endif
+
+#if !defined(__wasm_simd128__) && (defined(WAV_EMULATION) && (WAV_EMULATION == 1))
+  #define WAV_EXPR_ATTRIBUTES inline __attribute__((__always_inline__,__artificial__))
+#else
+  #define WAV_EXPR_ATTRIBUTES inline __attribute__((__always_inline__,__artificial__,__target__("simd128")))
+#endif
+
+namespace wav {
+  /* Loads and stores for each vector type, and the vector type for
+   * each element type. */
+  template <typename Vector> struct vector_traits { static const bool is_vector = false; };
+  template <typename Element> struct element_traits;
+
+  #define WAV_EXPR_DEFINE_TRAITS_(Type, Element) \
+    template <> struct vector_traits<wav_##Type##_t> { \
+      static const bool is_vector = true; \
+      typedef Element element_type; \
+      static const std::size_t lanes = sizeof(wav_##Type##_t) / sizeof(Element); \
+      WAV_EXPR_ATTRIBUTES static wav_##Type##_t loadu(const Element * src) { return wav_##Type##_loadu(src); } \
+      WAV_EXPR_ATTRIBUTES static wav_##Type##_t load_partial(const Element * src, std::size_t n) { return wav_##Type##_load_partial(src, n); } \
+      WAV_EXPR_ATTRIBUTES static void storeu(Element * dest, wav_##Type##_t src) { wav_##Type##_storeu(dest, src); } \
+      WAV_EXPR_ATTRIBUTES static void store_partial(Element * dest, wav_##Type##_t src, std::size_t n) { wav_##Type##_store_partial(dest, src, n); } \
+    }; \
+    template <> struct element_traits<Element> { typedef wav_##Type##_t vector_type; };
+
+  WAV_EXPR_DEFINE_TRAITS_(i8x16,   int8_t)
+  WAV_EXPR_DEFINE_TRAITS_(i16x8,  int16_t)
+  WAV_EXPR_DEFINE_TRAITS_(i32x4,  int32_t)
+  WAV_EXPR_DEFINE_TRAITS_(i64x2,  int64_t)
+  WAV_EXPR_DEFINE_TRAITS_(u8x16,  uint8_t)
+  WAV_EXPR_DEFINE_TRAITS_(u16x8, uint16_t)
+  WAV_EXPR_DEFINE_TRAITS_(u32x4, uint32_t)
+  WAV_EXPR_DEFINE_TRAITS_(u64x2, uint64_t)
+  WAV_EXPR_DEFINE_TRAITS_(f32x4,    float)
+  WAV_EXPR_DEFINE_TRAITS_(f64x2,   double)
+
+  #undef WAV_EXPR_DEFINE_TRAITS_
+
+  /* Every node derives from expr, and provides:
+   *
+   *   vector_type load(std::size_t i) const;
+   *   vector_type load_partial(std::size_t i, std::size_t n) const;
+   *
+   * which evaluate the vector starting at element i (for
+   * load_partial, only the first n lanes need to be meaningful). */
+  struct expr { };
+
+  template <typename T> struct is_expr : std::integral_constant<bool, std::is_base_of<expr, T>::value> { };
+
+  /* An array; element i of the expression is element i of the array. */
+  template <typename Vector>
+  struct array_leaf : expr {
+    typedef Vector vector_type;
+    typedef typename vector_traits<Vector>::element_type element_type;
+
+    const element_type * src;
+
+    explicit array_leaf(const element_type * src_) : src(src_) { }
+
+    WAV_EXPR_ATTRIBUTES vector_type load(std::size_t i) const { return vector_traits<Vector>::loadu(src + i); }
+    WAV_EXPR_ATTRIBUTES vector_type load_partial(std::size_t i, std::size_t n) const { return vector_traits<Vector>::load_partial(src + i, n); }
+  };
+
+  /* A vector, which is the same for every step. */
+  template <typename Vector>
+  struct vector_leaf : expr {
+    typedef Vector vector_type;
+
+    Vector value;
+
+    explicit vector_leaf(Vector value_) : value(value_) { }
+
+    WAV_EXPR_ATTRIBUTES vector_type load(std::size_t) const { return value; }
+    WAV_EXPR_ATTRIBUTES vector_type load_partial(std::size_t, std::size_t) const { return value; }
+  };
+
+  template <typename Op, typename A>
+  struct unary_node : expr {
+    typedef typename A::vector_type vector_type;
+
+    A a;
+
+    explicit unary_node(const A & a_) : a(a_) { }
+
+    WAV_EXPR_ATTRIBUTES vector_type load(std::size_t i) const { return Op::apply(a.load(i)); }
+    WAV_EXPR_ATTRIBUTES vector_type load_partial(std::size_t i, std::size_t n) const { return Op::apply(a.load_partial(i, n)); }
+  };
+
+  template <typename Op, typename A, typename B>
+  struct binary_node : expr {
+    typedef typename A::vector_type vector_type;
+    static_assert(std::is_same<vector_type, typename B::vector_type>::value, "operands must have the same vector type");
+
+    A a;
+    B b;
+
+    binary_node(const A & a_, const B & b_) : a(a_), b(b_) { }
+
+    WAV_EXPR_ATTRIBUTES vector_type load(std::size_t i) const { return Op::apply(a.load(i), b.load(i)); }
+    WAV_EXPR_ATTRIBUTES vector_type load_partial(std::size_t i, std::size_t n) const { return Op::apply(a.load_partial(i, n), b.load_partial(i, n)); }
+  };
+
+  /* a * b + c */
+  template <typename A, typename B, typename C>
+  struct madd_node : expr {
+    typedef typename A::vector_type vector_type;
+    static_assert(std::is_same<vector_type, typename B::vector_type>::value, "operands must have the same vector type");
+    static_assert(std::is_same<vector_type, typename C::vector_type>::value, "operands must have the same vector type");
+
+    A a;
+    B b;
+    C c;
+
+    madd_node(const A & a_, const B & b_, const C & c_) : a(a_), b(b_), c(c_) { }
+
+    WAV_EXPR_ATTRIBUTES vector_type load(std::size_t i) const { return madd(a.load(i), b.load(i), c.load(i)); }
+    WAV_EXPR_ATTRIBUTES vector_type load_partial(std::size_t i, std::size_t n) const { return madd(a.load_partial(i, n), b.load_partial(i, n), c.load_partial(i, n)); }
+
+  private:
+    template <typename V>
+    WAV_EXPR_ATTRIBUTES static V madd(V x, V y, V z) { return wav_add(wav_mul(x, y), z); }
+
+    #if WAV_EXPR_RELAXED_MADD
+      WAV_EXPR_ATTRIBUTES static wav_f32x4_t madd(wav_f32x4_t x, wav_f32x4_t y, wav_f32x4_t z) { return wav_f32x4_relaxed_madd(x, y, z); }
+      WAV_EXPR_ATTRIBUTES static wav_f64x2_t madd(wav_f64x2_t x, wav_f64x2_t y, wav_f64x2_t z) { return wav_f64x2_relaxed_madd(x, y, z); }
+    #endif
+  };
+
+  #define WAV_EXPR_DEFINE_OP_(name, expression) \
+    struct name##_op { \
+      template <typename V> WAV_EXPR_ATTRIBUTES static V apply(V a, V b) { return expression; } \
+    };
+
+  WAV_EXPR_DEFINE_OP_(add, wav_add(a, b))
+  WAV_EXPR_DEFINE_OP_(sub, wav_sub(a, b))
+  WAV_EXPR_DEFINE_OP_(mul, wav_mul(a, b))
+  WAV_EXPR_DEFINE_OP_(div, wav_div(a, b))
+  WAV_EXPR_DEFINE_OP_(and, wav_and(a, b))
+  WAV_EXPR_DEFINE_OP_(or,  wav_or(a, b))
+  WAV_EXPR_DEFINE_OP_(xor, wav_xor(a, b))
+  WAV_EXPR_DEFINE_OP_(min, wav_min(a, b))
+  WAV_EXPR_DEFINE_OP_(max, wav_max(a, b))
+
+  #undef WAV_EXPR_DEFINE_OP_
+
+  struct neg_op {
+    template <typename V> WAV_EXPR_ATTRIBUTES static V apply(V a) { return wav_neg(a); }
+  };
+
+  /* Operands may be nodes or plain vectors; as_node turns the latter
+   * into a vector_leaf. */
+  template <typename T, typename Enable = void> struct as_node;
+  template <typename T> struct as_node<T, typename std::enable_if<is_expr<T>::value>::type> {
+    typedef T type;
+    WAV_EXPR_ATTRIBUTES static const T & make(const T & v) { return v; }
+  };
+  template <typename T> struct as_node<T, typename std::enable_if<vector_traits<T>::is_vector>::type> {
+    typedef vector_leaf<T> type;
+    WAV_EXPR_ATTRIBUTES static vector_leaf<T> make(const T & v) { return vector_leaf<T>(v); }
+  };
+
+  /* At least one side must already be a node, otherwise this would
+   * hijack the eager operators in wav.h. */
+  template <typename A, typename B, typename R>
+  struct enable_binary : std::enable_if<
+    (is_expr<A>::value || is_expr<B>::value) &&
+    (is_expr<A>::value || vector_traits<A>::is_vector) &&
+    (is_expr<B>::value || vector_traits<B>::is_vector), R> { };
+
+  #define WAV_EXPR_BINARY_TYPE_(Op) binary_node<Op, typename as_node<A>::type, typename as_node<B>::type>
+  #define WAV_EXPR_DEFINE_BINARY_(function, Op) \
+    template <typename A, typename B> \
+    WAV_EXPR_ATTRIBUTES typename enable_binary<A, B, WAV_EXPR_BINARY_TYPE_(Op)>::type \
+    function(const A & a, const B & b) { \
+      return WAV_EXPR_BINARY_TYPE_(Op)(as_node<A>::make(a), as_node<B>::make(b)); \
+    }
+
+  WAV_EXPR_DEFINE_BINARY_(operator-, sub_op)
+  WAV_EXPR_DEFINE_BINARY_(operator*, mul_op)
+  WAV_EXPR_DEFINE_BINARY_(operator/, div_op)
+  WAV_EXPR_DEFINE_BINARY_(operator&, and_op)
+  WAV_EXPR_DEFINE_BINARY_(operator|, or_op)
+  WAV_EXPR_DEFINE_BINARY_(operator^, xor_op)
+  WAV_EXPR_DEFINE_BINARY_(min, min_op)
+  WAV_EXPR_DEFINE_BINARY_(max, max_op)
+
+  /* Addition is where multiplications get fused.  The overloads taking
+   * a multiplication node are more specialized than the generic one,
+   * so they win whenever they match. */
+  template <typename A, typename B>
+  WAV_EXPR_ATTRIBUTES typename enable_binary<A, B, WAV_EXPR_BINARY_TYPE_(add_op)>::type
+  operator+(const A & a, const B & b) {
+    return WAV_EXPR_BINARY_TYPE_(add_op)(as_node<A>::make(a), as_node<B>::make(b));
+  }
+
+  template <typename X, typename Y, typename C>
+  WAV_EXPR_ATTRIBUTES typename enable_binary<binary_node<mul_op, X, Y>, C, madd_node<X, Y, typename as_node<C>::type> >::type
+  operator+(const binary_node<mul_op, X, Y> & m, const C & c) {
+    return madd_node<X, Y, typename as_node<C>::type>(m.a, m.b, as_node<C>::make(c));
+  }
+
+  template <typename C, typename X, typename Y>
+  WAV_EXPR_ATTRIBUTES typename enable_binary<C, binary_node<mul_op, X, Y>, madd_node<X, Y, typename as_node<C>::type> >::type
+  operator+(const C & c, const binary_node<mul_op, X, Y> & m) {
+    return madd_node<X, Y, typename as_node<C>::type>(m.a, m.b, as_node<C>::make(c));
+  }
+
+  template <typename X0, typename Y0, typename X1, typename Y1>
+  WAV_EXPR_ATTRIBUTES madd_node<X0, Y0, binary_node<mul_op, X1, Y1> >
+  operator+(const binary_node<mul_op, X0, Y0> & m0, const binary_node<mul_op, X1, Y1> & m1) {
+    return madd_node<X0, Y0, binary_node<mul_op, X1, Y1> >(m0.a, m0.b, m1);
+  }
+
+  #undef WAV_EXPR_DEFINE_BINARY_
+  #undef WAV_EXPR_BINARY_TYPE_
+
+  template <typename A>
+  WAV_EXPR_ATTRIBUTES typename std::enable_if<is_expr<A>::value, unary_node<neg_op, A> >::type
+  operator-(const A & a) {
+    return unary_node<neg_op, A>(a);
+  }
+
+  /* wav::array -- Use an array as a leaf
+   */
+  template <typename Element>
+  WAV_EXPR_ATTRIBUTES array_leaf<typename element_traits<Element>::vector_type>
+  array(const Element * src) {
+    return array_leaf<typename element_traits<Element>::vector_type>(src);
+  }
+
+  /* wav::lazy -- Use a vector as a leaf
+   */
+  template <typename Vector>
+  WAV_EXPR_ATTRIBUTES typename std::enable_if<vector_traits<Vector>::is_vector, vector_leaf<Vector> >::type
+  lazy(Vector v) {
+    return vector_leaf<Vector>(v);
+  }
+
+  /* wav::eval -- Evaluate an expression
+   *
+   * With a destination, the expression is evaluated for len elements
+   * and stored to dest.  Without one, the (first) vector is returned.
+   */
+  template <typename E>
+  WAV_EXPR_ATTRIBUTES typename std::enable_if<is_expr<E>::value, typename E::vector_type>::type
+  eval(const E & e) {
+    return e.load(0);
+  }
+
+  template <typename E>
+  WAV_KERNEL_ATTRIBUTES typename std::enable_if<is_expr<E>::value, void>::type
+  eval(typename vector_traits<typename E::vector_type>::element_type * dest, const E & e, std::size_t len) {
+    typedef vector_traits<typename E::vector_type> traits;
+    const std::size_t lanes = traits::lanes;
+    std::size_t i = 0;
+
+    /* Two vectors per iteration so the loads of one can overlap with
+     * the arithmetic of the other. */
+    for ( ; (len - i) >= (lanes * 2) ; i += lanes * 2) {
+      const typename E::vector_type r0 = e.load(i);
+      const typename E::vector_type r1 = e.load(i + lanes);
+      traits::storeu(dest + i, r0);
+      traits::storeu(dest + i + lanes, r1);
+    }
+
+    if ((len - i) >= lanes) {
+      traits::storeu(dest + i, e.load(i));
+      i += lanes;
+    }
+
+    if (i != len) {
+      traits::store_partial(dest + i, e.load_partial(i, len - i), len - i);
+    }
+  }
+}
+
+#pragma clang diagnostic pop
+
+#endif /* !defined(WAV_EXPR_H) */
@@ -0,0 +1,179 @@
+/* WAV gather
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* Gather and scatter.
+ *
+ * WebAssembly SIMD has no gather or scatter instructions, and the
+ * lane arguments to extract_lane and replace_lane have to be
+ * constants, so indexed loads and stores end up being written by hand
+ * over and over.  These provide them for the 32- and 64-bit types:
+ *
+ *   wav_f32x4_t wav_f32x4_gather(const float * base, wav_i32x4_t idx);
+ *   void        wav_f32x4_scatter(float * base, wav_i32x4_t idx, wav_f32x4_t v);
+ *
+ * Indices are in elements, not bytes, and may be negative.  The 64-bit
+ * types take a wav_i64x2_t (use wav_i32x4_extend_low or
+ * wav_i32x4_extend_high to widen 32-bit indices).  If several lanes
+ * of a scatter have the same index the highest lane wins.
+ *
+ * Gathers are scalar loads in a single vector initializer (make),
+ * the same on every backend, which leaves the choice of insertion
+ * sequence to the compiler: MOVD/MOVQ plus PINSRD (SSE4.1) or unpacks
+ * (SSE2) when emulating, and lane inserts on WebAssembly.  x86's
+ * VGATHER isn't used; for 2 or 4 lanes it's no faster than scalar
+ * loads on most CPUs.
+ *
+ * For 8- and 16-bit lanes there are also gathers from small tables:
+ *
+ *   wav_u8x16_t wav_u8x16_gather(const uint8_t * table, size_t len, wav_u8x16_t idx);
+ *   wav_u16x8_t wav_u16x8_gather(const uint16_t * table, size_t len, wav_u16x8_t idx);
+ *
+ * The table is processed 16 bytes at a time with swizzle, so it stays
+ * in registers and there are no scalar loads at all.  This is only a
+ * win for small tables (up to 64 or so entries); len must be a
+ * multiple of the number of lanes, and lanes whose index is not less
+ * than len are set to 0.  Entries past the largest index (255 or
+ * 65535) can't be reached, so they are never loaded.
+ *
+ * All of these are also available as wav_gather and wav_scatter
+ * overloads. */
+
+#if !defined(WAV_GATHER_H)
+#define WAV_GATHER_H
+
+#include <stddef.h>
+#include "wav.h"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc99-extensions"
+#pragma clang diagnostic ignored "-Wc11-extensions"
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#pragma clang diagnostic ignored "-Wold-style-cast"
+
+#define WAV_GATHER_DEFINE_32_(Type, Element) \
+  WAV_FUNCTION_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_##Type##_gather(const Element * base, wav_i32x4_t idx) { \
+    return wav_##Type##_make( \
+      base[wav_i32x4_extract_lane(idx, 0)], \
+      base[wav_i32x4_extract_lane(idx, 1)], \
+      base[wav_i32x4_extract_lane(idx, 2)], \
+      base[wav_i32x4_extract_lane(idx, 3)]); \
+  } \
+  \
+  WAV_FUNCTION_ATTRIBUTES \
+  void \
+  wav_##Type##_scatter(Element * base, wav_i32x4_t idx, wav_##Type##_t v) { \
+    base[wav_i32x4_extract_lane(idx, 0)] = wav_##Type##_extract_lane(v, 0); \
+    base[wav_i32x4_extract_lane(idx, 1)] = wav_##Type##_extract_lane(v, 1); \
+    base[wav_i32x4_extract_lane(idx, 2)] = wav_##Type##_extract_lane(v, 2); \
+    base[wav_i32x4_extract_lane(idx, 3)] = wav_##Type##_extract_lane(v, 3); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES wav_##Type##_t wav_gather(const Element * base, wav_i32x4_t idx) { return wav_##Type##_gather(base, idx); } \
+  WAV_OVERLOAD_ATTRIBUTES void wav_scatter(Element * base, wav_i32x4_t idx, wav_##Type##_t v) { wav_##Type##_scatter(base, idx, v); }
+
+#define WAV_GATHER_DEFINE_64_(Type, Element) \
+  WAV_FUNCTION_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_##Type##_gather(const Element * base, wav_i64x2_t idx) { \
+    return wav_##Type##_make( \
+      base[wav_i64x2_extract_lane(idx, 0)], \
+      base[wav_i64x2_extract_lane(idx, 1)]); \
+  } \
+  \
+  WAV_FUNCTION_ATTRIBUTES \
+  void \
+  wav_##Type##_scatter(Element * base, wav_i64x2_t idx, wav_##Type##_t v) { \
+    base[wav_i64x2_extract_lane(idx, 0)] = wav_##Type##_extract_lane(v, 0); \
+    base[wav_i64x2_extract_lane(idx, 1)] = wav_##Type##_extract_lane(v, 1); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES wav_##Type##_t wav_gather(const Element * base, wav_i64x2_t idx) { return wav_##Type##_gather(base, idx); } \
+  WAV_OVERLOAD_ATTRIBUTES void wav_scatter(Element * base, wav_i64x2_t idx, wav_##Type##_t v) { wav_##Type##_scatter(base, idx, v); }
+
+/* gather, scatter -- Indexed loads and stores
+ */
+
+WAV_GATHER_DEFINE_32_(i32x4,  int32_t)
+WAV_GATHER_DEFINE_32_(u32x4, uint32_t)
+WAV_GATHER_DEFINE_32_(f32x4,    float)
+WAV_GATHER_DEFINE_64_(i64x2,  int64_t)
+WAV_GATHER_DEFINE_64_(u64x2, uint64_t)
+WAV_GATHER_DEFINE_64_(f64x2,   double)
+
+/* gather -- Lookups in small tables
+ */
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u8x16_t
+wav_u8x16_gather(const uint8_t * table, size_t len, wav_u8x16_t idx) {
+  /* After subtracting the start of each chunk, indices from other
+   * chunks are 16 or more (earlier ones wrap around), so swizzle
+   * zeroes every lane which isn't in the current chunk. */
+  wav_u8x16_t r = wav_u8x16_splat(0);
+  const size_t n = (len < 256) ? len : 256;
+  size_t i;
+  for (i = 0 ; i < n ; i += 16) {
+    r = wav_u8x16_or(r,
+      wav_u8x16_swizzle(
+        wav_u8x16_loadu(&(table[i])),
+        wav_u8x16_sub(idx, wav_u8x16_splat((uint8_t) i))));
+  }
+  return r;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u16x8_t
+wav_u16x8_gather(const uint16_t * table, size_t len, wav_u16x8_t idx) {
+  /* Same idea as the u8 version, but each 16-bit index n becomes the
+   * byte indices 2n and 2n + 1.  Clamping to 8 first keeps lanes from
+   * other chunks out of range (both bytes land on 16 or 17) without
+   * letting the multiplication overflow. */
+  wav_u16x8_t r = wav_u16x8_splat(0);
+  const size_t n = (len < 65536) ? len : 65536;
+  size_t i;
+  for (i = 0 ; i < n ; i += 8) {
+    const wav_u16x8_t local = wav_u16x8_min(wav_u16x8_sub(idx, wav_u16x8_splat((uint16_t) i)), wav_u16x8_splat(8));
+    const wav_u16x8_t bytes = wav_u16x8_add(wav_u16x8_mul(local, wav_u16x8_splat(0x0202)), wav_u16x8_splat(0x0100));
+    r = wav_u16x8_or(r,
+      wav_u8x16_as_u16x8(
+        wav_u8x16_swizzle(
+          wav_u16x8_as_u8x16(wav_u16x8_loadu(&(table[i]))),
+          wav_u16x8_as_u8x16(bytes))));
+  }
+  return r;
+}
+
+WAV_OVERLOAD_ATTRIBUTES wav_u8x16_t wav_gather(const  uint8_t * table, size_t len, wav_u8x16_t idx) { return wav_u8x16_gather(table, len, idx); }
+WAV_OVERLOAD_ATTRIBUTES wav_u16x8_t wav_gather(const uint16_t * table, size_t len, wav_u16x8_t idx) { return wav_u16x8_gather(table, len, idx); }
+
+#pragma clang diagnostic pop
+
+#endif /* !defined(WAV_GATHER_H) */
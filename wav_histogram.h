@@ -0,0 +1,307 @@
+/* WAV histograms
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* Histograms.
+ *
+ *   void   wav_histogram_u8(uint32_t hist[256], const uint8_t src[], size_t len);
+ *   size_t wav_histogram_u16(uint32_t hist[], size_t bins, const uint16_t src[], size_t len);
+ *
+ * Both overwrite hist with the number of times each value occurs in
+ * src.  wav_histogram_u16 only counts values less than bins (so hist
+ * has bins elements), and returns the number of values it skipped.
+ * Counts are 32-bit, so they wrap if len is 2^32 or more.
+ *
+ * The obvious scalar loop (hist[src[i]]++) is limited by the
+ * dependency between the increment of one element and the next when
+ * they land in the same bin, which is the common case for skewed data.
+ * Instead, the elements of each vector are spread across four
+ * sub-histograms which are then merged with vector adds.  This needs
+ * 4 KiB of stack.  For more than 256 bins wav_histogram_u16 alternates
+ * between two sub-histograms instead, as long as there are at most
+ * WAV_HISTOGRAM_WIDE_BINS (default 1024, which takes 8 KiB of stack;
+ * define it to something smaller if that's too much); past that it
+ * counts directly into hist.  For up to WAV_HISTOGRAM_COMPARE_BINS
+ * bins it doesn't index memory at all: each vector is compared to
+ * every bin and the matches are accumulated in 16-bit lanes. */
+
+#if !defined(WAV_HISTOGRAM_H)
+#define WAV_HISTOGRAM_H
+
+#include <stddef.h>
+#include "wav.h"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc99-extensions"
+#pragma clang diagnostic ignored "-Wc11-extensions"
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#pragma clang diagnostic ignored "-Wold-style-cast"
+#pragma clang diagnostic ignored "-Wcast-align"
+
+#if !defined(WAV_HISTOGRAM_COMPARE_BINS)
+  #define WAV_HISTOGRAM_COMPARE_BINS 16
+#endif
+
+#if !defined(WAV_HISTOGRAM_WIDE_BINS)
+  #define WAV_HISTOGRAM_WIDE_BINS 1024
+#endif
+
+/* Each sub-histogram has an extra bin for out-of-range values, plus
+ * padding to keep it a whole number of vectors. */
+#define WAV_HISTOGRAM_SUB_BINS_ 260
+#define WAV_HISTOGRAM_WIDE_SUB_BINS_ (WAV_HISTOGRAM_WIDE_BINS + 4)
+
+#define WAV_HISTOGRAM_COUNT4_(sub, Type, v, l0, l1, l2, l3) \
+  sub[0][wav_##Type##_extract_lane(v, l0)]++; \
+  sub[1][wav_##Type##_extract_lane(v, l1)]++; \
+  sub[2][wav_##Type##_extract_lane(v, l2)]++; \
+  sub[3][wav_##Type##_extract_lane(v, l3)]++
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_histogram_clear_(uint32_t sub[4][WAV_HISTOGRAM_SUB_BINS_]) {
+  const wav_u32x4_t zero = wav_u32x4_splat(0);
+  size_t i;
+
+  for (i = 0 ; i < WAV_HISTOGRAM_SUB_BINS_ ; i += 4) {
+    wav_u32x4_storeu(&(sub[0][i]), zero);
+    wav_u32x4_storeu(&(sub[1][i]), zero);
+    wav_u32x4_storeu(&(sub[2][i]), zero);
+    wav_u32x4_storeu(&(sub[3][i]), zero);
+  }
+}
+
+/* Sum the sub-histograms into hist[0..bins), and return the total of
+ * bin number bins (i.e., the out-of-range values). */
+WAV_KERNEL_ATTRIBUTES
+uint32_t
+wav_histogram_merge_(uint32_t * hist, uint32_t sub[4][WAV_HISTOGRAM_SUB_BINS_], size_t bins) {
+  size_t i = 0;
+
+  for ( ; (bins - i) >= 4 ; i += 4) {
+    wav_u32x4_storeu(&(hist[i]),
+      wav_u32x4_add(
+        wav_u32x4_add(wav_u32x4_loadu(&(sub[0][i])), wav_u32x4_loadu(&(sub[1][i]))),
+        wav_u32x4_add(wav_u32x4_loadu(&(sub[2][i])), wav_u32x4_loadu(&(sub[3][i])))
+      )
+    );
+  }
+
+  for ( ; i < bins ; i++) {
+    hist[i] = sub[0][i] + sub[1][i] + sub[2][i] + sub[3][i];
+  }
+
+  return sub[0][bins] + sub[1][bins] + sub[2][bins] + sub[3][bins];
+}
+
+/* histogram_u8 -- Count the occurrences of each byte value
+ */
+WAV_KERNEL_ATTRIBUTES
+void
+wav_histogram_u8(uint32_t hist[256], const uint8_t * src, size_t len) {
+  uint32_t sub[4][WAV_HISTOGRAM_SUB_BINS_];
+  size_t i = 0;
+
+  wav_histogram_clear_(sub);
+
+  for ( ; (len - i) >= 16 ; i += 16) {
+    const wav_u8x16_t v = wav_u8x16_loadu(&(src[i]));
+    WAV_HISTOGRAM_COUNT4_(sub, u8x16, v,  0,  1,  2,  3);
+    WAV_HISTOGRAM_COUNT4_(sub, u8x16, v,  4,  5,  6,  7);
+    WAV_HISTOGRAM_COUNT4_(sub, u8x16, v,  8,  9, 10, 11);
+    WAV_HISTOGRAM_COUNT4_(sub, u8x16, v, 12, 13, 14, 15);
+  }
+
+  for ( ; i < len ; i++) {
+    sub[i & 3][src[i]]++;
+  }
+
+  wav_histogram_merge_(hist, sub, 256);
+}
+
+/* Compare-and-count: a lane of acc[bin] is decremented (the boolean
+ * is -1) each time that lane of the input equals bin.  A lane sees at
+ * most one element per vector, so the 16-bit accumulators are drained
+ * into hist every 65535 vectors. */
+WAV_KERNEL_ATTRIBUTES
+size_t
+wav_histogram_u16_compare_(uint32_t * hist, size_t bins, const uint16_t * src, size_t len) {
+  wav_u16x8_t acc[WAV_HISTOGRAM_COMPARE_BINS];
+  wav_u16x8_t keys[WAV_HISTOGRAM_COMPARE_BINS];
+  size_t counted = 0;
+  size_t i = 0;
+  size_t bin;
+
+  for (bin = 0 ; bin < bins ; bin++) {
+    hist[bin] = 0;
+    keys[bin] = wav_u16x8_splat((uint16_t) bin);
+  }
+
+  while ((len - i) >= 8) {
+    const size_t block_end = i + ((((len - i) / 8) < 65535) ? (((len - i) / 8) * 8) : (65535 * 8));
+
+    for (bin = 0 ; bin < bins ; bin++) {
+      acc[bin] = wav_u16x8_splat(0);
+    }
+
+    for ( ; i < block_end ; i += 8) {
+      const wav_u16x8_t v = wav_u16x8_loadu(&(src[i]));
+      for (bin = 0 ; bin < bins ; bin++) {
+        acc[bin] = wav_u16x8_sub(acc[bin], wav_b16x8_as_u16x8(wav_u16x8_eq(v, keys[bin])));
+      }
+    }
+
+    for (bin = 0 ; bin < bins ; bin++) {
+      const wav_u32x4_t w = wav_u16x8_extadd_pairwise(acc[bin]);
+      const uint32_t count =
+        wav_u32x4_extract_lane(w, 0) + wav_u32x4_extract_lane(w, 1) +
+        wav_u32x4_extract_lane(w, 2) + wav_u32x4_extract_lane(w, 3);
+      hist[bin] += count;
+      counted += count;
+    }
+  }
+
+  for ( ; i < len ; i++) {
+    if (src[i] < bins) {
+      hist[src[i]]++;
+      counted++;
+    }
+  }
+
+  return len - counted;
+}
+
+/* Values which are out of range are clamped (with a vector min) to
+ * bins, which is the extra bin at the end of each sub-histogram. */
+WAV_KERNEL_ATTRIBUTES
+size_t
+wav_histogram_u16_sub_(uint32_t * hist, size_t bins, const uint16_t * src, size_t len) {
+  uint32_t sub[4][WAV_HISTOGRAM_SUB_BINS_];
+  const wav_u16x8_t limit = wav_u16x8_splat((uint16_t) bins);
+  size_t i = 0;
+
+  wav_histogram_clear_(sub);
+
+  for ( ; (len - i) >= 8 ; i += 8) {
+    const wav_u16x8_t v = wav_u16x8_min(wav_u16x8_loadu(&(src[i])), limit);
+    WAV_HISTOGRAM_COUNT4_(sub, u16x8, v, 0, 1, 2, 3);
+    WAV_HISTOGRAM_COUNT4_(sub, u16x8, v, 4, 5, 6, 7);
+  }
+
+  for ( ; i < len ; i++) {
+    sub[i & 3][(src[i] < bins) ? src[i] : bins]++;
+  }
+
+  return (size_t) wav_histogram_merge_(hist, sub, bins);
+}
+
+/* Like wav_histogram_u16_sub_, but with two sub-histograms large
+ * enough for WAV_HISTOGRAM_WIDE_BINS bins.  Only the first bins + 1
+ * entries of each (rounded up to a whole vector) are used, so they're
+ * all that gets cleared. */
+WAV_KERNEL_ATTRIBUTES
+size_t
+wav_histogram_u16_wide_(uint32_t * hist, size_t bins, const uint16_t * src, size_t len) {
+  uint32_t sub[2][WAV_HISTOGRAM_WIDE_SUB_BINS_];
+  const wav_u16x8_t limit = wav_u16x8_splat((uint16_t) bins);
+  const wav_u32x4_t zero = wav_u32x4_splat(0);
+  const size_t used = (bins + 4) & ~((size_t) 3);
+  size_t i;
+
+  for (i = 0 ; i < used ; i += 4) {
+    wav_u32x4_storeu(&(sub[0][i]), zero);
+    wav_u32x4_storeu(&(sub[1][i]), zero);
+  }
+
+  for (i = 0 ; (len - i) >= 8 ; i += 8) {
+    const wav_u16x8_t v = wav_u16x8_min(wav_u16x8_loadu(&(src[i])), limit);
+    sub[0][wav_u16x8_extract_lane(v, 0)]++;
+    sub[1][wav_u16x8_extract_lane(v, 1)]++;
+    sub[0][wav_u16x8_extract_lane(v, 2)]++;
+    sub[1][wav_u16x8_extract_lane(v, 3)]++;
+    sub[0][wav_u16x8_extract_lane(v, 4)]++;
+    sub[1][wav_u16x8_extract_lane(v, 5)]++;
+    sub[0][wav_u16x8_extract_lane(v, 6)]++;
+    sub[1][wav_u16x8_extract_lane(v, 7)]++;
+  }
+
+  for ( ; i < len ; i++) {
+    sub[i & 1][(src[i] < bins) ? src[i] : bins]++;
+  }
+
+  for (i = 0 ; (bins - i) >= 4 ; i += 4) {
+    wav_u32x4_storeu(&(hist[i]), wav_u32x4_add(wav_u32x4_loadu(&(sub[0][i])), wav_u32x4_loadu(&(sub[1][i]))));
+  }
+
+  for ( ; i < bins ; i++) {
+    hist[i] = sub[0][i] + sub[1][i];
+  }
+
+  return (size_t) (sub[0][bins] + sub[1][bins]);
+}
+
+WAV_KERNEL_ATTRIBUTES
+size_t
+wav_histogram_u16_direct_(uint32_t * hist, size_t bins, const uint16_t * src, size_t len) {
+  size_t skipped = 0;
+  size_t i;
+
+  for (i = 0 ; i < bins ; i++) {
+    hist[i] = 0;
+  }
+
+  for (i = 0 ; i < len ; i++) {
+    if (src[i] < bins) {
+      hist[src[i]]++;
+    } else {
+      skipped++;
+    }
+  }
+
+  return skipped;
+}
+
+/* histogram_u16 -- Count the occurrences of each value below bins
+ */
+WAV_FUNCTION_ATTRIBUTES
+size_t
+wav_histogram_u16(uint32_t * hist, size_t bins, const uint16_t * src, size_t len) {
+  if (bins <= WAV_HISTOGRAM_COMPARE_BINS) {
+    return wav_histogram_u16_compare_(hist, bins, src, len);
+  } else if (bins <= 256) {
+    return wav_histogram_u16_sub_(hist, bins, src, len);
+  } else if (bins <= WAV_HISTOGRAM_WIDE_BINS) {
+    return wav_histogram_u16_wide_(hist, bins, src, len);
+  } else {
+    return wav_histogram_u16_direct_(hist, bins, src, len);
+  }
+}
+
+#pragma clang diagnostic pop
+
+#endif /* !defined(WAV_HISTOGRAM_H) */
@@ -0,0 +1,347 @@
+/* WAV interleave
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* Interleaved loads and stores.
+ *
+ * Like NEON's vld2/vld3/vld4 and vst2/vst3/vst4, these convert between
+ * interleaved data (e.g., RGB pixels, stereo samples, or xyz points)
+ * and one vector per channel:
+ *
+ *   wav_u8x16x3_t wav_u8x16_load3(const void * src);
+ *   void          wav_u8x16_store3(void * dest, wav_u8x16x3_t v);
+ *
+ * load3 reads 48 bytes (16 RGB pixels) and returns the first, second,
+ * and third element of each group in values[0], values[1], and
+ * values[2]; store3 does the reverse.  They're available with 2, 3,
+ * and 4 channels for the 8-, 16-, and 32-bit types, and the stores
+ * are also available as wav_store2, wav_store3, and wav_store4
+ * overloads.  Like loadu and storeu, there are no alignment
+ * requirements.
+ *
+ * Everything is done with two-input shuffles on the unsigned types
+ * (the others are reinterpreted).  With 2 channels each output vector
+ * is one shuffle of the two inputs.  With 4, two rounds of even/odd
+ * shuffles (8 in total) are needed, since each output depends on all
+ * four inputs.  With 3, each output also depends on all three inputs,
+ * so it takes two shuffles: one picking its lanes from the first two
+ * inputs and one filling in the rest from the third. */
+
+#if !defined(WAV_INTERLEAVE_H)
+#define WAV_INTERLEAVE_H
+
+#include "wav.h"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc99-extensions"
+#pragma clang diagnostic ignored "-Wc11-extensions"
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#pragma clang diagnostic ignored "-Wold-style-cast"
+
+#define WAV_INTERLEAVE_DEFINE_TYPES_(Type) \
+  typedef struct { wav_##Type##_t values[2]; } wav_##Type##x2_t; \
+  typedef struct { wav_##Type##_t values[3]; } wav_##Type##x3_t; \
+  typedef struct { wav_##Type##_t values[4]; } wav_##Type##x4_t;
+
+WAV_INTERLEAVE_DEFINE_TYPES_(i8x16)
+WAV_INTERLEAVE_DEFINE_TYPES_(i16x8)
+WAV_INTERLEAVE_DEFINE_TYPES_(i32x4)
+WAV_INTERLEAVE_DEFINE_TYPES_(u8x16)
+WAV_INTERLEAVE_DEFINE_TYPES_(u16x8)
+WAV_INTERLEAVE_DEFINE_TYPES_(u32x4)
+WAV_INTERLEAVE_DEFINE_TYPES_(f32x4)
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u8x16x2_t
+wav_u8x16_load2(const void * src) {
+  const wav_u8x16_t a = wav_u8x16_loadu(src);
+  const wav_u8x16_t b = wav_u8x16_loadu(((const uint8_t *) src) + 16);
+  wav_u8x16x2_t r;
+  r.values[0] = wav_u8x16_shuffle(a, b,  0,  2,  4,  6,  8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+  r.values[1] = wav_u8x16_shuffle(a, b,  1,  3,  5,  7,  9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+  return r;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u8x16_store2(void * dest, wav_u8x16x2_t v) {
+  wav_u8x16_storeu(dest, wav_u8x16_shuffle(v.values[0], v.values[1],  0, 16,  1, 17,  2, 18,  3, 19,  4, 20,  5, 21,  6, 22,  7, 23));
+  wav_u8x16_storeu(((uint8_t *) dest) + 16, wav_u8x16_shuffle(v.values[0], v.values[1],  8, 24,  9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u8x16x3_t
+wav_u8x16_load3(const void * src) {
+  const wav_u8x16_t a = wav_u8x16_loadu(src);
+  const wav_u8x16_t b = wav_u8x16_loadu(((const uint8_t *) src) + 16);
+  const wav_u8x16_t c = wav_u8x16_loadu(((const uint8_t *) src) + 32);
+  wav_u8x16x3_t r;
+  r.values[0] = wav_u8x16_shuffle(wav_u8x16_shuffle(a, b,  0,  3,  6,  9, 12, 15, 18, 21, 24, 27, 30,  0,  0,  0,  0,  0), c,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 17, 20, 23, 26, 29);
+  r.values[1] = wav_u8x16_shuffle(wav_u8x16_shuffle(a, b,  1,  4,  7, 10, 13, 16, 19, 22, 25, 28, 31,  0,  0,  0,  0,  0), c,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 18, 21, 24, 27, 30);
+  r.values[2] = wav_u8x16_shuffle(wav_u8x16_shuffle(a, b,  2,  5,  8, 11, 14, 17, 20, 23, 26, 29,  0,  0,  0,  0,  0,  0), c,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 16, 19, 22, 25, 28, 31);
+  return r;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u8x16_store3(void * dest, wav_u8x16x3_t v) {
+  wav_u8x16_storeu(dest, wav_u8x16_shuffle(wav_u8x16_shuffle(v.values[0], v.values[1],  0, 16,  0,  1, 17,  0,  2, 18,  0,  3, 19,  0,  4, 20,  0,  5), v.values[2],  0,  1, 16,  3,  4, 17,  6,  7, 18,  9, 10, 19, 12, 13, 20, 15));
+  wav_u8x16_storeu(((uint8_t *) dest) + 16, wav_u8x16_shuffle(wav_u8x16_shuffle(v.values[0], v.values[1], 21,  0,  6, 22,  0,  7, 23,  0,  8, 24,  0,  9, 25,  0, 10, 26), v.values[2],  0, 21,  2,  3, 22,  5,  6, 23,  8,  9, 24, 11, 12, 25, 14, 15));
+  wav_u8x16_storeu(((uint8_t *) dest) + 32, wav_u8x16_shuffle(wav_u8x16_shuffle(v.values[0], v.values[1],  0, 11, 27,  0, 12, 28,  0, 13, 29,  0, 14, 30,  0, 15, 31,  0), v.values[2], 26,  1,  2, 27,  4,  5, 28,  7,  8, 29, 10, 11, 30, 13, 14, 31));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u8x16x4_t
+wav_u8x16_load4(const void * src) {
+  const wav_u8x16_t a = wav_u8x16_loadu(src);
+  const wav_u8x16_t b = wav_u8x16_loadu(((const uint8_t *) src) + 16);
+  const wav_u8x16_t c = wav_u8x16_loadu(((const uint8_t *) src) + 32);
+  const wav_u8x16_t d = wav_u8x16_loadu(((const uint8_t *) src) + 48);
+  const wav_u8x16_t ab_even = wav_u8x16_shuffle(a, b,  0,  2,  4,  6,  8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+  const wav_u8x16_t ab_odd  = wav_u8x16_shuffle(a, b,  1,  3,  5,  7,  9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+  const wav_u8x16_t cd_even = wav_u8x16_shuffle(c, d,  0,  2,  4,  6,  8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+  const wav_u8x16_t cd_odd  = wav_u8x16_shuffle(c, d,  1,  3,  5,  7,  9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+  wav_u8x16x4_t r;
+  r.values[0] = wav_u8x16_shuffle(ab_even, cd_even,  0,  2,  4,  6,  8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+  r.values[1] = wav_u8x16_shuffle(ab_odd, cd_odd,  0,  2,  4,  6,  8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+  r.values[2] = wav_u8x16_shuffle(ab_even, cd_even,  1,  3,  5,  7,  9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+  r.values[3] = wav_u8x16_shuffle(ab_odd, cd_odd,  1,  3,  5,  7,  9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+  return r;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u8x16_store4(void * dest, wav_u8x16x4_t v) {
+  const wav_u8x16_t lo02 = wav_u8x16_shuffle(v.values[0], v.values[2],  0, 16,  1, 17,  2, 18,  3, 19,  4, 20,  5, 21,  6, 22,  7, 23);
+  const wav_u8x16_t hi02 = wav_u8x16_shuffle(v.values[0], v.values[2],  8, 24,  9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+  const wav_u8x16_t lo13 = wav_u8x16_shuffle(v.values[1], v.values[3],  0, 16,  1, 17,  2, 18,  3, 19,  4, 20,  5, 21,  6, 22,  7, 23);
+  const wav_u8x16_t hi13 = wav_u8x16_shuffle(v.values[1], v.values[3],  8, 24,  9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+  wav_u8x16_storeu(dest, wav_u8x16_shuffle(lo02, lo13,  0, 16,  1, 17,  2, 18,  3, 19,  4, 20,  5, 21,  6, 22,  7, 23));
+  wav_u8x16_storeu(((uint8_t *) dest) + 16, wav_u8x16_shuffle(lo02, lo13,  8, 24,  9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31));
+  wav_u8x16_storeu(((uint8_t *) dest) + 32, wav_u8x16_shuffle(hi02, hi13,  0, 16,  1, 17,  2, 18,  3, 19,  4, 20,  5, 21,  6, 22,  7, 23));
+  wav_u8x16_storeu(((uint8_t *) dest) + 48, wav_u8x16_shuffle(hi02, hi13,  8, 24,  9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u16x8x2_t
+wav_u16x8_load2(const void * src) {
+  const wav_u16x8_t a = wav_u16x8_loadu(src);
+  const wav_u16x8_t b = wav_u16x8_loadu(((const uint16_t *) src) + 8);
+  wav_u16x8x2_t r;
+  r.values[0] = wav_u16x8_shuffle(a, b,  0,  2,  4,  6,  8, 10, 12, 14);
+  r.values[1] = wav_u16x8_shuffle(a, b,  1,  3,  5,  7,  9, 11, 13, 15);
+  return r;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u16x8_store2(void * dest, wav_u16x8x2_t v) {
+  wav_u16x8_storeu(dest, wav_u16x8_shuffle(v.values[0], v.values[1],  0,  8,  1,  9,  2, 10,  3, 11));
+  wav_u16x8_storeu(((uint16_t *) dest) + 8, wav_u16x8_shuffle(v.values[0], v.values[1],  4, 12,  5, 13,  6, 14,  7, 15));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u16x8x3_t
+wav_u16x8_load3(const void * src) {
+  const wav_u16x8_t a = wav_u16x8_loadu(src);
+  const wav_u16x8_t b = wav_u16x8_loadu(((const uint16_t *) src) + 8);
+  const wav_u16x8_t c = wav_u16x8_loadu(((const uint16_t *) src) + 16);
+  wav_u16x8x3_t r;
+  r.values[0] = wav_u16x8_shuffle(wav_u16x8_shuffle(a, b,  0,  3,  6,  9, 12, 15,  0,  0), c,  0,  1,  2,  3,  4,  5, 10, 13);
+  r.values[1] = wav_u16x8_shuffle(wav_u16x8_shuffle(a, b,  1,  4,  7, 10, 13,  0,  0,  0), c,  0,  1,  2,  3,  4,  8, 11, 14);
+  r.values[2] = wav_u16x8_shuffle(wav_u16x8_shuffle(a, b,  2,  5,  8, 11, 14,  0,  0,  0), c,  0,  1,  2,  3,  4,  9, 12, 15);
+  return r;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u16x8_store3(void * dest, wav_u16x8x3_t v) {
+  wav_u16x8_storeu(dest, wav_u16x8_shuffle(wav_u16x8_shuffle(v.values[0], v.values[1],  0,  8,  0,  1,  9,  0,  2, 10), v.values[2],  0,  1,  8,  3,  4,  9,  6,  7));
+  wav_u16x8_storeu(((uint16_t *) dest) + 8, wav_u16x8_shuffle(wav_u16x8_shuffle(v.values[0], v.values[1],  0,  3, 11,  0,  4, 12,  0,  5), v.values[2], 10,  1,  2, 11,  4,  5, 12,  7));
+  wav_u16x8_storeu(((uint16_t *) dest) + 16, wav_u16x8_shuffle(wav_u16x8_shuffle(v.values[0], v.values[1], 13,  0,  6, 14,  0,  7, 15,  0), v.values[2],  0, 13,  2,  3, 14,  5,  6, 15));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u16x8x4_t
+wav_u16x8_load4(const void * src) {
+  const wav_u16x8_t a = wav_u16x8_loadu(src);
+  const wav_u16x8_t b = wav_u16x8_loadu(((const uint16_t *) src) + 8);
+  const wav_u16x8_t c = wav_u16x8_loadu(((const uint16_t *) src) + 16);
+  const wav_u16x8_t d = wav_u16x8_loadu(((const uint16_t *) src) + 24);
+  const wav_u16x8_t ab_even = wav_u16x8_shuffle(a, b,  0,  2,  4,  6,  8, 10, 12, 14);
+  const wav_u16x8_t ab_odd  = wav_u16x8_shuffle(a, b,  1,  3,  5,  7,  9, 11, 13, 15);
+  const wav_u16x8_t cd_even = wav_u16x8_shuffle(c, d,  0,  2,  4,  6,  8, 10, 12, 14);
+  const wav_u16x8_t cd_odd  = wav_u16x8_shuffle(c, d,  1,  3,  5,  7,  9, 11, 13, 15);
+  wav_u16x8x4_t r;
+  r.values[0] = wav_u16x8_shuffle(ab_even, cd_even,  0,  2,  4,  6,  8, 10, 12, 14);
+  r.values[1] = wav_u16x8_shuffle(ab_odd, cd_odd,  0,  2,  4,  6,  8, 10, 12, 14);
+  r.values[2] = wav_u16x8_shuffle(ab_even, cd_even,  1,  3,  5,  7,  9, 11, 13, 15);
+  r.values[3] = wav_u16x8_shuffle(ab_odd, cd_odd,  1,  3,  5,  7,  9, 11, 13, 15);
+  return r;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u16x8_store4(void * dest, wav_u16x8x4_t v) {
+  const wav_u16x8_t lo02 = wav_u16x8_shuffle(v.values[0], v.values[2],  0,  8,  1,  9,  2, 10,  3, 11);
+  const wav_u16x8_t hi02 = wav_u16x8_shuffle(v.values[0], v.values[2],  4, 12,  5, 13,  6, 14,  7, 15);
+  const wav_u16x8_t lo13 = wav_u16x8_shuffle(v.values[1], v.values[3],  0,  8,  1,  9,  2, 10,  3, 11);
+  const wav_u16x8_t hi13 = wav_u16x8_shuffle(v.values[1], v.values[3],  4, 12,  5, 13,  6, 14,  7, 15);
+  wav_u16x8_storeu(dest, wav_u16x8_shuffle(lo02, lo13,  0,  8,  1,  9,  2, 10,  3, 11));
+  wav_u16x8_storeu(((uint16_t *) dest) + 8, wav_u16x8_shuffle(lo02, lo13,  4, 12,  5, 13,  6, 14,  7, 15));
+  wav_u16x8_storeu(((uint16_t *) dest) + 16, wav_u16x8_shuffle(hi02, hi13,  0,  8,  1,  9,  2, 10,  3, 11));
+  wav_u16x8_storeu(((uint16_t *) dest) + 24, wav_u16x8_shuffle(hi02, hi13,  4, 12,  5, 13,  6, 14,  7, 15));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u32x4x2_t
+wav_u32x4_load2(const void * src) {
+  const wav_u32x4_t a = wav_u32x4_loadu(src);
+  const wav_u32x4_t b = wav_u32x4_loadu(((const uint32_t *) src) + 4);
+  wav_u32x4x2_t r;
+  r.values[0] = wav_u32x4_shuffle(a, b,  0,  2,  4,  6);
+  r.values[1] = wav_u32x4_shuffle(a, b,  1,  3,  5,  7);
+  return r;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u32x4_store2(void * dest, wav_u32x4x2_t v) {
+  wav_u32x4_storeu(dest, wav_u32x4_shuffle(v.values[0], v.values[1],  0,  4,  1,  5));
+  wav_u32x4_storeu(((uint32_t *) dest) + 4, wav_u32x4_shuffle(v.values[0], v.values[1],  2,  6,  3,  7));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u32x4x3_t
+wav_u32x4_load3(const void * src) {
+  const wav_u32x4_t a = wav_u32x4_loadu(src);
+  const wav_u32x4_t b = wav_u32x4_loadu(((const uint32_t *) src) + 4);
+  const wav_u32x4_t c = wav_u32x4_loadu(((const uint32_t *) src) + 8);
+  wav_u32x4x3_t r;
+  r.values[0] = wav_u32x4_shuffle(wav_u32x4_shuffle(a, b,  0,  3,  6,  0), c,  0,  1,  2,  5);
+  r.values[1] = wav_u32x4_shuffle(wav_u32x4_shuffle(a, b,  1,  4,  7,  0), c,  0,  1,  2,  6);
+  r.values[2] = wav_u32x4_shuffle(wav_u32x4_shuffle(a, b,  2,  5,  0,  0), c,  0,  1,  4,  7);
+  return r;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u32x4_store3(void * dest, wav_u32x4x3_t v) {
+  wav_u32x4_storeu(dest, wav_u32x4_shuffle(wav_u32x4_shuffle(v.values[0], v.values[1],  0,  4,  0,  1), v.values[2],  0,  1,  4,  3));
+  wav_u32x4_storeu(((uint32_t *) dest) + 4, wav_u32x4_shuffle(wav_u32x4_shuffle(v.values[0], v.values[1],  5,  0,  2,  6), v.values[2],  0,  5,  2,  3));
+  wav_u32x4_storeu(((uint32_t *) dest) + 8, wav_u32x4_shuffle(wav_u32x4_shuffle(v.values[0], v.values[1],  0,  3,  7,  0), v.values[2],  6,  1,  2,  7));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u32x4x4_t
+wav_u32x4_load4(const void * src) {
+  const wav_u32x4_t a = wav_u32x4_loadu(src);
+  const wav_u32x4_t b = wav_u32x4_loadu(((const uint32_t *) src) + 4);
+  const wav_u32x4_t c = wav_u32x4_loadu(((const uint32_t *) src) + 8);
+  const wav_u32x4_t d = wav_u32x4_loadu(((const uint32_t *) src) + 12);
+  const wav_u32x4_t ab_even = wav_u32x4_shuffle(a, b,  0,  2,  4,  6);
+  const wav_u32x4_t ab_odd  = wav_u32x4_shuffle(a, b,  1,  3,  5,  7);
+  const wav_u32x4_t cd_even = wav_u32x4_shuffle(c, d,  0,  2,  4,  6);
+  const wav_u32x4_t cd_odd  = wav_u32x4_shuffle(c, d,  1,  3,  5,  7);
+  wav_u32x4x4_t r;
+  r.values[0] = wav_u32x4_shuffle(ab_even, cd_even,  0,  2,  4,  6);
+  r.values[1] = wav_u32x4_shuffle(ab_odd, cd_odd,  0,  2,  4,  6);
+  r.values[2] = wav_u32x4_shuffle(ab_even, cd_even,  1,  3,  5,  7);
+  r.values[3] = wav_u32x4_shuffle(ab_odd, cd_odd,  1,  3,  5,  7);
+  return r;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u32x4_store4(void * dest, wav_u32x4x4_t v) {
+  const wav_u32x4_t lo02 = wav_u32x4_shuffle(v.values[0], v.values[2],  0,  4,  1,  5);
+  const wav_u32x4_t hi02 = wav_u32x4_shuffle(v.values[0], v.values[2],  2,  6,  3,  7);
+  const wav_u32x4_t lo13 = wav_u32x4_shuffle(v.values[1], v.values[3],  0,  4,  1,  5);
+  const wav_u32x4_t hi13 = wav_u32x4_shuffle(v.values[1], v.values[3],  2,  6,  3,  7);
+  wav_u32x4_storeu(dest, wav_u32x4_shuffle(lo02, lo13,  0,  4,  1,  5));
+  wav_u32x4_storeu(((uint32_t *) dest) + 4, wav_u32x4_shuffle(lo02, lo13,  2,  6,  3,  7));
+  wav_u32x4_storeu(((uint32_t *) dest) + 8, wav_u32x4_shuffle(hi02, hi13,  0,  4,  1,  5));
+  wav_u32x4_storeu(((uint32_t *) dest) + 12, wav_u32x4_shuffle(hi02, hi13,  2,  6,  3,  7));
+}
+
+#define WAV_INTERLEAVE_DEFINE_(Type, Unsigned, Count) \
+  WAV_FUNCTION_ATTRIBUTES \
+  wav_##Type##x##Count##_t \
+  wav_##Type##_load##Count(const void * src) { \
+    const wav_##Unsigned##x##Count##_t u = wav_##Unsigned##_load##Count(src); \
+    wav_##Type##x##Count##_t r; \
+    int i; \
+    for (i = 0 ; i < Count ; i++) { \
+      r.values[i] = wav_##Unsigned##_as_##Type(u.values[i]); \
+    } \
+    return r; \
+  } \
+  \
+  WAV_FUNCTION_ATTRIBUTES \
+  void \
+  wav_##Type##_store##Count(void * dest, wav_##Type##x##Count##_t v) { \
+    wav_##Unsigned##x##Count##_t u; \
+    int i; \
+    for (i = 0 ; i < Count ; i++) { \
+      u.values[i] = wav_##Type##_as_##Unsigned(v.values[i]); \
+    } \
+    wav_##Unsigned##_store##Count(dest, u); \
+  }
+
+#define WAV_INTERLEAVE_DEFINE_OVERLOADS_(Type) \
+  WAV_OVERLOAD_ATTRIBUTES void wav_store2(void * dest, wav_##Type##x2_t v) { wav_##Type##_store2(dest, v); } \
+  WAV_OVERLOAD_ATTRIBUTES void wav_store3(void * dest, wav_##Type##x3_t v) { wav_##Type##_store3(dest, v); } \
+  WAV_OVERLOAD_ATTRIBUTES void wav_store4(void * dest, wav_##Type##x4_t v) { wav_##Type##_store4(dest, v); }
+
+WAV_INTERLEAVE_DEFINE_(i8x16, u8x16, 2)
+WAV_INTERLEAVE_DEFINE_(i8x16, u8x16, 3)
+WAV_INTERLEAVE_DEFINE_(i8x16, u8x16, 4)
+WAV_INTERLEAVE_DEFINE_(i16x8, u16x8, 2)
+WAV_INTERLEAVE_DEFINE_(i16x8, u16x8, 3)
+WAV_INTERLEAVE_DEFINE_(i16x8, u16x8, 4)
+WAV_INTERLEAVE_DEFINE_(i32x4, u32x4, 2)
+WAV_INTERLEAVE_DEFINE_(i32x4, u32x4, 3)
+WAV_INTERLEAVE_DEFINE_(i32x4, u32x4, 4)
+WAV_INTERLEAVE_DEFINE_(f32x4, u32x4, 2)
+WAV_INTERLEAVE_DEFINE_(f32x4, u32x4, 3)
+WAV_INTERLEAVE_DEFINE_(f32x4, u32x4, 4)
+
+/* load2, load3, load4, store2, store3, store4 -- Interleaved loads and stores
+ */
+
+WAV_INTERLEAVE_DEFINE_OVERLOADS_(i8x16)
+WAV_INTERLEAVE_DEFINE_OVERLOADS_(i16x8)
+WAV_INTERLEAVE_DEFINE_OVERLOADS_(i32x4)
+WAV_INTERLEAVE_DEFINE_OVERLOADS_(u8x16)
+WAV_INTERLEAVE_DEFINE_OVERLOADS_(u16x8)
+WAV_INTERLEAVE_DEFINE_OVERLOADS_(u32x4)
+WAV_INTERLEAVE_DEFINE_OVERLOADS_(f32x4)
+
+#pragma clang diagnostic pop
+
+#endif /* !defined(WAV_INTERLEAVE_H) */
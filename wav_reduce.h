@@ -0,0 +1,497 @@
+/* WAV reductions
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* Horizontal reductions.
+ *
+ * Register-level reductions collapse all the lanes of a vector into a
+ * single scalar:
+ *
+ *   int32_t  wav_i32x4_reduce_add(wav_i32x4_t v);
+ *   uint8_t  wav_u8x16_reduce_max(wav_u8x16_t v);
+ *   uint32_t wav_u8x16_reduce_add_wide(wav_u8x16_t v);
+ *
+ * They are built as a shuffle tree: the upper half of the vector is
+ * combined with the lower half, then the upper half of that, and so
+ * on, so a reduction of N lanes takes log2(N) shuffles and operations
+ * instead of N - 1 dependent scalar operations.  add, and, or, and xor
+ * are provided for every integer type; min and max for every type
+ * (64-bit integers, which have no vector min or max, compare the two
+ * lanes as scalars).  add wraps like wav_*_add; the _wide variants of
+ * the 8- and 16-bit sums widen with extadd_pairwise first so the result
+ * can't overflow.  For floating point types the order of the additions
+ * is the tree order, not the lane order, and min and max propagate
+ * NaNs the same way wav_f32x4_min and wav_f32x4_max do.
+ *
+ * Buffer-level reductions work on whole arrays:
+ *
+ *   int64_t wav_i8x16_array_sum(const int8_t src[], size_t len);
+ *   bool    wav_f32x4_array_minmax(const float src[], size_t len, float * min, float * max);
+ *
+ * (or the wav_sum and wav_minmax overloads).  Integer sums are
+ * returned as 64-bit integers; narrow lanes are accumulated at the
+ * narrowest width which can't overflow, and widened in blocks.
+ * Several independent accumulators are kept, and they are only
+ * reduced once at the end.  For floating point sums this means the
+ * result is generally not bit-identical to a sequential scalar loop.
+ * wav_*_array_minmax returns false (leaving *min and *max alone) if
+ * len is 0; it isn't available for 64-bit integers. */
+
+#if !defined(WAV_REDUCE_H)
+#define WAV_REDUCE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "wav.h"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc99-extensions"
+#pragma clang diagnostic ignored "-Wc11-extensions"
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#pragma clang diagnostic ignored "-Wold-style-cast"
+#pragma clang diagnostic ignored "-Wcast-align"
+
+/* Shuffle trees.  Each step folds the upper half of the lanes which
+ * are still live onto the lower half; the lanes which are no longer
+ * live just carry along whatever the shuffle puts there. */
+
+#define WAV_REDUCE_FOLD2_(Type, Operation, v) \
+  v = wav_##Type##_##Operation(v, wav_##Type##_shuffle(v, v, 1, 0))
+
+#define WAV_REDUCE_FOLD4_(Type, Operation, v) \
+  v = wav_##Type##_##Operation(v, wav_##Type##_shuffle(v, v, 2, 3, 0, 1)); \
+  v = wav_##Type##_##Operation(v, wav_##Type##_shuffle(v, v, 1, 0, 3, 2))
+
+#define WAV_REDUCE_FOLD8_(Type, Operation, v) \
+  v = wav_##Type##_##Operation(v, wav_##Type##_shuffle(v, v, 4, 5, 6, 7, 0, 1, 2, 3)); \
+  v = wav_##Type##_##Operation(v, wav_##Type##_shuffle(v, v, 2, 3, 0, 1, 6, 7, 4, 5)); \
+  v = wav_##Type##_##Operation(v, wav_##Type##_shuffle(v, v, 1, 0, 3, 2, 5, 4, 7, 6))
+
+#define WAV_REDUCE_FOLD16_(Type, Operation, v) \
+  v = wav_##Type##_##Operation(v, wav_##Type##_shuffle(v, v, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7)); \
+  v = wav_##Type##_##Operation(v, wav_##Type##_shuffle(v, v, 4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9, 10, 11)); \
+  v = wav_##Type##_##Operation(v, wav_##Type##_shuffle(v, v, 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13)); \
+  v = wav_##Type##_##Operation(v, wav_##Type##_shuffle(v, v, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14))
+
+#define WAV_REDUCE_DEFINE_(Type, Element, Lanes, Operation) \
+  WAV_FUNCTION_ATTRIBUTES \
+  Element \
+  wav_##Type##_reduce_##Operation(wav_##Type##_t v) { \
+    WAV_REDUCE_FOLD##Lanes##_(Type, Operation, v); \
+    return wav_##Type##_extract_lane(v, 0); \
+  }
+
+/* reduce_add, reduce_and, reduce_or, reduce_xor, reduce_min,
+ * reduce_max -- Combine all lanes into a scalar
+ */
+
+WAV_REDUCE_DEFINE_(i8x16,   int8_t, 16, add)
+WAV_REDUCE_DEFINE_(i8x16,   int8_t, 16, and)
+WAV_REDUCE_DEFINE_(i8x16,   int8_t, 16, or)
+WAV_REDUCE_DEFINE_(i8x16,   int8_t, 16, xor)
+WAV_REDUCE_DEFINE_(i8x16,   int8_t, 16, min)
+WAV_REDUCE_DEFINE_(i8x16,   int8_t, 16, max)
+
+WAV_REDUCE_DEFINE_(i16x8,  int16_t,  8, add)
+WAV_REDUCE_DEFINE_(i16x8,  int16_t,  8, and)
+WAV_REDUCE_DEFINE_(i16x8,  int16_t,  8, or)
+WAV_REDUCE_DEFINE_(i16x8,  int16_t,  8, xor)
+WAV_REDUCE_DEFINE_(i16x8,  int16_t,  8, min)
+WAV_REDUCE_DEFINE_(i16x8,  int16_t,  8, max)
+
+WAV_REDUCE_DEFINE_(i32x4,  int32_t,  4, add)
+WAV_REDUCE_DEFINE_(i32x4,  int32_t,  4, and)
+WAV_REDUCE_DEFINE_(i32x4,  int32_t,  4, or)
+WAV_REDUCE_DEFINE_(i32x4,  int32_t,  4, xor)
+WAV_REDUCE_DEFINE_(i32x4,  int32_t,  4, min)
+WAV_REDUCE_DEFINE_(i32x4,  int32_t,  4, max)
+
+WAV_REDUCE_DEFINE_(i64x2,  int64_t,  2, add)
+WAV_REDUCE_DEFINE_(i64x2,  int64_t,  2, and)
+WAV_REDUCE_DEFINE_(i64x2,  int64_t,  2, or)
+WAV_REDUCE_DEFINE_(i64x2,  int64_t,  2, xor)
+
+WAV_REDUCE_DEFINE_(u8x16,  uint8_t, 16, add)
+WAV_REDUCE_DEFINE_(u8x16,  uint8_t, 16, and)
+WAV_REDUCE_DEFINE_(u8x16,  uint8_t, 16, or)
+WAV_REDUCE_DEFINE_(u8x16,  uint8_t, 16, xor)
+WAV_REDUCE_DEFINE_(u8x16,  uint8_t, 16, min)
+WAV_REDUCE_DEFINE_(u8x16,  uint8_t, 16, max)
+
+WAV_REDUCE_DEFINE_(u16x8, uint16_t,  8, add)
+WAV_REDUCE_DEFINE_(u16x8, uint16_t,  8, and)
+WAV_REDUCE_DEFINE_(u16x8, uint16_t,  8, or)
+WAV_REDUCE_DEFINE_(u16x8, uint16_t,  8, xor)
+WAV_REDUCE_DEFINE_(u16x8, uint16_t,  8, min)
+WAV_REDUCE_DEFINE_(u16x8, uint16_t,  8, max)
+
+WAV_REDUCE_DEFINE_(u32x4, uint32_t,  4, add)
+WAV_REDUCE_DEFINE_(u32x4, uint32_t,  4, and)
+WAV_REDUCE_DEFINE_(u32x4, uint32_t,  4, or)
+WAV_REDUCE_DEFINE_(u32x4, uint32_t,  4, xor)
+WAV_REDUCE_DEFINE_(u32x4, uint32_t,  4, min)
+WAV_REDUCE_DEFINE_(u32x4, uint32_t,  4, max)
+
+WAV_REDUCE_DEFINE_(u64x2, uint64_t,  2, add)
+WAV_REDUCE_DEFINE_(u64x2, uint64_t,  2, and)
+WAV_REDUCE_DEFINE_(u64x2, uint64_t,  2, or)
+WAV_REDUCE_DEFINE_(u64x2, uint64_t,  2, xor)
+
+WAV_REDUCE_DEFINE_(f32x4,    float,  4, add)
+WAV_REDUCE_DEFINE_(f32x4,    float,  4, min)
+WAV_REDUCE_DEFINE_(f32x4,    float,  4, max)
+
+WAV_REDUCE_DEFINE_(f64x2,   double,  2, add)
+WAV_REDUCE_DEFINE_(f64x2,   double,  2, min)
+WAV_REDUCE_DEFINE_(f64x2,   double,  2, max)
+
+WAV_FUNCTION_ATTRIBUTES
+int64_t
+wav_i64x2_reduce_min(wav_i64x2_t v) {
+  const int64_t a = wav_i64x2_extract_lane(v, 0);
+  const int64_t b = wav_i64x2_extract_lane(v, 1);
+  return (b < a) ? b : a;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+int64_t
+wav_i64x2_reduce_max(wav_i64x2_t v) {
+  const int64_t a = wav_i64x2_extract_lane(v, 0);
+  const int64_t b = wav_i64x2_extract_lane(v, 1);
+  return (b > a) ? b : a;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+uint64_t
+wav_u64x2_reduce_min(wav_u64x2_t v) {
+  const uint64_t a = wav_u64x2_extract_lane(v, 0);
+  const uint64_t b = wav_u64x2_extract_lane(v, 1);
+  return (b < a) ? b : a;
+}
+
+WAV_FUNCTION_ATTRIBUTES
+uint64_t
+wav_u64x2_reduce_max(wav_u64x2_t v) {
+  const uint64_t a = wav_u64x2_extract_lane(v, 0);
+  const uint64_t b = wav_u64x2_extract_lane(v, 1);
+  return (b > a) ? b : a;
+}
+
+#define WAV_REDUCE_DEFINE_OVERLOADS_(Type, Element) \
+  WAV_OVERLOAD_ATTRIBUTES Element wav_reduce_add(wav_##Type##_t v) { return wav_##Type##_reduce_add(v); } \
+  WAV_OVERLOAD_ATTRIBUTES Element wav_reduce_min(wav_##Type##_t v) { return wav_##Type##_reduce_min(v); } \
+  WAV_OVERLOAD_ATTRIBUTES Element wav_reduce_max(wav_##Type##_t v) { return wav_##Type##_reduce_max(v); }
+
+#define WAV_REDUCE_DEFINE_BITWISE_OVERLOADS_(Type, Element) \
+  WAV_OVERLOAD_ATTRIBUTES Element wav_reduce_and(wav_##Type##_t v) { return wav_##Type##_reduce_and(v); } \
+  WAV_OVERLOAD_ATTRIBUTES Element wav_reduce_or(wav_##Type##_t v) { return wav_##Type##_reduce_or(v); } \
+  WAV_OVERLOAD_ATTRIBUTES Element wav_reduce_xor(wav_##Type##_t v) { return wav_##Type##_reduce_xor(v); }
+
+WAV_REDUCE_DEFINE_OVERLOADS_(i8x16,   int8_t)
+WAV_REDUCE_DEFINE_OVERLOADS_(i16x8,  int16_t)
+WAV_REDUCE_DEFINE_OVERLOADS_(i32x4,  int32_t)
+WAV_REDUCE_DEFINE_OVERLOADS_(i64x2,  int64_t)
+WAV_REDUCE_DEFINE_OVERLOADS_(u8x16,  uint8_t)
+WAV_REDUCE_DEFINE_OVERLOADS_(u16x8, uint16_t)
+WAV_REDUCE_DEFINE_OVERLOADS_(u32x4, uint32_t)
+WAV_REDUCE_DEFINE_OVERLOADS_(u64x2, uint64_t)
+WAV_REDUCE_DEFINE_OVERLOADS_(f32x4,    float)
+WAV_REDUCE_DEFINE_OVERLOADS_(f64x2,   double)
+
+WAV_REDUCE_DEFINE_BITWISE_OVERLOADS_(i8x16,   int8_t)
+WAV_REDUCE_DEFINE_BITWISE_OVERLOADS_(i16x8,  int16_t)
+WAV_REDUCE_DEFINE_BITWISE_OVERLOADS_(i32x4,  int32_t)
+WAV_REDUCE_DEFINE_BITWISE_OVERLOADS_(i64x2,  int64_t)
+WAV_REDUCE_DEFINE_BITWISE_OVERLOADS_(u8x16,  uint8_t)
+WAV_REDUCE_DEFINE_BITWISE_OVERLOADS_(u16x8, uint16_t)
+WAV_REDUCE_DEFINE_BITWISE_OVERLOADS_(u32x4, uint32_t)
+WAV_REDUCE_DEFINE_BITWISE_OVERLOADS_(u64x2, uint64_t)
+
+/* reduce_add_wide -- Sum all lanes without overflow
+ *
+ * Lanes are widened with extadd_pairwise (and, for 8-bit lanes,
+ * widened again) before the final reduction, so the result can hold
+ * the sum of every possible input.
+ */
+
+WAV_FUNCTION_ATTRIBUTES
+int32_t
+wav_i8x16_reduce_add_wide(wav_i8x16_t v) {
+  return wav_i32x4_reduce_add(wav_i16x8_extadd_pairwise(wav_i8x16_extadd_pairwise(v)));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+int32_t
+wav_i16x8_reduce_add_wide(wav_i16x8_t v) {
+  return wav_i32x4_reduce_add(wav_i16x8_extadd_pairwise(v));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+uint32_t
+wav_u8x16_reduce_add_wide(wav_u8x16_t v) {
+  return wav_u32x4_reduce_add(wav_u16x8_extadd_pairwise(wav_u8x16_extadd_pairwise(v)));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+uint32_t
+wav_u16x8_reduce_add_wide(wav_u16x8_t v) {
+  return wav_u32x4_reduce_add(wav_u16x8_extadd_pairwise(v));
+}
+
+WAV_OVERLOAD_ATTRIBUTES  int32_t wav_reduce_add_wide(wav_i8x16_t v) { return wav_i8x16_reduce_add_wide(v); }
+WAV_OVERLOAD_ATTRIBUTES  int32_t wav_reduce_add_wide(wav_i16x8_t v) { return wav_i16x8_reduce_add_wide(v); }
+WAV_OVERLOAD_ATTRIBUTES uint32_t wav_reduce_add_wide(wav_u8x16_t v) { return wav_u8x16_reduce_add_wide(v); }
+WAV_OVERLOAD_ATTRIBUTES uint32_t wav_reduce_add_wide(wav_u16x8_t v) { return wav_u16x8_reduce_add_wide(v); }
+
+/* Widen 32-bit lanes to 64 bits and add the two halves together. */
+
+WAV_FUNCTION_ATTRIBUTES
+wav_i64x2_t
+wav_reduce_i32x4_widen_(wav_i32x4_t v) {
+  return wav_i64x2_add(wav_i32x4_extend_low(v), wav_i32x4_extend_high(v));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u64x2_t
+wav_reduce_u32x4_widen_(wav_u32x4_t v) {
+  return wav_u64x2_add(wav_u32x4_extend_low(v), wav_u32x4_extend_high(v));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_i64x2_t
+wav_reduce_i16x8_widen_(wav_i16x8_t v) {
+  return wav_reduce_i32x4_widen_(wav_i16x8_extadd_pairwise(v));
+}
+
+WAV_FUNCTION_ATTRIBUTES
+wav_u64x2_t
+wav_reduce_u16x8_widen_(wav_u16x8_t v) {
+  return wav_reduce_u32x4_widen_(wav_u16x8_extadd_pairwise(v));
+}
+
+/* Sums of 8- and 16-bit lanes.  Each input vector is folded into an
+ * accumulator of twice the lane width with extadd_pairwise, so each
+ * accumulator lane grows by at most 2 * 2^(bits) per vector.  The
+ * input is processed in blocks of BlockVectors vectors (split between
+ * two accumulators, plus up to two more from the tail) which is small
+ * enough that the accumulators can't overflow; after each block they
+ * are widened into the 64-bit total. */
+#define WAV_REDUCE_DEFINE_ARRAY_SUM_NARROW_(Type, Element, Sum, AccType, SumType, BlockVectors) \
+  WAV_KERNEL_ATTRIBUTES \
+  Sum \
+  wav_##Type##_array_sum(const Element * src, size_t len) { \
+    const size_t lanes = sizeof(wav_##Type##_t) / sizeof(Element); \
+    wav_##SumType##_t total = wav_##SumType##_splat(0); \
+    size_t i = 0; \
+    \
+    while (i != len) { \
+      const size_t end = i + ((len - i) < (lanes * BlockVectors) ? (len - i) : (lanes * BlockVectors)); \
+      wav_##AccType##_t acc0 = wav_##AccType##_splat(0); \
+      wav_##AccType##_t acc1 = wav_##AccType##_splat(0); \
+      \
+      for ( ; (end - i) >= (lanes * 2) ; i += lanes * 2) { \
+        acc0 = wav_##AccType##_add(acc0, wav_##Type##_extadd_pairwise(wav_##Type##_loadu(&(src[i        ])))); \
+        acc1 = wav_##AccType##_add(acc1, wav_##Type##_extadd_pairwise(wav_##Type##_loadu(&(src[i + lanes])))); \
+      } \
+      \
+      if ((end - i) >= lanes) { \
+        acc0 = wav_##AccType##_add(acc0, wav_##Type##_extadd_pairwise(wav_##Type##_loadu(&(src[i])))); \
+        i += lanes; \
+      } \
+      \
+      if (i != end) { \
+        acc1 = wav_##AccType##_add(acc1, wav_##Type##_extadd_pairwise(wav_##Type##_load_partial(&(src[i]), end - i))); \
+        i = end; \
+      } \
+      \
+      total = wav_##SumType##_add(total, wav_reduce_##AccType##_widen_(acc0)); \
+      total = wav_##SumType##_add(total, wav_reduce_##AccType##_widen_(acc1)); \
+    } \
+    \
+    return wav_##SumType##_reduce_add(total); \
+  }
+
+/* Sums of 32-bit lanes, which are widened to 64 bits as they are
+ * loaded. */
+#define WAV_REDUCE_DEFINE_ARRAY_SUM_32_(Type, Element, Sum, SumType) \
+  WAV_KERNEL_ATTRIBUTES \
+  Sum \
+  wav_##Type##_array_sum(const Element * src, size_t len) { \
+    const size_t lanes = sizeof(wav_##Type##_t) / sizeof(Element); \
+    wav_##SumType##_t acc0 = wav_##SumType##_splat(0); \
+    wav_##SumType##_t acc1 = wav_##SumType##_splat(0); \
+    size_t i = 0; \
+    \
+    for ( ; (len - i) >= (lanes * 2) ; i += lanes * 2) { \
+      acc0 = wav_##SumType##_add(acc0, wav_reduce_##Type##_widen_(wav_##Type##_loadu(&(src[i        ])))); \
+      acc1 = wav_##SumType##_add(acc1, wav_reduce_##Type##_widen_(wav_##Type##_loadu(&(src[i + lanes])))); \
+    } \
+    \
+    if ((len - i) >= lanes) { \
+      acc0 = wav_##SumType##_add(acc0, wav_reduce_##Type##_widen_(wav_##Type##_loadu(&(src[i])))); \
+      i += lanes; \
+    } \
+    \
+    if (i != len) { \
+      acc1 = wav_##SumType##_add(acc1, wav_reduce_##Type##_widen_(wav_##Type##_load_partial(&(src[i]), len - i))); \
+    } \
+    \
+    return wav_##SumType##_reduce_add(wav_##SumType##_add(acc0, acc1)); \
+  }
+
+/* Sums in the lane type (64-bit integers, which wrap, and floating
+ * point), with four accumulators. */
+#define WAV_REDUCE_DEFINE_ARRAY_SUM_(Type, Element) \
+  WAV_KERNEL_ATTRIBUTES \
+  Element \
+  wav_##Type##_array_sum(const Element * src, size_t len) { \
+    const size_t lanes = sizeof(wav_##Type##_t) / sizeof(Element); \
+    wav_##Type##_t acc0 = wav_##Type##_splat(0); \
+    wav_##Type##_t acc1 = wav_##Type##_splat(0); \
+    wav_##Type##_t acc2 = wav_##Type##_splat(0); \
+    wav_##Type##_t acc3 = wav_##Type##_splat(0); \
+    size_t i = 0; \
+    \
+    for ( ; (len - i) >= (lanes * 4) ; i += lanes * 4) { \
+      acc0 = wav_##Type##_add(acc0, wav_##Type##_loadu(&(src[i + (lanes * 0)]))); \
+      acc1 = wav_##Type##_add(acc1, wav_##Type##_loadu(&(src[i + (lanes * 1)]))); \
+      acc2 = wav_##Type##_add(acc2, wav_##Type##_loadu(&(src[i + (lanes * 2)]))); \
+      acc3 = wav_##Type##_add(acc3, wav_##Type##_loadu(&(src[i + (lanes * 3)]))); \
+    } \
+    \
+    for ( ; (len - i) >= lanes ; i += lanes) { \
+      acc0 = wav_##Type##_add(acc0, wav_##Type##_loadu(&(src[i]))); \
+    } \
+    \
+    if (i != len) { \
+      acc1 = wav_##Type##_add(acc1, wav_##Type##_load_partial(&(src[i]), len - i)); \
+    } \
+    \
+    return wav_##Type##_reduce_add(wav_##Type##_add(wav_##Type##_add(acc0, acc1), wav_##Type##_add(acc2, acc3))); \
+  }
+
+/* With fewer than one vector's worth of elements, each element is
+ * splatted so NaNs are handled exactly like the vector path.  For
+ * longer arrays the tail is handled by re-reading the last full
+ * vector, which overlaps elements we have already seen; that's fine
+ * for min and max. */
+#define WAV_REDUCE_DEFINE_ARRAY_MINMAX_(Type, Element) \
+  WAV_KERNEL_ATTRIBUTES \
+  bool \
+  wav_##Type##_array_minmax(const Element * src, size_t len, Element * min, Element * max) { \
+    const size_t lanes = sizeof(wav_##Type##_t) / sizeof(Element); \
+    wav_##Type##_t min0, max0; \
+    size_t i; \
+    \
+    if (len == 0) { \
+      return false; \
+    } else if (len < lanes) { \
+      min0 = max0 = wav_##Type##_splat(src[0]); \
+      for (i = 1 ; i < len ; i++) { \
+        const wav_##Type##_t v = wav_##Type##_splat(src[i]); \
+        min0 = wav_##Type##_min(min0, v); \
+        max0 = wav_##Type##_max(max0, v); \
+      } \
+    } else { \
+      wav_##Type##_t min1, max1; \
+      min0 = max0 = wav_##Type##_loadu(&(src[len - lanes])); \
+      min1 = max1 = wav_##Type##_loadu(&(src[0])); \
+      \
+      for (i = lanes ; (len - i) >= (lanes * 2) ; i += lanes * 2) { \
+        const wav_##Type##_t v0 = wav_##Type##_loadu(&(src[i        ])); \
+        const wav_##Type##_t v1 = wav_##Type##_loadu(&(src[i + lanes])); \
+        min0 = wav_##Type##_min(min0, v0); \
+        max0 = wav_##Type##_max(max0, v0); \
+        min1 = wav_##Type##_min(min1, v1); \
+        max1 = wav_##Type##_max(max1, v1); \
+      } \
+      \
+      if ((len - i) >= lanes) { \
+        const wav_##Type##_t v = wav_##Type##_loadu(&(src[i])); \
+        min0 = wav_##Type##_min(min0, v); \
+        max0 = wav_##Type##_max(max0, v); \
+      } \
+      \
+      min0 = wav_##Type##_min(min0, min1); \
+      max0 = wav_##Type##_max(max0, max1); \
+    } \
+    \
+    *min = wav_##Type##_reduce_min(min0); \
+    *max = wav_##Type##_reduce_max(max0); \
+    return true; \
+  }
+
+/* wav_*_array_sum -- Sum of an array
+ */
+
+WAV_REDUCE_DEFINE_ARRAY_SUM_NARROW_(i8x16,   int8_t,  int64_t, i16x8, i64x2, 128)
+WAV_REDUCE_DEFINE_ARRAY_SUM_NARROW_(u8x16,  uint8_t, uint64_t, u16x8, u64x2, 128)
+WAV_REDUCE_DEFINE_ARRAY_SUM_NARROW_(i16x8,  int16_t,  int64_t, i32x4, i64x2, 16384)
+WAV_REDUCE_DEFINE_ARRAY_SUM_NARROW_(u16x8, uint16_t, uint64_t, u32x4, u64x2, 16384)
+WAV_REDUCE_DEFINE_ARRAY_SUM_32_(i32x4,  int32_t,  int64_t, i64x2)
+WAV_REDUCE_DEFINE_ARRAY_SUM_32_(u32x4, uint32_t, uint64_t, u64x2)
+WAV_REDUCE_DEFINE_ARRAY_SUM_(i64x2,  int64_t)
+WAV_REDUCE_DEFINE_ARRAY_SUM_(u64x2, uint64_t)
+WAV_REDUCE_DEFINE_ARRAY_SUM_(f32x4,    float)
+WAV_REDUCE_DEFINE_ARRAY_SUM_(f64x2,   double)
+
+WAV_OVERLOAD_ATTRIBUTES  int64_t wav_sum(const   int8_t * src, size_t len) { return wav_i8x16_array_sum(src, len); }
+WAV_OVERLOAD_ATTRIBUTES  int64_t wav_sum(const  int16_t * src, size_t len) { return wav_i16x8_array_sum(src, len); }
+WAV_OVERLOAD_ATTRIBUTES  int64_t wav_sum(const  int32_t * src, size_t len) { return wav_i32x4_array_sum(src, len); }
+WAV_OVERLOAD_ATTRIBUTES  int64_t wav_sum(const  int64_t * src, size_t len) { return wav_i64x2_array_sum(src, len); }
+WAV_OVERLOAD_ATTRIBUTES uint64_t wav_sum(const  uint8_t * src, size_t len) { return wav_u8x16_array_sum(src, len); }
+WAV_OVERLOAD_ATTRIBUTES uint64_t wav_sum(const uint16_t * src, size_t len) { return wav_u16x8_array_sum(src, len); }
+WAV_OVERLOAD_ATTRIBUTES uint64_t wav_sum(const uint32_t * src, size_t len) { return wav_u32x4_array_sum(src, len); }
+WAV_OVERLOAD_ATTRIBUTES uint64_t wav_sum(const uint64_t * src, size_t len) { return wav_u64x2_array_sum(src, len); }
+WAV_OVERLOAD_ATTRIBUTES    float wav_sum(const    float * src, size_t len) { return wav_f32x4_array_sum(src, len); }
+WAV_OVERLOAD_ATTRIBUTES   double wav_sum(const   double * src, size_t len) { return wav_f64x2_array_sum(src, len); }
+
+/* wav_*_array_minmax -- Minimum and maximum of an array
+ */
+
+WAV_REDUCE_DEFINE_ARRAY_MINMAX_(i8x16,   int8_t)
+WAV_REDUCE_DEFINE_ARRAY_MINMAX_(i16x8,  int16_t)
+WAV_REDUCE_DEFINE_ARRAY_MINMAX_(i32x4,  int32_t)
+WAV_REDUCE_DEFINE_ARRAY_MINMAX_(u8x16,  uint8_t)
+WAV_REDUCE_DEFINE_ARRAY_MINMAX_(u16x8, uint16_t)
+WAV_REDUCE_DEFINE_ARRAY_MINMAX_(u32x4, uint32_t)
+WAV_REDUCE_DEFINE_ARRAY_MINMAX_(f32x4,    float)
+WAV_REDUCE_DEFINE_ARRAY_MINMAX_(f64x2,   double)
+
+WAV_OVERLOAD_ATTRIBUTES bool wav_minmax(const   int8_t * src, size_t len,   int8_t * min,   int8_t * max) { return wav_i8x16_array_minmax(src, len, min, max); }
+WAV_OVERLOAD_ATTRIBUTES bool wav_minmax(const  int16_t * src, size_t len,  int16_t * min,  int16_t * max) { return wav_i16x8_array_minmax(src, len, min, max); }
+WAV_OVERLOAD_ATTRIBUTES bool wav_minmax(const  int32_t * src, size_t len,  int32_t * min,  int32_t * max) { return wav_i32x4_array_minmax(src, len, min, max); }
+WAV_OVERLOAD_ATTRIBUTES bool wav_minmax(const  uint8_t * src, size_t len,  uint8_t * min,  uint8_t * max) { return wav_u8x16_array_minmax(src, len, min, max); }
+WAV_OVERLOAD_ATTRIBUTES bool wav_minmax(const uint16_t * src, size_t len, uint16_t * min, uint16_t * max) { return wav_u16x8_array_minmax(src, len, min, max); }
+WAV_OVERLOAD_ATTRIBUTES bool wav_minmax(const uint32_t * src, size_t len, uint32_t * min, uint32_t * max) { return wav_u32x4_array_minmax(src, len, min, max); }
+WAV_OVERLOAD_ATTRIBUTES bool wav_minmax(const    float * src, size_t len,    float * min,    float * max) { return wav_f32x4_array_minmax(src, len, min, max); }
+WAV_OVERLOAD_ATTRIBUTES bool wav_minmax(const   double * src, size_t len,   double * min,   double * max) { return wav_f64x2_array_minmax(src, len, min, max); }
+
+#pragma clang diagnostic pop
+
+#endif /* !defined(WAV_REDUCE_H) */
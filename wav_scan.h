@@ -0,0 +1,257 @@
+/* WAV scans
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* Prefix sums.
+ *
+ * Register-level scans replace each lane with the sum of itself and
+ * all the lanes below it (inclusive) or of just the lanes below it
+ * (exclusive, so lane 0 is zero):
+ *
+ *   wav_u32x4_t wav_u32x4_scan(wav_u32x4_t v);
+ *   wav_u32x4_t wav_u32x4_scan_exclusive(wav_u32x4_t v);
+ *
+ * They take log2(lanes) steps, each of which shifts the vector up by
+ * 1, 2, 4, ... lanes (a shuffle against zero) and adds it to itself.
+ * Integer sums wrap like wav_*_add.
+ *
+ * Buffer-level scans do the same for whole arrays, carrying the
+ * running total from one vector to the next, and return the sum of
+ * all the elements:
+ *
+ *   uint32_t wav_u32x4_array_scan(uint32_t dest[], const uint32_t src[], size_t len);
+ *   uint32_t wav_u32x4_array_scan_exclusive(uint32_t dest[], const uint32_t src[], size_t len);
+ *
+ * dest may be the same as src.  All of these are also available as
+ * wav_scan and wav_scan_exclusive overloads.
+ *
+ * For floating point types the additions within a vector are done in
+ * tree order, so results are generally not bit-identical to a
+ * sequential scalar loop.  The shifted-in lanes are -0.0, not 0.0, so
+ * that they don't change the sign of a zero. */
+
+#if !defined(WAV_SCAN_H)
+#define WAV_SCAN_H
+
+#include <stddef.h>
+#include "wav.h"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc99-extensions"
+#pragma clang diagnostic ignored "-Wc11-extensions"
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#pragma clang diagnostic ignored "-Wold-style-cast"
+#pragma clang diagnostic ignored "-Wcast-align"
+
+/* Log-step scans; z is the additive identity.  Lanes of z are shuffled
+ * in below the shifted copy of v. */
+
+#define WAV_SCAN_STEPS2_(Type, v, z) \
+  v = wav_##Type##_add(v, wav_##Type##_shuffle(z, v, 0, 2))
+
+#define WAV_SCAN_STEPS4_(Type, v, z) \
+  v = wav_##Type##_add(v, wav_##Type##_shuffle(z, v, 0, 4, 5, 6)); \
+  v = wav_##Type##_add(v, wav_##Type##_shuffle(z, v, 0, 1, 4, 5))
+
+#define WAV_SCAN_STEPS8_(Type, v, z) \
+  v = wav_##Type##_add(v, wav_##Type##_shuffle(z, v, 0,  8,  9, 10, 11, 12, 13, 14)); \
+  v = wav_##Type##_add(v, wav_##Type##_shuffle(z, v, 0,  1,  8,  9, 10, 11, 12, 13)); \
+  v = wav_##Type##_add(v, wav_##Type##_shuffle(z, v, 0,  1,  2,  3,  8,  9, 10, 11))
+
+#define WAV_SCAN_STEPS16_(Type, v, z) \
+  v = wav_##Type##_add(v, wav_##Type##_shuffle(z, v, 0, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30)); \
+  v = wav_##Type##_add(v, wav_##Type##_shuffle(z, v, 0,  1, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29)); \
+  v = wav_##Type##_add(v, wav_##Type##_shuffle(z, v, 0,  1,  2,  3, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27)); \
+  v = wav_##Type##_add(v, wav_##Type##_shuffle(z, v, 0,  1,  2,  3,  4,  5,  6,  7, 16, 17, 18, 19, 20, 21, 22, 23))
+
+/* Shift up by a single lane, for exclusive scans. */
+
+#define WAV_SCAN_SHIFT2_(Type, v, z) \
+  wav_##Type##_shuffle(z, v, 0, 2)
+
+#define WAV_SCAN_SHIFT4_(Type, v, z) \
+  wav_##Type##_shuffle(z, v, 0, 4, 5, 6)
+
+#define WAV_SCAN_SHIFT8_(Type, v, z) \
+  wav_##Type##_shuffle(z, v, 0, 8, 9, 10, 11, 12, 13, 14)
+
+#define WAV_SCAN_SHIFT16_(Type, v, z) \
+  wav_##Type##_shuffle(z, v, 0, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30)
+
+/* Broadcast the highest lane, which holds the total after a scan. */
+
+#define WAV_SCAN_LAST2_(Type, v) \
+  wav_##Type##_shuffle(v, v, 1, 1)
+
+#define WAV_SCAN_LAST4_(Type, v) \
+  wav_##Type##_shuffle(v, v, 3, 3, 3, 3)
+
+#define WAV_SCAN_LAST8_(Type, v) \
+  wav_##Type##_shuffle(v, v, 7, 7, 7, 7, 7, 7, 7, 7)
+
+#define WAV_SCAN_LAST16_(Type, v) \
+  wav_##Type##_shuffle(v, v, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15)
+
+#define WAV_SCAN_DEFINE_(Type, Element, Lanes, Identity) \
+  WAV_FUNCTION_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_##Type##_scan(wav_##Type##_t v) { \
+    const wav_##Type##_t z = wav_##Type##_splat(Identity); \
+    WAV_SCAN_STEPS##Lanes##_(Type, v, z); \
+    return v; \
+  } \
+  \
+  WAV_FUNCTION_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_##Type##_scan_exclusive(wav_##Type##_t v) { \
+    const wav_##Type##_t z = wav_##Type##_splat(Identity); \
+    v = wav_##Type##_scan(v); \
+    return WAV_SCAN_SHIFT##Lanes##_(Type, v, z); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_scan(wav_##Type##_t v) { \
+    return wav_##Type##_scan(v); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_scan_exclusive(wav_##Type##_t v) { \
+    return wav_##Type##_scan_exclusive(v); \
+  }
+
+/* The 16 bytes starting at wav_scan_tail_mask_[16 - n] are n bytes of
+ * ones followed by zeros, i.e., a mask of the first n bytes. */
+static const uint8_t wav_scan_tail_mask_[32] = {
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+/* Load the first n elements of src, with the identity in the
+ * remaining lanes. */
+#define WAV_SCAN_LOAD_TAIL_(Type, Element, Bool, Identity, src, n) \
+  wav_##Type##_bitselect( \
+    wav_v128_as_##Bool(wav_u8x16_as_v128(wav_u8x16_loadu(&(wav_scan_tail_mask_[16 - ((n) * sizeof(Element))])))), \
+    wav_##Type##_load_partial((src), (n)), \
+    wav_##Type##_splat(Identity))
+
+/* The scan of each vector is independent of the running total, so
+ * only the final add and the broadcast of the new total are on the
+ * loop-carried dependency chain.  The running total starts out as the
+ * identity (-0.0 for floats, so an array of -0.0 sums to -0.0).  The
+ * tail is loaded with load_partial and the lanes past the end are
+ * replaced with the identity, so the total is still in the highest
+ * lane. */
+#define WAV_SCAN_DEFINE_ARRAY_(Type, Element, Bool, Lanes, Identity) \
+  WAV_KERNEL_ATTRIBUTES \
+  Element \
+  wav_##Type##_array_scan(Element * dest, const Element * src, size_t len) { \
+    wav_##Type##_t carry = wav_##Type##_splat(Identity); \
+    size_t i = 0; \
+    \
+    for ( ; (len - i) >= Lanes ; i += Lanes) { \
+      const wav_##Type##_t v = wav_##Type##_add(wav_##Type##_scan(wav_##Type##_loadu(&(src[i]))), carry); \
+      wav_##Type##_storeu(&(dest[i]), v); \
+      carry = WAV_SCAN_LAST##Lanes##_(Type, v); \
+    } \
+    \
+    if (i != len) { \
+      const wav_##Type##_t v = wav_##Type##_add(wav_##Type##_scan(WAV_SCAN_LOAD_TAIL_(Type, Element, Bool, Identity, &(src[i]), len - i)), carry); \
+      wav_##Type##_store_partial(&(dest[i]), v, len - i); \
+      carry = WAV_SCAN_LAST##Lanes##_(Type, v); \
+    } \
+    \
+    return wav_##Type##_extract_lane(carry, 0); \
+  } \
+  \
+  WAV_KERNEL_ATTRIBUTES \
+  Element \
+  wav_##Type##_array_scan_exclusive(Element * dest, const Element * src, size_t len) { \
+    const wav_##Type##_t z = wav_##Type##_splat(Identity); \
+    wav_##Type##_t carry = wav_##Type##_splat(Identity); \
+    size_t i = 0; \
+    \
+    for ( ; (len - i) >= Lanes ; i += Lanes) { \
+      const wav_##Type##_t v = wav_##Type##_scan(wav_##Type##_loadu(&(src[i]))); \
+      wav_##Type##_storeu(&(dest[i]), wav_##Type##_add(WAV_SCAN_SHIFT##Lanes##_(Type, v, z), carry)); \
+      carry = wav_##Type##_add(WAV_SCAN_LAST##Lanes##_(Type, v), carry); \
+    } \
+    \
+    if (i != len) { \
+      const wav_##Type##_t v = wav_##Type##_scan(WAV_SCAN_LOAD_TAIL_(Type, Element, Bool, Identity, &(src[i]), len - i)); \
+      wav_##Type##_store_partial(&(dest[i]), wav_##Type##_add(WAV_SCAN_SHIFT##Lanes##_(Type, v, z), carry), len - i); \
+      carry = wav_##Type##_add(WAV_SCAN_LAST##Lanes##_(Type, v), carry); \
+    } \
+    \
+    return wav_##Type##_extract_lane(carry, 0); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  Element \
+  wav_scan(Element * dest, const Element * src, size_t len) { \
+    return wav_##Type##_array_scan(dest, src, len); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  Element \
+  wav_scan_exclusive(Element * dest, const Element * src, size_t len) { \
+    return wav_##Type##_array_scan_exclusive(dest, src, len); \
+  }
+
+/* scan, scan_exclusive -- Prefix sums of the lanes of a vector
+ */
+
+WAV_SCAN_DEFINE_(i8x16,   int8_t, 16, 0)
+WAV_SCAN_DEFINE_(i16x8,  int16_t,  8, 0)
+WAV_SCAN_DEFINE_(i32x4,  int32_t,  4, 0)
+WAV_SCAN_DEFINE_(i64x2,  int64_t,  2, 0)
+WAV_SCAN_DEFINE_(u8x16,  uint8_t, 16, 0)
+WAV_SCAN_DEFINE_(u16x8, uint16_t,  8, 0)
+WAV_SCAN_DEFINE_(u32x4, uint32_t,  4, 0)
+WAV_SCAN_DEFINE_(u64x2, uint64_t,  2, 0)
+WAV_SCAN_DEFINE_(f32x4,    float,  4, -0.0f)
+WAV_SCAN_DEFINE_(f64x2,   double,  2, -0.0)
+
+/* array_scan, array_scan_exclusive -- Prefix sums of an array
+ */
+
+WAV_SCAN_DEFINE_ARRAY_(i8x16,   int8_t, b8x16, 16, 0)
+WAV_SCAN_DEFINE_ARRAY_(i16x8,  int16_t, b16x8,  8, 0)
+WAV_SCAN_DEFINE_ARRAY_(i32x4,  int32_t, b32x4,  4, 0)
+WAV_SCAN_DEFINE_ARRAY_(i64x2,  int64_t, b64x2,  2, 0)
+WAV_SCAN_DEFINE_ARRAY_(u8x16,  uint8_t, b8x16, 16, 0)
+WAV_SCAN_DEFINE_ARRAY_(u16x8, uint16_t, b16x8,  8, 0)
+WAV_SCAN_DEFINE_ARRAY_(u32x4, uint32_t, b32x4,  4, 0)
+WAV_SCAN_DEFINE_ARRAY_(u64x2, uint64_t, b64x2,  2, 0)
+WAV_SCAN_DEFINE_ARRAY_(f32x4,    float, b32x4,  4, -0.0f)
+WAV_SCAN_DEFINE_ARRAY_(f64x2,   double, b64x2,  2, -0.0)
+
+#pragma clang diagnostic pop
+
+#endif /* !defined(WAV_SCAN_H) */
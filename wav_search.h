@@ -0,0 +1,237 @@
+/* WAV search
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* k-ary search.
+ *
+ * Binary search does one comparison per cache miss.  A k-ary search
+ * tree instead stores a vector's worth of keys in each node: each step
+ * compares the key being searched for with all of them at once (lt
+ * with a splatted key), and the number of lanes which are less than
+ * the key (bitmask and popcount) picks one of lanes + 1 children.
+ * For u32x4 that's a 5-ary tree, for u16x8 a 9-ary tree.
+ *
+ * First the sorted array is rebuilt into the tree layout, which has
+ * wav_u32x4_kary_size(len) elements (len rounded up to a whole number
+ * of nodes):
+ *
+ *   size_t wav_u32x4_kary_size(size_t len);
+ *   void   wav_u32x4_kary_build(uint32_t tree[], const uint32_t sorted[], size_t len);
+ *
+ * Then lookups return the same index into the sorted array that a
+ * lower bound search would (the number of elements less than key,
+ * so len if they are all smaller):
+ *
+ *   size_t wav_u32x4_kary_lower_bound(const uint32_t tree[], size_t len, uint32_t key);
+ *   void   wav_u32x4_kary_lower_bound_batch(const uint32_t tree[], size_t len, const uint32_t keys[], size_t results[], size_t count);
+ *
+ * len is the length of the original sorted array.  The batched version
+ * walks WAV_SEARCH_BATCH keys down the tree together, so the loads for
+ * different keys are independent and their cache misses overlap.
+ *
+ * Nodes are stored breadth-first, and every level is full except the
+ * last, which is filled from the left; the children of node n are
+ * nodes n * (lanes + 1) + 1 through n * (lanes + 1) + lanes + 1, if
+ * they exist.  The unused slots (fewer than lanes of them, and last
+ * in order) hold the largest value, which is never less than a key so
+ * it doesn't affect the results.  The child picked at each level, as
+ * digits in base lanes + 1, gives the rank the key would have in the
+ * complete tree with the same number of levels; subtracting the
+ * elements of the missing leaves before it gives the index in the
+ * sorted array.  Keeping the tree 16-byte aligned means no node
+ * straddles a cache line. */
+
+#if !defined(WAV_SEARCH_H)
+#define WAV_SEARCH_H
+
+#include <stddef.h>
+#include "wav.h"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc99-extensions"
+#pragma clang diagnostic ignored "-Wc11-extensions"
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#pragma clang diagnostic ignored "-Wold-style-cast"
+#pragma clang diagnostic ignored "-Wcast-align"
+
+#if !defined(WAV_SEARCH_BATCH)
+  #define WAV_SEARCH_BATCH 8
+#endif
+
+/* Count the levels of a tree of nodes nodes, and set *leaves to the
+ * number of nodes in the last one. */
+WAV_FUNCTION_ATTRIBUTES
+size_t
+wav_search_kary_levels_(size_t nodes, size_t lanes, size_t * leaves) {
+  size_t levels = 0;
+  size_t full = 0;
+  size_t level_nodes = 1;
+
+  while (full < nodes) {
+    full += level_nodes;
+    level_nodes *= lanes + 1;
+    levels++;
+  }
+
+  *leaves = nodes - (full - (level_nodes / (lanes + 1)));
+  return levels;
+}
+
+/* r is a position in the complete tree with the same number of levels
+ * (one digit per level, the last digit 0 if the search ran off the
+ * end of the tree); each missing leaf before it would have held lanes
+ * elements. */
+WAV_FUNCTION_ATTRIBUTES
+size_t
+wav_search_kary_rank_(size_t r, size_t lanes, size_t leaves) {
+  const size_t leaf = r / (lanes + 1);
+  return r - (lanes * ((leaf > leaves) ? (leaf - leaves) : 0));
+}
+
+#define WAV_SEARCH_DEFINE_(Type, Element, Bool, Lanes, Max) \
+  WAV_FUNCTION_ATTRIBUTES \
+  size_t \
+  wav_##Type##_kary_size(size_t len) { \
+    return ((len + (Lanes - 1)) / Lanes) * Lanes; \
+  } \
+  \
+  WAV_KERNEL_ATTRIBUTES \
+  void \
+  wav_##Type##_kary_build(Element * tree, const Element * sorted, size_t len) { \
+    const size_t nodes = wav_##Type##_kary_size(len) / Lanes; \
+    size_t leaves; \
+    const size_t levels = wav_search_kary_levels_(nodes, Lanes, &leaves); \
+    size_t first = 0; \
+    size_t level_nodes = 1; \
+    size_t scale = 1; \
+    size_t level; \
+    \
+    for (level = 0 ; level < levels ; level++) { \
+      scale *= Lanes + 1; \
+    } \
+    \
+    /* scale is (lanes + 1) to the power of the number of levels from \
+     * this one down; in the complete tree a node's subtree covers that \
+     * many ranks, and the offset of the node in its level gives its \
+     * first rank.  Subtracting the missing leaves before each slot \
+     * turns that into the rank in this tree. */ \
+    for (level = 0 ; level < levels ; level++) { \
+      const size_t child_scale = scale / (Lanes + 1); \
+      size_t offset, lane; \
+      for (offset = 0 ; offset < level_nodes && (first + offset) < nodes ; offset++) { \
+        for (lane = 0 ; lane < Lanes ; lane++) { \
+          const size_t full_rank = (offset * scale) + ((lane + 1) * child_scale) - 1; \
+          const size_t leaves_before = (child_scale == 1) ? offset : ((offset * child_scale) + ((lane + 1) * (child_scale / (Lanes + 1)))); \
+          const size_t rank = full_rank - (Lanes * ((leaves_before > leaves) ? (leaves_before - leaves) : 0)); \
+          tree[((first + offset) * Lanes) + lane] = (rank < len) ? sorted[rank] : (Max); \
+        } \
+      } \
+      first += level_nodes; \
+      level_nodes *= Lanes + 1; \
+      scale = child_scale; \
+    } \
+  } \
+  \
+  WAV_KERNEL_ATTRIBUTES \
+  size_t \
+  wav_##Type##_kary_lower_bound(const Element * tree, size_t len, Element key) { \
+    const size_t nodes = wav_##Type##_kary_size(len) / Lanes; \
+    const wav_##Type##_t k = wav_##Type##_splat(key); \
+    size_t leaves; \
+    const size_t levels = wav_search_kary_levels_(nodes, Lanes, &leaves); \
+    size_t node = 0; \
+    size_t r = 0; \
+    size_t level; \
+    \
+    for (level = 0 ; level < levels ; level++) { \
+      size_t child = 0; \
+      if (node < nodes) { \
+        const wav_##Type##_t v = wav_##Type##_loadu(&(tree[node * Lanes])); \
+        child = (size_t) __builtin_popcount(wav_##Bool##_bitmask(wav_##Type##_lt(v, k))); \
+      } \
+      r = (r * (Lanes + 1)) + child; \
+      node = (node * (Lanes + 1)) + 1 + child; \
+    } \
+    \
+    return wav_search_kary_rank_(r, Lanes, leaves); \
+  } \
+  \
+  WAV_KERNEL_ATTRIBUTES \
+  void \
+  wav_##Type##_kary_lower_bound_batch(const Element * tree, size_t len, const Element * keys, size_t * results, size_t count) { \
+    const size_t nodes = wav_##Type##_kary_size(len) / Lanes; \
+    size_t leaves; \
+    const size_t levels = wav_search_kary_levels_(nodes, Lanes, &leaves); \
+    size_t i = 0; \
+    \
+    for ( ; (count - i) >= WAV_SEARCH_BATCH ; i += WAV_SEARCH_BATCH) { \
+      wav_##Type##_t k[WAV_SEARCH_BATCH]; \
+      size_t node[WAV_SEARCH_BATCH]; \
+      size_t r[WAV_SEARCH_BATCH]; \
+      size_t level, b; \
+      \
+      for (b = 0 ; b < WAV_SEARCH_BATCH ; b++) { \
+        k[b] = wav_##Type##_splat(keys[i + b]); \
+        node[b] = 0; \
+        r[b] = 0; \
+      } \
+      \
+      /* Every key takes the same number of steps; only the last one \
+       * can run off the end of the tree. */ \
+      for (level = 0 ; level < levels ; level++) { \
+        for (b = 0 ; b < WAV_SEARCH_BATCH ; b++) { \
+          size_t child = 0; \
+          if (node[b] < nodes) { \
+            const wav_##Type##_t v = wav_##Type##_loadu(&(tree[node[b] * Lanes])); \
+            child = (size_t) __builtin_popcount(wav_##Bool##_bitmask(wav_##Type##_lt(v, k[b]))); \
+          } \
+          r[b] = (r[b] * (Lanes + 1)) + child; \
+          node[b] = (node[b] * (Lanes + 1)) + 1 + child; \
+        } \
+      } \
+      \
+      for (b = 0 ; b < WAV_SEARCH_BATCH ; b++) { \
+        results[i + b] = wav_search_kary_rank_(r[b], Lanes, leaves); \
+      } \
+    } \
+    \
+    for ( ; i < count ; i++) { \
+      results[i] = wav_##Type##_kary_lower_bound(tree, len, keys[i]); \
+    } \
+  }
+
+/* kary_size, kary_build, kary_lower_bound, kary_lower_bound_batch --
+ * k-ary search trees
+ */
+
+WAV_SEARCH_DEFINE_(u16x8, uint16_t, b16x8, 8, UINT16_MAX)
+WAV_SEARCH_DEFINE_(u32x4, uint32_t, b32x4, 4, UINT32_MAX)
+
+#pragma clang diagnostic pop
+
+#endif /* !defined(WAV_SEARCH_H) */
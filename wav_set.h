@@ -0,0 +1,336 @@
+/* WAV sets
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* Sorted arrays of 32-bit unsigned integers.
+ *
+ * Set operations on sorted arrays without duplicates (e.g., posting
+ * lists); each returns the number of elements written to dest, which
+ * are also sorted and unique:
+ *
+ *   size_t wav_u32x4_set_intersection(uint32_t dest[], const uint32_t a[], size_t a_len, const uint32_t b[], size_t b_len);
+ *   size_t wav_u32x4_set_union(uint32_t dest[], const uint32_t a[], size_t a_len, const uint32_t b[], size_t b_len);
+ *   size_t wav_u32x4_set_difference(uint32_t dest[], const uint32_t a[], size_t a_len, const uint32_t b[], size_t b_len);
+ *
+ * set_difference returns the elements of a which aren't in b.  There
+ * is also a merge of any two sorted arrays, which keeps duplicates and
+ * always writes a_len + b_len elements:
+ *
+ *   void wav_u32x4_array_merge(uint32_t dest[], const uint32_t a[], size_t a_len, const uint32_t b[], size_t b_len);
+ *
+ * Since whole vectors are stored, dest must have room for a_len
+ * elements for intersection and difference, or a_len + b_len for union
+ * and merge, even if the result is shorter.  For intersection and
+ * difference dest may be the same as a; for union and merge it must
+ * not overlap either input.
+ *
+ * Intersection and difference compare a vector from each array with
+ * every rotation of the other (so all 16 pairs), advance whichever
+ * vector has the smaller last element (or both), and once a vector of
+ * a is finished compress the lanes which should be kept.  When one array is more than
+ * WAV_SET_GALLOP_RATIO times longer than the other, each element of the
+ * short one is instead looked up in the long one with a galloping
+ * search which finishes with a vector compare.  Union and merge use a
+ * bitonic merge of two vectors (see wav_sort.h) to emit four elements
+ * at a time, reading next from whichever array has the smaller next
+ * element; union then drops lanes equal to the one before them. */
+
+#if !defined(WAV_SET_H)
+#define WAV_SET_H
+
+#include <stddef.h>
+#include "wav.h"
+#include "wav_compress.h"
+#include "wav_sort.h"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc99-extensions"
+#pragma clang diagnostic ignored "-Wc11-extensions"
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#pragma clang diagnostic ignored "-Wold-style-cast"
+#pragma clang diagnostic ignored "-Wcast-align"
+
+#if !defined(WAV_SET_GALLOP_RATIO)
+  #define WAV_SET_GALLOP_RATIO 32
+#endif
+
+/* Lanes of a which are equal to any lane of b. */
+WAV_FUNCTION_ATTRIBUTES
+wav_b32x4_t
+wav_u32x4_set_match_(wav_u32x4_t a, wav_u32x4_t b) {
+  return wav_b32x4_or(
+    wav_b32x4_or(
+      wav_u32x4_eq(a, b),
+      wav_u32x4_eq(a, wav_u32x4_shuffle(b, b, 1, 2, 3, 0))
+    ),
+    wav_b32x4_or(
+      wav_u32x4_eq(a, wav_u32x4_shuffle(b, b, 2, 3, 0, 1)),
+      wav_u32x4_eq(a, wav_u32x4_shuffle(b, b, 3, 0, 1, 2))
+    )
+  );
+}
+
+/* Index of the first element of data[start..len) which is >= value.
+ * The step doubles until it overshoots, then a binary search narrows
+ * it down to four elements which are compared at once. */
+WAV_KERNEL_ATTRIBUTES
+size_t
+wav_u32x4_set_lower_bound_(const uint32_t * data, size_t start, size_t len, uint32_t value) {
+  size_t lo, hi, step;
+
+  if ((start >= len) || (data[start] >= value)) {
+    return start;
+  }
+
+  /* data[lo] < value, and the answer is in (lo, hi]. */
+  lo = start;
+  step = 1;
+  while (((len - lo) > step) && (data[lo + step] < value)) {
+    lo += step;
+    step *= 2;
+  }
+  hi = ((len - lo) > step) ? (lo + step) : len;
+
+  while ((hi - lo) > 4) {
+    const size_t mid = lo + ((hi - lo) / 2);
+    if (data[mid] < value) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+
+  if ((len - lo) > 4) {
+    const wav_u32x4_t v = wav_u32x4_loadu(&(data[lo + 1]));
+    return lo + 1 + (size_t) __builtin_popcount(wav_b32x4_bitmask(wav_u32x4_lt(v, wav_u32x4_splat(value))));
+  }
+
+  for (lo++ ; (lo < hi) && (data[lo] < value) ; lo++) { }
+  return lo;
+}
+
+/* Galloping version; keep (intersection) or drop (difference) the
+ * elements of a which are found in b. */
+WAV_KERNEL_ATTRIBUTES
+size_t
+wav_u32x4_set_gallop_(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len, int keep) {
+  size_t n = 0;
+  size_t i;
+  size_t j = 0;
+
+  for (i = 0 ; i < a_len ; i++) {
+    const uint32_t value = a[i];
+    j = wav_u32x4_set_lower_bound_(b, j, b_len, value);
+    if (((j < b_len) && (b[j] == value)) == (keep != 0)) {
+      dest[n++] = value;
+    }
+  }
+
+  return n;
+}
+
+/* Vector version of the above.  A vector of a may be compared with
+ * several vectors of b before we move past it, so matches are
+ * accumulated in found and the vector is only written once a moves
+ * on; at that point at most i elements have been written, so the store
+ * can't go past the end of a (or dest). */
+WAV_KERNEL_ATTRIBUTES
+size_t
+wav_u32x4_set_filter_(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len, int keep) {
+  const wav_b32x4_t none = wav_u32x4_as_b32x4(wav_u32x4_splat(0));
+  wav_b32x4_t found = none;
+  unsigned int found_bits;
+  size_t i = 0;
+  size_t j = 0;
+  size_t n = 0;
+  size_t k;
+
+  while (((a_len - i) >= 4) && ((b_len - j) >= 4)) {
+    const wav_u32x4_t va = wav_u32x4_loadu(&(a[i]));
+    const wav_u32x4_t vb = wav_u32x4_loadu(&(b[j]));
+    const uint32_t a_max = a[i + 3];
+    const uint32_t b_max = b[j + 3];
+
+    found = wav_b32x4_or(found, wav_u32x4_set_match_(va, vb));
+
+    if (a_max <= b_max) {
+      size_t count;
+      wav_u32x4_storeu(&(dest[n]), wav_u32x4_compress(va, keep ? found : wav_b32x4_not(found), &count));
+      n += count;
+      found = none;
+      i += 4;
+    }
+    j += (b_max <= a_max) ? 4 : 0;
+  }
+
+  /* The current vector of a may already have matched earlier elements
+   * of b. */
+  found_bits = wav_b32x4_bitmask(found);
+  for (k = 0 ; i < a_len ; i++, k++) {
+    const uint32_t value = a[i];
+    int match = (k < 4) && ((found_bits >> k) & 1);
+    if (!match) {
+      while ((j < b_len) && (b[j] < value)) {
+        j++;
+      }
+      match = (j < b_len) && (b[j] == value);
+    }
+    if (match == (keep != 0)) {
+      dest[n++] = value;
+    }
+  }
+
+  return n;
+}
+
+/* set_intersection -- Elements in both a and b
+ */
+WAV_KERNEL_ATTRIBUTES
+size_t
+wav_u32x4_set_intersection(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len) {
+  if ((a_len / WAV_SET_GALLOP_RATIO) > b_len) {
+    return wav_u32x4_set_gallop_(dest, b, b_len, a, a_len, 1);
+  } else if ((b_len / WAV_SET_GALLOP_RATIO) > a_len) {
+    return wav_u32x4_set_gallop_(dest, a, a_len, b, b_len, 1);
+  } else {
+    return wav_u32x4_set_filter_(dest, a, a_len, b, b_len, 1);
+  }
+}
+
+/* set_difference -- Elements in a but not in b
+ */
+WAV_KERNEL_ATTRIBUTES
+size_t
+wav_u32x4_set_difference(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len) {
+  if ((b_len / WAV_SET_GALLOP_RATIO) > a_len) {
+    return wav_u32x4_set_gallop_(dest, a, a_len, b, b_len, 0);
+  } else {
+    return wav_u32x4_set_filter_(dest, a, a_len, b, b_len, 0);
+  }
+}
+
+/* Shared by merge and union.  lo and hi hold the 8 smallest elements
+ * which haven't been written yet; after merging them lo is written,
+ * and the next vector is read from the array with the smaller next
+ * element, so nothing still unread can be smaller than hi.  Once that
+ * array has less than a vector left, hi and whatever is left of both
+ * arrays are merged with scalar code. */
+WAV_KERNEL_ATTRIBUTES
+size_t
+wav_u32x4_merge_(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len, int unique) {
+  uint32_t buf[4];
+  uint32_t last = 0;
+  int have_last = 0;
+  size_t i = 0;
+  size_t j = 0;
+  size_t k = 4;
+  size_t n = 0;
+
+  if ((a_len >= 4) && (b_len >= 4)) {
+    wav_u32x4_t lo = wav_u32x4_loadu(&(a[0]));
+    wav_u32x4_t hi = wav_u32x4_loadu(&(b[0]));
+    /* Lane 3 of prev is compared with lane 0 of the first vector, so
+     * it must not be equal to the smallest element. */
+    wav_u32x4_t prev = wav_u32x4_splat(((a[0] < b[0]) ? a[0] : b[0]) - 1);
+    i = 4;
+    j = 4;
+
+    for (;;) {
+      wav_u32x4_merge8(&lo, &hi);
+
+      if (unique) {
+        size_t count;
+        const wav_b32x4_t keep = wav_u32x4_ne(lo, wav_u32x4_shuffle(prev, lo, 3, 4, 5, 6));
+        wav_u32x4_storeu(&(dest[n]), wav_u32x4_compress(lo, keep, &count));
+        n += count;
+        prev = lo;
+      } else {
+        wav_u32x4_storeu(&(dest[n]), lo);
+        n += 4;
+      }
+
+      if ((j == b_len) || ((i < a_len) && (a[i] < b[j]))) {
+        if ((a_len - i) < 4) {
+          break;
+        }
+        lo = wav_u32x4_loadu(&(a[i]));
+        i += 4;
+      } else {
+        if ((b_len - j) < 4) {
+          break;
+        }
+        lo = wav_u32x4_loadu(&(b[j]));
+        j += 4;
+      }
+    }
+
+    wav_u32x4_storeu(buf, hi);
+    k = 0;
+    last = wav_u32x4_extract_lane(lo, 3);
+    have_last = 1;
+  }
+
+  while ((k < 4) || (i < a_len) || (j < b_len)) {
+    uint32_t value;
+    if ((k < 4) && ((i == a_len) || (buf[k] <= a[i])) && ((j == b_len) || (buf[k] <= b[j]))) {
+      value = buf[k++];
+    } else if ((i < a_len) && ((j == b_len) || (a[i] <= b[j]))) {
+      value = a[i++];
+    } else {
+      value = b[j++];
+    }
+
+    if (!unique || !have_last || (value != last)) {
+      dest[n++] = value;
+    }
+    last = value;
+    have_last = 1;
+  }
+
+  return n;
+}
+
+/* set_union -- Elements in either a or b
+ */
+WAV_KERNEL_ATTRIBUTES
+size_t
+wav_u32x4_set_union(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len) {
+  return wav_u32x4_merge_(dest, a, a_len, b, b_len, 1);
+}
+
+/* array_merge -- Merge two sorted arrays
+ */
+WAV_KERNEL_ATTRIBUTES
+void
+wav_u32x4_array_merge(uint32_t * dest, const uint32_t * a, size_t a_len, const uint32_t * b, size_t b_len) {
+  wav_u32x4_merge_(dest, a, a_len, b, b_len, 0);
+}
+
+#pragma clang diagnostic pop
+
+#endif /* !defined(WAV_SET_H) */
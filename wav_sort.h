@@ -0,0 +1,526 @@
+/* WAV sorting
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* Sorting networks.
+ *
+ * Register-level sorts, built from wav_*_min, wav_*_max, and shuffles,
+ * for i32x4, u32x4, and f32x4 (names use the number of elements):
+ *
+ *   wav_i32x4_t wav_i32x4_sort4(wav_i32x4_t v);
+ *   void        wav_i32x4_sort8(wav_i32x4_t * a, wav_i32x4_t * b);
+ *   void        wav_i32x4_sort16(wav_i32x4_t * a, wav_i32x4_t * b, wav_i32x4_t * c, wav_i32x4_t * d);
+ *
+ * and likewise wav_i16x8_sort8, wav_i16x8_sort16, and wav_i16x8_sort32
+ * for i16x8 and u16x8.  Multi-register sorts treat the registers as one
+ * sequence, lowest lanes of the first register first, and sort it in
+ * place in ascending order.
+ *
+ * The merge functions take two sorted sequences of one or two registers
+ * each (a or a, b; then b or c, d) and leave the combined sequence
+ * sorted across all the registers:
+ *
+ *   void wav_i32x4_merge8(wav_i32x4_t * a, wav_i32x4_t * b);
+ *   void wav_i32x4_merge16(wav_i32x4_t * a, wav_i32x4_t * b, wav_i32x4_t * c, wav_i32x4_t * d);
+ *
+ * All of these are also available as wav_sort and wav_merge overloads
+ * (the number of arguments selects the size).
+ *
+ * A single register is sorted with an optimal network (3 layers for
+ * 4 lanes, 6 for 8), where each layer is a shuffle to line up the
+ * pairs being compared, a min and a max, and a shuffle to pick the
+ * lower or upper result for each lane.  Larger sorts use bitonic
+ * merges: the second sequence is reversed and compared with the
+ * first, then each half is cleaned up within its registers.
+ *
+ * Whole arrays are sorted with a quicksort which partitions a vector
+ * at a time (compare, bitmask, and a swizzle from a small table) and
+ * finishes partitions of up to 16 elements with the networks above
+ * (insertion sort for 64-bit types, which have no vector min or max):
+ *
+ *   void wav_u32x4_array_sort(uint32_t data[], size_t len);
+ *
+ * It's available for i32x4, u32x4, f32x4, i64x2, and u64x2, and as a
+ * wav_sort overload.  It isn't stable, and falls back on heapsort if
+ * partitioning goes badly.
+ *
+ * For f32x4, wav_f32x4_min and wav_f32x4_max order -0.0 before 0.0,
+ * though the array sort may not (it considers them equal when
+ * partitioning).  NaN isn't supported; the networks let it overwrite
+ * other lanes. */
+
+#if !defined(WAV_SORT_H)
+#define WAV_SORT_H
+
+#include <stddef.h>
+#include "wav.h"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc99-extensions"
+#pragma clang diagnostic ignored "-Wc11-extensions"
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#pragma clang diagnostic ignored "-Wold-style-cast"
+#pragma clang diagnostic ignored "-Wcast-align"
+
+/* One layer of comparators.  p is the lane each lane is compared
+ * with, and s selects the min (s < lanes) or max (s >= lanes) for
+ * each lane. */
+
+#define WAV_SORT_LAYER4_(Type, v, p0, p1, p2, p3, s0, s1, s2, s3) { \
+    const wav_##Type##_t p_ = wav_##Type##_shuffle(v, v, p0, p1, p2, p3); \
+    v = wav_##Type##_shuffle(wav_##Type##_min(v, p_), wav_##Type##_max(v, p_), s0, s1, s2, s3); \
+  }
+
+#define WAV_SORT_LAYER8_(Type, v, p0, p1, p2, p3, p4, p5, p6, p7, s0, s1, s2, s3, s4, s5, s6, s7) { \
+    const wav_##Type##_t p_ = wav_##Type##_shuffle(v, v, p0, p1, p2, p3, p4, p5, p6, p7); \
+    v = wav_##Type##_shuffle(wav_##Type##_min(v, p_), wav_##Type##_max(v, p_), s0, s1, s2, s3, s4, s5, s6, s7); \
+  }
+
+/* Sort the lanes of a single register:
+ *   4 lanes: [0:1 2:3] [0:2 1:3] [1:2]
+ *   8 lanes: [0:2 1:3 4:6 5:7] [0:4 1:5 2:6 3:7] [0:1 2:3 4:5 6:7]
+ *            [2:4 3:5] [1:4 3:6] [1:2 3:4 5:6] */
+
+#define WAV_SORT_NETWORK4_(Type, v) \
+  WAV_SORT_LAYER4_(Type, v, 1, 0, 3, 2,  0, 5, 2, 7) \
+  WAV_SORT_LAYER4_(Type, v, 2, 3, 0, 1,  0, 1, 6, 7) \
+  WAV_SORT_LAYER4_(Type, v, 0, 2, 1, 3,  0, 1, 6, 3)
+
+#define WAV_SORT_NETWORK8_(Type, v) \
+  WAV_SORT_LAYER8_(Type, v, 2, 3, 0, 1, 6, 7, 4, 5,  0, 1, 10, 11,  4,  5, 14, 15) \
+  WAV_SORT_LAYER8_(Type, v, 4, 5, 6, 7, 0, 1, 2, 3,  0, 1,  2,  3, 12, 13, 14, 15) \
+  WAV_SORT_LAYER8_(Type, v, 1, 0, 3, 2, 5, 4, 7, 6,  0, 9,  2, 11,  4, 13,  6, 15) \
+  WAV_SORT_LAYER8_(Type, v, 0, 1, 4, 5, 2, 3, 6, 7,  0, 1,  2,  3, 12, 13,  6,  7) \
+  WAV_SORT_LAYER8_(Type, v, 0, 4, 2, 6, 1, 5, 3, 7,  0, 1,  2,  3, 12,  5, 14,  7) \
+  WAV_SORT_LAYER8_(Type, v, 0, 2, 1, 4, 3, 6, 5, 7,  0, 1, 10,  3, 12,  5, 14,  7)
+
+/* Sort a bitonic register (half cleaners at distance lanes/2, ..., 1). */
+
+#define WAV_SORT_CLEAN4_(Type, v) \
+  WAV_SORT_LAYER4_(Type, v, 2, 3, 0, 1,  0, 1, 6, 7) \
+  WAV_SORT_LAYER4_(Type, v, 1, 0, 3, 2,  0, 5, 2, 7)
+
+#define WAV_SORT_CLEAN8_(Type, v) \
+  WAV_SORT_LAYER8_(Type, v, 4, 5, 6, 7, 0, 1, 2, 3,  0, 1,  2,  3, 12, 13, 14, 15) \
+  WAV_SORT_LAYER8_(Type, v, 2, 3, 0, 1, 6, 7, 4, 5,  0, 1, 10, 11,  4,  5, 14, 15) \
+  WAV_SORT_LAYER8_(Type, v, 1, 0, 3, 2, 5, 4, 7, 6,  0, 9,  2, 11,  4, 13,  6, 15)
+
+#define WAV_SORT_REVERSE4_(Type, v) \
+  wav_##Type##_shuffle(v, v, 3, 2, 1, 0)
+
+#define WAV_SORT_REVERSE8_(Type, v) \
+  wav_##Type##_shuffle(v, v, 7, 6, 5, 4, 3, 2, 1, 0)
+
+#define WAV_SORT_DEFINE_(Type, Lanes, N1, N2, N4) \
+  WAV_FUNCTION_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_##Type##_sort_bitonic_(wav_##Type##_t v) { \
+    WAV_SORT_CLEAN##Lanes##_(Type, v) \
+    return v; \
+  } \
+  \
+  WAV_FUNCTION_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_##Type##_sort##N1(wav_##Type##_t v) { \
+    WAV_SORT_NETWORK##Lanes##_(Type, v) \
+    return v; \
+  } \
+  \
+  WAV_FUNCTION_ATTRIBUTES \
+  void \
+  wav_##Type##_merge##N2(wav_##Type##_t * a, wav_##Type##_t * b) { \
+    const wav_##Type##_t r = WAV_SORT_REVERSE##Lanes##_(Type, *b); \
+    const wav_##Type##_t lo = wav_##Type##_min(*a, r); \
+    const wav_##Type##_t hi = wav_##Type##_max(*a, r); \
+    *a = wav_##Type##_sort_bitonic_(lo); \
+    *b = wav_##Type##_sort_bitonic_(hi); \
+  } \
+  \
+  WAV_FUNCTION_ATTRIBUTES \
+  void \
+  wav_##Type##_sort##N2(wav_##Type##_t * a, wav_##Type##_t * b) { \
+    *a = wav_##Type##_sort##N1(*a); \
+    *b = wav_##Type##_sort##N1(*b); \
+    wav_##Type##_merge##N2(a, b); \
+  } \
+  \
+  WAV_FUNCTION_ATTRIBUTES \
+  void \
+  wav_##Type##_merge##N4(wav_##Type##_t * a, wav_##Type##_t * b, wav_##Type##_t * c, wav_##Type##_t * d) { \
+    const wav_##Type##_t rd = WAV_SORT_REVERSE##Lanes##_(Type, *d); \
+    const wav_##Type##_t rc = WAV_SORT_REVERSE##Lanes##_(Type, *c); \
+    const wav_##Type##_t lo0 = wav_##Type##_min(*a, rd); \
+    const wav_##Type##_t lo1 = wav_##Type##_min(*b, rc); \
+    const wav_##Type##_t hi0 = wav_##Type##_max(*a, rd); \
+    const wav_##Type##_t hi1 = wav_##Type##_max(*b, rc); \
+    *a = wav_##Type##_sort_bitonic_(wav_##Type##_min(lo0, lo1)); \
+    *b = wav_##Type##_sort_bitonic_(wav_##Type##_max(lo0, lo1)); \
+    *c = wav_##Type##_sort_bitonic_(wav_##Type##_min(hi0, hi1)); \
+    *d = wav_##Type##_sort_bitonic_(wav_##Type##_max(hi0, hi1)); \
+  } \
+  \
+  WAV_FUNCTION_ATTRIBUTES \
+  void \
+  wav_##Type##_sort##N4(wav_##Type##_t * a, wav_##Type##_t * b, wav_##Type##_t * c, wav_##Type##_t * d) { \
+    wav_##Type##_sort##N2(a, b); \
+    wav_##Type##_sort##N2(c, d); \
+    wav_##Type##_merge##N4(a, b, c, d); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  wav_##Type##_t \
+  wav_sort(wav_##Type##_t v) { \
+    return wav_##Type##_sort##N1(v); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  void \
+  wav_sort(wav_##Type##_t * a, wav_##Type##_t * b) { \
+    wav_##Type##_sort##N2(a, b); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  void \
+  wav_sort(wav_##Type##_t * a, wav_##Type##_t * b, wav_##Type##_t * c, wav_##Type##_t * d) { \
+    wav_##Type##_sort##N4(a, b, c, d); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  void \
+  wav_merge(wav_##Type##_t * a, wav_##Type##_t * b) { \
+    wav_##Type##_merge##N2(a, b); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  void \
+  wav_merge(wav_##Type##_t * a, wav_##Type##_t * b, wav_##Type##_t * c, wav_##Type##_t * d) { \
+    wav_##Type##_merge##N4(a, b, c, d); \
+  }
+
+/* sort, merge -- Sorting networks
+ */
+
+WAV_SORT_DEFINE_(i16x8, 8, 8, 16, 32)
+WAV_SORT_DEFINE_(i32x4, 4, 4,  8, 16)
+WAV_SORT_DEFINE_(u16x8, 8, 8, 16, 32)
+WAV_SORT_DEFINE_(u32x4, 4, 4,  8, 16)
+WAV_SORT_DEFINE_(f32x4, 4, 4,  8, 16)
+
+/* Array sorting.
+ *
+ * Everything below implements wav_*_array_sort, a quicksort which
+ * partitions a vector at a time: compare with the pivot, turn the
+ * result into a bitmask, and use it to look up a swizzle which moves
+ * the lanes which belong on the left below the ones which belong on
+ * the right. */
+
+/* For each 4-bit mask (a lane per 32 bits; 64-bit lanes just use two
+ * bits each), byte indices for a swizzle which puts the lanes whose
+ * bit is clear first and the lanes whose bit is set last. */
+static const uint8_t wav_sort_partition_table_[16][16] = {
+  {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+  {  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,  0,  1,  2,  3 },
+  {  0,  1,  2,  3,  8,  9, 10, 11, 12, 13, 14, 15,  4,  5,  6,  7 },
+  {  8,  9, 10, 11, 12, 13, 14, 15,  0,  1,  2,  3,  4,  5,  6,  7 },
+  {  0,  1,  2,  3,  4,  5,  6,  7, 12, 13, 14, 15,  8,  9, 10, 11 },
+  {  4,  5,  6,  7, 12, 13, 14, 15,  0,  1,  2,  3,  8,  9, 10, 11 },
+  {  0,  1,  2,  3, 12, 13, 14, 15,  4,  5,  6,  7,  8,  9, 10, 11 },
+  { 12, 13, 14, 15,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11 },
+  {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+  {  4,  5,  6,  7,  8,  9, 10, 11,  0,  1,  2,  3, 12, 13, 14, 15 },
+  {  0,  1,  2,  3,  8,  9, 10, 11,  4,  5,  6,  7, 12, 13, 14, 15 },
+  {  8,  9, 10, 11,  0,  1,  2,  3,  4,  5,  6,  7, 12, 13, 14, 15 },
+  {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+  {  4,  5,  6,  7,  0,  1,  2,  3,  8,  9, 10, 11, 12, 13, 14, 15 },
+  {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+  {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 }
+};
+
+/* Partitions of this many elements or fewer are sorted directly, with
+ * sorting networks for 32-bit types and insertion sort for 64-bit. */
+#define WAV_SORT_SMALL_ 16
+
+/* Move the elements of data[left..right) for which `element Operator
+ * pivot` is true to the end, and return the index of the first one.
+ * right - left must be greater than WAV_SORT_SMALL_.
+ *
+ * First a few elements are swapped with scalar code so the rest is a
+ * whole number of vectors.  Then one vector from each end is held in
+ * registers, which leaves a vector's worth of free space at both ends
+ * of the unread part of the array.  Each vector which is read is
+ * permuted and stored twice, at the next free position on the left
+ * (so its left elements land in place) and at the last free position
+ * on the right (so its right elements do), always reading from
+ * whichever side has less free space so neither store can clobber an
+ * element which hasn't been read yet.  The two held vectors fill the
+ * space which is left at the end. */
+#define WAV_SORT_DEFINE_PARTITION_(Type, Element, Bool, Operation, Operator) \
+  WAV_FUNCTION_ATTRIBUTES \
+  size_t \
+  wav_##Type##_partition_store_##Operation##_(Element * data, size_t * l_store, size_t * r_store, wav_##Type##_t v, wav_##Type##_t pivot) { \
+    const size_t lanes = sizeof(wav_##Type##_t) / sizeof(Element); \
+    const unsigned int bits = wav_u32x4_bitmask(wav_##Bool##_as_u32x4(wav_##Type##_##Operation(v, pivot))); \
+    const size_t right = (size_t) __builtin_popcount(bits) / (sizeof(Element) / 4); \
+    const wav_u8x16_t indices = wav_u8x16_loadu(wav_sort_partition_table_[bits]); \
+    v = wav_u8x16_as_##Type(wav_u8x16_swizzle(wav_##Type##_as_u8x16(v), indices)); \
+    wav_##Type##_storeu(&(data[*l_store]), v); \
+    wav_##Type##_storeu(&(data[*r_store - lanes]), v); \
+    *l_store += lanes - right; \
+    *r_store -= right; \
+    return right; \
+  } \
+  \
+  WAV_KERNEL_ATTRIBUTES \
+  size_t \
+  wav_##Type##_partition_##Operation##_(Element * data, size_t left, size_t right, Element pivot) { \
+    const size_t lanes = sizeof(wav_##Type##_t) / sizeof(Element); \
+    const wav_##Type##_t pv = wav_##Type##_splat(pivot); \
+    wav_##Type##_t vl, vr; \
+    size_t l_store, r_store; \
+    size_t i; \
+    \
+    for (i = (right - left) % lanes ; i != 0 ; i--) { \
+      if (data[left] Operator pivot) { \
+        const Element t = data[left]; \
+        data[left] = data[--right]; \
+        data[right] = t; \
+      } else { \
+        left++; \
+      } \
+    } \
+    \
+    vl = wav_##Type##_loadu(&(data[left])); \
+    vr = wav_##Type##_loadu(&(data[right - lanes])); \
+    l_store = left; \
+    r_store = right; \
+    left += lanes; \
+    right -= lanes; \
+    \
+    while (left != right) { \
+      wav_##Type##_t v; \
+      if ((r_store - right) < (left - l_store)) { \
+        right -= lanes; \
+        v = wav_##Type##_loadu(&(data[right])); \
+      } else { \
+        v = wav_##Type##_loadu(&(data[left])); \
+        left += lanes; \
+      } \
+      wav_##Type##_partition_store_##Operation##_(data, &l_store, &r_store, v, pv); \
+    } \
+    \
+    wav_##Type##_partition_store_##Operation##_(data, &l_store, &r_store, vl, pv); \
+    wav_##Type##_partition_store_##Operation##_(data, &l_store, &r_store, vr, pv); \
+    \
+    return l_store; \
+  }
+
+/* Fallback if partitioning goes badly, so the worst case is still
+ * O(n log n). */
+#define WAV_SORT_DEFINE_HEAPSORT_(Type, Element) \
+  WAV_KERNEL_ATTRIBUTES \
+  void \
+  wav_##Type##_heapsort_(Element * data, size_t len) { \
+    size_t start = len / 2; \
+    size_t end = len; \
+    \
+    while (end > 1) { \
+      size_t root, child; \
+      if (start > 0) { \
+        start--; \
+      } else { \
+        const Element t = data[--end]; \
+        data[end] = data[0]; \
+        data[0] = t; \
+      } \
+      \
+      for (root = start ; (child = (root * 2) + 1) < end ; root = child) { \
+        Element t; \
+        if (((child + 1) < end) && (data[child] < data[child + 1])) { \
+          child++; \
+        } \
+        if (!(data[root] < data[child])) { \
+          break; \
+        } \
+        t = data[root]; \
+        data[root] = data[child]; \
+        data[child] = t; \
+      } \
+    } \
+  }
+
+/* Pad to a whole number of registers with the largest value, and use
+ * the smallest network which fits. */
+#define WAV_SORT_DEFINE_SMALL_NETWORK_(Type, Element, Max) \
+  WAV_KERNEL_ATTRIBUTES \
+  void \
+  wav_##Type##_sort_small_(Element * data, size_t len) { \
+    Element buf[16]; \
+    wav_##Type##_t a, b, c, d; \
+    size_t i; \
+    \
+    for (i = 0 ; i < 16 ; i++) { \
+      buf[i] = (i < len) ? data[i] : (Max); \
+    } \
+    \
+    a = wav_##Type##_loadu(&(buf[ 0])); \
+    b = wav_##Type##_loadu(&(buf[ 4])); \
+    if (len <= 4) { \
+      a = wav_##Type##_sort4(a); \
+    } else if (len <= 8) { \
+      wav_##Type##_sort8(&a, &b); \
+    } else { \
+      c = wav_##Type##_loadu(&(buf[ 8])); \
+      d = wav_##Type##_loadu(&(buf[12])); \
+      wav_##Type##_sort16(&a, &b, &c, &d); \
+      wav_##Type##_storeu(&(buf[ 8]), c); \
+      wav_##Type##_storeu(&(buf[12]), d); \
+    } \
+    wav_##Type##_storeu(&(buf[ 0]), a); \
+    wav_##Type##_storeu(&(buf[ 4]), b); \
+    \
+    for (i = 0 ; i < len ; i++) { \
+      data[i] = buf[i]; \
+    } \
+  }
+
+#define WAV_SORT_DEFINE_SMALL_INSERTION_(Type, Element) \
+  WAV_KERNEL_ATTRIBUTES \
+  void \
+  wav_##Type##_sort_small_(Element * data, size_t len) { \
+    size_t i, j; \
+    \
+    for (i = 1 ; i < len ; i++) { \
+      const Element t = data[i]; \
+      for (j = i ; (j > 0) && (t < data[j - 1]) ; j--) { \
+        data[j] = data[j - 1]; \
+      } \
+      data[j] = t; \
+    } \
+  }
+
+/* The pivot is the median of the first, middle, and last elements, so
+ * it's always in the range; everything >= pivot goes right, so the
+ * right side is never empty.  If the left side is empty (the pivot is
+ * the smallest element) the elements equal to the pivot are split off
+ * instead, since they're already in their final position.  The
+ * smaller side is sorted recursively and the larger one iteratively,
+ * which bounds the stack depth. */
+#define WAV_SORT_DEFINE_ARRAY_(Type, Element) \
+  WAV_KERNEL_ATTRIBUTES \
+  void \
+  wav_##Type##_quicksort_(Element * data, size_t len, unsigned int depth) { \
+    while (len > WAV_SORT_SMALL_) { \
+      const Element x = data[0]; \
+      const Element y = data[len / 2]; \
+      const Element z = data[len - 1]; \
+      Element pivot; \
+      size_t p; \
+      \
+      if (depth-- == 0) { \
+        wav_##Type##_heapsort_(data, len); \
+        return; \
+      } \
+      \
+      if (x < y) { \
+        pivot = (y < z) ? y : ((x < z) ? z : x); \
+      } else { \
+        pivot = (x < z) ? x : ((y < z) ? z : y); \
+      } \
+      \
+      p = wav_##Type##_partition_ge_(data, 0, len, pivot); \
+      if (p == 0) { \
+        p = wav_##Type##_partition_ne_(data, 0, len, pivot); \
+        data += p; \
+        len -= p; \
+      } else if (p < (len - p)) { \
+        wav_##Type##_quicksort_(data, p, depth); \
+        data += p; \
+        len -= p; \
+      } else { \
+        wav_##Type##_quicksort_(data + p, len - p, depth); \
+        len = p; \
+      } \
+    } \
+    \
+    wav_##Type##_sort_small_(data, len); \
+  } \
+  \
+  WAV_KERNEL_ATTRIBUTES \
+  void \
+  wav_##Type##_array_sort(Element * data, size_t len) { \
+    unsigned int depth = 0; \
+    size_t n; \
+    \
+    for (n = len ; n > 1 ; n >>= 1) { \
+      depth += 2; \
+    } \
+    \
+    wav_##Type##_quicksort_(data, len, depth); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  void \
+  wav_sort(Element * data, size_t len) { \
+    wav_##Type##_array_sort(data, len); \
+  }
+
+WAV_SORT_DEFINE_PARTITION_(i32x4,  int32_t, b32x4, ge, >=)
+WAV_SORT_DEFINE_PARTITION_(i32x4,  int32_t, b32x4, ne, !=)
+WAV_SORT_DEFINE_PARTITION_(i64x2,  int64_t, b64x2, ge, >=)
+WAV_SORT_DEFINE_PARTITION_(i64x2,  int64_t, b64x2, ne, !=)
+WAV_SORT_DEFINE_PARTITION_(u32x4, uint32_t, b32x4, ge, >=)
+WAV_SORT_DEFINE_PARTITION_(u32x4, uint32_t, b32x4, ne, !=)
+WAV_SORT_DEFINE_PARTITION_(u64x2, uint64_t, b64x2, ge, >=)
+WAV_SORT_DEFINE_PARTITION_(u64x2, uint64_t, b64x2, ne, !=)
+WAV_SORT_DEFINE_PARTITION_(f32x4,    float, b32x4, ge, >=)
+WAV_SORT_DEFINE_PARTITION_(f32x4,    float, b32x4, ne, !=)
+
+WAV_SORT_DEFINE_HEAPSORT_(i32x4,  int32_t)
+WAV_SORT_DEFINE_HEAPSORT_(i64x2,  int64_t)
+WAV_SORT_DEFINE_HEAPSORT_(u32x4, uint32_t)
+WAV_SORT_DEFINE_HEAPSORT_(u64x2, uint64_t)
+WAV_SORT_DEFINE_HEAPSORT_(f32x4,    float)
+
+WAV_SORT_DEFINE_SMALL_NETWORK_(i32x4,  int32_t, INT32_MAX)
+WAV_SORT_DEFINE_SMALL_INSERTION_(i64x2,  int64_t)
+WAV_SORT_DEFINE_SMALL_NETWORK_(u32x4, uint32_t, UINT32_MAX)
+WAV_SORT_DEFINE_SMALL_INSERTION_(u64x2, uint64_t)
+WAV_SORT_DEFINE_SMALL_NETWORK_(f32x4,    float, __builtin_inff())
+
+/* array_sort -- Sort an array in ascending order
+ */
+
+WAV_SORT_DEFINE_ARRAY_(i32x4,  int32_t)
+WAV_SORT_DEFINE_ARRAY_(i64x2,  int64_t)
+WAV_SORT_DEFINE_ARRAY_(u32x4, uint32_t)
+WAV_SORT_DEFINE_ARRAY_(u64x2, uint64_t)
+WAV_SORT_DEFINE_ARRAY_(f32x4,    float)
+
+#pragma clang diagnostic pop
+
+#endif /* !defined(WAV_SORT_H) */
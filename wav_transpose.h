@@ -0,0 +1,226 @@
+/* WAV transpose
+ * <https://github.com/nemequ/wav>
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Copyright:
+ *   2021      Evan Nemerson <evan@nemerson.com>
+ * */
+
+/* Matrix transposes.
+ *
+ * Register-level transposes treat an array of vectors as the rows of
+ * a square matrix (4x4 for 32-bit lanes, 8x8 for 16-bit, 16x16 for
+ * 8-bit, and 2x2 for 64-bit) and transpose it in place:
+ *
+ *   void wav_f32x4_transpose(wav_f32x4_t rows[4]);
+ *   void wav_i16x8_transpose(wav_i16x8_t rows[8]);
+ *   void wav_u8x16_transpose(wav_u8x16_t rows[16]);
+ *
+ * Each of the log2(lanes) steps interleaves the low halves, and the
+ * high halves, of row i and row i + lanes / 2 into rows 2i and 2i + 1.
+ * Every output lane depends on as many inputs as there are lanes, so
+ * with two-input shuffles that is the minimum: 8 shuffles for 4x4, 24
+ * for 8x8, and 64 for 16x16.
+ *
+ * Buffer-level transposes work on row-major matrices of any size:
+ *
+ *   void wav_f32x4_array_transpose(float dest[], const float src[], size_t rows, size_t cols);
+ *
+ * src has rows rows of cols elements, and dest gets cols rows of rows
+ * elements; they must not overlap.  The matrix is processed in tiles
+ * of WAV_TRANSPOSE_TILE x WAV_TRANSPOSE_TILE elements so the rows of
+ * both src and dest being touched stay in cache, and each tile in
+ * blocks of one register-level transpose.  Elements which don't fill
+ * a whole block (at the right and bottom edges) are copied one at a
+ * time.  All of these are also available as wav_transpose overloads. */
+
+#if !defined(WAV_TRANSPOSE_H)
+#define WAV_TRANSPOSE_H
+
+#include <stddef.h>
+#include "wav.h"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc99-extensions"
+#pragma clang diagnostic ignored "-Wc11-extensions"
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#pragma clang diagnostic ignored "-Wold-style-cast"
+#pragma clang diagnostic ignored "-Wcast-align"
+
+#if !defined(WAV_TRANSPOSE_TILE)
+  #define WAV_TRANSPOSE_TILE 64
+#endif
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u8x16_transpose(wav_u8x16_t rows[16]) {
+  wav_u8x16_t t[16];
+  int step, i;
+
+  for (step = 0 ; step < 4 ; step++) {
+    for (i = 0 ; i < 8 ; i++) {
+      t[(i * 2)    ] = wav_u8x16_shuffle(rows[i], rows[i + 8], 0, 16, 1, 17, 2, 18, 3, 19,  4, 20,  5, 21,  6, 22,  7, 23);
+      t[(i * 2) + 1] = wav_u8x16_shuffle(rows[i], rows[i + 8], 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+    }
+    for (i = 0 ; i < 16 ; i++) {
+      rows[i] = t[i];
+    }
+  }
+}
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u16x8_transpose(wav_u16x8_t rows[8]) {
+  wav_u16x8_t t[8];
+  int step, i;
+
+  for (step = 0 ; step < 3 ; step++) {
+    for (i = 0 ; i < 4 ; i++) {
+      t[(i * 2)    ] = wav_u16x8_shuffle(rows[i], rows[i + 4], 0,  8, 1,  9, 2, 10, 3, 11);
+      t[(i * 2) + 1] = wav_u16x8_shuffle(rows[i], rows[i + 4], 4, 12, 5, 13, 6, 14, 7, 15);
+    }
+    for (i = 0 ; i < 8 ; i++) {
+      rows[i] = t[i];
+    }
+  }
+}
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u32x4_transpose(wav_u32x4_t rows[4]) {
+  wav_u32x4_t t[4];
+  int step, i;
+
+  for (step = 0 ; step < 2 ; step++) {
+    for (i = 0 ; i < 2 ; i++) {
+      t[(i * 2)    ] = wav_u32x4_shuffle(rows[i], rows[i + 2], 0, 4, 1, 5);
+      t[(i * 2) + 1] = wav_u32x4_shuffle(rows[i], rows[i + 2], 2, 6, 3, 7);
+    }
+    for (i = 0 ; i < 4 ; i++) {
+      rows[i] = t[i];
+    }
+  }
+}
+
+WAV_FUNCTION_ATTRIBUTES
+void
+wav_u64x2_transpose(wav_u64x2_t rows[2]) {
+  const wav_u64x2_t t = wav_u64x2_shuffle(rows[0], rows[1], 0, 2);
+  rows[1] = wav_u64x2_shuffle(rows[0], rows[1], 1, 3);
+  rows[0] = t;
+}
+
+#define WAV_TRANSPOSE_DEFINE_(Type, Unsigned, Lanes) \
+  WAV_FUNCTION_ATTRIBUTES \
+  void \
+  wav_##Type##_transpose(wav_##Type##_t rows[Lanes]) { \
+    wav_##Unsigned##_t u[Lanes]; \
+    int i; \
+    for (i = 0 ; i < Lanes ; i++) { \
+      u[i] = wav_##Type##_as_##Unsigned(rows[i]); \
+    } \
+    wav_##Unsigned##_transpose(u); \
+    for (i = 0 ; i < Lanes ; i++) { \
+      rows[i] = wav_##Unsigned##_as_##Type(u[i]); \
+    } \
+  }
+
+WAV_TRANSPOSE_DEFINE_(i8x16, u8x16, 16)
+WAV_TRANSPOSE_DEFINE_(i16x8, u16x8,  8)
+WAV_TRANSPOSE_DEFINE_(i32x4, u32x4,  4)
+WAV_TRANSPOSE_DEFINE_(i64x2, u64x2,  2)
+WAV_TRANSPOSE_DEFINE_(f32x4, u32x4,  4)
+WAV_TRANSPOSE_DEFINE_(f64x2, u64x2,  2)
+
+#define WAV_TRANSPOSE_DEFINE_ARRAY_(Type, Element, Lanes) \
+  WAV_KERNEL_ATTRIBUTES \
+  void \
+  wav_##Type##_array_transpose(Element * dest, const Element * src, size_t rows, size_t cols) { \
+    size_t r0, c0, r, c, i; \
+    \
+    for (r0 = 0 ; r0 < rows ; r0 += WAV_TRANSPOSE_TILE) { \
+      const size_t r_end = ((rows - r0) < WAV_TRANSPOSE_TILE) ? rows : (r0 + WAV_TRANSPOSE_TILE); \
+      const size_t r_full = r0 + (((r_end - r0) / Lanes) * Lanes); \
+      \
+      for (c0 = 0 ; c0 < cols ; c0 += WAV_TRANSPOSE_TILE) { \
+        const size_t c_end = ((cols - c0) < WAV_TRANSPOSE_TILE) ? cols : (c0 + WAV_TRANSPOSE_TILE); \
+        const size_t c_full = c0 + (((c_end - c0) / Lanes) * Lanes); \
+        \
+        for (r = r0 ; r < r_full ; r += Lanes) { \
+          for (c = c0 ; c < c_full ; c += Lanes) { \
+            wav_##Type##_t block[Lanes]; \
+            for (i = 0 ; i < Lanes ; i++) { \
+              block[i] = wav_##Type##_loadu(&(src[((r + i) * cols) + c])); \
+            } \
+            wav_##Type##_transpose(block); \
+            for (i = 0 ; i < Lanes ; i++) { \
+              wav_##Type##_storeu(&(dest[((c + i) * rows) + r]), block[i]); \
+            } \
+          } \
+          \
+          for (i = r ; i < (r + Lanes) ; i++) { \
+            for (c = c_full ; c < c_end ; c++) { \
+              dest[(c * rows) + i] = src[(i * cols) + c]; \
+            } \
+          } \
+        } \
+        \
+        for (r = r_full ; r < r_end ; r++) { \
+          for (c = c0 ; c < c_end ; c++) { \
+            dest[(c * rows) + r] = src[(r * cols) + c]; \
+          } \
+        } \
+      } \
+    } \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  void \
+  wav_transpose(wav_##Type##_t rows[Lanes]) { \
+    wav_##Type##_transpose(rows); \
+  } \
+  \
+  WAV_OVERLOAD_ATTRIBUTES \
+  void \
+  wav_transpose(Element * dest, const Element * src, size_t rows, size_t cols) { \
+    wav_##Type##_array_transpose(dest, src, rows, cols); \
+  }
+
+/* array_transpose -- Transpose a row-major matrix
+ */
+
+WAV_TRANSPOSE_DEFINE_ARRAY_(i8x16,   int8_t, 16)
+WAV_TRANSPOSE_DEFINE_ARRAY_(i16x8,  int16_t,  8)
+WAV_TRANSPOSE_DEFINE_ARRAY_(i32x4,  int32_t,  4)
+WAV_TRANSPOSE_DEFINE_ARRAY_(i64x2,  int64_t,  2)
+WAV_TRANSPOSE_DEFINE_ARRAY_(u8x16,  uint8_t, 16)
+WAV_TRANSPOSE_DEFINE_ARRAY_(u16x8, uint16_t,  8)
+WAV_TRANSPOSE_DEFINE_ARRAY_(u32x4, uint32_t,  4)
+WAV_TRANSPOSE_DEFINE_ARRAY_(u64x2, uint64_t,  2)
+WAV_TRANSPOSE_DEFINE_ARRAY_(f32x4,    float,  4)
+WAV_TRANSPOSE_DEFINE_ARRAY_(f64x2,   double,  2)
+
+#pragma clang diagnostic pop
+
+#endif /* !defined(WAV_TRANSPOSE_H) */